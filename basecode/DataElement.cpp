@@ -102,6 +102,13 @@ void DataElement::resize( unsigned int newNumLocalData )
 	numLocalData_ = newNumLocalData;
 }
 
+void DataElement::replaceData( char* data, unsigned int numLocalData )
+{
+	cinfo()->dinfo()->destroyData( data_ );
+	data_ = data;
+	numLocalData_ = numLocalData;
+}
+
 /////////////////////////////////////////////////////////////////////////
 // Zombie stuff
 /////////////////////////////////////////////////////////////////////////
@@ -128,6 +128,14 @@ class DataElement: public Element
 		/// Virtual func.
 		void zombieSwap( const Cinfo* newCinfo );
 
+	protected:
+		/**
+		 * Takes over a new local data array, allocated by the Dinfo,
+		 * and destroys the old one. Used by derived classes when they
+		 * change which entries live on this node.
+		 */
+		void replaceData( char* data, unsigned int numLocalData );
+
 	private:
 
 		/**
@@ -50,6 +50,26 @@ class DinfoBase
 		*/
 		virtual bool isA( const DinfoBase* other ) const = 0;
 
+		/**
+		 * True if the class keeps runtime state beyond its fields, which
+		 * it saves and restores for checkpoints. See StateBuffer.h.
+		 */
+		virtual bool hasState() const {
+			return false;
+		}
+
+		/// Appends the runtime state of the entry at d to w.
+		virtual void saveState( const char* d, StateWriter& w ) const
+		{;}
+
+		/**
+		 * Restores the entry at d from r. Returns false if r did not
+		 * hold the state of this class.
+		 */
+		virtual bool restoreState( char* d, StateReader& r ) const {
+			return true;
+		}
+
 		bool isOneZombie() const {
 			return isOneZombie_;
 		}
@@ -57,6 +77,19 @@ class DinfoBase
 		const bool isOneZombie_;
 };
 
+/**
+ * True if D has both saveState( StateWriter& ) const and
+ * restoreState( StateReader& ).
+ */
+template< class D, class = void > struct HasState: std::false_type
+{;};
+
+template< class D > struct HasState< D, decltype(
+		std::declval< const D& >().saveState( std::declval< StateWriter& >() ),
+		std::declval< D& >().restoreState( std::declval< StateReader& >() ),
+		void() ) >: std::true_type
+{;};
+
 template< class D > class Dinfo: public DinfoBase
 {
 	public:
@@ -170,6 +203,22 @@ template< class D > class Dinfo: public DinfoBase
 		bool isA( const DinfoBase* other ) const {
 			return dynamic_cast< const Dinfo< D >* >( other );
 		}
+
+		/// A OneZombie only points into its solver, which has the state.
+		bool hasState() const {
+			return HasState< D >::value && !isOneZombie();
+		}
+
+		void saveState( const char* d, StateWriter& w ) const {
+			if constexpr ( HasState< D >::value )
+				reinterpret_cast< const D* >( d )->saveState( w );
+		}
+
+		bool restoreState( char* d, StateReader& r ) const {
+			if constexpr ( HasState< D >::value )
+				reinterpret_cast< D* >( d )->restoreState( r );
+			return r.ok();
+		}
 	private:
 		unsigned int sizeIncrement_;
 };
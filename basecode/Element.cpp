@@ -471,8 +471,15 @@ void Element::putTargetsInDigest(
 {
     const Msg* msg = Msg::getMsg( mfb.mid );
     vector< vector < Eref > > erefs;
+    const OpFunc* func = fo.func();
     if ( msg->e1() == this )
-        msg->targets( erefs );
+    {
+        const OpFunc* routed = msg->routedTargets( erefs );
+        if ( routed )
+            func = routed;
+        else
+            msg->targets( erefs );
+    }
     else if ( msg->e2() == this )
         msg->sources( erefs );
     else
@@ -490,9 +497,9 @@ void Element::putTargetsInDigest(
         vector< MsgDigest >& md =
             msgDigest_[ msgBinding_.size() * j + srcNum ];
         // k->func(); erefs[ j ];
-        if ( md.size() == 0 || md.back().func != fo.func() )
+        if ( md.size() == 0 || md.back().func != func )
         {
-            md.push_back( MsgDigest( fo.func(), erefs[j] ) );
+            md.push_back( MsgDigest( func, erefs[j] ) );
             /*
             if ( md.back().targets.size() > 0 )
             	cout << "putTargetsInDigest: " << md.back().targets[0] <<
@@ -78,12 +78,17 @@ unsigned int LocalDataElement::getNode( unsigned int dataId ) const {
 			return 0; // Sure to have some data on node 0.
 		}
 	}
+	if ( !nodeStart_.empty() )
+		return upper_bound( nodeStart_.begin() + 1, nodeStart_.end() - 1,
+						dataId ) - nodeStart_.begin() - 1;
 	return dataId / numPerNode_;
 }
 
 /// Inherited virtual. Returns start DataId on specified node
 unsigned int LocalDataElement::startDataIndex( unsigned int node ) const
 {
+	if ( !nodeStart_.empty() )
+		return node < nodeStart_.size() ? nodeStart_[node] : numData_;
 	if ( numPerNode_ * node < numData_ )
 		return numPerNode_ * node;
 	else
@@ -91,6 +96,8 @@ unsigned int LocalDataElement::startDataIndex( unsigned int node ) const
 }
 
 unsigned int LocalDataElement::rawIndex( unsigned int dataId ) const {
+	if ( !nodeStart_.empty() )
+		return dataId - localDataStart_;
 	return dataId % numPerNode_;
 }
 
@@ -115,11 +122,23 @@ unsigned int LocalDataElement::setDataSize( unsigned int numData )
 // virtual func, overridden.
 void LocalDataElement::resize( unsigned int newNumData )
 {
+	if ( !nodeStart_.empty() ) {
+		// Go back to the even split, keeping what is on this node.
+		vector< unsigned int > start( Shell::numNodes() + 1 );
+		unsigned int numPerNode = 1 + ( numData_ - 1 ) / Shell::numNodes();
+		for ( unsigned int i = 0; i < start.size(); ++i )
+			start[i] = min( i * numPerNode, numData_ );
+		setNodeBlocks( start );
+		nodeStart_.clear();
+	}
 	DataElement::resize( setDataSize( newNumData ) );
 }
 
 unsigned int LocalDataElement::getNumOnNode( unsigned int node ) const
 {
+	if ( !nodeStart_.empty() )
+		return node + 1 < nodeStart_.size() ?
+				nodeStart_[node + 1] - nodeStart_[node] : 0;
 	unsigned int lastUsedNode = numData_ / numPerNode_;
 	if ( lastUsedNode > node )
 		return numPerNode_;
@@ -127,3 +146,37 @@ unsigned int LocalDataElement::getNumOnNode( unsigned int node ) const
 		return numData() - node * numPerNode_;
 	return 0;
 }
+
+unsigned int LocalDataElement::setNodeBlocks(
+				const vector< unsigned int >& start )
+{
+	unsigned int myNode = Shell::myNode();
+	if ( start.size() != Shell::numNodes() + 1 || start.front() != 0 ||
+			start.back() != numData_ ) {
+		cout << "Error: LocalDataElement::setNodeBlocks: " << getName() <<
+			": block boundaries must run from 0 to " << numData_ <<
+			" over " << Shell::numNodes() << " nodes\n";
+		return 0;
+	}
+	for ( unsigned int i = 1; i < start.size(); ++i )
+		if ( start[i] < start[i - 1] )
+			return 0;
+
+	unsigned int oldStart = localDataStart_;
+	unsigned int oldEnd = oldStart + numLocalData();
+	unsigned int newStart = start[ myNode ];
+	unsigned int newEnd = start[ myNode + 1 ];
+	unsigned int lo = max( oldStart, newStart );
+	unsigned int hi = min( oldEnd, newEnd );
+
+	const DinfoBase* d = cinfo()->dinfo();
+	char* data = d->allocData( newEnd - newStart );
+	if ( hi > lo && !d->isOneZombie() )
+		d->assignData( data + ( lo - newStart ) * d->sizeIncrement(),
+			hi - lo, this->data( lo - oldStart ), hi - lo );
+	replaceData( data, newEnd - newStart );
+
+	nodeStart_ = start;
+	localDataStart_ = newStart;
+	return ( newEnd - newStart ) - ( hi > lo ? hi - lo : 0 );
+}
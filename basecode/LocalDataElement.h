@@ -99,6 +99,15 @@ class LocalDataElement: public DataElement
 		/////////////////////////////////////////////////////////////////
 		unsigned int setDataSize( unsigned int numData );
 
+		/**
+		 * Assigns the block of entries held by each node, in place of
+		 * the even split. The vector has numNodes + 1 boundaries, from
+		 * 0 to numData. Entries that stay on this node keep their
+		 * values. Entries that arrive are default-constructed, and
+		 * their number is returned. Used by Shell::loadBalance.
+		 */
+		unsigned int setNodeBlocks( const vector< unsigned int >& start );
+
 	private:
 		/**
 		 * This is the total number of data entries on this Element, in
@@ -119,6 +128,12 @@ class LocalDataElement: public DataElement
 		 * Precomputed value for start index of data on this node.
 		 */
 		unsigned int localDataStart_;
+
+		/**
+		 * Start index of the block on each node, set by setNodeBlocks.
+		 * Empty for the even split.
+		 */
+		vector< unsigned int > nodeStart_;
 };
 
 #endif // _LOCAL_DATA_ELEMENT_H
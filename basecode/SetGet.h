@@ -10,6 +10,8 @@
 #ifndef _SETGET_H
 #define _SETGET_H
 
+#include <cstddef>
+
 #ifndef NDEBUG
 #include <typeinfo>
 using namespace std;
@@ -367,6 +369,56 @@ public:
              dest.path() << endl;
     }
 
+    /**
+     * Bulk get and set for n entries of the Element of dest. These are
+     * the data entries, or the field entries on dest.dataIndex if the
+     * Element is a FieldElement. The set or get function is looked up
+     * once and called directly on each entry, instead of looking it up
+     * and dispatching it per entry as set() and get() do. Zombie classes
+     * bring their own functions, so solved fields go to the solver.
+     *
+     * vals is read or written with a stride in units of A, so that
+     * strided numpy buffers can be used as they are. A stride of 0 in
+     * setBulk assigns the same value to every entry.
+     *
+     * Return false without touching any entry if the function is not
+     * found or has another type, or if some entry is off-node. Callers
+     * then fall back on set() and get().
+     */
+    static bool getBulk( const ObjId& dest, const string& field,
+                         A* vals, size_t n, ptrdiff_t stride = 1 )
+    {
+        string fullFieldName = "get" + field;
+        fullFieldName[3] = std::toupper( fullFieldName[3] );
+        const GetOpFuncBase< A >* gof =
+            dynamic_cast< const GetOpFuncBase< A >* >(
+                findBulkFunc( dest, fullFieldName, n ) );
+        if ( !gof )
+            return false;
+        Element* elm = dest.element();
+        for ( size_t i = 0; i < n; ++i )
+            vals[ static_cast< std::ptrdiff_t >( i ) * stride ] =
+                gof->returnOp( bulkEref( dest, elm, i ) );
+        return true;
+    }
+
+    static bool setBulk( const ObjId& dest, const string& field,
+                         const A* vals, size_t n, ptrdiff_t stride = 1 )
+    {
+        string fullFieldName = "set" + field;
+        fullFieldName[3] = std::toupper( fullFieldName[3] );
+        const OpFunc1Base< A >* op =
+            dynamic_cast< const OpFunc1Base< A >* >(
+                findBulkFunc( dest, fullFieldName, n ) );
+        if ( !op )
+            return false;
+        Element* elm = dest.element();
+        for ( size_t i = 0; i < n; ++i )
+            op->op( bulkEref( dest, elm, i ),
+                    vals[ static_cast< std::ptrdiff_t >( i ) * stride ] );
+        return true;
+    }
+
     /**
      * Blocking call for finding a value and returning in a
      * string.
@@ -377,6 +429,29 @@ public:
         Conv< A >::val2str( str, get( dest, field ) );
         return 1;
     }
+
+private:
+    static Eref bulkEref( const ObjId& dest, Element* elm, size_t i )
+    {
+        if ( elm->hasFields() )
+            return Eref( elm, dest.dataIndex, i );
+        return Eref( elm, i, 0 );
+    }
+
+    // The field function if all n entries can be reached directly.
+    static const OpFunc* findBulkFunc( const ObjId& dest,
+                                       const string& fullFieldName, size_t n )
+    {
+        Element* elm = dest.element();
+        const DestFinfo* df = dynamic_cast< const DestFinfo* >(
+                                  elm->cinfo()->findFinfo( fullFieldName ) );
+        if ( !df )
+            return 0;
+        for ( size_t i = 0; i < n; ++i )
+            if ( !bulkEref( dest, elm, i ).isDataHere() )
+                return 0;
+        return df->getOpFunc();
+    }
 };
 
 /**
@@ -624,6 +624,42 @@ public:
         }
     }
 
+    /**
+     * Fills the matrix from n (row, col, value) entries, keeping its
+     * size. Unlike tripletFill this does not sort the entries, but
+     * places them by a counting sort on column and then on row, so it
+     * takes time linear in n and the matrix size. Entries in a row come
+     * out in column order. All indices must be within the matrix.
+     */
+    void countingFill( const unsigned int* row, const unsigned int* col,
+                       const T* z, size_t n )
+    {
+        vector< unsigned int > colStart( ncolumns_ + 1, 0 );
+        for ( size_t i = 0; i < n; ++i )
+            ++colStart[ col[i] + 1 ];
+        for ( unsigned int i = 0; i < ncolumns_; ++i )
+            colStart[i + 1] += colStart[i];
+        vector< unsigned int > byCol( n );
+        for ( size_t i = 0; i < n; ++i )
+            byCol[ colStart[ col[i] ]++ ] = i;
+
+        rowStart_.assign( nrows_ + 1, 0 );
+        for ( size_t i = 0; i < n; ++i )
+            ++rowStart_[ row[i] + 1 ];
+        for ( unsigned int i = 0; i < nrows_; ++i )
+            rowStart_[i + 1] += rowStart_[i];
+        vector< unsigned int > next( rowStart_.begin(), rowStart_.end() - 1 );
+        N_.resize( n );
+        colIndex_.resize( n );
+        for ( size_t k = 0; k < n; ++k )
+        {
+            unsigned int i = byCol[k];
+            unsigned int j = next[ row[i] ]++;
+            N_[j] = z[i];
+            colIndex_[j] = col[i];
+        }
+    }
+
     void pairFill( const vector< unsigned int >& row,
                    const vector< unsigned int >& col, T value )
     {
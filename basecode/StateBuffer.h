@@ -0,0 +1,190 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+#ifndef _STATE_BUFFER_H
+#define _STATE_BUFFER_H
+
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Byte buffers for the runtime state of objects, used for checkpoints.
+ * A class takes part by defining
+ *     void saveState( StateWriter& w ) const;
+ *     void restoreState( StateReader& r );
+ * which Dinfo picks up. Values are written as their raw bytes, so a
+ * checkpoint only restores onto a build of the same code on the same
+ * kind of machine, and restoring gives back exactly the same numbers.
+ * Vectors and strings are written as their length and then the entries.
+ */
+class StateWriter
+{
+	public:
+		StateWriter( vector< char >& buf )
+			: buf_( buf )
+		{;}
+
+		template< class T > void put( const T& v )
+		{
+			static_assert( std::is_trivially_copyable< T >::value,
+					"StateWriter::put needs a plain value" );
+			append( &v, sizeof( T ) );
+		}
+
+		template< class T > void put( const vector< T >& v )
+		{
+			put< uint64_t >( v.size() );
+			if constexpr ( std::is_trivially_copyable< T >::value )
+				append( v.data(), v.size() * sizeof( T ) );
+			else
+				for ( size_t i = 0; i < v.size(); ++i )
+					put( v[i] );
+		}
+
+		void put( const vector< bool >& v )
+		{
+			put< uint64_t >( v.size() );
+			for ( size_t i = 0; i < v.size(); ++i )
+				put< bool >( v[i] );
+		}
+
+		void put( const string& s )
+		{
+			put< uint64_t >( s.length() );
+			append( s.data(), s.length() );
+		}
+
+	private:
+		void append( const void* p, size_t n )
+		{
+			const char* c = static_cast< const char* >( p );
+			buf_.insert( buf_.end(), c, c + n );
+		}
+
+		vector< char >& buf_;
+};
+
+/**
+ * Reads back what a StateWriter wrote. Reading past the end, or a
+ * length that does not fit in what is left, leaves the value alone
+ * and sets ok() to false, after which nothing more is read.
+ */
+class StateReader
+{
+	public:
+		StateReader( const char* buf, size_t size )
+			: p_( buf ), end_( buf + size ), ok_( true )
+		{;}
+
+		template< class T > void get( T& v )
+		{
+			static_assert( std::is_trivially_copyable< T >::value,
+					"StateReader::get needs a plain value" );
+			take( &v, sizeof( T ) );
+		}
+
+		template< class T > void get( vector< T >& v )
+		{
+			const bool plain = std::is_trivially_copyable< T >::value;
+			uint64_t n = 0;
+			get( n );
+			// Other entries start with a length.
+			if ( !fits( n, plain ? sizeof( T ) : sizeof( uint64_t ) ) )
+				return;
+			v.resize( n );
+			if constexpr ( std::is_trivially_copyable< T >::value )
+				take( v.data(), n * sizeof( T ) );
+			else
+				for ( size_t i = 0; i < n; ++i )
+					get( v[i] );
+		}
+
+		/**
+		 * Reads a vector that must be as long as v already is, as for
+		 * arrays whose size is fixed when the object is set up. On a
+		 * mismatch v is left alone and ok() becomes false.
+		 */
+		template< class T > void getFixed( vector< T >& v )
+		{
+			vector< T > t;
+			get( t );
+			if ( t.size() != v.size() )
+				fail();
+			if ( ok_ )
+				v.swap( t );
+		}
+
+		void get( vector< bool >& v )
+		{
+			uint64_t n = 0;
+			get( n );
+			if ( !fits( n, sizeof( bool ) ) )
+				return;
+			v.resize( n );
+			for ( size_t i = 0; i < n; ++i ) {
+				bool b = false;
+				get( b );
+				v[i] = b;
+			}
+		}
+
+		void get( string& s )
+		{
+			uint64_t n = 0;
+			get( n );
+			if ( !fits( n, 1 ) )
+				return;
+			s.assign( p_, n );
+			p_ += n;
+		}
+
+		bool ok() const
+		{
+			return ok_;
+		}
+
+		/// Marks the state as unusable, as when it does not fit the object.
+		void fail()
+		{
+			ok_ = false;
+		}
+
+		/// True when all of the buffer has been read without error.
+		bool done() const
+		{
+			return ok_ && p_ == end_;
+		}
+
+	private:
+		/// Each entry takes at least minSize bytes.
+		bool fits( uint64_t n, size_t minSize )
+		{
+			if ( ok_ && n <= uint64_t( end_ - p_ ) / minSize )
+				return true;
+			ok_ = false;
+			return false;
+		}
+
+		void take( void* v, size_t n )
+		{
+			if ( !ok_ || n > size_t( end_ - p_ ) ) {
+				ok_ = false;
+				return;
+			}
+			memcpy( v, p_, n );
+			p_ += n;
+		}
+
+		const char* p_;
+		const char* end_;
+		bool ok_;
+};
+
+#endif // _STATE_BUFFER_H
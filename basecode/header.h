@@ -59,6 +59,7 @@ const unsigned int BADINDEX = ~1U;
 #include "ProcInfo.h"
 #include "MsgFuncBinding.h"
 #include "../msg/Msg.h"
+#include "StateBuffer.h"
 #include "Dinfo.h"
 #include "MsgDigest.h"
 #include "Element.h"
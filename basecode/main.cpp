@@ -22,6 +22,7 @@
 #include "../msg/DiagonalMsg.h"
 #include "../msg/SparseMsg.h"
 #include "../mpi/PostMaster.h"
+#include "../mpi/ShmTransport.h"
 #ifdef USE_MPI
 #include <mpi.h>
 #endif
@@ -53,6 +54,9 @@ extern void testMpiBuiltins();
 extern void testMpiShell();
 extern void testMsg();
 extern void testMpiMsg();
+extern void testMpi();
+extern void testMpiFibonacci();
+extern void testMpiSpikeBatch();
 // extern void testKinetics();
 extern void testKsolve();
 extern void testKsolveProcess();
@@ -117,6 +121,7 @@ unsigned int getNumCores()
 }
 
 bool quitFlag = 0;
+bool nodeTestFlag = 0;
 //////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////
 
@@ -139,6 +144,7 @@ Id init(int argc, char** argv, bool& doUnitTests)
     unsigned int numCores = getNumCores();
     int numNodes = 1;
     int myNode = 0;
+    unsigned int numShmNodes = 0;
     bool isInfinite = 0;
     int opt;
     Cinfo::rebuildOpIndex();
@@ -153,7 +159,7 @@ Id init(int argc, char** argv, bool& doUnitTests)
      * Here we allow the user to override the automatic identification
      * of processor configuration
      */
-    while ( ( opt = getopt( argc, argv, "hiqun:b:B:" ) ) != -1 )
+    while ( ( opt = getopt( argc, argv, "hiqumn:s:b:B:" ) ) != -1 )
     {
         switch ( opt )
         {
@@ -163,21 +169,40 @@ Id init(int argc, char** argv, bool& doUnitTests)
         case 'n': // Multiple nodes
             numNodes = (unsigned int)atoi( optarg );
         break;
+        case 's': // Multiple nodes as processes on this host
+            numShmNodes = (unsigned int)atoi( optarg );
+        break;
         case 'B': // Benchmark plus dump data: handle later.
             break;
         case 'u': // Do unit tests, pass back.
             doUnitTests = true;
             break;
+        case 'm': // Do the tests that pass data between nodes.
+            nodeTestFlag = 1;
+            break;
         case 'q': // quit immediately after completion.
             quitFlag = 1;
             break;
         case 'h': // help
         default:
-            cout << "Usage: moose -help -infiniteLoop -unit_tests -quit -n numNodes\n";
+            cout << "Usage: moose -help -infiniteLoop -unit_tests -multinode_tests -quit -n numNodes -s numSharedMemoryNodes\n";
 
             exit( 1 );
         }
     }
+#ifndef USE_MPI
+    /**
+     * Without MPI, we can still run several nodes on one host, as forked
+     * processes that pass messages through shared memory.
+     */
+    if ( numShmNodes > 1 )
+    {
+        myNode = ShmTransport::launch( numShmNodes,
+                                       2 * ( PostMaster::reserveBufSize + 1 ) );
+        if ( ShmTransport::instance() )
+            numNodes = numShmNodes;
+    }
+#endif
     if ( myNode == 0 )
     {
 #ifndef QUIET_MODE
@@ -286,8 +311,23 @@ void mpiTests()
     MOOSE_TEST( "testMpiShell", testMpiShell());
     MOOSE_TEST( "testMpiBuiltins", testMpiBuiltins());
     MOOSE_TEST( "testMpiScheduling", testMpiScheduling());
+    MOOSE_TEST( "testMpi", testMpi());
 #endif
 }
+/**
+ * These tests pass data between the nodes on every step, so they
+ * check the transport as well as the PostMaster. Run them with -s or
+ * under MPI on two or more nodes.
+ */
+void multiNodeTests()
+{
+#ifdef DO_UNIT_TESTS
+    MOOSE_TEST( "testMpi", testMpi());
+    MOOSE_TEST( "testMpiFibonacci", testMpiFibonacci());
+    MOOSE_TEST( "testMpiSpikeBatch", testMpiSpikeBatch());
+#endif
+}
+
 #if ! defined(PYMOOSE) && ! defined(MOOSE_LIB)
 int main( int argc, char** argv )
 {
@@ -320,11 +360,17 @@ int main( int argc, char** argv )
             mpiTests();
             processTests( s );
         }
+        if ( nodeTestFlag )
+            multiNodeTests();
 #endif
         // Here we set off a little event loop to poll user input.
         // It deals with the doQuit call too.
         if(! quitFlag)
             Shell::launchParser();
+        // Release any workers that are still waiting on us, whether
+        // they are forked processes or MPI ranks.
+        if ( Shell::numNodes() > 1 && Shell::keepLooping() )
+            s->doQuit();
     }
     else
     {
@@ -336,10 +382,11 @@ int main( int argc, char** argv )
     }
     Msg::clearAllMsgs();
     Id::clearAllElements();
+    bool workersOk = ShmTransport::finalize();
 #ifdef USE_MPI
     MPI_Finalize();
 #endif
-    return 0;
+    return workersOk ? 0 : 1;
 }
 #endif
 
@@ -20,6 +20,7 @@
 
 #include "../synapse/Synapse.h"
 #include "../synapse/SynEvent.h"
+#include "../synapse/SynEventRing.h"
 #include "../synapse/SynHandlerBase.h"
 #include "../synapse/SimpleSynHandler.h"
 
@@ -975,6 +976,67 @@ void testSetRepeat()
     cout << "." << flush;
 }
 
+void testSetGetBulk()
+{
+    const Cinfo* sc = SimpleSynHandler::initCinfo();
+    unsigned int size = 100;
+
+    Id cell = Id::nextId();
+    Element* temp = new GlobalDataElement(cell, sc, "cell", size);
+    assert(temp);
+
+    // Data entries, read back through the per-entry path.
+    vector<unsigned int> numSyn(2 * size, 0);
+    for(unsigned int i = 0; i < size; ++i)
+        numSyn[2 * i] = i % 7;
+    bool ret = Field<unsigned int>::setBulk(cell, "numSynapse", &numSyn[0], size, 2);
+    assert(ret);
+    for(unsigned int i = 0; i < size; ++i)
+        assert(Field<unsigned int>::get(ObjId(cell, i), "numSynapse") == i % 7);
+
+    vector<unsigned int> got(size, 0);
+    ret = Field<unsigned int>::getBulk(cell, "numSynapse", &got[0], size);
+    assert(ret);
+    for(unsigned int i = 0; i < size; ++i)
+        assert(got[i] == i % 7);
+
+    // A negative stride walks the buffer backwards from its last entry.
+    ret = Field<unsigned int>::getBulk(cell, "numSynapse", &got[size - 1],
+                                       size, -1);
+    assert(ret);
+    for(unsigned int i = 0; i < size; ++i)
+        assert(got[size - 1 - i] == i % 7);
+    ret = Field<unsigned int>::setBulk(cell, "numSynapse",
+                                       &numSyn[2 * (size - 1)], size, -2);
+    assert(ret);
+    for(unsigned int i = 0; i < size; ++i)
+        assert(Field<unsigned int>::get(ObjId(cell, i), "numSynapse") ==
+               (size - 1 - i) % 7);
+    ret = Field<unsigned int>::setBulk(cell, "numSynapse", &numSyn[0], size, 2);
+    assert(ret);
+
+    // Field entries of one data entry, with stride 0 to repeat a value.
+    Id synapse(cell.value() + 1);
+    double delay = 4.5;
+    ret = Field<double>::setBulk(ObjId(synapse, 6), "delay", &delay, 6, 0);
+    assert(ret);
+    vector<double> delays;
+    Field<double>::getVec(ObjId(synapse, 6), "delay", delays);
+    assert(delays.size() == 6);
+    for(unsigned int j = 0; j < 6; ++j)
+        assert(doubleEq(delays[j], 4.5));
+
+    // Type mismatch and unknown fields are refused.
+    ret = Field<int>::getBulk(cell, "numSynapse", (int*)&got[0], size);
+    assert(!ret);
+    ret = Field<double>::getBulk(cell, "noSuchField", &delays[0], 1);
+    assert(!ret);
+
+    delete synapse.element();
+    delete temp;
+    cout << "." << flush;
+}
+
 /**
  * This sets up a reciprocal shared Msg in which the incoming value gets
  * appended onto the corresponding value of the target. Also, as soon
@@ -1819,6 +1881,7 @@ void testAsync()
     testSetGetVec();
     test2ArgSetVec();
     testSetRepeat();
+    testSetGetBulk();
     testStrSet();
     testStrGet();
     testLookupSetGet();
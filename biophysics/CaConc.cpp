@@ -137,6 +137,20 @@ void CaConc::vProcess( const Eref& e, ProcPtr p )
 }
 
 
+void CaConc::saveState( StateWriter& w ) const
+{
+	w.put( Ca_ );
+	w.put( c_ );
+	w.put( activation_ );
+}
+
+void CaConc::restoreState( StateReader& r )
+{
+	r.get( Ca_ );
+	r.get( c_ );
+	r.get( activation_ );
+}
+
 void CaConc::vCurrent( const Eref& e, double I )
 {
 	activation_ += I;
@@ -63,6 +63,10 @@ class CaConc: public CaConcBase
         void vSetFloor( const Eref& e, double val );
         double vGetFloor( const Eref& e ) const;
 
+		/// Runtime state for checkpoints
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+
 		static const Cinfo* initCinfo();
 	private:
 		double Ca_;
@@ -132,3 +132,17 @@ double ChanCommon::getGbar() const
 {
     return Gbar_;
 }
+
+void ChanCommon::saveState( StateWriter& w ) const
+{
+    w.put( Vm_ );
+    w.put( Gk_ );
+    w.put( Ik_ );
+}
+
+void ChanCommon::restoreState( StateReader& r )
+{
+    r.get( Vm_ );
+    r.get( Gk_ );
+    r.get( Ik_ );
+}
@@ -75,6 +75,10 @@ public:
     /// Utility function to acces Gbar
     double getGbar() const;
 
+    /// Runtime state for checkpoints
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     /// Specify the Class Info static variable for initialization.
     static const Cinfo* initCinfo();
 protected:
@@ -216,6 +216,26 @@ void Compartment::vReinit(  const Eref& e, ProcPtr p )
     VmOut()->send( e, Vm_ );
 }
 
+void Compartment::saveState( StateWriter& w ) const
+{
+    w.put( Vm_ );
+    w.put( Im_ );
+    w.put( lastIm_ );
+    w.put( A_ );
+    w.put( B_ );
+    w.put( sumInject_ );
+}
+
+void Compartment::restoreState( StateReader& r )
+{
+    r.get( Vm_ );
+    r.get( Im_ );
+    r.get( lastIm_ );
+    r.get( A_ );
+    r.get( B_ );
+    r.get( sumInject_ );
+}
+
 void Compartment::vInitProc( const Eref& e, ProcPtr p )
 {
     // Send out the axial messages
@@ -109,6 +109,9 @@ public:
      */
     void cable();
 
+    /// Runtime state for checkpoints, including the currents gathered so far.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
 
     /**
      * Initializes the class info.
@@ -327,6 +327,26 @@ void HHChannel::vProcess(const Eref& e, ProcPtr info)
  * Here we get the steady-state values for the gate (the 'instant'
  * calculation) as A_/B_.
  */
+void HHChannel::saveState(StateWriter& w) const
+{
+    ChanCommon::saveState(w);
+    w.put(conc_);
+    w.put(X_);
+    w.put(Y_);
+    w.put(Z_);
+    w.put(g_);
+}
+
+void HHChannel::restoreState(StateReader& r)
+{
+    ChanCommon::restoreState(r);
+    r.get(conc_);
+    r.get(X_);
+    r.get(Y_);
+    r.get(Z_);
+    r.get(g_);
+}
+
 void HHChannel::vReinit(const Eref& er, ProcPtr info)
 {
     g_ = ChanCommon::vGetGbar(er);
@@ -409,3 +429,10 @@ HHGate* HHChannel::vGetZgate(unsigned int i) const
 {
     return zGate_;
 }
+
+void HHChannel::vSetGates(HHGate* x, HHGate* y, HHGate* z)
+{
+    xGate_ = x;
+    yGate_ = y;
+    zGate_ = z;
+}
@@ -170,6 +170,7 @@ public:
     bool checkOriginal(Id chanId) const;
 
     void vCreateGate(const Eref& e, string gateType);
+    void vSetGates(HHGate* x, HHGate* y, HHGate* z);
     /**
      * Utility function for destroying gate. Works only on original
      * HHChannel. Somewhat dangerous, should never be used after a
@@ -189,6 +190,10 @@ public:
     bool setGatePower(const Eref& e, double power, double* assignee,
                       const string& gateType);
 
+    /// Runtime state for checkpoints
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     /////////////////////////////////////////////////////////////
     static const Cinfo* initCinfo();
 
@@ -356,9 +356,10 @@ void HHChannelBase::zombify(Element* orig, const Cinfo* zClass, Id hsolve)
     if(num == 0)
         return;
     // Parameters are Gbar, Ek, Xpower, Ypower, Zpower, useConcentration
-    // We also want to haul the original gates over, this is done earlier
-    // in the HSolve building process. So just six terms.
+    // The gates are carried over separately, so that the new channel
+    // has them before its powers are set.
     vector<double> chandata(num * 6, 0.0);
+    vector<HHGate*> gates(num * 3, 0);
     vector<double>::iterator j = chandata.begin();
 
     for(unsigned int i = 0; i < num; ++i) {
@@ -371,6 +372,9 @@ void HHChannelBase::zombify(Element* orig, const Cinfo* zClass, Id hsolve)
         *(j + 3) = hb->getYpower(er);
         *(j + 4) = hb->getZpower(er);
         *(j + 5) = hb->getUseConcentration(er);
+        gates[i * 3] = hb->vGetXgate(0);
+        gates[i * 3 + 1] = hb->vGetYgate(0);
+        gates[i * 3 + 2] = hb->vGetZgate(0);
         j += 6;
     }
     orig->zombieSwap(zClass);
@@ -378,6 +382,7 @@ void HHChannelBase::zombify(Element* orig, const Cinfo* zClass, Id hsolve)
     for(unsigned int i = 0; i < num; ++i) {
         Eref er(orig, i + start);
         HHChannelBase* hb = reinterpret_cast<HHChannelBase*>(er.data());
+        hb->vSetGates(gates[i * 3], gates[i * 3 + 1], gates[i * 3 + 2]);
         hb->vSetSolver(er, hsolve);
         hb->vSetGbar(er, *j);
         hb->vSetEk(er, *(j + 1));
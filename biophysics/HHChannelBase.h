@@ -152,6 +152,11 @@ class HHChannelBase: public ChanCommon
 		virtual HHGate* vGetYgate( unsigned int i ) const = 0;
 		virtual HHGate* vGetZgate( unsigned int i ) const = 0;
 		virtual void vCreateGate( const Eref& e, string gateType ) = 0;
+		/**
+		 * Takes over the gates of the channel that zombify replaces,
+		 * as the new data is made without them.
+		 */
+		virtual void vSetGates( HHGate* x, HHGate* y, HHGate* z ) = 0;
 
 		/////////////////////////////////////////////////////////////
 		// Utility functions for taking integer powers.
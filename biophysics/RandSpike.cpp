@@ -243,3 +243,17 @@ void RandSpike::reinit( const Eref& e, ProcPtr p )
         lastEvent_ = m * log( prob );
     }
 }
+
+void RandSpike::saveState( StateWriter& w ) const
+{
+    w.put( lastEvent_ );
+    w.put( realRate_ );
+    w.put( fired_ );
+}
+
+void RandSpike::restoreState( StateReader& r )
+{
+    r.get( lastEvent_ );
+    r.get( realRate_ );
+    r.get( fired_ );
+}
@@ -39,6 +39,10 @@ public:
     void process( const Eref& e, ProcPtr p );
     void reinit( const Eref& e, ProcPtr p );
 
+    /// Runtime state for checkpoints
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     //////////////////////////////////////////////////////////////////
     static const Cinfo* initCinfo();
 private:
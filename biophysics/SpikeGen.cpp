@@ -226,6 +226,20 @@ void SpikeGen::handleVm( double val )
 	V_ = val;
 }
 
+void SpikeGen::saveState( StateWriter& w ) const
+{
+	w.put( lastEvent_ );
+	w.put( V_ );
+	w.put( fired_ );
+}
+
+void SpikeGen::restoreState( StateReader& r )
+{
+	r.get( lastEvent_ );
+	r.get( V_ );
+	r.get( fired_ );
+}
+
 /////////////////////////////////////////////////////////////////////
 
 #ifdef DO_UNIT_TESTS
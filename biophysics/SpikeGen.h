@@ -45,6 +45,10 @@ class SpikeGen
 		void reinit( const Eref& e, ProcPtr p );
 		void handleVm( double val );
 
+		/// Runtime state for checkpoints
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+
 		static const Cinfo* initCinfo();
 	private:
 		double threshold_;
@@ -8,6 +8,8 @@
 **********************************************************************/
 
 #include "../basecode/header.h"
+#include "../basecode/ElementValueFinfo.h"
+#include "CompartmentBase.h"
 #include "ChanBase.h"
 #include "ChanCommon.h"
 #include "SynChan.h"
@@ -44,6 +46,29 @@ const Cinfo* SynChan::initCinfo()
 		&SynChan::getNormalizeWeights
 	);
 
+	static ElementValueFinfo< SynChan, bool > aggregate(
+		"aggregate",
+		"Flag. If true, this SynChan joins the other aggregating SynChans "
+		"on the same compartment with the same tau1, tau2 and Ek, to "
+		"share a single dual-exponential conductance by linear "
+		"superposition. Each member scales its incoming activation by "
+		"its own Gbar and modulation and passes it on to the group "
+		"leader, which computes and sends the summed conductance to "
+		"the compartment. The other members report zero Gk and Ik. "
+		"A SynChan with IkOut or permeabilityOut messages needs its "
+		"own Ik and Gk, so it is left out of groups, with a warning. "
+		"Groups are worked out on reinit. Only plain SynChans can "
+		"aggregate; the flag is ignored on derived classes.",
+		&SynChan::setAggregate,
+		&SynChan::getAggregate
+	);
+	static ReadOnlyElementValueFinfo< SynChan, ObjId > aggregateLeader(
+		"aggregateLeader",
+		"The SynChan that computes the conductance of this one in "
+		"aggregated mode. This is the SynChan itself if it is the "
+		"leader of its group, or if it is not aggregating.",
+		&SynChan::getAggregateLeader
+	);
 	///////////////////////////////////////////////////////
 	// MsgDest definitions
 	///////////////////////////////////////////////////////
@@ -57,6 +82,8 @@ const Cinfo* SynChan::initCinfo()
 		&tau1,			// Value
 		&tau2,			// Value
 		&normalizeWeights,	// Value
+		&aggregate,		// Value
+		&aggregateLeader,	// ReadOnlyValue
 		&activation,	// Dest
 	};
 
@@ -104,7 +131,9 @@ SynChan::SynChan()
         activation_(0.0),
         X_(0.0),
         Y_(0.0),
-		dt_( 25.0e-6 )
+		dt_( 25.0e-6 ),
+		aggregate_( false ),
+		leader_()
 { ; }
 
 SynChan::~SynChan()
@@ -168,6 +197,70 @@ bool SynChan::getNormalizeWeights() const
 	return normalizeWeights_;
 }
 
+void SynChan::setAggregate( const Eref& e, bool value )
+{
+	if ( value && e.element()->cinfo() != SynChan::initCinfo() ) {
+		cout << "Warning: SynChan::setAggregate: " << e.objId().path() <<
+			" is a " << e.element()->cinfo()->name() <<
+			", which cannot aggregate. Ignored.\n";
+		return;
+	}
+	aggregate_ = value;
+}
+
+bool SynChan::getAggregate( const Eref& e ) const
+{
+	return aggregate_;
+}
+
+ObjId SynChan::getAggregateLeader( const Eref& e ) const
+{
+	return findAggregateLeader( e );
+}
+
+ObjId SynChan::findAggregateLeader( const Eref& e )
+{
+	ObjId self = e.objId();
+	const Cinfo* cinfo = SynChan::initCinfo();
+	if ( e.element()->cinfo() != cinfo )
+		return self;
+	const SynChan* me = reinterpret_cast< const SynChan* >( e.data() );
+	if ( !me->aggregate_ || sendsOwnCurrent( e ) )
+		return self;
+
+	vector< ObjId > compt = e.element()->getMsgTargets(
+					e.dataIndex(), ChanBase::channelOut() );
+	if ( compt.size() != 1 )
+		return self;
+	vector< ObjId > chans = compt[0].element()->getMsgTargets(
+		compt[0].dataIndex, moose::CompartmentBase::VmOut() );
+
+	double Ek = me->getEk( e );
+	ObjId ret = self;
+	for ( vector< ObjId >::const_iterator
+					i = chans.begin(); i != chans.end(); ++i ) {
+		if ( i->element()->cinfo() != cinfo || !( *i < ret ) )
+			continue;
+		const SynChan* other =
+			reinterpret_cast< const SynChan* >( i->data() );
+		if ( other->aggregate_ &&
+			doubleEq( other->tau1_, me->tau1_ ) &&
+			doubleEq( other->tau2_, me->tau2_ ) &&
+			doubleEq( other->getEk( i->eref() ), Ek ) &&
+			!sendsOwnCurrent( i->eref() ) )
+			ret = *i;
+	}
+	return ret;
+}
+
+bool SynChan::sendsOwnCurrent( const Eref& e )
+{
+	return !( e.element()->getMsgTargets( e.dataIndex(),
+					ChanBase::IkOut() ).empty() &&
+		e.element()->getMsgTargets( e.dataIndex(),
+					ChanBase::permeability() ).empty() );
+}
+
 void SynChan::normalizeGbar()
 {
         if ( doubleEq( tau2_, 0.0 ) ) {
@@ -199,6 +292,13 @@ void SynChan::normalizeGbar()
 /// Update alpha function terms for synaptic channel.
 double SynChan::calcGk()
 {
+	if ( aggregate_ ) {
+		// Activation is already scaled to conductance.
+		X_ = activation_ * xconst1_ + X_ * xconst2_;
+		Y_ = X_ * yconst1_ + Y_ * yconst2_;
+		activation_ = 0.0;
+		return Y_;
+	}
 		/*
 	X_ = getModulation() * activation_ * xconst1_ + X_ * xconst2_;
 	Y_ = X_ * yconst1_ + Y_ * yconst2_;
@@ -218,6 +318,9 @@ void SynChan::vProcess( const Eref& e, ProcPtr info )
     //      is sent from SynHandler-s for one dt
     // For continuous activation in a graded synapse,
     //      send activation for continous dt-s.
+	// The leader sends our share of the conductance.
+	if ( leader_ != ObjId() && !leader_.bad() )
+		return;
 	setGk( e, calcGk() );
 	updateIk();
 	sendProcessMsgs( e, info ); // Sends out messages for channel.
@@ -247,10 +350,39 @@ void SynChan::vReinit( const Eref& e, ProcPtr info )
                 yconst2_ = exp( -dt_ / tau2_ );
         }
 	normalizeGbar();
+	leader_ = ObjId();
+	if ( aggregate_ && sendsOwnCurrent( e ) )
+		cout << "Warning: SynChan::reinit: " << e.objId().path() <<
+			" sends out its own Ik or Gk, so it is not aggregated.\n";
+	ObjId leader = findAggregateLeader( e );
+	if ( leader != e.objId() )
+		leader_ = leader;
     sendReinitMsgs(e, info);
 }
 
 void SynChan::activation( double val )
 {
-	activation_ += val;
+	if ( !aggregate_ )
+		activation_ += val;
+	else if ( leader_ != ObjId() && !leader_.bad() )
+		reinterpret_cast< SynChan* >( leader_.data() )->activation_ +=
+			val * norm_ * getModulation();
+	else
+		activation_ += val * norm_ * getModulation();
+}
+
+void SynChan::saveState( StateWriter& w ) const
+{
+	ChanCommon::saveState( w );
+	w.put( activation_ );
+	w.put( X_ );
+	w.put( Y_ );
+}
+
+void SynChan::restoreState( StateReader& r )
+{
+	ChanCommon::restoreState( r );
+	r.get( activation_ );
+	r.get( X_ );
+	r.get( Y_ );
 }
@@ -29,6 +29,10 @@ class SynChan: public ChanCommon
 		void setNormalizeWeights( bool value );
 		bool getNormalizeWeights() const;
 
+		void setAggregate( const Eref& e, bool value );
+		bool getAggregate( const Eref& e ) const;
+		ObjId getAggregateLeader( const Eref& e ) const;
+
 		// override virtual func from ChanBase
 		void vSetGbar( const Eref& e, double Gbar );
 
@@ -57,12 +61,32 @@ class SynChan: public ChanCommon
 		void vReinit( const Eref& e, ProcPtr p );
 
 		void activation( double val );
+///////////////////////////////////////////////////
+		/**
+		 * Returns the SynChan that computes the conductance on behalf of
+		 * the SynChan e. This is the first, by ObjId, of the aggregating
+		 * SynChans on the same compartment with the same tau1, tau2
+		 * and Ek. Returns e itself if it is not aggregating.
+		 * Also used by the HSolve to keep one entry per group.
+		 */
+		static ObjId findAggregateLeader( const Eref& e );
+
+		/**
+		 * True if the SynChan e sends its own Ik or Gk out through
+		 * IkOut or permeabilityOut. Such a SynChan is kept out of
+		 * aggregate groups, as a group only computes the summed Gk.
+		 */
+		static bool sendsOwnCurrent( const Eref& e );
 ///////////////////////////////////////////////////
 		/**
 		 * Override base class function for spike handling
 		 */
 		/* void innerAddSpike( unsigned int synIndex, const double time ); */
 
+		/// Runtime state for checkpoints
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+
 		static const Cinfo* initCinfo();
 	protected: // Used by NMDAChan
 
@@ -83,6 +107,19 @@ class SynChan: public ChanCommon
 		double X_;
 		double Y_;
 		double dt_; /// Tracks the timestep assigned at reinit.
+
+		/**
+		 * Aggregated mode: the SynChans of a group share a single
+		 * dual-exponential state, held by the leader, into which all
+		 * of them pour their scaled activation. Activation is then
+		 * in units of conductance.
+		 */
+		bool aggregate_;
+		/**
+		 * Leader of our aggregate group, or ObjId() if we are the leader.
+		 * Looked up on each use, so that it is never left dangling.
+		 */
+		ObjId leader_;
 };
 
 
@@ -353,6 +353,8 @@ Function::Function():
     , independent_("t")
     , stoich_(nullptr)
     , parser_(shared_ptr<moose::MooseParser>(new moose::MooseParser()))
+    , batchFirst_(false)
+    , batched_(false)
 {
 }
 
@@ -374,6 +376,8 @@ Function& Function::operator=(const Function& rhs)
     allowUnknownVar_ = rhs.allowUnknownVar_;
     t_ = rhs.t_;
     rate_ = rhs.rate_;
+    batchFirst_ = false;
+    batched_ = false;
 
     // Deep copy; create new Variable and constant to link with new parser.
     // Zombification requires it. DO NOT just copy the object/pointer of
@@ -773,20 +777,30 @@ bool Function::symbolExists(const string& name) const
 
 void Function::process(const Eref &e, ProcPtr p)
 {
-    if(! valid_)
+    if(batchFirst_)
+    {
+        processBatch(e, p);
+        return;
+    }
+    if(batched_ || ! valid_)
         return;
 
     // Update values of incoming variables.
-    vector<double> databuf;
-    requestOut()->send(e, &databuf);
+    inputs_.clear();
+    requestOut()->send(e, &inputs_);
 
     t_ = p->currTime;
     value_ = getValue();
     rate_ = (value_ - lastValue_) / p->dt;
 
-    for (unsigned int ii = 0; (ii < databuf.size()) && (ii < ys_.size()); ++ii)
-        *ys_[ii] = databuf[ii];
+    for (unsigned int ii = 0; (ii < inputs_.size()) && (ii < ys_.size()); ++ii)
+        *ys_[ii] = inputs_[ii];
 
+    sendOutputs(e, p);
+}
+
+void Function::sendOutputs(const Eref& e, ProcPtr p)
+{
     if ( useTrigger_ && value_ < TriggerThreshold )
     {
         lastValue_ = value_;
@@ -821,8 +835,89 @@ void Function::process(const Eref &e, ProcPtr p)
     }
 }
 
+void Function::processBatch(const Eref& e, ProcPtr p)
+{
+    Element* elm = e.element();
+    unsigned int start = e.dataIndex();
+    unsigned int n = elm->localDataStart() + elm->numLocalData() - start;
+
+    // Gather the inputs of all valid entries into one buffer.
+    inputs_.clear();
+    inputStart_.clear();
+    batchParsers_.clear();
+    for(unsigned int i = 0; i < n; ++i)
+    {
+        Eref er(elm, start + i);
+        Function* f = reinterpret_cast<Function*>(er.data());
+        if(! f->valid_)
+            continue;
+        inputStart_.push_back(inputs_.size());
+        requestOut()->send(er, &inputs_);
+        f->t_ = p->currTime;
+        batchParsers_.push_back(f->parser_.get());
+    }
+    inputStart_.push_back(inputs_.size());
+
+    // Entries with the same expression share it, so this is one pass.
+    batchValues_.resize(batchParsers_.size());
+    moose::MooseParser::EvalBatch(batchParsers_.data(), batchParsers_.size(),
+            batchValues_.data());
+
+    unsigned int j = 0;
+    for(unsigned int i = 0; i < n; ++i)
+    {
+        Eref er(elm, start + i);
+        Function* f = reinterpret_cast<Function*>(er.data());
+        if(! f->valid_)
+            continue;
+        f->value_ = batchValues_[j];
+        f->rate_ = (f->value_ - f->lastValue_) / p->dt;
+        unsigned int num = inputStart_[j + 1] - inputStart_[j];
+        for(unsigned int ii = 0; ii < num && ii < f->ys_.size(); ++ii)
+            *f->ys_[ii] = inputs_[inputStart_[j] + ii];
+        f->sendOutputs(er, p);
+        j++;
+    }
+}
+
+/**
+ * Called on reinit of the first local entry. The whole Element is done in
+ * one batch unless an output of the Element goes back into the Element, its
+ * x inputs or an object it reads through requestOut. In those cases an
+ * entry may depend on what an earlier entry sent in the same step, so the
+ * order of entries matters.
+ */
+void Function::setupBatch(const Eref& e)
+{
+    Element* elm = e.element();
+    unsigned int start = elm->localDataStart();
+    unsigned int end = start + elm->numLocalData();
+    bool batch = (end - start > 1);
+    vector<Id> sources;
+    elm->getNeighbors(sources, requestOut());
+    const SrcFinfo* outs[] = { valueOut(), derivativeOut(), rateOut() };
+    for(auto out: outs)
+    {
+        vector<Id> tgts;
+        elm->getNeighbors(tgts, out);
+        for(auto& t: tgts)
+            if(t == e.id() || Neutral::parent(t.eref()).id == e.id() ||
+                    find(sources.begin(), sources.end(), t) != sources.end())
+                batch = false;
+    }
+    for(unsigned int i = start; i < end; ++i)
+    {
+        Function* f = reinterpret_cast<Function*>(Eref(elm, i).data());
+        f->batchFirst_ = batch && (i == start);
+        f->batched_ = batch && (i != start);
+    }
+}
+
 void Function::reinit(const Eref &e, ProcPtr p)
 {
+    if(e.dataIndex() == e.element()->localDataStart())
+        setupBatch(e);
+
     if (! (valid_ || parser_->GetExpr().empty()))
     {
         MOOSE_WARN("Error: " << e.objId().path() << "::reinit() - invalid parser state"
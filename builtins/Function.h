@@ -91,6 +91,15 @@ public:
     void process(const Eref& e, ProcPtr p);
     void reinit(const Eref& e, ProcPtr p);
 
+    /**
+     * Processes all local entries of the Element at once, from the call
+     * to the first one: gathers the inputs of all entries into one
+     * buffer, evaluates them in one pass, then sends the outputs. Used
+     * when no output of the Element feeds back into its own inputs.
+     */
+    void processBatch(const Eref& e, ProcPtr p);
+    void setupBatch(const Eref& e);
+
     // This is also used as callback.
     void addVariable(const string& name);
 
@@ -142,6 +151,21 @@ protected:
     // pointer to the MooseParser
     shared_ptr<moose::MooseParser> parser_;
 
+private:
+    // Sends the outputs for value_, as set up by mode_.
+    void sendOutputs(const Eref& e, ProcPtr p);
+
+    // Set on the first entry if it processes the whole Element, and on
+    // the others if they are processed by the first one.
+    bool batchFirst_;
+    bool batched_;
+
+    // Scratch space, kept so that process does not allocate.
+    vector<double> inputs_;
+    vector<unsigned int> inputStart_;
+    vector<moose::MooseParser*> batchParsers_;
+    vector<double> batchValues_;
+
 };
 
 #endif /* end of include guard: FUNCTIONH_ */
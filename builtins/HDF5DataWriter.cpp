@@ -117,14 +117,19 @@ void HDF5DataWriter::close()
         return;
     }
     this->flush();
-    for (map < string, hid_t >::iterator ii = nodemap_.begin();
-         ii != nodemap_.end(); ++ii){
-        if (ii->second >= 0){
-            herr_t status = H5Dclose(ii->second);
-            if (status < 0){
-  	        cerr << "Warning: closing dataset for "
-                     << ii->first << ", returned status = "
-                     << status << endl;
+    {
+        // HDF5WriterBase::close flushes again, which in a subclass may
+        // wait for a thread that needs the lock, so it is not held there.
+        std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+        for (map < string, hid_t >::iterator ii = nodemap_.begin();
+             ii != nodemap_.end(); ++ii){
+            if (ii->second >= 0){
+                herr_t status = H5Dclose(ii->second);
+                if (status < 0){
+                    cerr << "Warning: closing dataset for "
+                         << ii->first << ", returned status = "
+                         << status << endl;
+                }
             }
         }
     }
@@ -139,6 +144,7 @@ void HDF5DataWriter::flush()
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     for (unsigned int ii = 0; ii < datasets_.size(); ++ii){
         herr_t status = appendToDataset(datasets_[ii], data_[ii]);
         data_[ii].clear();
@@ -168,6 +174,7 @@ void HDF5DataWriter::process(const Eref & e, ProcPtr p)
     ++steps_;
     if (steps_ >= flushLimit_){
         steps_ = 0;
+        std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
         for (unsigned int ii = 0; ii < datasets_.size(); ++ii){
             herr_t status = appendToDataset(datasets_[ii], data_[ii]);
             data_[ii].clear();
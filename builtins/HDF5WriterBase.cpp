@@ -130,14 +130,7 @@ hid_t HDF5WriterBase::createDoubleDataset(hid_t parent_id, std::string name, hsi
     hid_t chunk_params = H5Pcreate(H5P_DATASET_CREATE);
     status = H5Pset_chunk(chunk_params, 1, chunk_dims);
     assert( status >= 0 );
-    if (compressor_ == "zlib"){
-        status = H5Pset_deflate(chunk_params, compression_);
-    } else if (compressor_ == "szip"){
-        // this needs more study
-        unsigned sz_opt_mask = H5_SZIP_NN_OPTION_MASK;
-        status = H5Pset_szip(chunk_params, sz_opt_mask,
-                             HDF5WriterBase::CHUNK_SIZE);
-    }
+    status = setFilters(chunk_params);
     hid_t dataspace = H5Screate_simple(1, dims, maxdims);
     hid_t dataset_id = H5Dcreate2(parent_id, name.c_str(),
                                   H5T_NATIVE_DOUBLE, dataspace,
@@ -164,14 +157,7 @@ hid_t HDF5WriterBase::createStringDataset(hid_t parent_id, string name, hsize_t
     hid_t chunk_params = H5Pcreate(H5P_DATASET_CREATE);
     status = H5Pset_chunk(chunk_params, 1, chunk_dims);
     assert( status >= 0 );
-    if (compressor_ == "zlib"){
-        status = H5Pset_deflate(chunk_params, compression_);
-    } else if (compressor_ == "szip"){
-        // this needs more study
-        unsigned sz_opt_mask = H5_SZIP_NN_OPTION_MASK;
-        status = H5Pset_szip(chunk_params, sz_opt_mask,
-                             HDF5WriterBase::CHUNK_SIZE);
-    }
+    status = setFilters(chunk_params);
     hid_t dataspace = H5Screate_simple(1, dims, maxdims);
     hid_t dataset_id = H5Dcreate2(parent_id, name.c_str(),
                                   ftype, dataspace,
@@ -216,29 +202,61 @@ herr_t HDF5WriterBase::appendToDataset(hid_t dataset_id, const vector< double >&
 }
 
 
+/**
+   Set the shuffle and compression filters on dataset creation
+   property list `chunk_params`. The shuffle filter must come before
+   the compressor, as filters are applied in the order they are set.
+ */
+herr_t HDF5WriterBase::setFilters(hid_t chunk_params)
+{
+    herr_t status = 0;
+    if (shuffle_){
+        status = H5Pset_shuffle(chunk_params);
+    }
+    if (compressor_ == "zlib"){
+        status = H5Pset_deflate(chunk_params, compression_);
+    } else if (compressor_ == "szip"){
+        // this needs more study
+        unsigned sz_opt_mask = H5_SZIP_NN_OPTION_MASK;
+        status = H5Pset_szip(chunk_params, sz_opt_mask,
+                             HDF5WriterBase::CHUNK_SIZE);
+    }
+    return status;
+}
+
 /**
    Create a 2D dataset under parent with name. It will have specified
    number of rows and unlimited columns.
  */
 hid_t HDF5WriterBase::createDataset2D(hid_t parent, string name, unsigned int rows)
+{
+    return createDataset2D(parent, name, rows, rows, chunkSize_);
+}
+
+/**
+   Same as above, with chunks of chunkRows x chunkCols. A chunk is the
+   unit of compression and of I/O in HDF5, so reading one row over a
+   short time range touches only the chunks that hold it.
+ */
+hid_t HDF5WriterBase::createDataset2D(hid_t parent, string name, unsigned int rows,
+                                      unsigned int chunkRows, unsigned int chunkCols)
 {
     if (parent < 0){
         return 0;
     }
     herr_t status;
+    if (chunkRows == 0 || chunkRows > rows){
+        chunkRows = rows > 0? rows: 1;
+    }
+    if (chunkCols == 0){
+        chunkCols = 1;
+    }
     // we need chunking here to allow extensibility
-    hsize_t chunkdims[] = {rows, chunkSize_};
+    hsize_t chunkdims[] = {chunkRows, chunkCols};
     hid_t chunk_params = H5Pcreate(H5P_DATASET_CREATE);
     status = H5Pset_chunk(chunk_params, 2, chunkdims);
     assert(status >= 0);
-    if (compressor_ == "zlib"){
-        status = H5Pset_deflate(chunk_params, compression_);
-    } else if (compressor_ == "szip"){
-        // this needs more study
-        unsigned sz_opt_mask = H5_SZIP_NN_OPTION_MASK;
-        status = H5Pset_szip(chunk_params, sz_opt_mask,
-                             HDF5WriterBase::CHUNK_SIZE);
-    }
+    status = setFilters(chunk_params);
     hsize_t dims[2] = {rows, 0};
     hsize_t maxdims[2] = {rows, H5S_UNLIMITED};
     hid_t dataspace = H5Screate_simple(2, dims, maxdims);
@@ -433,6 +451,14 @@ const Cinfo* HDF5WriterBase::initCinfo()
       &HDF5WriterBase::setCompression,
       &HDF5WriterBase::getCompression);
 
+  static ValueFinfo< HDF5WriterBase, bool> shuffle(
+      "shuffle",
+      "Apply the HDF5 byte shuffle filter before compressing array data."
+      " Storing the same byte of successive values together often makes"
+      " floating point data compress much better. Defaults to False.",
+      &HDF5WriterBase::setShuffle,
+      &HDF5WriterBase::getShuffle);
+
   static LookupValueFinfo< HDF5WriterBase, string, string  > sattr(
       "stringAttr",
       "String attributes. The key is attribute name, value is attribute value"
@@ -491,6 +517,7 @@ const Cinfo* HDF5WriterBase::initCinfo()
     &chunkSize,
     &compressor,
     &compression,
+    &shuffle,
     &sattr,
     &dattr,
     &lattr,
@@ -523,6 +550,17 @@ const Cinfo* HDF5WriterBase::initCinfo()
 
 const hssize_t HDF5WriterBase::CHUNK_SIZE = 1024; // default chunk size
 
+/**
+   The HDF5 library is not thread safe unless built so, and NSDFWriter2
+   writes from a thread of its own. All calls into the library that may
+   run alongside such a write take this lock.
+ */
+std::recursive_mutex& HDF5WriterBase::hdf5Mutex()
+{
+    static std::recursive_mutex m;
+    return m;
+}
+
 
 HDF5WriterBase::HDF5WriterBase():
         filehandle_(-1),
@@ -530,7 +568,8 @@ HDF5WriterBase::HDF5WriterBase():
         openmode_(H5F_ACC_EXCL),
         chunkSize_(CHUNK_SIZE),
         compressor_("zlib"),
-        compression_(6)
+        compression_(6),
+        shuffle_(false)
 {
 }
 
@@ -570,6 +609,7 @@ bool HDF5WriterBase::isOpen() const
 
 herr_t HDF5WriterBase::openFile()
 {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     herr_t status = 0;
     if (filehandle_ >= 0){
         cout << "Warning: closing already open file and opening " << filename_ <<  endl;
@@ -647,11 +687,22 @@ unsigned int HDF5WriterBase::getCompression() const
     return compression_;
 }
 
+void HDF5WriterBase::setShuffle(bool shuffle)
+{
+    shuffle_ = shuffle;
+}
+
+bool HDF5WriterBase::getShuffle() const
+{
+    return shuffle_;
+}
+
 
 // Subclasses should reimplement this for flushing data content to
 // file.
 void HDF5WriterBase::flush()
 {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     flushAttributes();
     sattr_.clear();
     dattr_.clear();
@@ -682,6 +733,7 @@ void HDF5WriterBase::close()
         return;
     }
     flush();
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     herr_t status = H5Fclose(filehandle_);
     filehandle_ = -1;
     if (status < 0){
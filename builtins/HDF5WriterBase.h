@@ -32,6 +32,7 @@
 #ifndef _HDF5IO_H
 #define _HDF5IO_H
 #include <typeinfo>
+#include <mutex>
 
 hid_t require_attribute(hid_t file_id, string path,
                         hid_t data_type, hid_t data_id);
@@ -55,6 +56,8 @@ class HDF5WriterBase
     string getCompressor() const;
     void setCompression(unsigned int level);
     unsigned int getCompression() const;
+    void setShuffle(bool shuffle);
+    bool getShuffle() const;
     void setStringAttr(string name, string value);
     void setDoubleAttr(string name, double value);
     void setLongAttr(string name, long value);
@@ -75,8 +78,12 @@ class HDF5WriterBase
 
     static const Cinfo* initCinfo();
 
+    /// Lock held around calls into the HDF5 library
+    static std::recursive_mutex& hdf5Mutex();
+
   protected:
     friend void testCreateStringDataset();
+    friend void testCreateDataset2DChunks();
 
     herr_t openFile();
     // C++ sucks - does not allow template specialization inside class
@@ -85,6 +92,9 @@ class HDF5WriterBase
 
     herr_t appendToDataset(hid_t dataset, const vector<double>& data);
     hid_t createDataset2D(hid_t parent, string name, unsigned int rows);
+    hid_t createDataset2D(hid_t parent, string name, unsigned int rows,
+                          unsigned int chunkRows, unsigned int chunkCols);
+    herr_t setFilters(hid_t chunk_params);
 
     /// map from element path to nodes in hdf5file.  Multiple MOOSE
     /// tables can be written to the single file corresponding to a
@@ -106,6 +116,7 @@ class HDF5WriterBase
     unsigned int chunkSize_;
     string compressor_; // can be zlib or szip
     unsigned int compression_;
+    bool shuffle_;
 
 };
 
@@ -29,9 +29,51 @@ using namespace std;
 namespace moose
 {
 
+/*-----------------------------------------------------------------------------
+ *  Cache of compiled expressions. Models often have thousands of Functions
+ *  with the same expression, and compiling with exprtk is far more costly
+ *  than evaluating. Entries that no parser uses are dropped when the cache
+ *  has doubled in size since the last sweep.
+ *-----------------------------------------------------------------------------*/
+namespace
+{
+struct ExprCache
+{
+    std::mutex mutex;
+    map<string, shared_ptr<Parser::SharedExpr>> compiled;
+    map<string, vector<string>> symbols;
+    size_t sweepAt = 64;
+};
+
+ExprCache& exprCache()
+{
+    static ExprCache* cache = new ExprCache();
+    return *cache;
+}
+}
+
+Parser::SharedExpr::SharedExpr()
+{
+    for(auto& c: copies)
+        c = nullptr;
+}
+
+Parser::SharedExpr::~SharedExpr()
+{
+    for(auto& c: copies)
+        delete c.load();
+}
+
 MooseParser::MooseParser(): expr_("0"), valid_(true)
 {
     Parser::symbol_table_t symbolTable;
+    AddDefaultFunctions(symbolTable);
+    expression_.register_symbol_table(symbolTable);
+    SetExpr(expr_);
+}
+
+void MooseParser::AddDefaultFunctions( Parser::symbol_table_t& symbolTable )
+{
     symbolTable.add_function("ln", MooseParser::Ln);
     symbolTable.add_function("rand", MooseParser::Rand); // between 0 and 1
     symbolTable.add_function("rnd", MooseParser::Rand);  // between 0 and 1
@@ -39,8 +81,6 @@ MooseParser::MooseParser(): expr_("0"), valid_(true)
     symbolTable.add_function("rand2", MooseParser::Rand2);
     symbolTable.add_function("srand2", MooseParser::SRand2);
     symbolTable.add_function("fmod", MooseParser::Fmod);
-    expression_.register_symbol_table(symbolTable);
-    SetExpr(expr_);
 }
 
 MooseParser::~MooseParser()
@@ -135,7 +175,10 @@ bool MooseParser::DefineVar( const string varName, double* const val)
     // Use in copy assignment.
     if( GetSymbolTable().is_variable(varName))
         GetSymbolTable().remove_variable(varName);
-    return GetSymbolTable().add_variable(varName, *val);
+    bool res = GetSymbolTable().add_variable(varName, *val);
+    if(shared_)
+        BindShared();
+    return res;
 }
 
 void MooseParser::DefineConst( const string& constName, const double value )
@@ -233,6 +276,11 @@ bool MooseParser::CompileExpr()
     // GCC specific
     ASSERT_FALSE(expr_.empty(), __func__ << ": Empty expression not allowed here");
 
+    if(CompileShared())
+        return true;
+    shared_.reset();
+    bind_.clear();
+
     Parser::parser_t  parser;
 
     // This option is very useful when setting expression which don't have
@@ -268,6 +316,23 @@ bool MooseParser::CompileExprWithUnknown(Function* func)
 {
     ASSERT_FALSE(expr_.empty(), __func__ << ": Empty expression not allowed here");
 
+    // The variables an expression uses depend only on the expression, so
+    // they are looked up once, and the compile goes through the cache.
+    vector<string> names;
+    if(num_user_defined_funcs_ == 0 && FindSymbols(expr_, names))
+    {
+        for(auto& name: names)
+        {
+            if(GetSymbolTable().symbol_exists(name))
+                continue;
+            if(func->getVarType(name) == XVAR_NAMED)
+                func->callbackAddSymbol(name);
+            else
+                GetSymbolTable().create_variable(name);
+        }
+        return CompileExpr();
+    }
+
     // User should make sure that symbol table has been setup. 
     Parser::parser_t  parser;
     parser.enable_unknown_symbol_resolver();
@@ -329,6 +394,175 @@ bool MooseParser::CompileExprWithUnknown(Function* func)
 }
 
 
+/* --------------------------------------------------------------------------*/
+/**
+ * @Synopsis  Use the cached compile of this expression and variables, or
+ * compile it into the cache. Expressions that assign to variables, and
+ * parsers with functions of their own, are not shared.
+ *
+ * @Returns True if the parser now uses a shared expression. False if the
+ * expression is not shareable or does not compile.
+ */
+/* ----------------------------------------------------------------------------*/
+bool MooseParser::CompileShared()
+{
+    if(num_user_defined_funcs_ > 0 || expr_.find(":=") != string::npos)
+        return false;
+
+    // Key on the expression, the variables and the constants by value,
+    // since exprtk folds constants into the compiled expression.
+    Parser::symbol_table_t& symbols = GetSymbolTable();
+    vector<string> all, vars;
+    symbols.get_variable_list(all);
+    vector<pair<string, double>> consts;
+    stringstream key;
+    key << expr_ << '\n' << std::hexfloat;
+    for(auto& name: all)
+    {
+        if(symbols.is_constant_node(name))
+        {
+            consts.push_back({name, symbols.get_variable(name)->value()});
+            key << name << '=' << consts.back().second << ';';
+        }
+        else
+        {
+            vars.push_back(name);
+            key << name << ';';
+        }
+    }
+
+    ExprCache& cache = exprCache();
+    lock_guard<std::mutex> lock(cache.mutex);
+    shared_ptr<Parser::SharedExpr>& e = cache.compiled[key.str()];
+    if(! e)
+    {
+        e = make_shared<Parser::SharedExpr>();
+        e->expr = expr_;
+        e->names = vars;
+        e->consts = consts;
+        e->copies[0] = CompileCopy(*e);
+        if(! e->copies[0])
+        {
+            cache.compiled.erase(key.str());
+            return false;
+        }
+    }
+    shared_ = e;
+
+    // Drop the entries no parser uses any more, now and then.
+    if(cache.compiled.size() >= cache.sweepAt)
+    {
+        for(auto it = cache.compiled.begin(); it != cache.compiled.end(); )
+            it = it->second.use_count() == 1 ? cache.compiled.erase(it) : ++it;
+        cache.sweepAt = 2 * cache.compiled.size() + 64;
+    }
+    BindShared();
+
+    // Free our own compiled copy, if any.
+    Parser::expression_t empty;
+    empty.register_symbol_table(symbols);
+    expression_ = empty;
+    return true;
+}
+
+Parser::CompiledExpr* MooseParser::CompileCopy(const Parser::SharedExpr& e)
+{
+    Parser::CompiledExpr* c = new Parser::CompiledExpr();
+    AddDefaultFunctions(c->symbols);
+    c->slots.assign(e.names.size(), 0.0);
+    for(unsigned int i = 0; i < e.names.size(); i++)
+        c->symbols.add_variable(e.names[i], c->slots[i]);
+    for(auto& k: e.consts)
+        c->symbols.add_constant(k.first, k.second);
+    c->expression.register_symbol_table(c->symbols);
+    Parser::parser_t parser;
+    if(! parser.compile(e.expr, c->expression))
+    {
+        delete c;
+        return nullptr;
+    }
+    return c;
+}
+
+Parser::CompiledExpr* MooseParser::Claim(Parser::SharedExpr& e)
+{
+    for(auto& c: e.copies)
+    {
+        Parser::CompiledExpr* p = c.exchange(nullptr, std::memory_order_acquire);
+        if(p)
+            return p;
+    }
+    // All copies are in use on other threads.
+    Parser::CompiledExpr* p = CompileCopy(e);
+    assert(p);
+    return p;
+}
+
+void MooseParser::Release(Parser::SharedExpr& e, Parser::CompiledExpr* p)
+{
+    for(auto& c: e.copies)
+    {
+        Parser::CompiledExpr* empty = nullptr;
+        if(c.compare_exchange_strong(empty, p, std::memory_order_release))
+            return;
+    }
+    delete p;
+}
+
+/* Evaluate a claimed copy of the shared expression on our own variables. */
+double MooseParser::EvalShared(Parser::CompiledExpr* c) const
+{
+    for(unsigned int i = 0; i < bind_.size(); i++)
+        if(bind_[i])
+            c->slots[i] = *bind_[i];
+    return c->expression.value();
+}
+
+/* Point each slot of the shared expression at our own variable. */
+void MooseParser::BindShared()
+{
+    bind_.assign(shared_->names.size(), nullptr);
+    for(unsigned int i = 0; i < bind_.size(); i++)
+    {
+        auto v = GetSymbolTable().get_variable(shared_->names[i]);
+        if(v)
+            bind_[i] = &v->ref();
+    }
+}
+
+bool MooseParser::FindSymbols(const string& expr, vector<string>& names)
+{
+    ExprCache& cache = exprCache();
+    lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.symbols.find(expr);
+    if(it != cache.symbols.end())
+    {
+        names = it->second;
+        return true;
+    }
+
+    Parser::symbol_table_t symbols;
+    AddDefaultFunctions(symbols);
+    Parser::expression_t e;
+    e.register_symbol_table(symbols);
+    Parser::parser_t parser;
+    parser.enable_unknown_symbol_resolver();
+    if(! parser.compile(expr, e))
+        return false;
+    symbols.get_variable_list(names);
+    if(cache.symbols.size() > 100000)
+        cache.symbols.clear();
+    cache.symbols[expr] = names;
+    return true;
+}
+
+size_t MooseParser::NumSharedExprs()
+{
+    ExprCache& cache = exprCache();
+    lock_guard<std::mutex> lock(cache.mutex);
+    return cache.compiled.size();
+}
+
 double MooseParser::Derivative(const string& name, unsigned int nth) const
 {
     if(nth > 3)
@@ -336,6 +570,20 @@ double MooseParser::Derivative(const string& name, unsigned int nth) const
         cout << "Error: " << nth << "th derivative is not supported." << endl;
         return 0.0;
     }
+    if(shared_)
+    {
+        Parser::CompiledExpr* c = Claim(*shared_);
+        EvalShared(c);
+        double d;
+        if(nth == 3)
+            d = exprtk::third_derivative(c->expression, name);
+        else if(nth == 2)
+            d = exprtk::second_derivative(c->expression, name);
+        else
+            d = exprtk::derivative(c->expression, name);
+        Release(*shared_, c);
+        return d;
+    }
     if(nth == 3)
         return exprtk::third_derivative(expression_, name);
     if(nth == 2)
@@ -360,10 +608,36 @@ double MooseParser::Eval(bool check) const
     // PrintSymbolTable();
     // Make sure that no symbol is unknown at this point. Else emit error. The
     // Function::reinit must take of it.
+    if(shared_)
+    {
+        Parser::CompiledExpr* c = Claim(*shared_);
+        double v = EvalShared(c);
+        Release(*shared_, c);
+        return v;
+    }
     return expression_.value();
 }
 
 
+void MooseParser::EvalBatch(MooseParser* const* parsers, size_t n, double* out)
+{
+    size_t i = 0;
+    while(i < n)
+    {
+        shared_ptr<Parser::SharedExpr> s = parsers[i]->shared_;
+        if(! s)
+        {
+            out[i] = parsers[i]->Eval();
+            i++;
+            continue;
+        }
+        Parser::CompiledExpr* c = Claim(*s);
+        for(; i < n && parsers[i]->shared_ == s; i++)
+            out[i] = parsers[i]->EvalShared(c);
+        Release(*s, c);
+    }
+}
+
 double MooseParser::Diff( const double a, const double b ) const
 {
     return a-b;
@@ -376,6 +650,14 @@ Parser::varmap_type MooseParser::GetConst( ) const
 
 void MooseParser::ClearVariables( )
 {
+    // Drop the compiled expression as well, shared or our own, since it
+    // reads the variables being cleared. It is compiled again when the
+    // expression is next set.
+    shared_.reset();
+    bind_.clear();
+    Parser::expression_t empty;
+    empty.register_symbol_table(GetSymbolTable());
+    expression_ = empty;
     GetSymbolTable().clear_variables();
 }
 
@@ -387,6 +669,8 @@ void MooseParser::ClearAll( )
 void MooseParser::Reset( )
 {
     expression_.release();
+    shared_.reset();
+    bind_.clear();
 }
 
 const string MooseParser::GetExpr( ) const
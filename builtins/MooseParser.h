@@ -15,6 +15,8 @@
 #include <memory>
 #include <exception>
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <iostream>
 
 #define exprtk_enabled_debugging 0
@@ -51,6 +53,38 @@ struct ParserException : public std::exception
 
 typedef ParserException exception_type;
 typedef map<string, double> varmap_type;
+
+/**
+ * One compiled copy of a shared expression, with the slots that its
+ * variables are bound to.
+ */
+struct CompiledExpr
+{
+    symbol_table_t symbols;
+    expression_t expression;
+    vector<double> slots;           // Not resized once compiled.
+};
+
+/**
+ * An expression shared by all parsers that have the same expression and
+ * the same variables and constants. It keeps a few compiled copies. A
+ * parser evaluates it by claiming a free copy, copying the values of its
+ * own variables into the copy's slots and evaluating it. So threads that
+ * evaluate the same expression at once each work on a copy of their own,
+ * and do not wait on each other. A copy is compiled when none is free.
+ */
+struct SharedExpr
+{
+    static const unsigned int MaxCopies = 16;
+
+    SharedExpr();
+    ~SharedExpr();
+
+    string expr;
+    vector<string> names;           // Variable of each slot.
+    vector<pair<string, double>> consts;
+    std::atomic<CompiledExpr*> copies[MaxCopies];   // Free copies.
+};
 } // namespace Parser
 
 class MooseParser
@@ -93,6 +127,10 @@ public:
 
     double Eval(bool check=false) const;
 
+    /* Evaluate n parsers into out. Runs of parsers that share a compiled
+     * expression are evaluated on one claimed copy of it. */
+    static void EvalBatch(moose::MooseParser* const* parsers, size_t n, double* out);
+
     double Derivative(const string& name, unsigned int nth=1) const;
 
     double Diff( const double a, const double b) const;
@@ -117,7 +155,24 @@ public:
     static double SRand2( double a, double b, double seed );
     static double Fmod( double a, double b );
 
+    /* Number of compiled expressions in the shared cache. */
+    static size_t NumSharedExprs( );
+
 private:
+    static void AddDefaultFunctions( Parser::symbol_table_t& symbols );
+
+    // Variables the expression uses, found once per expression string.
+    static bool FindSymbols( const string& expr, vector<string>& names );
+
+    bool CompileShared( );
+    void BindShared( );
+
+    // Compiled copies of a shared expression. Claim returns a free copy,
+    // or a new one, and Release gives it back.
+    static Parser::CompiledExpr* CompileCopy( const Parser::SharedExpr& e );
+    static Parser::CompiledExpr* Claim( Parser::SharedExpr& e );
+    static void Release( Parser::SharedExpr& e, Parser::CompiledExpr* c );
+    double EvalShared( Parser::CompiledExpr* c ) const;
 
     /* data */
     string expr_;
@@ -130,6 +185,11 @@ private:
 
     bool valid_{false};
 
+    // The compiled expression, if it came from the shared cache, and
+    // where this parser keeps the value of each of its slots.
+    shared_ptr<Parser::SharedExpr> shared_;
+    vector<double*> bind_;
+
 };
 
 } // namespace moose.
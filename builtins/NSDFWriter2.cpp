@@ -49,6 +49,7 @@
 #include <ctime>
 #include <cctype>
 #include <deque>
+#include <algorithm>
 #include "../basecode/header.h"
 #include "../utility/utility.h"
 #include "../utility/strutil.h"
@@ -124,6 +125,30 @@ const Cinfo * NSDFWriter2::initCinfo()
       &NSDFWriter2::setBlocks,
       &NSDFWriter2::getBlocks);
 
+    static ValueFinfo <NSDFWriter2, bool > asyncFlush(
+      "asyncFlush",
+      "If True (default), data is written to file on a thread of its own"
+      " when flushLimit steps have been collected, while the simulation"
+      " goes on collecting the next lot. If False, the simulation waits"
+      " for each write.",
+      &NSDFWriter2::setAsyncFlush,
+      &NSDFWriter2::getAsyncFlush);
+
+    static ValueFinfo <NSDFWriter2, unsigned int > chunkRows(
+      "chunkRows",
+      "Number of objects (rows) in each HDF5 chunk of a uniform dataset."
+      " 0 (default) picks it so that a chunk holds about 1 MiB.",
+      &NSDFWriter2::setChunkRows,
+      &NSDFWriter2::getChunkRows);
+
+    static ValueFinfo <NSDFWriter2, unsigned int > chunkSteps(
+      "chunkSteps",
+      "Number of time steps (columns) in each HDF5 chunk of a uniform"
+      " dataset. 0 (default) uses chunkSize, or flushLimit if that is"
+      " smaller.",
+      &NSDFWriter2::setChunkSteps,
+      &NSDFWriter2::getChunkSteps);
+
     static DestFinfo process(
         "process",
         "Handle process calls. Collects data in buffer and if number of steps"
@@ -136,6 +161,12 @@ const Cinfo * NSDFWriter2::initCinfo()
         " to close that and open the file specified in current filename field.",
         new ProcOpFunc<NSDFWriter2>( &NSDFWriter2::reinit ));
 
+    static DestFinfo finished(
+        "finished",
+        "Waits for the data being written on the writer's own thread."
+        " Shell::doStart calls this at the end of each run.",
+        new OpFunc0<NSDFWriter2>( &NSDFWriter2::finished ));
+
     static Finfo * processShared[] = {
         &process, &reinit
     };
@@ -150,6 +181,10 @@ const Cinfo * NSDFWriter2::initCinfo()
 		&modelRoot,	// ValueFinfo
 		&modelFileNames,	// ValueFinfo
 		&blocks,	// ValueFinfo
+		&asyncFlush,	// ValueFinfo
+		&chunkRows,	// ValueFinfo
+		&chunkSteps,	// ValueFinfo
+        &finished,	// DestFinfo
         &proc,
     };
 
@@ -173,7 +208,7 @@ const Cinfo * NSDFWriter2::initCinfo()
 
 static const Cinfo * nsdfWriterCinfo = NSDFWriter2::initCinfo();
 
-NSDFWriter2::NSDFWriter2(): eventGroup_(-1), uniformGroup_(-1), dataGroup_(-1), modelGroup_(-1), mapGroup_(-1), modelRoot_("/")
+NSDFWriter2::NSDFWriter2(): eventGroup_(-1), uniformGroup_(-1), dataGroup_(-1), modelGroup_(-1), mapGroup_(-1), modelRoot_("/"), asyncFlush_(true), chunkRows_(0), chunkSteps_(0)
 {
     ;
 }
@@ -188,20 +223,25 @@ void NSDFWriter2::close()
     if (filehandle_ < 0){
         return;
     }
+    // flush waits for the writing thread, which needs hdf5Mutex, so it
+    // must not be called with the lock held.
     flush();
-    closeUniformData();
-    if (uniformGroup_ >= 0){
-        H5Gclose(uniformGroup_);
-		uniformGroup_ = -1;
-    }
-    closeEventData();
-    if (eventGroup_ >= 0){
-        H5Gclose(eventGroup_);
-		eventGroup_ = -1;
-    }
-    if (dataGroup_ >= 0){
-        H5Gclose(dataGroup_);
-		dataGroup_ = -1;
+    {
+        std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+        closeUniformData();
+        if (uniformGroup_ >= 0){
+            H5Gclose(uniformGroup_);
+            uniformGroup_ = -1;
+        }
+        closeEventData();
+        if (eventGroup_ >= 0){
+            H5Gclose(eventGroup_);
+            eventGroup_ = -1;
+        }
+        if (dataGroup_ >= 0){
+            H5Gclose(dataGroup_);
+            dataGroup_ = -1;
+        }
     }
     HDF5DataWriter::close();
 	for ( auto bb = blocks_.begin(); bb != blocks_.end(); ++bb ) {
@@ -211,6 +251,7 @@ void NSDFWriter2::close()
 
 void NSDFWriter2::closeUniformData()
 {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
 	for ( vector< Block >::iterator ii = blocks_.begin(); ii != blocks_.end(); ++ii ) {
 		if ( ii->dataset >= 0 ) {
 			H5Dclose( ii->dataset );
@@ -220,10 +261,7 @@ void NSDFWriter2::closeUniformData()
 		ii->hasContainer = false;
 		ii->objVec.clear();
 		ii->objPathList.clear();
-		for ( auto jj = ii->data.begin(); jj != ii->data.end(); jj++ ) {
-			jj.clear();
-		}
-		ii->data.clear();
+		ii->stage.clear();
 		*/
 	}
     vars_.clear();
@@ -285,21 +323,29 @@ void NSDFWriter2::buildUniformSources(const Eref& eref)
 void NSDFWriter2::openUniformData(const Eref &eref)
 {
     buildUniformSources(eref);
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     htri_t exists;
     herr_t status;
     if (uniformGroup_ < 0){
         uniformGroup_ = require_group(filehandle_, UNIFORMPATH);
     }
+	unsigned int steps = chunkSteps_;
+	if ( steps == 0 )
+		steps = std::max( 1u, std::min( flushLimit_, chunkSize_ ) );
 	for ( auto bb = blocks_.begin(); bb != blocks_.end(); ++bb ) {
 		if ( bb->hasContainer )
 			continue;
+		unsigned int numObj = bb->objVec.size();
+		unsigned int rows = chunkRows_;
+		if ( rows == 0 ) // About 1 MiB of doubles per chunk
+			rows = std::max( 1u, std::min( numObj, (1u << 17) / steps ) );
 		// From the documentation: 
 		// https://support.hdfgroup.org/HDF5/doc1.6/UG/09_Groups.html
 		// "Component link names may be any string of ASCII characters not containing a slash or a dot (/ and ., which are reserved as noted above)."
 		// So I need to replace path with a string with the slashes
         bb->container = require_group(uniformGroup_, bb->nsdfContainerPath);
         bb->relPathContainer = require_group(bb->container,bb->nsdfRelPath);
-       	hid_t dataset = createDataset2D(bb->relPathContainer, bb->field.c_str(), bb->data.size());
+       	hid_t dataset = createDataset2D(bb->relPathContainer, bb->field.c_str(), numObj, rows, steps);
 		bb->dataset = dataset;
        	writeScalarAttr<string>(dataset, "field", bb->field);
        	H5Gclose(bb->container);
@@ -375,6 +421,7 @@ void NSDFWriter2::innerCreateMaps( const char* const mapSrcStr )
 
 void NSDFWriter2::closeEventData()
 {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     for (unsigned int ii = 0; ii < eventDatasets_.size(); ++ii){
         if (eventDatasets_[ii] >= 0){
             H5Dclose(eventDatasets_[ii]);
@@ -516,21 +563,87 @@ hid_t NSDFWriter2::getEventDataset(string srcPath, string srcField)
 
 void NSDFWriter2::flush()
 {
+    startFlush();
+    waitFlush();
+    // flush HDF5 nodes.
+    HDF5DataWriter::flush();
+}
+
+/**
+   Swap the staging buffers into job_, and write them out, on a thread
+   of its own if asyncFlush is set. Any earlier job is waited for first,
+   so at most one write is in progress.
+ */
+void NSDFWriter2::startFlush()
+{
+    waitFlush();
     // We need to update the tend on each write since we do not know
     // when the simulation is getting over and when it is just paused.
-    writeScalarAttr<string>(filehandle_, "tend", iso_time(NULL));
+    {
+        std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+        writeScalarAttr<string>(filehandle_, "tend", iso_time(NULL));
+    }
+
+    job_.steps = steps_;
+    job_.datasets.resize(blocks_.size());
+    job_.stages.resize(blocks_.size());
+    for (unsigned int ii = 0; ii < blocks_.size(); ++ii){
+        job_.datasets[ii] = blocks_[ii].dataset;
+        job_.stages[ii].clear();
+        job_.stages[ii].swap(blocks_[ii].stage);
+    }
+	steps_ = 0;
+
+    job_.eventDatasets = eventDatasets_;
+    job_.events.resize(events_.size());
+    for (unsigned int ii = 0; ii < events_.size(); ++ii){
+        job_.events[ii].clear();
+        job_.events[ii].swap(events_[ii]);
+    }
+
+    if (asyncFlush_){
+        pending_ = std::async(std::launch::async, &NSDFWriter2::writeJob, this);
+    } else {
+        writeJob();
+    }
+}
+
+void NSDFWriter2::waitFlush()
+{
+    if (pending_.valid()){
+        pending_.get();
+    }
+}
 
+void NSDFWriter2::finished()
+{
+    waitFlush();
+}
+
+/**
+   Write out job_. This may run on another thread, so it touches
+   nothing but job_ and the HDF5 library.
+ */
+void NSDFWriter2::writeJob()
+{
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+    const hsize_t steps = job_.steps;
     // append all uniform data
-	for ( vector< Block >::iterator bit = blocks_.begin(); (steps_ > 0) && (bit != blocks_.end()); bit++ ) {
-		assert( steps_ == bit->data[0].size() );
-        double* buffer = (double*)calloc(bit->data.size() * steps_, sizeof(double));
-        for (unsigned int ii = 0; ii < bit->data.size(); ++ii){
-            for (unsigned int jj = 0; jj < steps_; ++jj){
-                buffer[ii * steps_ + jj] = bit->data[ii][jj];
+	for ( unsigned int bi = 0; (steps > 0) && (bi < job_.stages.size()); ++bi ) {
+        const vector< double >& stage = job_.stages[bi];
+        const hsize_t numObj = stage.size() / steps;
+        assert( numObj * steps == stage.size() );
+        // The stage is by time step, the dataset is by object.
+        vector< double >& buffer = job_.buffer;
+        buffer.resize(stage.size());
+        for (hsize_t jj = 0; jj < steps; ++jj){
+            const double* row = &stage[jj * numObj];
+            for (hsize_t ii = 0; ii < numObj; ++ii){
+                buffer[ii * steps + jj] = row[ii];
             }
-            bit->data[ii].clear();
         }
-        hid_t filespace = H5Dget_space(bit->dataset);
+        hid_t dataset = job_.datasets[bi];
+        hid_t filespace = H5Dget_space(dataset);
         if (filespace < 0){
 			cout << "Error: NSDFWriter2::flush(): Failed to open filespace\n";
             break;
@@ -539,37 +652,31 @@ void NSDFWriter2::flush()
         hsize_t maxdims[2];
         // retrieve current datset dimensions
         herr_t status = H5Sget_simple_extent_dims(filespace, dims, maxdims);
-        hsize_t newdims[] = {dims[0], dims[1] + steps_}; // new column count
-        status = H5Dset_extent(bit->dataset, newdims); // extend dataset to new column count
+        hsize_t newdims[] = {dims[0], dims[1] + steps}; // new column count
+        status = H5Dset_extent(dataset, newdims); // extend dataset to new column count
 		if ( status < 0 ) {
 			cout << "Error: NSDFWriter2::flush(): Fail to extend dataset\n";
             break;
 		}
         H5Sclose(filespace);
-        filespace = H5Dget_space(bit->dataset); // get the updated filespace
+        filespace = H5Dget_space(dataset); // get the updated filespace
         hsize_t start[2] = {0, dims[1]};
-        dims[1] = steps_; // change dims for memspace & hyperslab
+        dims[1] = steps; // change dims for memspace & hyperslab
         hid_t memspace = H5Screate_simple(2, dims, NULL);
         H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, dims, NULL);
-        status = H5Dwrite(bit->dataset, H5T_NATIVE_DOUBLE,  memspace, filespace, H5P_DEFAULT, buffer);
+        status = H5Dwrite(dataset, H5T_NATIVE_DOUBLE,  memspace, filespace, H5P_DEFAULT, buffer.data());
 		if ( status < 0 ) {
 			cout << "Error: NSDFWriter2::flush(): Failed to write data\n";
             break;
 		}
         H5Sclose(memspace);
         H5Sclose(filespace);
-        free(buffer);
     }
-	steps_ = 0;
 
     // append all event data
-    for (unsigned int ii = 0; ii < eventSrc_.size(); ++ii){
-        appendToDataset(getEventDataset(eventSrc_[ii], eventSrcFields_[ii]),
-                        events_[ii]);
-        events_[ii].clear();
+    for (unsigned int ii = 0; ii < job_.eventDatasets.size() && ii < job_.events.size(); ++ii){
+        appendToDataset(job_.eventDatasets[ii], job_.events[ii]);
     }
-    // flush HDF5 nodes.
-    HDF5DataWriter::flush();
 }
 
 void NSDFWriter2::reinit(const Eref& eref, const ProcPtr proc)
@@ -586,6 +693,8 @@ void NSDFWriter2::reinit(const Eref& eref, const ProcPtr proc)
     if (filename_.empty()){
         filename_ = "moose_data.nsdf.h5";
     }
+    // Another writer may still be writing its last lot on its own thread.
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     openFile();
     writeScalarAttr<string>(filehandle_, "created", iso_time(0));
     writeScalarAttr<string>(filehandle_, "tstart", iso_time(0));
@@ -620,9 +729,10 @@ void NSDFWriter2::process(const Eref& eref, ProcPtr proc)
 	// data in block_->objVec order.
 	unsigned int ii = 0;
 	for (unsigned int blockIdx = 0; blockIdx < blocks_.size(); ++blockIdx) {
-		vector< vector< double > >&  bjd = blocks_[blockIdx].data;
-		for ( auto jj = bjd.begin(); jj != bjd.end(); ++jj ) {
-			jj->push_back( uniformData[ mapMsgIdx_[ii] ] );
+		vector< double >& stage = blocks_[blockIdx].stage;
+		unsigned int numObj = blocks_[blockIdx].objVec.size();
+		for ( unsigned int jj = 0; jj < numObj; ++jj ) {
+			stage.push_back( uniformData[ mapMsgIdx_[ii] ] );
 			ii++;
 		}
 	}
@@ -630,7 +740,7 @@ void NSDFWriter2::process(const Eref& eref, ProcPtr proc)
     if (steps_ < flushLimit_){
         return;
     }
-    NSDFWriter2::flush();
+    startFlush();
  }
 
 NSDFWriter2& NSDFWriter2::operator=( const NSDFWriter2& other)
@@ -691,6 +801,36 @@ string NSDFWriter2::getModelRoot() const
     return modelRoot_;
 }
 
+void NSDFWriter2::setAsyncFlush(bool value)
+{
+    asyncFlush_ = value;
+}
+
+bool NSDFWriter2::getAsyncFlush() const
+{
+    return asyncFlush_;
+}
+
+void NSDFWriter2::setChunkRows(unsigned int value)
+{
+    chunkRows_ = value;
+}
+
+unsigned int NSDFWriter2::getChunkRows() const
+{
+    return chunkRows_;
+}
+
+void NSDFWriter2::setChunkSteps(unsigned int value)
+{
+    chunkSteps_ = value;
+}
+
+unsigned int NSDFWriter2::getChunkSteps() const
+{
+    return chunkSteps_;
+}
+
 void NSDFWriter2::setModelFiles(string value)
 {
 	modelFileNames_.clear();	
@@ -778,9 +918,7 @@ bool parseBlockString( const string& val, Block& block )
 		}
 	}
 
-	block.data.resize( block.objVec.size() );
-	for( auto i = block.data.begin(); i != block.data.end(); i++ )
-		i->clear();
+	block.stage.clear();
 	return true;
 }
 
@@ -818,16 +956,17 @@ ObjId findParentElecCompt( ObjId obj )
 
 void NSDFWriter2::writeStaticCoords()
 {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     hid_t staticObjContainer = require_group(filehandle_, STATICPATH );
 	for( auto bit = blocks_.begin(); bit != blocks_.end(); bit++ ) {
 		string coordContainer = bit->nsdfContainerPath + "/" + bit->nsdfRelPath;
 		string fieldName = "coords"; // pathTokens[1] is not relevant.
         hid_t container = require_group(staticObjContainer, coordContainer);
         double * buffer = 
-			(double*)calloc(bit->data.size() * 7, sizeof(double));
+			(double*)calloc(bit->objVec.size() * 7, sizeof(double));
 		if ( bit->className.find( "Pool" ) != string::npos || 
 			 bit->className.find( "Compartment" ) != string::npos ) {
-        	for (unsigned int jj = 0; jj < bit->data.size(); ++jj) {
+        	for (unsigned int jj = 0; jj < bit->objVec.size(); ++jj) {
 				ObjId obj = bit->objVec[jj];
             	vector< double > coords = Field< vector< double > >::get( obj, fieldName );
 				if ( coords.size() == 11 ) { // For SpineMesh
@@ -860,7 +999,7 @@ void NSDFWriter2::writeStaticCoords()
 			}
 		}
         hsize_t dims[2];
-		dims[0] = bit->data.size();
+		dims[0] = bit->objVec.size();
 		dims[1] = 7;
         hid_t memspace = H5Screate_simple(2, dims, NULL);
         hid_t dataspace = H5Screate_simple(2, dims, NULL);
@@ -48,6 +48,7 @@
 #ifndef _NSDFWRITER2_H
 #define _NSDFWRITER2_H
 
+#include <future>
 #include "HDF5DataWriter.h"
 
 class InputVariable;
@@ -81,7 +82,7 @@ typedef struct {
 	string field;	// Regular MOOSE value field.
 	string getField; // name of call to get the field.
 	string className; // All obj in a block should be of same class.
-	vector< vector< double > > data; // data_[objIdx][timeStep]
+	vector< double > stage; // stage[timeStep * objVec.size() + objIdx]
 	vector< ObjId > objVec;
 	hid_t container;	// reference to container
 	hid_t relPathContainer;	// reference to objects on nsdfRelPath
@@ -111,6 +112,12 @@ class NSDFWriter2: public HDF5DataWriter
     NSDFWriter2();
     ~NSDFWriter2();
     virtual void flush();
+    void setAsyncFlush(bool value);
+    bool getAsyncFlush() const;
+    void setChunkRows(unsigned int value);
+    unsigned int getChunkRows() const;
+    void setChunkSteps(unsigned int value);
+    unsigned int getChunkSteps() const;
 	void setModelFiles(string value);
 	string getModelFiles() const;
     // set the environment specs like title, author, tstart etc.
@@ -139,11 +146,31 @@ class NSDFWriter2: public HDF5DataWriter
     // Sort the incoming data lines according to source object/field.
     void process(const Eref &e, ProcPtr p);
     void reinit(const Eref &e, ProcPtr p);
+    // Called by Shell::doStart when a run ends.
+    void finished();
     NSDFWriter2& operator=(const NSDFWriter2& other);
 
     static const Cinfo *initCinfo();
 
   protected:
+    /**
+       Data handed over to be written while process goes on filling
+       the staging buffers in the blocks. The buffers are swapped back
+       and forth, so neither side allocates once they have grown.
+     */
+    struct FlushJob {
+        vector< hid_t > datasets;
+        vector< vector< double > > stages;
+        unsigned long steps;
+        vector< hid_t > eventDatasets;
+        vector< vector< double > > events;
+        vector< double > buffer; // stage transposed to dataset layout
+    };
+    // Hand the buffered data to the writer, and return at once if async.
+    void startFlush();
+    // Wait for the data handed over to be written.
+    void waitFlush();
+    void writeJob();
     hid_t getEventDataset(string srcPath, string srcField);
     // void sortOutUniformSources(const Eref& eref);
 	void buildUniformSources(const Eref& eref);
@@ -205,6 +232,11 @@ class NSDFWriter2: public HDF5DataWriter
     map< string, vector < string > > classFieldToObjectField_;
     vector < string > vars_;
     string modelRoot_;
+    bool asyncFlush_;
+    unsigned int chunkRows_;
+    unsigned int chunkSteps_;
+    FlushJob job_;
+    std::future< void > pending_;
 
 };
 #endif // _NSDFWRITER2_H
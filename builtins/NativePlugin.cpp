@@ -0,0 +1,447 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "../basecode/header.h"
+#include "../utility/print_function.hpp"
+#include "Variable.h"
+#include "NativePlugin.h"
+
+namespace
+{
+
+#if defined(_WIN32)
+void* openLibrary( const string& path )
+{
+	return reinterpret_cast< void* >( LoadLibraryA( path.c_str() ) );
+}
+
+void* findSymbol( void* handle, const char* name )
+{
+	return reinterpret_cast< void* >(
+		GetProcAddress( reinterpret_cast< HMODULE >( handle ), name ) );
+}
+
+void closeLibrary( void* handle )
+{
+	FreeLibrary( reinterpret_cast< HMODULE >( handle ) );
+}
+
+string libraryError()
+{
+	return "error " + to_string( GetLastError() );
+}
+#else
+void* openLibrary( const string& path )
+{
+	return dlopen( path.c_str(), RTLD_NOW | RTLD_LOCAL );
+}
+
+void* findSymbol( void* handle, const char* name )
+{
+	return dlsym( handle, name );
+}
+
+void closeLibrary( void* handle )
+{
+	dlclose( handle );
+}
+
+string libraryError()
+{
+	const char* err = dlerror();
+	return err ? err : "unknown error";
+}
+#endif
+
+typedef const MoosePlugin* ( *PluginEntry )();
+
+vector< string > names( const char* const* n, unsigned int num )
+{
+	vector< string > ret;
+	for ( unsigned int i = 0; i < num; ++i )
+		ret.push_back( ( n && n[i] ) ? n[i] : "" );
+	return ret;
+}
+
+} // namespace
+
+static SrcFinfo1< double > *valueOut() {
+	static SrcFinfo1< double > valueOut(
+			"valueOut",
+			"Sends the first output of the plugin on each time step."
+			);
+	return &valueOut;
+}
+
+static SrcFinfo1< vector< double > > *outputsOut() {
+	static SrcFinfo1< vector< double > > outputsOut(
+			"outputsOut",
+			"Sends all the outputs of the plugin on each time step."
+			);
+	return &outputsOut;
+}
+
+const Cinfo* NativePlugin::initCinfo()
+{
+		//////////////////////////////////////////////////////////////
+		// Field Definitions
+		//////////////////////////////////////////////////////////////
+		static ValueFinfo< NativePlugin, string > library(
+			"library",
+			"Path of the shared library implementing the plugin. Setting "
+			"it loads the library and runs the plugin's init.",
+			&NativePlugin::setLibrary,
+			&NativePlugin::getLibrary
+		);
+		static ValueFinfo< NativePlugin, string > config(
+			"config",
+			"String handed to the plugin's init. Changing it once the "
+			"library is loaded runs init again.",
+			&NativePlugin::setConfig,
+			&NativePlugin::getConfig
+		);
+		static ReadOnlyValueFinfo< NativePlugin, string > pluginName(
+			"pluginName",
+			"Name the plugin gives itself.",
+			&NativePlugin::getPluginName
+		);
+		static ReadOnlyValueFinfo< NativePlugin, vector< string > >
+			inputNames(
+			"inputNames",
+			"Names of the inputs, as given by the plugin.",
+			&NativePlugin::getInputNames
+		);
+		static ReadOnlyValueFinfo< NativePlugin, vector< string > >
+			outputNames(
+			"outputNames",
+			"Names of the outputs, as given by the plugin.",
+			&NativePlugin::getOutputNames
+		);
+		static ReadOnlyValueFinfo< NativePlugin, unsigned int > numOutputs(
+			"numOutputs",
+			"Number of outputs of the plugin.",
+			&NativePlugin::getNumOutputs
+		);
+		static ReadOnlyValueFinfo< NativePlugin, double > value(
+			"value",
+			"First output of the plugin.",
+			&NativePlugin::getValue
+		);
+		static ReadOnlyValueFinfo< NativePlugin, vector< double > > outputs(
+			"outputs",
+			"All outputs of the plugin.",
+			&NativePlugin::getOutputs
+		);
+		static FieldElementFinfo< NativePlugin, Variable > x(
+			"x",
+			"Inputs to the plugin. These can be passed via messages to "
+			"x[i].input. Their number is set by the plugin.",
+			Variable::initCinfo(),
+			&NativePlugin::getX,
+			&NativePlugin::setNumInputs,
+			&NativePlugin::getNumInputs
+		);
+
+		//////////////////////////////////////////////////////////////
+		// MsgDest Definitions
+		//////////////////////////////////////////////////////////////
+		static DestFinfo process( "process",
+			"Handles process call. Runs the plugin on the current inputs "
+			"and sends out its outputs.",
+			new ProcOpFunc< NativePlugin >( &NativePlugin::process ) );
+		static DestFinfo reinit( "reinit",
+			"Handles reinit call. Runs the plugin's reinit.",
+			new ProcOpFunc< NativePlugin >( &NativePlugin::reinit ) );
+
+		//////////////////////////////////////////////////////////////
+		// SharedFinfo Definitions
+		//////////////////////////////////////////////////////////////
+		static Finfo* procShared[] = {
+			&process, &reinit
+		};
+		static SharedFinfo proc( "proc",
+			"Shared message for process and reinit",
+			procShared, sizeof( procShared ) / sizeof( const Finfo* )
+		);
+
+	static Finfo* nativePluginFinfos[] = {
+		&library,		// Value
+		&config,		// Value
+		&pluginName,	// ReadOnlyValue
+		&inputNames,	// ReadOnlyValue
+		&outputNames,	// ReadOnlyValue
+		&numOutputs,	// ReadOnlyValue
+		&value,			// ReadOnlyValue
+		&outputs,		// ReadOnlyValue
+		&x,				// FieldElement
+		valueOut(),		// SrcFinfo
+		outputsOut(),	// SrcFinfo
+		&proc			// SharedFinfo
+	};
+
+	static string doc[] = {
+		"Name", "NativePlugin",
+		"Description",
+		"Runs per-step logic from a compiled shared library, for "
+		"controllers and stimuli that would be too slow as PyRun scripts. "
+		"The library implements the C interface in moose_plugin.h: it "
+		"declares its numbers of inputs and outputs and supplies init, "
+		"reinit and process functions. Inputs are connected to x[i].input "
+		"as for a Function, and outputs are sent on valueOut (the first "
+		"one) and outputsOut (all of them). "
+		"See examples/plugins for a sample plugin and how to build it.",
+	};
+
+	static Dinfo< NativePlugin > dinfo;
+	static Cinfo nativePluginCinfo (
+		"NativePlugin",
+		Neutral::initCinfo(),
+		nativePluginFinfos,
+		sizeof( nativePluginFinfos ) / sizeof ( Finfo* ),
+		&dinfo,
+		doc,
+		sizeof( doc ) / sizeof( string )
+	);
+
+	return &nativePluginCinfo;
+}
+
+static const Cinfo* nativePluginCinfo = NativePlugin::initCinfo();
+
+///////////////////////////////////////////////////////////////////////////
+// Inner class funcs
+///////////////////////////////////////////////////////////////////////////
+
+NativePlugin::NativePlugin()
+	:
+	handle_( 0 ), plugin_( 0 ), state_( 0 ), started_( false )
+{;}
+
+NativePlugin::NativePlugin( const NativePlugin& other )
+	:
+	handle_( 0 ), plugin_( 0 ), state_( 0 ), started_( false )
+{
+	*this = other;
+}
+
+NativePlugin::~NativePlugin()
+{
+	close();
+}
+
+/// Copies open the library again and get a state of their own.
+NativePlugin& NativePlugin::operator=( const NativePlugin& other )
+{
+	if ( this == &other )
+		return *this;
+	close();
+	library_ = other.library_;
+	config_ = other.config_;
+	x_ = other.x_;
+	if ( !library_.empty() )
+		open();
+	return *this;
+}
+
+bool NativePlugin::open()
+{
+	handle_ = openLibrary( library_ );
+	if ( !handle_ ) {
+		MOOSE_WARN( "NativePlugin: cannot load '" << library_ << "': "
+				<< libraryError() );
+		return false;
+	}
+	PluginEntry entry = reinterpret_cast< PluginEntry >(
+			findSymbol( handle_, "moose_plugin" ) );
+	const MoosePlugin* plugin = entry ? entry() : 0;
+	if ( !plugin ) {
+		MOOSE_WARN( "NativePlugin: '" << library_ <<
+				"' does not export moose_plugin()" );
+		close();
+		return false;
+	}
+	if ( plugin->abiVersion != MOOSE_PLUGIN_ABI_VERSION ) {
+		MOOSE_WARN( "NativePlugin: '" << library_ << "' was built for "
+				"plugin interface version " << plugin->abiVersion <<
+				", not " << MOOSE_PLUGIN_ABI_VERSION );
+		close();
+		return false;
+	}
+	if ( !plugin->process ) {
+		MOOSE_WARN( "NativePlugin: '" << library_ << "' has no process" );
+		close();
+		return false;
+	}
+	plugin_ = plugin;
+	x_.resize( plugin_->numInputs );
+	inputs_.assign( plugin_->numInputs, 0.0 );
+	outputs_.assign( plugin_->numOutputs, 0.0 );
+	if ( !start() ) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void NativePlugin::close()
+{
+	stop();
+	if ( handle_ )
+		closeLibrary( handle_ );
+	handle_ = 0;
+	plugin_ = 0;
+}
+
+bool NativePlugin::start()
+{
+	state_ = 0;
+	if ( plugin_->init && plugin_->init( config_.c_str(), &state_ ) != 0 ) {
+		MOOSE_WARN( "NativePlugin: init of '" << getPluginName() <<
+				"' failed with config '" << config_ << "'" );
+		state_ = 0;
+		return false;
+	}
+	started_ = true;
+	return true;
+}
+
+void NativePlugin::stop()
+{
+	if ( started_ && plugin_->destroy )
+		plugin_->destroy( state_ );
+	state_ = 0;
+	started_ = false;
+}
+
+void NativePlugin::setLibrary( string path )
+{
+	close();
+	library_ = path;
+	if ( !library_.empty() && !open() )
+		library_.clear();
+}
+
+string NativePlugin::getLibrary() const
+{
+	return library_;
+}
+
+void NativePlugin::setConfig( string config )
+{
+	config_ = config;
+	if ( plugin_ ) {
+		stop();
+		if ( !start() )
+			close();
+	}
+}
+
+string NativePlugin::getConfig() const
+{
+	return config_;
+}
+
+string NativePlugin::getPluginName() const
+{
+	return ( plugin_ && plugin_->name ) ? plugin_->name : "";
+}
+
+vector< string > NativePlugin::getInputNames() const
+{
+	if ( !plugin_ )
+		return vector< string >();
+	return names( plugin_->inputNames, plugin_->numInputs );
+}
+
+vector< string > NativePlugin::getOutputNames() const
+{
+	if ( !plugin_ )
+		return vector< string >();
+	return names( plugin_->outputNames, plugin_->numOutputs );
+}
+
+unsigned int NativePlugin::getNumOutputs() const
+{
+	return outputs_.size();
+}
+
+Variable* NativePlugin::getX( unsigned int i )
+{
+	static Variable dummy( "DUMMY" );
+	if ( i < x_.size() )
+		return &x_[i];
+	MOOSE_WARN( "NativePlugin: input " << i << " out of bounds." );
+	return &dummy;
+}
+
+void NativePlugin::setNumInputs( unsigned int num )
+{
+	if ( plugin_ && num != plugin_->numInputs ) {
+		MOOSE_WARN( "NativePlugin: '" << getPluginName() << "' takes " <<
+				plugin_->numInputs << " inputs." );
+		return;
+	}
+	x_.resize( num );
+}
+
+unsigned int NativePlugin::getNumInputs() const
+{
+	return x_.size();
+}
+
+double NativePlugin::getValue() const
+{
+	return outputs_.empty() ? 0.0 : outputs_[0];
+}
+
+vector< double > NativePlugin::getOutputs() const
+{
+	return outputs_;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// Dest funcs
+///////////////////////////////////////////////////////////////////////////
+
+void NativePlugin::gatherInputs()
+{
+	for ( unsigned int i = 0; i < inputs_.size(); ++i )
+		inputs_[i] = x_[i].getValue();
+}
+
+void NativePlugin::process( const Eref& e, ProcPtr p )
+{
+	if ( !started_ )
+		return;
+	gatherInputs();
+	plugin_->process( state_, p->currTime, p->dt,
+			inputs_.data(), outputs_.data() );
+	if ( !outputs_.empty() )
+		valueOut()->send( e, outputs_[0] );
+	outputsOut()->send( e, outputs_ );
+}
+
+void NativePlugin::reinit( const Eref& e, ProcPtr p )
+{
+	if ( !started_ )
+		return;
+	outputs_.assign( outputs_.size(), 0.0 );
+	gatherInputs();
+	if ( plugin_->reinit )
+		plugin_->reinit( state_, p->dt, inputs_.data(), outputs_.data() );
+	if ( !outputs_.empty() )
+		valueOut()->send( e, outputs_[0] );
+	outputsOut()->send( e, outputs_ );
+}
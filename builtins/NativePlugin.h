@@ -0,0 +1,83 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+#ifndef _NATIVE_PLUGIN_H
+#define _NATIVE_PLUGIN_H
+
+#include "moose_plugin.h"
+
+class Variable;
+
+/**
+ * NativePlugin runs per-step logic from a compiled shared library, as a
+ * fast alternative to PyRun. The library implements the small C
+ * interface in moose_plugin.h. Inputs arrive on the x[i] Variables, as
+ * with Function, and outputs are sent on valueOut and outputsOut.
+ *
+ * Each object opens the library for itself, which only bumps the
+ * loader's reference count, and holds its own plugin state.
+ */
+class NativePlugin
+{
+	public:
+		NativePlugin();
+		NativePlugin( const NativePlugin& other );
+		~NativePlugin();
+		NativePlugin& operator=( const NativePlugin& other );
+
+		////////////////////////////////////////////////////////////////
+		// Field assignment stuff.
+		////////////////////////////////////////////////////////////////
+		void setLibrary( string path );
+		string getLibrary() const;
+		void setConfig( string config );
+		string getConfig() const;
+
+		string getPluginName() const;
+		vector< string > getInputNames() const;
+		vector< string > getOutputNames() const;
+		unsigned int getNumOutputs() const;
+
+		Variable* getX( unsigned int i );
+		void setNumInputs( unsigned int num );
+		unsigned int getNumInputs() const;
+
+		double getValue() const;
+		vector< double > getOutputs() const;
+
+		////////////////////////////////////////////////////////////////
+		// Dest Func
+		////////////////////////////////////////////////////////////////
+		void process( const Eref& e, ProcPtr p );
+		void reinit( const Eref& e, ProcPtr p );
+
+		////////////////////////////////////////////////////////////////
+		static const Cinfo* initCinfo();
+	private:
+		/// Opens library_ and starts the plugin. Leaves it closed on error.
+		bool open();
+		void close();
+		/// Runs the plugin's init on config_.
+		bool start();
+		void stop();
+		void gatherInputs();
+
+		string library_;
+		string config_;
+
+		void* handle_;
+		const MoosePlugin* plugin_;
+		void* state_;
+		bool started_;
+
+		vector< Variable > x_;
+		vector< double > inputs_;
+		vector< double > outputs_;
+};
+
+#endif // _NATIVE_PLUGIN_H
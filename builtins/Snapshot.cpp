@@ -0,0 +1,172 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2003-2020 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include "../basecode/header.h"
+#include "Snapshot.h"
+
+static SrcFinfo1< vector< double >* > *requestOut() {
+	static SrcFinfo1< vector< double >* > requestOut(
+			"requestOut",
+			"Sends request for a field to target object"
+			);
+	return &requestOut;
+}
+
+const Cinfo* Snapshot::initCinfo()
+{
+		//////////////////////////////////////////////////////////////
+		// Field Definitions
+		//////////////////////////////////////////////////////////////
+		static ReadOnlyValueFinfo< Snapshot, vector< double > > values(
+			"values",
+			"Latest sample of the requested fields, in the order of the "
+			"requestOut messages. Safe to read from another thread while "
+			"the simulation runs.",
+			&Snapshot::getValues
+		);
+		static ReadOnlyValueFinfo< Snapshot, double > time(
+			"time",
+			"Simulation time of the sample last returned by values.",
+			&Snapshot::getTime
+		);
+		static ReadOnlyValueFinfo< Snapshot, unsigned long > count(
+			"count",
+			"Number of samples taken since reinit.",
+			&Snapshot::getCount
+		);
+
+		//////////////////////////////////////////////////////////////
+		// MsgDest Definitions
+		//////////////////////////////////////////////////////////////
+		static DestFinfo process( "process",
+			"Handles process call. Samples the requested fields.",
+			new ProcOpFunc< Snapshot >( &Snapshot::process ) );
+		static DestFinfo reinit( "reinit",
+			"Handles reinit call. Clears the samples and takes one.",
+			new ProcOpFunc< Snapshot >( &Snapshot::reinit ) );
+
+		//////////////////////////////////////////////////////////////
+		// SharedFinfo Definitions
+		//////////////////////////////////////////////////////////////
+		static Finfo* procShared[] = {
+			&process, &reinit
+		};
+		static SharedFinfo proc( "proc",
+			"Shared message for process and reinit",
+			procShared, sizeof( procShared ) / sizeof( const Finfo* )
+		);
+
+	static Finfo* snapshotFinfos[] = {
+		&values,	// ReadOnlyValue
+		&time,		// ReadOnlyValue
+		&count,		// ReadOnlyValue
+		requestOut(),		// SrcFinfo
+		&proc		// SharedFinfo
+	};
+
+	static string doc[] = {
+		"Name", "Snapshot",
+		"Description",
+		"Samples the fields it requests on each time step and publishes "
+		"the latest sample without locks, so that another thread can "
+		"read it while the simulation is running. "
+		"Connect requestOut to get<Field> of the objects to watch, as for "
+		"a Table, and read values from a monitoring thread.",
+	};
+
+	static Dinfo< Snapshot > dinfo;
+	static Cinfo snapshotCinfo (
+		"Snapshot",
+		Neutral::initCinfo(),
+		snapshotFinfos,
+		sizeof( snapshotFinfos ) / sizeof ( Finfo* ),
+		&dinfo,
+		doc,
+		sizeof( doc ) / sizeof( string )
+	);
+
+	return &snapshotCinfo;
+}
+
+static const Cinfo* snapshotCinfo = Snapshot::initCinfo();
+
+///////////////////////////////////////////////////////////////////////////
+// Inner class funcs
+///////////////////////////////////////////////////////////////////////////
+
+Snapshot::Snapshot()
+	:
+	back_( 0 ), middle_( 1 ), front_( 2 ), count_( 0 )
+{
+	for ( unsigned int i = 0; i < 3; ++i )
+		times_[i] = 0.0;
+}
+
+/// Copies start out empty, as after reinit.
+Snapshot& Snapshot::operator=( const Snapshot& other )
+{
+	for ( unsigned int i = 0; i < 3; ++i ) {
+		slots_[i].clear();
+		times_[i] = 0.0;
+	}
+	back_ = 0;
+	middle_ = 1;
+	front_ = 2;
+	count_ = 0;
+	return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// Reader side
+///////////////////////////////////////////////////////////////////////////
+
+vector< double > Snapshot::getValues() const
+{
+	Snapshot* self = const_cast< Snapshot* >( this );
+	if ( self->middle_.load( std::memory_order_acquire ) & FRESH )
+		front_ = self->middle_.exchange( front_,
+				std::memory_order_acq_rel ) & ~FRESH;
+	return slots_[ front_ ];
+}
+
+double Snapshot::getTime() const
+{
+	return times_[ front_ ];
+}
+
+unsigned long Snapshot::getCount() const
+{
+	return count_.load( std::memory_order_relaxed );
+}
+
+///////////////////////////////////////////////////////////////////////////
+// Simulation side
+///////////////////////////////////////////////////////////////////////////
+
+void Snapshot::sample( const Eref& e, double t )
+{
+	vector< double >& slot = slots_[ back_ ];
+	slot.clear();
+	requestOut()->send( e, &slot );
+	times_[ back_ ] = t;
+	back_ = middle_.exchange( back_ | FRESH, std::memory_order_acq_rel )
+		& ~FRESH;
+	count_.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void Snapshot::process( const Eref& e, ProcPtr p )
+{
+	sample( e, p->currTime );
+}
+
+void Snapshot::reinit( const Eref& e, ProcPtr p )
+{
+	operator=( *this );
+	sample( e, p->currTime );
+}
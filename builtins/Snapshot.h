@@ -0,0 +1,68 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2003-2020 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+#include <atomic>
+
+/**
+ * Snapshot samples the fields it is connected to through requestOut on
+ * each process call, and publishes them so that another thread can read
+ * the latest sample while the simulation is running, for example a Python
+ * thread doing live plots while moose.start runs on another.
+ *
+ * Samples are passed through a triple buffer: the simulation fills one
+ * slot, the reader holds another, and the third is the latest complete
+ * sample. Each side swaps its slot with that one by a single atomic
+ * exchange, so neither ever waits for the other. There may be only one
+ * reader at a time; from Python, the GIL sees to that.
+ */
+class Snapshot
+{
+	public:
+		Snapshot();
+		Snapshot& operator=( const Snapshot& other );
+
+		////////////////////////////////////////////////////////////////
+		// Field assignment stuff.
+		////////////////////////////////////////////////////////////////
+
+		/// Latest published sample. Moves the reader to it.
+		vector< double > getValues() const;
+		/// Time of the sample last returned by getValues.
+		double getTime() const;
+		/// Number of samples published since reinit.
+		unsigned long getCount() const;
+
+		////////////////////////////////////////////////////////////////
+		// Dest Func
+		////////////////////////////////////////////////////////////////
+		void process( const Eref& e, ProcPtr p );
+		void reinit( const Eref& e, ProcPtr p );
+
+		////////////////////////////////////////////////////////////////
+		static const Cinfo* initCinfo();
+	private:
+		void sample( const Eref& e, double t );
+
+		static const unsigned int FRESH = 4;
+
+		vector< double > slots_[3];
+		double times_[3];
+		/// Slot being filled, owned by the simulation.
+		unsigned int back_;
+		/// Latest complete slot, with FRESH set if the reader has not
+		/// taken it yet.
+		std::atomic< unsigned int > middle_;
+		/// Slot being read, owned by the reader.
+		mutable unsigned int front_;
+		std::atomic< unsigned long > count_;
+};
+
+#endif // _SNAPSHOT_H
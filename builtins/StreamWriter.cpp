@@ -0,0 +1,169 @@
+/***
+ *    Description:  Background writer thread for Streamer and Table.
+ */
+
+#include <chrono>
+
+#include "../basecode/global.h"
+#include "../basecode/header.h"
+#include "StreamWriter.h"
+
+using namespace std::chrono;
+
+static double secondsSince( const steady_clock::time_point& t0 )
+{
+    return duration<double>( steady_clock::now() - t0 ).count();
+}
+
+StreamWriter::StreamWriter() :
+    numBuffers_( 2 ),
+    inFlight_( 0 ),
+    stop_( false ),
+    stallTime_( 0.0 ),
+    writeTime_( 0.0 ),
+    numValues_( 0.0 )
+{
+}
+
+StreamWriter::~StreamWriter()
+{
+    flush();
+    {
+        lock_guard<mutex> lock( mutex_ );
+        stop_ = true;
+    }
+    hasWork_.notify_all();
+    if( thread_.joinable() )
+        thread_.join();
+}
+
+/**
+ * @brief The writer thread. Takes jobs off the queue in order, and writes
+ * them without holding the lock.
+ */
+void StreamWriter::run( )
+{
+    unique_lock<mutex> lock( mutex_ );
+    while( true )
+    {
+        hasWork_.wait( lock, [this]{ return stop_ || ! queue_.empty(); } );
+        if( queue_.empty() )
+            break;
+        Job job = std::move( queue_.front() );
+        queue_.pop_front();
+        lock.unlock();
+
+        auto t0 = steady_clock::now();
+        StreamerBase::writeToOutFile( job.filepath, job.format, job.openmode
+                , job.data, job.columns );
+        double dt = secondsSince( t0 );
+
+        lock.lock();
+        writeTime_ += dt;
+        numValues_ += job.data.size();
+        inFlight_ -= 1;
+        hasRoom_.notify_all();
+    }
+}
+
+void StreamWriter::write( const string& filepath, const string& format
+        , const OpenMode openmode
+        , vector<double>& data
+        , const vector<string>& columns
+        )
+{
+    if( data.size() == 0 )
+        return;
+
+    if( numBuffers_ <= 1 )
+    {
+        // Anything queued before the switch must go first.
+        flush();
+        auto t0 = steady_clock::now();
+        StreamerBase::writeToOutFile( filepath, format, openmode, data, columns );
+        double dt = secondsSince( t0 );
+        lock_guard<mutex> lock( mutex_ );
+        stallTime_ += dt;
+        writeTime_ += dt;
+        numValues_ += data.size();
+        data.clear();
+        return;
+    }
+
+    unique_lock<mutex> lock( mutex_ );
+    if( ! thread_.joinable() )
+        thread_ = thread( &StreamWriter::run, this );
+
+    // One buffer is always with the caller, the rest may be in flight.
+    if( inFlight_ + 1 >= numBuffers_ )
+    {
+        auto t0 = steady_clock::now();
+        hasRoom_.wait( lock, [this]{ return inFlight_ + 1 < numBuffers_; } );
+        stallTime_ += secondsSince( t0 );
+    }
+
+    queue_.push_back( Job{ filepath, format, openmode, vector<double>(), columns } );
+    queue_.back().data.swap( data );
+    inFlight_ += 1;
+    hasWork_.notify_one();
+}
+
+void StreamWriter::flush( )
+{
+    unique_lock<mutex> lock( mutex_ );
+    if( inFlight_ == 0 )
+        return;
+    auto t0 = steady_clock::now();
+    hasRoom_.wait( lock, [this]{ return inFlight_ == 0; } );
+    stallTime_ += secondsSince( t0 );
+}
+
+void StreamWriter::setNumBuffers( unsigned int num )
+{
+    {
+        lock_guard<mutex> lock( mutex_ );
+        numBuffers_ = num > 0 ? num : 1;
+    }
+    hasRoom_.notify_all();
+}
+
+unsigned int StreamWriter::getNumBuffers( ) const
+{
+    return numBuffers_;
+}
+
+double StreamWriter::getStallTime( ) const
+{
+    lock_guard<mutex> lock( mutex_ );
+    return stallTime_;
+}
+
+double StreamWriter::getWriteTime( ) const
+{
+    lock_guard<mutex> lock( mutex_ );
+    return writeTime_;
+}
+
+double StreamWriter::getNumValues( ) const
+{
+    lock_guard<mutex> lock( mutex_ );
+    return numValues_;
+}
+
+void StreamWriter::resetStats( )
+{
+    lock_guard<mutex> lock( mutex_ );
+    stallTime_ = 0.0;
+    writeTime_ = 0.0;
+    numValues_ = 0.0;
+}
+
+/**
+ * @brief Never deleted, so that Tables destroyed late in the exit can
+ * still use it. Shell::doStart flushes it at the end of each run.
+ */
+StreamWriter& StreamWriter::shared( )
+{
+    static StreamWriter* writer = new StreamWriter();
+    return *writer;
+}
@@ -0,0 +1,102 @@
+/***
+ *       Filename:  StreamWriter.h
+ *
+ *    Description:  Background writer thread for Streamer and Table.
+ *
+ *        License:  GNU GPL2
+ */
+
+#ifndef  StreamWriter_INC
+#define  StreamWriter_INC
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "StreamerBase.h"
+
+using namespace std;
+
+/**
+ * @brief Writes buffers of table data to file on a thread of its own, so
+ * that the simulation does not wait for the disk.
+ *
+ * The caller hands over a filled buffer and carries on filling the next
+ * one. With numBuffers = 2 this is double buffering: one buffer is with
+ * the writer while the caller fills the other, and the caller waits only
+ * if it fills its buffer before the writer is done with the last one.
+ * More buffers absorb longer stalls of the disk. With numBuffers = 1 the
+ * data is written at once on the calling thread, as before.
+ *
+ * Buffers are written in the order they are handed over, so a file
+ * opened in WRITE mode is always written before the APPENDs to it.
+ */
+class StreamWriter
+{
+public:
+    StreamWriter();
+    ~StreamWriter();
+
+    /**
+     * @brief Queue data for writing with StreamerBase::writeToOutFile.
+     * The contents of data are taken over, and it is left empty.
+     */
+    void write( const string& filepath, const string& format
+            , const OpenMode openmode
+            , vector<double>& data
+            , const vector<string>& columns
+            );
+
+    /* Wait till everything handed over so far is on disk. */
+    void flush( );
+
+    void setNumBuffers( unsigned int num );
+    unsigned int getNumBuffers( ) const;
+
+    /* Seconds the caller spent waiting for the writer. */
+    double getStallTime( ) const;
+
+    /* Seconds the writer spent writing. */
+    double getWriteTime( ) const;
+
+    /* Number of values written. */
+    double getNumValues( ) const;
+
+    void resetStats( );
+
+    /* Writer shared by all Tables that stream to file. */
+    static StreamWriter& shared( );
+
+private:
+    struct Job
+    {
+        string filepath;
+        string format;
+        OpenMode openmode;
+        vector<double> data;
+        vector<string> columns;
+    };
+
+    void run( );
+
+    unsigned int numBuffers_;
+
+    deque<Job> queue_;
+    /* Jobs queued or being written */
+    unsigned int inFlight_;
+    bool stop_;
+
+    mutable mutex mutex_;
+    condition_variable hasWork_;
+    condition_variable hasRoom_;
+    thread thread_;
+
+    double stallTime_;
+    double writeTime_;
+    double numValues_;
+};
+
+#endif   /* ----- #ifndef StreamWriter_INC  ----- */
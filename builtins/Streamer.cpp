@@ -39,7 +39,8 @@ const Cinfo* Streamer::initCinfo()
 
     static ValueFinfo< Streamer, string > format(
         "format"
-        , "Format of output file, default is csv"
+        , "Format of output file: csv, npy or mcf (chunked and compressed "
+        " columns, see moose.streamer_utils.MCFReader). Default is csv"
         , &Streamer::setFormat
         , &Streamer::getFormat
     );
@@ -56,6 +57,35 @@ const Cinfo* Streamer::initCinfo()
         , &Streamer::getNumWriteEvents
     );
 
+    static ValueFinfo<Streamer, unsigned int> numBuffers(
+        "numBuffers"
+        , "Number of data buffers. Filled buffers are written to file on a "
+        " separate thread while the simulation fills the next one, and the "
+        " simulation waits only when all buffers are full. Default is 2 (double "
+        " buffering). Set to 1 to write on the simulation thread."
+        , &Streamer::setNumBuffers
+        , &Streamer::getNumBuffers
+    );
+
+    static ReadOnlyValueFinfo<Streamer, double> stallTime(
+        "stallTime"
+        , "Time (seconds, wallclock) the simulation spent waiting for data to be "
+        " written since reinit."
+        , &Streamer::getStallTime
+    );
+
+    static ReadOnlyValueFinfo<Streamer, double> writeTime(
+        "writeTime"
+        , "Time (seconds, wallclock) spent writing data to file since reinit."
+        , &Streamer::getWriteTime
+    );
+
+    static ReadOnlyValueFinfo<Streamer, double> throughput(
+        "throughput"
+        , "Number of values written to file per second of writeTime."
+        , &Streamer::getThroughput
+    );
+
     /*-----------------------------------------------------------------------------
      *
      *-----------------------------------------------------------------------------*/
@@ -96,6 +126,12 @@ const Cinfo* Streamer::initCinfo()
         , new OpFunc1<Streamer, vector<ObjId> >( &Streamer::removeTables )
     );
 
+    static DestFinfo flush(
+        "flush"
+        , "Wait till all data collected so far has been written to file."
+        , new OpFunc0<Streamer>( &Streamer::flush )
+    );
+
     /*-----------------------------------------------------------------------------
      *  ShareMsg definitions.
      *-----------------------------------------------------------------------------*/
@@ -113,6 +149,7 @@ const Cinfo* Streamer::initCinfo()
     static Finfo * tableStreamFinfos[] =
     {
         &datafile, &outfile, &format, &proc, &numTables, &numWriteEvents
+        , &numBuffers, &stallTime, &writeTime, &throughput, &flush
     };
 
     static string doc[] =
@@ -244,8 +281,9 @@ void Streamer::reinit(const Eref& e, ProcPtr p)
     // write now.
     currTime_ = 0.0;
     zipWithTime( );
-    StreamerBase::writeToOutFile(datafilePath_, format_, WRITE, data_, columns_);
-    data_.clear( );
+    writer_.flush( );
+    writer_.resetStats( );
+    writer_.write( datafilePath_, format_, WRITE, data_, columns_ );
 }
 
 /**
@@ -255,8 +293,8 @@ void Streamer::reinit(const Eref& e, ProcPtr p)
 void Streamer::cleanUp( )
 {
     zipWithTime( );
-    StreamerBase::writeToOutFile( datafilePath_, format_, APPEND, data_, columns_ );
-    data_.clear( );
+    writer_.write( datafilePath_, format_, APPEND, data_, columns_ );
+    writer_.flush( );
 }
 
 /**
@@ -269,8 +307,7 @@ void Streamer::process(const Eref& e, ProcPtr p)
 {
     // LOG( moose::debug, "Writing Streamer data to file." );
     zipWithTime( );
-    StreamerBase::writeToOutFile( datafilePath_, format_, APPEND, data_, columns_ );
-    data_.clear();
+    writer_.write( datafilePath_, format_, APPEND, data_, columns_ );
     numWriteEvents_ += 1;
 }
 
@@ -373,6 +410,39 @@ unsigned int Streamer::getNumWriteEvents( void ) const
 }
 
 
+void Streamer::setNumBuffers( unsigned int num )
+{
+    writer_.setNumBuffers( num );
+}
+
+unsigned int Streamer::getNumBuffers( void ) const
+{
+    return writer_.getNumBuffers( );
+}
+
+double Streamer::getStallTime( void ) const
+{
+    return writer_.getStallTime( );
+}
+
+double Streamer::getWriteTime( void ) const
+{
+    return writer_.getWriteTime( );
+}
+
+double Streamer::getThroughput( void ) const
+{
+    double t = writer_.getWriteTime( );
+    if( t <= 0.0 )
+        return 0.0;
+    return writer_.getNumValues( ) / t;
+}
+
+void Streamer::flush( void )
+{
+    writer_.flush( );
+}
+
 string Streamer::getDatafilePath( void ) const
 {
     return datafilePath_;
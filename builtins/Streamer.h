@@ -26,6 +26,7 @@
 #include <sstream>
 
 #include "StreamerBase.h"
+#include "StreamWriter.h"
 #include "Table.h"
 
 using namespace std;
@@ -51,6 +52,15 @@ public:
     unsigned int getNumTables( void ) const;
     unsigned int getNumWriteEvents( void ) const;
 
+    void setNumBuffers( unsigned int num );
+    unsigned int getNumBuffers( void ) const;
+    double getStallTime( void ) const;
+    double getWriteTime( void ) const;
+    double getThroughput( void ) const;
+
+    /* Wait till all data handed to the writer thread is on disk */
+    void flush( void );
+
     void addTable( ObjId table );
     void addTables( vector<ObjId> tables);
 
@@ -96,6 +106,9 @@ private:
     /*  Keep data in vector */
     vector<double> data_;
 
+    /* Writes data_ to file on a thread of its own */
+    StreamWriter writer_;
+
 };
 
 #endif   /* ----- #ifndef Streamer_INC  ----- */
@@ -21,10 +21,12 @@
 
 #include "../scheduling/Clock.h"
 #include "../utility/cnpy.hpp"
+#include "../utility/mcf.hpp"
 
 #include <algorithm>
 #include <sstream>
 #include <memory>
+#include <mutex>
 
 extern void cnpy2::appendNumpy(const string& outfile, const vector<double>& vec, const vector<string>& colnames);
 extern void cnpy2::writeNumpy(const string& outfile, const vector<double>& vec, const vector<string>& colnames);
@@ -72,6 +74,11 @@ void StreamerBase::writeToOutFile( const string& filepath
         OpenMode m = (openmode == WRITE)?WRITE_BIN:APPEND_BIN;
         writeToNPYFile( filepath, m, data, columns );
     }
+    else if( "mcf" == outputFormat )
+    {
+        OpenMode m = (openmode == WRITE)?WRITE_BIN:APPEND_BIN;
+        writeToMCFFile( filepath, m, data, columns );
+    }
     else if( "csv" == outputFormat || "dat" == outputFormat )
     {
         OpenMode m = (openmode == WRITE)?WRITE_STR:APPEND_STR;
@@ -125,6 +132,27 @@ void StreamerBase::writeToCSVFile( const string& filepath, const OpenMode openmo
     fclose(fp);
 }
 
+/* --------------------------------------------------------------------------*/
+/**
+ * @Synopsis  Numpy files open for appending through a memory map, by path.
+ * Never deleted, since Tables may still write to them late in the exit.
+ */
+/* ----------------------------------------------------------------------------*/
+static std::mutex openFilesMutex_;
+
+static map<string, unique_ptr<cnpy2::MappedNumpy> >& mappedNPYFiles( )
+{
+    static auto* files = new map<string, unique_ptr<cnpy2::MappedNumpy> >();
+    return *files;
+}
+
+/* Same for mcf files, which are given their index when closed. */
+static map<string, unique_ptr<mcf::Writer> >& openMCFFiles( )
+{
+    static auto* files = new map<string, unique_ptr<mcf::Writer> >();
+    return *files;
+}
+
 /*  write data to a numpy file */
 void StreamerBase::writeToNPYFile( const string& filepath, const OpenMode openmode
         , const vector<double>& data, const vector<string>& columns )
@@ -132,11 +160,72 @@ void StreamerBase::writeToNPYFile( const string& filepath, const OpenMode openmo
     //for(auto v: data) cout << v << ' ';
     //cout << endl;
 
-    if(openmode == APPEND_BIN)
-        return cnpy2::appendNumpy( filepath, data, columns);
+    std::lock_guard<std::mutex> lock( openFilesMutex_ );
+    auto& files = mappedNPYFiles( );
+    auto it = files.find( filepath );
 
     if(openmode == WRITE_BIN)
-        return cnpy2::writeNumpy( filepath, data, columns);
+    {
+        if( it != files.end() )
+            files.erase( it );
+        unique_ptr<cnpy2::MappedNumpy> f( new cnpy2::MappedNumpy() );
+        if( ! f->create( filepath, columns ) )
+            return cnpy2::writeNumpy( filepath, data, columns);
+        f->append( data.data(), data.size() );
+        files[filepath] = std::move( f );
+        return;
+    }
+
+    if(openmode == APPEND_BIN)
+    {
+        if( it == files.end() )
+        {
+            // A file left by an earlier run, or closed by closeOutFiles. Only
+            // the ones made by MappedNumpy can be mapped again.
+            unique_ptr<cnpy2::MappedNumpy> f( new cnpy2::MappedNumpy() );
+            if( ! f->open( filepath, columns.size() ) )
+                return cnpy2::appendNumpy( filepath, data, columns);
+            it = files.emplace( filepath, std::move( f ) ).first;
+        }
+        if( ! it->second->append( data.data(), data.size() ) )
+        {
+            files.erase( it );
+            return cnpy2::appendNumpy( filepath, data, columns);
+        }
+    }
+}
+
+/*  write data to a chunked columnar file */
+void StreamerBase::writeToMCFFile( const string& filepath, const OpenMode openmode
+        , const vector<double>& data, const vector<string>& columns )
+{
+    std::lock_guard<std::mutex> lock( openFilesMutex_ );
+    auto& files = openMCFFiles( );
+    auto it = files.find( filepath );
+
+    if( openmode == WRITE_BIN || it == files.end() )
+    {
+        if( it != files.end() )
+            files.erase( it );
+        unique_ptr<mcf::Writer> f( new mcf::Writer() );
+        bool ok = (openmode == WRITE_BIN)
+            ? f->create( filepath, columns )
+            : f->open( filepath, columns.size() );
+        if( ! ok )
+        {
+            LOG( moose::warning, "Failed to open " << filepath );
+            return;
+        }
+        it = files.emplace( filepath, std::move( f ) ).first;
+    }
+    it->second->append( data.data(), data.size() );
+}
+
+void StreamerBase::closeOutFiles( )
+{
+    std::lock_guard<std::mutex> lock( openFilesMutex_ );
+    mappedNPYFiles( ).clear();
+    openMCFFiles( ).clear();
 }
 
 string StreamerBase::vectorToCSV( const vector<double>& ys, const string& fmt )
@@ -54,6 +54,9 @@ public:
      * @param format
      *
      *  npy : numpy binary format (version 1 and 2), version 1 is default.
+     *  On POSIX systems the npy file is written through a memory map (see
+     *  cnpy2::MappedNumpy), and stays open until closeOutFiles is called.
+     *  mcf: chunked, compressed columns with an index (see utility/mcf.hpp).
      *  csv or dat: comma separated value (delimiter ' ' )
      *
      * @param  openmode (write or append)
@@ -87,6 +90,23 @@ public:
             , const vector<string>& columns
             );
 
+    /**
+     * @brief  Write to the chunked columnar format of utility/mcf.hpp. The
+     * file stays open until closeOutFiles is called, so that rows collect
+     * into whole chunks.
+     */
+    static void writeToMCFFile( const string& filepath, const OpenMode openmode
+            , const vector<double>& data
+            , const vector<string>& columns
+            );
+
+    /**
+     * @brief Close the npy files that are being appended to through a
+     * memory map, trimming them to the size of their data, and the mcf
+     * files, writing their index. They are opened again if more is
+     * appended.
+     */
+    static void closeOutFiles( );
 
     /* --------------------------------------------------------------------------*/
     /**
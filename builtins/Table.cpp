@@ -16,6 +16,12 @@
 #include "Table.h"
 #include "../scheduling/Clock.h"
 #include "StreamerBase.h"
+#include "StreamWriter.h"
+#include "../utility/cnpy.hpp"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 static SrcFinfo1< vector< double >* > *requestOut()
 {
@@ -97,10 +103,73 @@ const Cinfo* Table::initCinfo()
         , &Table::getColumnName
     );
 
+    static ValueFinfo< Table, string > decimation(
+        "decimation"
+        , "Reduce the data as it is recorded. Samples are grouped into bins of"
+        " binWidth seconds, and each bin is stored as: "
+        " 'nth', its first sample; 'mean', the mean time and value; 'minmax',"
+        " its smallest and largest samples in order of time; 'lttb', the sample"
+        " that makes the largest triangle with the previous point and the mean"
+        " of the next bin (largest triangle three buckets), which keeps peaks."
+        " Default is 'none'. Not used in spike mode."
+        , &Table::setDecimation
+        , &Table::getDecimation
+    );
+
+    static ValueFinfo< Table, double > binWidth(
+        "binWidth"
+        , "Width (seconds) of the bins used for decimation. Independent of the"
+        " dt of the table. Bins are aligned to multiples of binWidth. Default 0,"
+        " which keeps every sample."
+        , &Table::setBinWidth
+        , &Table::getBinWidth
+    );
+
+    static ReadOnlyValueFinfo< Table, vector< double > > times(
+        "times"
+        , "Times of the entries in vector. With decimation the points are not"
+        " evenly spaced, so use these to plot them."
+        , &Table::getTimes
+    );
+
+    static ValueFinfo< Table, unsigned int > ringSize(
+        "ringSize"
+        , "Number of entries kept in memory. Once there are this many, they"
+        " are moved, with their times, to a memory-mapped scratch file (see"
+        " spillFile) and memory is cleared, so memory use stays bounded on long"
+        " runs. vector, y and size still see all the entries. Default 0 keeps"
+        " everything in memory. Not used when streaming to datafile."
+        , &Table::setRingSize
+        , &Table::getRingSize
+    );
+
+    static ValueFinfo< Table, string > spillFile(
+        "spillFile"
+        , "File to which entries are spilled when ringSize is set. It is a npy"
+        " file with columns time and value, and is kept after the run. By"
+        " default a scratch file in $TMPDIR is used, and removed with the table."
+        , &Table::setSpillFile
+        , &Table::getSpillFile
+    );
+
+    static ReadOnlyValueFinfo< Table, unsigned int > numSpilled(
+        "numSpilled"
+        , "Number of entries that have been spilled to disk."
+        , &Table::getNumSpilled
+    );
+
     //////////////////////////////////////////////////////////////
     // MsgDest Definitions
     //////////////////////////////////////////////////////////////
 
+    static DestFinfo flushBins(
+        "flushBins",
+        "Add the bins that are still open to the table. With decimation, the"
+        " last bin (and for lttb the one before it) is stored only once it is"
+        " complete; call this at the end of a run to see it.",
+        new OpFunc0< Table >( &Table::flushBins )
+    );
+
     static DestFinfo spike(
         "spike",
         "Fills spike timings into the Table. Signal has to exceed thresh",
@@ -147,7 +216,14 @@ const Cinfo* Table::initCinfo()
         &outfile,               // Value
         &useStreamer,           // Value
         &useSpikeMode,          // Value
+        &decimation,            // Value
+        &binWidth,              // Value
+        &times,                 // ReadOnlyValue
+        &ringSize,              // Value
+        &spillFile,             // Value
+        &numSpilled,            // ReadOnlyValue
         handleInput(),		// DestFinfo
+        &flushBins,             // DestFinfo
         &spike,			// DestFinfo
         requestOut(),		// SrcFinfo
         &proc,			// SharedFinfo
@@ -226,7 +302,19 @@ Table::Table() :
     lastN_(0),
     useFileStreamer_(false),
     datafile_(""),
-    format_("csv")
+    format_("csv"),
+    decimation_( NO_DECIMATION ),
+    binWidth_( 0.0 ),
+    binEnd_( 0.0 ),
+    binCount_( 0 ),
+    binSum_( 0.0 ),
+    binTimeSum_( 0.0 ),
+    firstT_( 0.0 ), firstV_( 0.0 ),
+    minT_( 0.0 ), minV_( 0.0 ),
+    maxT_( 0.0 ), maxV_( 0.0 ),
+    lastT_( 0.0 ), lastV_( 0.0 ),
+    hasLast_( false ),
+    ringSize_( 0 )
 {
 }
 
@@ -235,11 +323,15 @@ Table::~Table( )
     // Make sure to write to rest of the entries to file before closing down.
     if( useFileStreamer_ )
     {
+        flushBins();
         mergeWithTime( data_ );
         assert( ! datafile_.empty() );
+        // Earlier buffers of this table may still be with the writer.
+        StreamWriter::shared().flush();
         StreamerBase::writeToOutFile( datafile_, format_, APPEND, data_, columns_);
         clearAllVecs();
     }
+    dropSpill();
 }
 
 Table& Table::operator=( const Table& tab )
@@ -255,7 +347,8 @@ Table& Table::operator=( const Table& tab )
 void Table::process( const Eref& e, ProcPtr p )
 {
     lastTime_ = p->currTime;
-    tvec_.push_back(lastTime_);
+    if( useSpikeMode_ || decimation_ == NO_DECIMATION )
+        tvec_.push_back(lastTime_);
 
     // Copy incoming data to ret and insert into vector.
     vector< double > ret;
@@ -266,6 +359,11 @@ void Table::process( const Eref& e, ProcPtr p )
         for ( auto i = ret.begin(); i != ret.end(); ++i )
             spike( *i );
     }
+    else if( decimation_ != NO_DECIMATION )
+    {
+        for ( auto i = ret.begin(); i != ret.end(); ++i )
+            addSample( lastTime_, *i );
+    }
     else
         vec().insert( vec().end(), ret.begin(), ret.end() );
 
@@ -278,11 +376,13 @@ void Table::process( const Eref& e, ProcPtr p )
         if( fmod(lastTime_, 5.0) == 0.0 || getVecSize() >= 10000 )
         {
             mergeWithTime( data_ );
-            StreamerBase::writeToOutFile( datafile_, format_, APPEND, data_, columns_ );
+            StreamWriter::shared().write( datafile_, format_, APPEND, data_, columns_ );
             clearAllVecs();
         }
-        }
     }
+    else if( ringSize_ > 0 )
+        spill();
+}
 
 void Table::clearAllVecs()
 {
@@ -326,6 +426,9 @@ void Table::reinit( const Eref& e, ProcPtr p )
 
     input_ = 0.0;
     vec().resize( 0 );
+    tvec_.clear();
+    resetBins();
+    dropSpill();
     lastTime_ = 0;
     vector< double > ret;
     requestOut()->send( e, &ret );
@@ -335,15 +438,21 @@ void Table::reinit( const Eref& e, ProcPtr p )
         for ( auto i = ret.begin(); i != ret.end(); ++i )
             spike( *i );
     }
+    else if( decimation_ != NO_DECIMATION )
+    {
+        for ( auto i = ret.begin(); i != ret.end(); ++i )
+            addSample( lastTime_, *i );
+    }
     else
         vec().insert( vec().end(), ret.begin(), ret.end() );
 
-    tvec_.push_back(lastTime_);
+    if( useSpikeMode_ || decimation_ == NO_DECIMATION )
+        tvec_.push_back(lastTime_);
 
     if( useFileStreamer_ )
     {
         mergeWithTime( data_ );
-        StreamerBase::writeToOutFile(datafile_, format_, WRITE, data_, columns_);
+        StreamWriter::shared().write( datafile_, format_, WRITE, data_, columns_ );
         clearAllVecs();
     }
 }
@@ -354,9 +463,162 @@ void Table::reinit( const Eref& e, ProcPtr p )
 //////////////////////////////////////////////////////////////
 void Table::input( double v )
 {
+    if( decimation_ != NO_DECIMATION )
+    {
+        // Incoming values carry no time, so use that of the clock.
+        Clock* clk = reinterpret_cast<Clock*>( Id(1).eref().data() );
+        addSample( clk->getCurrentTime(), v );
+    }
+    else
+        vec().push_back( v );
+
+    if( ringSize_ > 0 && ! useFileStreamer_ )
+        spill();
+}
+
+//////////////////////////////////////////////////////////////
+// Decimation
+//////////////////////////////////////////////////////////////
+
+void Table::pushPoint( double t, double v )
+{
+    tvec_.push_back( t );
     vec().push_back( v );
 }
 
+void Table::addSample( double t, double v )
+{
+    if( binWidth_ <= 0.0 )
+    {
+        pushPoint( t, v );
+        return;
+    }
+
+    if( binCount_ > 0 && t >= binEnd_ )
+        closeBin();
+
+    if( binCount_ == 0 )
+    {
+        // The small offset keeps a time that is a multiple of binWidth_ in
+        // the bin that it starts, in spite of roundoff.
+        binEnd_ = ( floor( t / binWidth_ + 1e-9 ) + 1.0 ) * binWidth_;
+        binSum_ = 0.0;
+        binTimeSum_ = 0.0;
+        firstT_ = minT_ = maxT_ = t;
+        firstV_ = minV_ = maxV_ = v;
+    }
+
+    binCount_ += 1;
+    binSum_ += v;
+    binTimeSum_ += t;
+    if( v < minV_ )
+    {
+        minV_ = v;
+        minT_ = t;
+    }
+    if( v > maxV_ )
+    {
+        maxV_ = v;
+        maxT_ = t;
+    }
+    if( decimation_ == LTTB )
+    {
+        binT_.push_back( t );
+        binV_.push_back( v );
+    }
+}
+
+void Table::closeBin( )
+{
+    if( binCount_ == 0 )
+        return;
+
+    switch( decimation_ )
+    {
+    case NTH:
+        pushPoint( firstT_, firstV_ );
+        break;
+    case MEAN:
+        pushPoint( binTimeSum_ / binCount_, binSum_ / binCount_ );
+        break;
+    case MINMAX:
+        if( minT_ < maxT_ )
+        {
+            pushPoint( minT_, minV_ );
+            pushPoint( maxT_, maxV_ );
+        }
+        else if( maxT_ < minT_ )
+        {
+            pushPoint( maxT_, maxV_ );
+            pushPoint( minT_, minV_ );
+        }
+        else
+            pushPoint( minT_, minV_ );
+        break;
+    case LTTB:
+        if( ! prevBinT_.empty() )
+        {
+            // Pick from the previous bin the point that makes the largest
+            // triangle with the last point picked and the mean of this bin.
+            // The first point of all is always kept.
+            size_t best = 0;
+            if( hasLast_ )
+            {
+                double cT = binTimeSum_ / binCount_;
+                double cV = binSum_ / binCount_;
+                double maxArea = -1.0;
+                for( size_t i = 0; i < prevBinT_.size(); i++ )
+                {
+                    double area = fabs( ( lastT_ - cT ) * ( prevBinV_[i] - lastV_ )
+                                        - ( lastT_ - prevBinT_[i] ) * ( cV - lastV_ ) );
+                    if( area > maxArea )
+                    {
+                        maxArea = area;
+                        best = i;
+                    }
+                }
+            }
+            lastT_ = prevBinT_[best];
+            lastV_ = prevBinV_[best];
+            hasLast_ = true;
+            pushPoint( lastT_, lastV_ );
+        }
+        prevBinT_.swap( binT_ );
+        prevBinV_.swap( binV_ );
+        binT_.clear();
+        binV_.clear();
+        break;
+    default:
+        break;
+    }
+    binCount_ = 0;
+}
+
+void Table::flushBins( )
+{
+    closeBin();
+    // The last point of all is always kept by LTTB.
+    if( decimation_ == LTTB && ! prevBinT_.empty() )
+    {
+        lastT_ = prevBinT_.back();
+        lastV_ = prevBinV_.back();
+        hasLast_ = true;
+        pushPoint( lastT_, lastV_ );
+        prevBinT_.clear();
+        prevBinV_.clear();
+    }
+}
+
+void Table::resetBins( )
+{
+    binCount_ = 0;
+    binT_.clear();
+    binV_.clear();
+    prevBinT_.clear();
+    prevBinV_.clear();
+    hasLast_ = false;
+}
+
 void Table::spike( double v )
 {
     if ( fired_ )
@@ -458,6 +720,263 @@ string Table::getDatafile( void ) const
     return datafile_;
 }
 
+static const char* decimationNames[] = { "none", "nth", "mean", "minmax", "lttb" };
+
+void Table::setDecimation( string mode )
+{
+    for( unsigned int i = 0; i < sizeof( decimationNames ) / sizeof( char* ); i++ )
+    {
+        if( mode == decimationNames[i] )
+        {
+            // Whatever was in the bins of the old mode is kept.
+            flushBins();
+            resetBins();
+            decimation_ = static_cast< DecimationMode >( i );
+            return;
+        }
+    }
+    LOG( moose::warning
+         , "Unsupported decimation " << mode
+         << ". Use one of none, nth, mean, minmax or lttb."
+       );
+}
+
+string Table::getDecimation( void ) const
+{
+    return decimationNames[ decimation_ ];
+}
+
+void Table::setBinWidth( double width )
+{
+    if( width < 0.0 )
+    {
+        LOG( moose::warning, "binWidth must be >= 0. Got " << width );
+        return;
+    }
+    flushBins();
+    binWidth_ = width;
+}
+
+double Table::getBinWidth( void ) const
+{
+    return binWidth_;
+}
+
+vector< double > Table::getTimes( void ) const
+{
+    if( ! spill_ )
+        return tvec_;
+    vector< double > ret;
+    const double* d = spill_->data();
+    size_t n = spill_->size() / 2;
+    ret.reserve( n + tvec_.size() );
+    for( size_t i = 0; i < n; i++ )
+        ret.push_back( d[2 * i] );
+    ret.insert( ret.end(), tvec_.begin(), tvec_.end() );
+    return ret;
+}
+
+//////////////////////////////////////////////////////////////
+// Spill to disk
+//////////////////////////////////////////////////////////////
+
+void Table::setRingSize( unsigned int num )
+{
+    ringSize_ = num;
+}
+
+unsigned int Table::getRingSize( void ) const
+{
+    return ringSize_;
+}
+
+void Table::setSpillFile( string filepath )
+{
+    spillFile_ = filepath;
+}
+
+string Table::getSpillFile( void ) const
+{
+    return spill_ ? spillPath_ : spillFile_;
+}
+
+unsigned int Table::getNumSpilled( void ) const
+{
+    return spill_ ? spill_->size() / 2 : 0;
+}
+
+void Table::spill( )
+{
+    if( vec().size() < ringSize_ )
+        return;
+
+    if( ! spill_ && ! openSpill() )
+        return;
+
+    // In spike mode the entries are themselves times.
+    const vector< double >& v = vec();
+    vector< double > rows;
+    rows.reserve( 2 * v.size() );
+    for( size_t i = 0; i < v.size(); i++ )
+    {
+        if( useSpikeMode_ )
+            rows.push_back( v[i] );
+        else
+            rows.push_back( i < tvec_.size() ? tvec_[i] : NAN );
+        rows.push_back( v[i] );
+    }
+    spill_->append( rows.data(), rows.size() );
+
+    TableBase::clearVec();
+    tvec_.clear();
+    lastN_ = 0;
+}
+
+bool Table::openSpill( )
+{
+    {
+        spillPath_ = spillFile_;
+        if( spillPath_.empty() )
+        {
+            const char* tmp = getenv( "TMPDIR" );
+            stringstream ss;
+            ss << ( tmp ? tmp : "/tmp" ) << "/moose-table-";
+#ifndef _WIN32
+            ss << getpid() << '-';
+#endif
+            ss << this << ".npy";
+            spillPath_ = ss.str();
+        }
+        spill_.reset( new cnpy2::MappedNumpy() );
+        string colname = tableColumnName_.empty() ? "value" : tableColumnName_;
+        if( ! spill_->create( spillPath_, { "time", colname } ) )
+        {
+            LOG( moose::warning, "Could not spill " << tablePath_ << " to "
+                 << spillPath_ << ". Keeping all its entries in memory." );
+            spill_.reset();
+            ringSize_ = 0;
+            return false;
+        }
+    }
+    return true;
+}
+
+void Table::dropSpill( )
+{
+    if( ! spill_ )
+        return;
+    spill_.reset();
+    if( spillFile_.empty() )
+        std::remove( spillPath_.c_str() );
+}
+
+void Table::saveState( StateWriter& w ) const
+{
+    TableBase::saveState( w );
+    w.put( tvec_ );
+    vector< double > rows;
+    if( spill_ )
+        rows.assign( spill_->data(), spill_->data() + spill_->size() );
+    w.put( rows );
+
+    w.put( lastTime_ );
+    w.put( input_ );
+    w.put( fired_ );
+    w.put( lastN_ );
+    w.put( binEnd_ );
+    w.put( binCount_ );
+    w.put( binSum_ );
+    w.put( binTimeSum_ );
+    w.put( firstT_ );
+    w.put( firstV_ );
+    w.put( minT_ );
+    w.put( minV_ );
+    w.put( maxT_ );
+    w.put( maxV_ );
+    w.put( binT_ );
+    w.put( binV_ );
+    w.put( prevBinT_ );
+    w.put( prevBinV_ );
+    w.put( lastT_ );
+    w.put( lastV_ );
+    w.put( hasLast_ );
+}
+
+void Table::restoreState( StateReader& r )
+{
+    TableBase::restoreState( r );
+    r.get( tvec_ );
+    vector< double > rows;
+    r.get( rows );
+
+    r.get( lastTime_ );
+    r.get( input_ );
+    r.get( fired_ );
+    r.get( lastN_ );
+    r.get( binEnd_ );
+    r.get( binCount_ );
+    r.get( binSum_ );
+    r.get( binTimeSum_ );
+    r.get( firstT_ );
+    r.get( firstV_ );
+    r.get( minT_ );
+    r.get( minV_ );
+    r.get( maxT_ );
+    r.get( maxV_ );
+    r.get( binT_ );
+    r.get( binV_ );
+    r.get( prevBinT_ );
+    r.get( prevBinV_ );
+    r.get( lastT_ );
+    r.get( lastV_ );
+    r.get( hasLast_ );
+
+    dropSpill();
+    if( rows.size() % 2 != 0 )
+        r.fail();
+    else if( r.ok() && ! rows.empty() )
+    {
+        if( openSpill() )
+            spill_->append( rows.data(), rows.size() );
+        else
+            r.fail();
+    }
+}
+
+vector< double > Table::getVector() const
+{
+    if( ! spill_ )
+        return TableBase::getVector();
+    vector< double > ret;
+    const double* d = spill_->data();
+    size_t n = spill_->size() / 2;
+    vector< double > mem = TableBase::getVector();
+    ret.reserve( n + mem.size() );
+    for( size_t i = 0; i < n; i++ )
+        ret.push_back( d[2 * i + 1] );
+    ret.insert( ret.end(), mem.begin(), mem.end() );
+    return ret;
+}
+
+unsigned int Table::getVecSize( ) const
+{
+    return getNumSpilled() + TableBase::getVecSize();
+}
+
+double Table::getY( unsigned int index ) const
+{
+    unsigned int n = getNumSpilled();
+    if( index < n )
+        return spill_->data()[2 * index + 1];
+    return TableBase::getY( index - n );
+}
+
+void Table::clearVec()
+{
+    TableBase::clearVec();
+    dropSpill();
+}
+
 // Get the dt_ of this table
 double Table::getDt( void ) const
 {
@@ -10,8 +10,12 @@
 #ifndef _TABLE_H
 #define _TABLE_H
 
+#include <memory>
+
 using namespace std;
 
+namespace cnpy2 { class MappedNumpy; }
+
 /**
  * Receives and records inputs. Handles plot and spiking data in batch mode.
  */
@@ -48,6 +52,31 @@ public:
     // Access the dt_ of table.
     double getDt ( void ) const;
 
+    void setDecimation ( string mode );
+    string getDecimation ( void ) const;
+
+    void setBinWidth ( double width );
+    double getBinWidth ( void ) const;
+
+    vector< double > getTimes ( void ) const;
+
+    void setRingSize ( unsigned int num );
+    unsigned int getRingSize ( void ) const;
+
+    void setSpillFile ( string filepath );
+    string getSpillFile ( void ) const;
+
+    unsigned int getNumSpilled ( void ) const;
+
+    // These see the spilled entries as well as those in memory.
+    vector< double > getVector() const;
+    unsigned int getVecSize( ) const;
+    double getY( unsigned int index ) const;
+    void clearVec();
+
+    /* Add whatever is in the open bins to the table. */
+    void flushBins( );
+
     // merge time value among values. e.g. t1, v1, t2, v2, etc.
     void mergeWithTime( vector<double>& data );
 
@@ -68,6 +97,13 @@ public:
     void input ( double v );
     void spike ( double v );
 
+    /**
+     * Runtime state for checkpoints. Entries already spilled to disk are
+     * saved too, and go to a fresh spill file on restoring.
+     */
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     //////////////////////////////////////////////////////////////////
     // Lookup funcs for table
     //////////////////////////////////////////////////////////////////
@@ -76,6 +112,19 @@ public:
 
 private:
 
+    /* Record a sample, reduced into bins when decimation is on. */
+    void addSample( double t, double v );
+    void pushPoint( double t, double v );
+    void closeBin( );
+    void resetBins( );
+
+    /* Move the entries in memory to the spill file, once there are ringSize_ */
+    void spill( );
+    bool openSpill( );
+    void dropSpill( );
+
+    enum DecimationMode { NO_DECIMATION, NTH, MEAN, MINMAX, LTTB };
+
     double threshold_;
     double lastTime_;
     double input_;
@@ -120,6 +169,39 @@ private:
      */
     string format_;
 
+    /**
+     * @brief Decimation. Samples are grouped into bins of binWidth_ seconds
+     * on a fixed time grid, and each bin is reduced to one or two points.
+     */
+    DecimationMode decimation_;
+    double binWidth_;
+
+    // The open bin.
+    double binEnd_;
+    unsigned int binCount_;
+    double binSum_;
+    double binTimeSum_;
+    double firstT_, firstV_;
+    double minT_, minV_;
+    double maxT_, maxV_;
+
+    // LTTB picks a point from a bin once the next bin is complete, so it
+    // keeps the samples of the last two bins.
+    vector< double > binT_, binV_;
+    vector< double > prevBinT_, prevBinV_;
+    double lastT_, lastV_;
+    bool hasLast_;
+
+    /**
+     * @brief Spill to disk. Once ringSize_ entries are in memory they are
+     * appended, with their times, to a memory-mapped npy file, and memory
+     * is cleared. 0 keeps everything in memory.
+     */
+    unsigned int ringSize_;
+    string spillFile_;
+    std::unique_ptr< cnpy2::MappedNumpy > spill_;
+    string spillPath_;
+
 };
 
 #endif	// _TABLE_H
@@ -171,6 +171,14 @@ TableBase::TableBase() : output_( 0 )
 
 void TableBase::linearTransform( double scale, double offset )
 {
+    // Entries a derived class keeps elsewhere cannot be changed here.
+    if ( getVecSize() != vec_.size() )
+    {
+        cout << "Warning: TableBase::linearTransform: " <<
+             getVecSize() - vec_.size() << " entries of this table have "
+             "been spilled to disk, and cannot be transformed. Ignored.\n";
+        return;
+    }
     for ( vector< double >::iterator i = vec_.begin(); i != vec_.end(); ++i)
         *i = *i * scale + offset;
 }
@@ -180,7 +188,8 @@ void TableBase::plainPlot( string fname )
     ofstream fout( fname.c_str(), ios_base::out );
     fout.precision( 18 );
     fout.setf( ios::scientific, ios::floatfield );
-    for ( vector< double >::iterator i = vec_.begin(); i != vec_.end(); ++i)
+    vector< double > v = getVector();
+    for ( vector< double >::iterator i = v.begin(); i != v.end(); ++i)
         fout << *i << endl;
     fout << "\n";
 }
@@ -190,7 +199,8 @@ void TableBase::xplot( string fname, string plotname )
     ofstream fout( fname.c_str(), ios_base::app );
     fout << "/newplot\n";
     fout << "/plotname " << plotname << "\n";
-    for ( vector< double >::iterator i = vec_.begin(); i != vec_.end(); ++i)
+    vector< double > v = getVector();
+    for ( vector< double >::iterator i = v.begin(); i != v.end(); ++i)
         fout << *i << endl;
     fout << "\n";
 }
@@ -408,12 +418,12 @@ void TableBase::compareXplot( string fname, string plotname, string op )
 
     if ( hop == "rmsd" )   // RMSDifference
     {
-        output_ = getRMSDiff( vec_, temp );
+        output_ = getRMSDiff( getVector(), temp );
     }
 
     if ( hop == "rmsr" )   // RMS ratio
     {
-        output_ = getRMSRatio( vec_, temp );
+        output_ = getRMSRatio( getVector(), temp );
     }
 
     if ( hop == "dotp" )
@@ -429,12 +439,12 @@ void TableBase::compareVec( vector< double > temp, string op )
 
     if ( hop == "rmsd" )   // RMSDifference
     {
-        output_ = getRMSDiff( vec_, temp );
+        output_ = getRMSDiff( getVector(), temp );
     }
 
     if ( hop == "rmsr" )   // RMS ratio
     {
-        output_ = getRMSRatio( vec_, temp );
+        output_ = getRMSRatio( getVector(), temp );
     }
 
     if ( hop == "dotp" )
@@ -460,6 +470,18 @@ void TableBase::setOutputValue( double v )
     output_ = v;
 }
 
+void TableBase::saveState( StateWriter& w ) const
+{
+    w.put( output_ );
+    w.put( vec_ );
+}
+
+void TableBase::restoreState( StateReader& r )
+{
+    r.get( output_ );
+    r.get( vec_ );
+}
+
 double TableBase::getY( unsigned int index ) const
 {
     if ( index < vec_.size() )
@@ -524,7 +546,8 @@ vector< double >& TableBase::vec()
     return vec_;
 }
 
-// Fetch the const copy of table. Used in Streamer class.
+// Fetch the const copy of table. Used in Streamer class and by moose.view.
+// Holds only the entries in memory; see getVector.
 const vector< double >& TableBase::data( )
 {
     return vec_;
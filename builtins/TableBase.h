@@ -20,12 +20,17 @@ class TableBase
 {
 public:
     TableBase();
+    virtual ~TableBase() {}
 
     /*-----------------------------------------------------------------------------
      *  Functions related to field assignment.
      *-----------------------------------------------------------------------------*/
-    vector< double > getVector() const;
+    // Virtual so that a table can keep part of its data elsewhere.
+    // Everything that reads the whole table goes through it.
+    virtual vector< double > getVector() const;
 
+    // Only the entries held in memory. A Table with a ringSize keeps
+    // the older ones in its spill file.
     const vector< double >& data( );
 
     void setVector( vector< double > val );
@@ -36,7 +41,7 @@ public:
     string getPlotDump() const;
     void setPlotDump( string v );
 
-    double getY( unsigned int index ) const;
+    virtual double getY( unsigned int index ) const;
 
     //////////////////////////////////////////////////////////////////
     // Dest funcs
@@ -54,21 +59,28 @@ public:
     void loadCSV( string fname, int startLine, int colNum, char separator );
     void compareXplot( string fname, string plotname, string op );
     void compareVec( vector< double > other, string op );
-    void clearVec();
+    virtual void clearVec();
 
     //////////////////////////////////////////////////////////////////
     // Lookup funcs for table
     //////////////////////////////////////////////////////////////////
-    double* lookupVec( unsigned int index );
     void setVecSize( unsigned int num );
-    unsigned int getVecSize( ) const;
+    virtual unsigned int getVecSize( ) const;
     double interpolate( double x, double xmin, double xmax ) const;
 
     static const Cinfo* initCinfo();
 
 protected:
+    // The entries held in memory, to which new ones are added.
     vector< double >& vec();
 
+    /**
+     * The entries and output value, for the checkpoint hooks of derived
+     * classes that change them as they run.
+     */
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
 private:
     double output_;
     vector< double > vec_;
@@ -203,3 +203,17 @@ void TimeTable::process(const Eref& e, ProcPtr p)
       state_ = 1;
   }
 }
+
+void TimeTable::saveState( StateWriter& w ) const
+{
+  TableBase::saveState( w );
+  w.put( state_ );
+  w.put( curPos_ );
+}
+
+void TimeTable::restoreState( StateReader& r )
+{
+  TableBase::restoreState( r );
+  r.get( state_ );
+  r.get( curPos_ );
+}
@@ -35,6 +35,10 @@ class TimeTable: public TableBase
      */
     void reinit(const Eref& e, ProcPtr p);
 
+    /* Runtime state for checkpoints */
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     static const Cinfo * initCinfo();
 
   private:
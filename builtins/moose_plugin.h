@@ -0,0 +1,80 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+/*
+ * C interface for libraries loaded by NativePlugin.
+ *
+ * A plugin is a shared library which exports one function,
+ * moose_plugin(), returning a description of the plugin. This header has
+ * no dependency on the rest of MOOSE, so a plugin can be built from a
+ * copy of it alone. See examples/plugins for a sample and build recipe.
+ *
+ * All inputs and outputs are doubles. There are no type tags in this
+ * ABI: integer and boolean quantities travel as doubles, and anything
+ * else, such as strings or vectors, has to come in through the config
+ * string. On every process call MOOSE hands the plugin the current
+ * values of its numInputs inputs, which arrive by message on
+ * NativePlugin.x[i], and the plugin writes its numOutputs outputs, which
+ * are sent on by NativePlugin.valueOut (the first output) and
+ * outputsOut (all of them).
+ */
+#ifndef MOOSE_PLUGIN_H
+#define MOOSE_PLUGIN_H
+
+#define MOOSE_PLUGIN_ABI_VERSION 1
+
+#if defined(_WIN32)
+#define MOOSE_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define MOOSE_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MoosePlugin
+{
+    /* Must be MOOSE_PLUGIN_ABI_VERSION. */
+    unsigned int abiVersion;
+    const char* name;
+
+    unsigned int numInputs;
+    unsigned int numOutputs;
+    /* Names of the inputs and outputs, for documentation. May be NULL. */
+    const char* const* inputNames;
+    const char* const* outputNames;
+
+    /*
+     * Called once for each NativePlugin object, and again if its config
+     * string changes. The plugin may put per-object state in *state.
+     * Returns 0 on success. May be NULL.
+     */
+    int (*init)( const char* config, void** state );
+
+    /* Called on reinit. The outputs start out at zero. May be NULL. */
+    void (*reinit)( void* state, double dt,
+                    const double* inputs, double* outputs );
+
+    /* Called on every time step. Required. */
+    void (*process)( void* state, double t, double dt,
+                     const double* inputs, double* outputs );
+
+    /* Releases the state made by init. May be NULL. */
+    void (*destroy)( void* state );
+} MoosePlugin;
+
+/* The one symbol MOOSE looks up in the library. */
+MOOSE_PLUGIN_EXPORT const MoosePlugin* moose_plugin( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOOSE_PLUGIN_H */
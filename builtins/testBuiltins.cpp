@@ -15,8 +15,10 @@
 #include "TableBase.h"
 #include "Table.h"
 #include <queue>
+#include <thread>
 
 #include "../shell/Shell.h"
+#include "MooseParser.h"
 
 #ifdef ENABLE_NSDF
 extern void testNSDF();
@@ -188,7 +190,7 @@ void testMpiFibonacci()
 		f2 = temp;
 	}
 
-	a1id.destroy();
+	shell->doDelete( a1id );
 	cout << "." << flush;
 }
 
@@ -425,8 +427,81 @@ void testStats()
 	cout << "." << flush;
 }
 
+// Parsers with the same expression and variables share one compile, but
+// each evaluates on its own variables.
+void testParserCache()
+{
+	double a = 1.0, b = 2.0, c = 10.0, d = 20.0;
+	moose::MooseParser p1, p2, p3;
+	p1.DefineVar( "x0", &a );
+	p1.DefineVar( "x1", &b );
+	p2.DefineVar( "x0", &c );
+	p2.DefineVar( "x1", &d );
+	p3.DefineVar( "x0", &c );
+	p3.DefineVar( "x1", &d );
+	p3.DefineConst( "k", 3.0 );
+	p1.SetExpr( "x0 + 2 * x1" );
+	size_t n = moose::MooseParser::NumSharedExprs();
+	p2.SetExpr( "x0 + 2 * x1" );
+	assert( moose::MooseParser::NumSharedExprs() <= n );
+	assert( doubleEq( p1.Eval(), 5.0 ) );
+	assert( doubleEq( p2.Eval(), 50.0 ) );
+	a = 3.0;
+	assert( doubleEq( p1.Eval(), 7.0 ) );
+	assert( doubleEq( p2.Eval(), 50.0 ) );
+	assert( doubleApprox( p1.Derivative( "x1" ), 2.0 ) );
+	assert( doubleEq( b, 2.0 ) );
+
+	// Constants are part of what is compiled.
+	p3.SetExpr( "x0 + k * x1" );
+	assert( doubleEq( p3.Eval(), 70.0 ) );
+
+	// Rebinding a variable takes effect without a recompile.
+	double e = 100.0;
+	p2.DefineVar( "x0", &e );
+	assert( doubleEq( p2.Eval(), 140.0 ) );
+
+	// Assignments write to our own variables, so are not shared.
+	p1.SetExpr( "x1 := x0 * 2" );
+	p1.Eval();
+	assert( doubleEq( b, 6.0 ) );
+
+	// Clearing the variables drops the shared compile along with them.
+	p2.ClearVariables();
+	assert( std::isnan( p2.Eval() ) );
+	p2.DefineVar( "x0", &a );
+	p2.DefineVar( "x1", &d );
+	p2.SetExpr( "x0 + 2 * x1" );
+	assert( doubleEq( p2.Eval(), 43.0 ) );
+
+	// Threads evaluating the same expression at once each get a copy of
+	// their own, so each sees its own variables.
+	const unsigned int numThreads = 8;
+	vector< double > xs( numThreads );
+	vector< moose::MooseParser > ps( numThreads );
+	for ( unsigned int i = 0; i < numThreads; ++i ) {
+		xs[i] = i;
+		ps[i].DefineVar( "x0", &xs[i] );
+		ps[i].SetExpr( "x0 * x0 + 1" );
+	}
+	vector< unsigned int > bad( numThreads, 0 );
+	vector< std::thread > threads;
+	for ( unsigned int i = 0; i < numThreads; ++i )
+		threads.push_back( std::thread( [&ps, &xs, &bad, i]() {
+			for ( unsigned int j = 0; j < 20000; ++j )
+				if ( ps[i].Eval() != xs[i] * xs[i] + 1 )
+					bad[i]++;
+		} ) );
+	for ( auto& t: threads )
+		t.join();
+	for ( unsigned int i = 0; i < numThreads; ++i )
+		assert( bad[i] == 0 );
+	cout << "." << flush;
+}
+
 void testBuiltins()
 {
+	testParserCache();
 	testArith();
 	testTable();
 #if ENABLE_NSDF
@@ -88,16 +88,59 @@ void testCreateStringDataset()
     H5Fclose(file);
 }
 
+void testCreateDataset2DChunks()
+{
+    HDF5WriterBase writer;
+    writer.setShuffle(true);
+    string h5Filename = moose::random_string( 10 );
+    hid_t file = H5Fcreate(h5Filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t dset = writer.createDataset2D(file, "chunked", 1000, 64, 256);
+    assert(dset >= 0);
+    hid_t plist = H5Dget_create_plist(dset);
+    hsize_t chunkdims[2];
+    int rank = H5Pget_chunk(plist, 2, chunkdims);
+    assert(rank == 2);
+    assert(chunkdims[0] == 64);
+    assert(chunkdims[1] == 256);
+    // shuffle goes before deflate
+    assert(H5Pget_nfilters(plist) == 2);
+    unsigned int flags;
+    size_t nelmts = 0;
+    H5Z_filter_t first = H5Pget_filter2(plist, 0, &flags, &nelmts, NULL, 0, NULL, NULL);
+    H5Z_filter_t second = H5Pget_filter2(plist, 1, &flags, &nelmts, NULL, 0, NULL, NULL);
+    assert(first == H5Z_FILTER_SHUFFLE);
+    assert(second == H5Z_FILTER_DEFLATE);
+    H5Pclose(plist);
+    H5Dclose(dset);
+
+    // The old form chunks all rows together.
+    dset = writer.createDataset2D(file, "whole", 10);
+    plist = H5Dget_create_plist(dset);
+    H5Pget_chunk(plist, 2, chunkdims);
+    assert(chunkdims[0] == 10);
+    assert(chunkdims[1] == (hsize_t)HDF5WriterBase::CHUNK_SIZE);
+    H5Pclose(plist);
+    H5Dclose(dset);
+    H5Fclose(file);
+    remove(h5Filename.c_str());
+}
+
 #else // dummy function
 void testCreateStringDataset()
 {
     ;
 }
+
+void testCreateDataset2DChunks()
+{
+    ;
+}
 #endif // USE_HDF5
 
 void testNSDF()
 {
     testCreateStringDataset();
+    testCreateDataset2DChunks();
 }
 
 //
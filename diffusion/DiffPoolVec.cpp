@@ -15,6 +15,7 @@
 using namespace std;
 
 #include "../basecode/SparseMatrix.h"
+#include "../basecode/StateBuffer.h"
 #include "DiffPoolVec.h"
 
 /**
@@ -84,6 +85,18 @@ void DiffPoolVec::setPrevVec()
     prev_ = n_;
 }
 
+void DiffPoolVec::saveState( StateWriter& w ) const
+{
+    w.put( n_ );
+    w.put( prev_ );
+}
+
+void DiffPoolVec::restoreState( StateReader& r )
+{
+    r.getFixed( n_ );
+    r.getFixed( prev_ );
+}
+
 double DiffPoolVec::getDiffConst() const
 {
     return diffConst_;
@@ -48,6 +48,10 @@ public:
     void setNvec( unsigned int start, unsigned int num,
                   vector< double >::const_iterator q );
     void setPrevVec(); /// Assigns prev_ = n_
+
+    /// Runtime state for checkpoints: n_ and prev_.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
     void setOps( const vector< Triplet< double > >& ops_,
                  const vector< double >& diagVal_ ); /// Assign operations.
 
@@ -222,6 +222,13 @@ vector< double > Dsolve::getNvec( unsigned int pool ) const
     return ret;
 }
 
+const vector< double >* Dsolve::nVecStorage( unsigned int pool ) const
+{
+    if ( pool < pools_.size() )
+        return &pools_[pool].getNvec();
+    return 0;
+}
+
 static bool checkJn( const vector< DiffJunction >& jn, unsigned int voxel,
                      const string& info )
 {
@@ -563,6 +570,23 @@ void Dsolve::reinit( const Eref& e, ProcPtr p )
 		i->reinit( m->vGetVoxelVolume() );
 }
 
+void Dsolve::saveState( StateWriter& w ) const
+{
+    w.put< uint64_t >( pools_.size() );
+    for ( auto i = pools_.begin(); i != pools_.end(); ++i )
+        i->saveState( w );
+}
+
+void Dsolve::restoreState( StateReader& r )
+{
+    uint64_t n = 0;
+    r.get( n );
+    if ( n != pools_.size() )
+        r.fail();
+    for ( auto i = pools_.begin(); i != pools_.end() && r.ok(); ++i )
+        i->restoreState( r );
+}
+
 void Dsolve::updateJunctions( double dt )
 {
     calcLocalChan( dt );
@@ -571,6 +595,25 @@ void Dsolve::updateJunctions( double dt )
 }
 
 
+/**
+ * The junctions only touch their own voxels on this Dsolve, so these
+ * are all that need to be current before updateJunctions. The local
+ * channels, if any, work on every voxel, and then we cannot say.
+ */
+bool Dsolve::getJunctionVoxels( vector< unsigned int >& voxels ) const
+{
+    voxels.clear();
+    for ( auto ch = channels_.begin(); ch != channels_.end(); ++ch )
+        if ( ch->isLocal )
+            return false;
+    for ( auto i = junctions_.begin(); i != junctions_.end(); ++i )
+        for ( auto j = i->vj.begin(); j != i->vj.end(); ++j )
+            voxels.push_back( j->first );
+    sort( voxels.begin(), voxels.end() );
+    voxels.erase( unique( voxels.begin(), voxels.end() ), voxels.end() );
+    return true;
+}
+
 void Dsolve::calcJunction_chunk( const size_t begin, const size_t end, double dt )
 {
     for (size_t i = begin; i < min(end, junctions_.size()); i++)
@@ -52,6 +52,8 @@ public:
 
     vector< double > getNvec( unsigned int pool ) const;
     void setNvec( unsigned int pool, vector< double > vec );
+    /// Inherited virtual.
+    const vector< double >* nVecStorage( unsigned int pool ) const;
 
     /// LookupFied for examining cross-solver diffusion terms.
     double getDiffVol1( unsigned int voxel ) const;
@@ -67,6 +69,10 @@ public:
     void process( const Eref& e, ProcPtr p );
     void reinit( const Eref& e, ProcPtr p );
 
+    /// Runtime state of all pools, for checkpoints.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     //////////////////////////////////////////////////////////////////
     void updateJunctions( double dt );
 
@@ -147,6 +153,7 @@ public:
     void getBlock( vector< double >& values ) const;
     void setBlock( const vector< double >& values );
     void setPrev();
+    bool getJunctionVoxels( vector< unsigned int >& voxels ) const;
 
     // This one isn't used in Dsolve, but is defined as a dummy.
     void setupCrossSolverReacs(
@@ -0,0 +1,90 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+/*
+ * Sample NativePlugin: a proportional-integral controller.
+ *
+ *   inputs:  setpoint, measured
+ *   outputs: command = kp * error + ki * integral of error, and error
+ *
+ * The gains come from the config string, e.g. "kp=2 ki=0.5".
+ * See README.md in this directory for how to build and use it.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "moose_plugin.h"
+
+typedef struct
+{
+    double kp;
+    double ki;
+    double integral;
+} PiState;
+
+static double configValue( const char* config, const char* key, double dflt )
+{
+    const char* p = strstr( config, key );
+    if ( !p )
+        return dflt;
+    return atof( p + strlen( key ) );
+}
+
+static int piInit( const char* config, void** state )
+{
+    PiState* s = (PiState*) malloc( sizeof( PiState ) );
+    if ( !s )
+        return 1;
+    s->kp = configValue( config, "kp=", 1.0 );
+    s->ki = configValue( config, "ki=", 0.0 );
+    s->integral = 0.0;
+    *state = s;
+    return 0;
+}
+
+static void piReinit( void* state, double dt,
+                      const double* inputs, double* outputs )
+{
+    PiState* s = (PiState*) state;
+    double error = inputs[0] - inputs[1];
+    s->integral = 0.0;
+    outputs[0] = s->kp * error;
+    outputs[1] = error;
+}
+
+static void piProcess( void* state, double t, double dt,
+                       const double* inputs, double* outputs )
+{
+    PiState* s = (PiState*) state;
+    double error = inputs[0] - inputs[1];
+    s->integral += error * dt;
+    outputs[0] = s->kp * error + s->ki * s->integral;
+    outputs[1] = error;
+}
+
+static void piDestroy( void* state )
+{
+    free( state );
+}
+
+static const char* const inputNames[] = { "setpoint", "measured" };
+static const char* const outputNames[] = { "command", "error" };
+
+static const MoosePlugin plugin = {
+    MOOSE_PLUGIN_ABI_VERSION,
+    "pi_controller",
+    2, 2,
+    inputNames, outputNames,
+    piInit, piReinit, piProcess, piDestroy
+};
+
+MOOSE_PLUGIN_EXPORT const MoosePlugin* moose_plugin( void )
+{
+    return &plugin;
+}
@@ -100,6 +100,26 @@ public:
 
     static bool abs_compare(double a, double b);
 
+    // Calls f on every member that the integration depends on, so that a
+    // caller can save and restore the solver exactly. param is left out,
+    // since it points back at the caller.
+    template <class F> void visitState(F &&f)
+    {
+        f(ml), f(mu), f(imxer), f(sqrteta);
+        f(mord), f(sm1), f(el), f(cm1), f(cm2), f(elco), f(tesco);
+        f(illin), f(init), f(ierpj), f(iersl), f(jcur), f(l), f(miter);
+        f(maxord), f(maxcor), f(msbp), f(mxncf), f(kflag), f(jstart);
+        f(ixpr), f(jtyp), f(mused), f(mxordn), f(mxords), f(meth_);
+        f(n), f(nq), f(nst), f(nfe), f(nje), f(nqu);
+        f(mxstep), f(mxhnil), f(nslast), f(nhnil), f(ntrep), f(nyh);
+        f(ccmax), f(el0), f(h_), f(hmin), f(hmxi), f(hu), f(rc), f(tn_);
+        f(tsw), f(pdnorm), f(conit), f(crate), f(hold), f(rmax);
+        f(ialth), f(ipup), f(lmax), f(nslp), f(pdest), f(pdlast), f(ratio);
+        f(icount), f(irflag);
+        f(ewt), f(savf), f(acor), f(yh_), f(wm_), f(ipvt);
+        f(itol_), f(rtol_), f(atol_);
+    }
+
 private:
     size_t ml, mu, imxer;
     double sqrteta;
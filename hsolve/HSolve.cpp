@@ -232,6 +232,75 @@ void HSolve::reinit( const Eref& hsolve, ProcPtr p )
     this->HSolveActive::reinit( p );
 }
 
+void HSolve::saveState( StateWriter& w ) const
+{
+    w.put( V_ );
+    w.put( VMid_ );
+    w.put( HS_ );
+    w.put( HJ_ );
+    w.put( stage_ );
+    w.put( state_ );
+    w.put( current_ );
+    w.put( ca_ );
+    w.put( caActivation_ );
+    vector< double > c;
+    for ( auto i = caConc_.begin(); i != caConc_.end(); ++i )
+        c.push_back( i->c_ );
+    w.put( c );
+    vector< double > modulation;
+    for ( auto i = channel_.begin(); i != channel_.end(); ++i )
+        modulation.push_back( i->modulation_ );
+    w.put( modulation );
+    w.put( externalCurrent_ );
+    w.put( prevExtCurr_ );
+    w.put( externalCalcium_ );
+    w.put< uint64_t >( inject_.size() );
+    for ( auto i = inject_.begin(); i != inject_.end(); ++i ) {
+        w.put( i->first );
+        w.put( i->second );
+    }
+}
+
+/// The solver must already be set up on the same cell.
+void HSolve::restoreState( StateReader& r )
+{
+    r.getFixed( V_ );
+    r.getFixed( VMid_ );
+    r.getFixed( HS_ );
+    r.getFixed( HJ_ );
+    r.get( stage_ );
+    r.getFixed( state_ );
+    // Filled in on the first step.
+    r.get( current_ );
+    if ( !current_.empty() && current_.size() != channel_.size() )
+        r.fail();
+    r.getFixed( ca_ );
+    r.getFixed( caActivation_ );
+    vector< double > c( caConc_.size() );
+    r.getFixed( c );
+    vector< double > modulation( channel_.size() );
+    r.getFixed( modulation );
+    r.getFixed( externalCurrent_ );
+    r.getFixed( prevExtCurr_ );
+    r.getFixed( externalCalcium_ );
+    if ( !r.ok() )
+        return;
+    for ( unsigned int i = 0; i < caConc_.size(); ++i )
+        caConc_[i].c_ = c[i];
+    for ( unsigned int i = 0; i < channel_.size(); ++i )
+        channel_[i].modulation_ = modulation[i];
+    uint64_t n = 0;
+    r.get( n );
+    inject_.clear();
+    for ( uint64_t i = 0; i < n && r.ok(); ++i ) {
+        unsigned int index = 0;
+        InjectStruct inject;
+        r.get( index );
+        r.get( inject );
+        inject_[ index ] = inject;
+    }
+}
+
 void HSolve::zombify( Eref hsolve ) const
 {
     vector< Id >::const_iterator i;
@@ -26,6 +26,13 @@ public:
     void process( const Eref& hsolve, ProcPtr p );
     void reinit( const Eref& hsolve, ProcPtr p );
 
+    /**
+     * Runtime state for checkpoints: voltages, gates, calcium and the
+     * currents carried over between steps.
+     */
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     void setSeed( Id seed );
     Id getSeed() const; 		/**< For searching for compartments:
 								 *   seed is the starting compt.     */
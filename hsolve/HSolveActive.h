@@ -20,6 +20,7 @@
 #include "../biophysics/HHChannelBase.h"
 #include "../biophysics/HHChannel.h"
 #include "../biophysics/SpikeGen.h"
+#include "../biophysics/SynChan.h"
 #include "HSolveUtils.h"
 #include "HSolveStruct.h"
 #include "HinesMatrix.h"
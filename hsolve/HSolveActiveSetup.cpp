@@ -534,6 +534,7 @@ void HSolveActive::createLookupTables()
  * calls are made by their respective clocks, and hence the process message is
  * not dropped. On the other hand, we drop the SpikeGen process messages here,
  * and explicitly call the SpikeGen process() from the HSolve via a pointer.
+ * SynChans in aggregated mode are represented by one entry per group.
  */
 void HSolveActive::readSynapses()
 {
@@ -549,6 +550,10 @@ void HSolveActive::readSynapses()
         HSolveUtils::synchans( compartmentId_[ ic ], synId );
         for ( syn = synId.begin(); syn != synId.end(); ++syn )
         {
+            // Aggregated SynChans are computed by their group leader, so
+            // only the leader needs an entry.
+            if ( SynChan::findAggregateLeader( syn->eref() ) != ObjId( *syn ) )
+                continue;
             synchan.compt_ = ic;
             synchan.elm_ = *syn;
             synchan_.push_back( synchan );
@@ -42,6 +42,7 @@ static const Cinfo* zombieHHChannelCinfo = ZombieHHChannel::initCinfo();
 // Constructor
 ///////////////////////////////////////////////////
 ZombieHHChannel::ZombieHHChannel()
+	: xGate_( 0 ), yGate_( 0 ), zGate_( 0 )
 { ; }
 
 ///////////////////////////////////////////////////
@@ -193,17 +194,24 @@ void ZombieHHChannel::vCreateGate(const Eref& e, string name)
 
 HHGate* ZombieHHChannel::vGetXgate( unsigned int i ) const
 {
-    return 0;
+    return xGate_;
 }
 
 HHGate* ZombieHHChannel::vGetYgate( unsigned int i ) const
 {
-    return 0;
+    return yGate_;
 }
 
 HHGate* ZombieHHChannel::vGetZgate( unsigned int i ) const
 {
-    return 0;
+    return zGate_;
+}
+
+void ZombieHHChannel::vSetGates( HHGate* x, HHGate* y, HHGate* z )
+{
+    xGate_ = x;
+    yGate_ = y;
+    zGate_ = z;
 }
 
 ///////////////////////////////////////////////////
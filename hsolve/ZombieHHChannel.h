@@ -113,6 +113,12 @@ public:
      * Access function used for the Z gate. The index is ignored.
      */
     HHGate* vGetZgate( unsigned int i ) const override;
+
+    /**
+     * Keeps the gates of the HHChannel this replaces, so that they can
+     * still be read, and are handed back when it is unzombified.
+     */
+    void vSetGates( HHGate* x, HHGate* y, HHGate* z ) override;
     /////////////////////////////////////////////////////////////
 	void vSetSolver( const Eref& e , Id hsolve ) override;
 
@@ -120,6 +126,9 @@ public:
 
 private:
     HSolve* hsolve_;
+    HHGate* xGate_;
+    HHGate* yGate_;
+    HHGate* zGate_;
 
     void copyFields( Id chanId, HSolve* hsolve_ );
 };
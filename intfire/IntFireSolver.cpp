@@ -0,0 +1,693 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include "../basecode/header.h"
+#include "../basecode/ElementValueFinfo.h"
+#include "../msg/Msg.h"
+#include "../biophysics/CompartmentBase.h"
+#include "../biophysics/Compartment.h"
+#include "IntFireBase.h"
+#include "LIF.h"
+#include "QIF.h"
+#include "ExIF.h"
+#include "AdExIF.h"
+#include "AdThreshIF.h"
+#include "IzhIF.h"
+#include "IntFireSolver.h"
+#include "ZombieIntFire.h"
+
+using namespace moose;
+
+// As in Compartment, the threshold for using exponential Euler.
+static const double EPSILON = 1.0e-15;
+
+const Cinfo* IntFireSolver::initCinfo()
+{
+	//////////////////////////////////////////////////////////////
+	// Field Definitions
+	//////////////////////////////////////////////////////////////
+	static ElementValueFinfo< IntFireSolver, Id > target(
+		"target",
+		"Element array of integrate-and-fire neurons (LIF, QIF, ExIF, "
+		"AdExIF, AdThreshIF or IzhIF) to be taken over by this solver. "
+		"Assigning the target zombifies the neurons; assigning an "
+		"empty Id, such as that of the root, writes their state back "
+		"and restores them.",
+		&IntFireSolver::setTarget,
+		&IntFireSolver::getTarget
+	);
+	static ReadOnlyValueFinfo< IntFireSolver, unsigned int > numNeurons(
+		"numNeurons",
+		"Number of neurons handled by the solver.",
+		&IntFireSolver::getNumNeurons
+	);
+	static ReadOnlyValueFinfo< IntFireSolver, string > model(
+		"model",
+		"Class of the neurons handled by the solver.",
+		&IntFireSolver::getModel
+	);
+	static ReadOnlyValueFinfo< IntFireSolver, double > numSpikes(
+		"numSpikes",
+		"Number of spikes fired by all the neurons since reinit.",
+		&IntFireSolver::getNumSpikes
+	);
+
+	//////////////////////////////////////////////////////////////
+	// MsgDest Definitions
+	//////////////////////////////////////////////////////////////
+	static DestFinfo process( "process",
+		"Handles process call",
+		new ProcOpFunc< IntFireSolver >( &IntFireSolver::process ) );
+	static DestFinfo reinit( "reinit",
+		"Handles reinit call",
+		new ProcOpFunc< IntFireSolver >( &IntFireSolver::reinit ) );
+
+	//////////////////////////////////////////////////////////////
+	// SharedMsg Definitions
+	//////////////////////////////////////////////////////////////
+	static Finfo* procShared[] = {
+		&process, &reinit
+	};
+	static SharedFinfo proc( "proc",
+		"Shared message for process and reinit",
+		procShared, sizeof( procShared ) / sizeof( const Finfo* )
+	);
+
+	static Finfo* intFireSolverFinfos[] = {
+		&target,		// Value
+		&numNeurons,	// ReadOnlyValue
+		&model,			// ReadOnlyValue
+		&numSpikes,		// ReadOnlyValue
+		&proc,			// SharedFinfo
+	};
+
+	static string doc[] =
+	{
+		"Name", "IntFireSolver",
+		"Author", "Upi Bhalla",
+		"Description", "Population solver for an array of integrate-and-"
+		"fire neurons. It keeps the state of all the neurons in one "
+		"vector per variable and advances them together, sending out "
+		"spikes only for the neurons that fired. The neurons are "
+		"zombified, and their fields and messages keep working.",
+	};
+
+	static Dinfo< IntFireSolver > dinfo;
+	static Cinfo intFireSolverCinfo(
+		"IntFireSolver",
+		Neutral::initCinfo(),
+		intFireSolverFinfos,
+		sizeof( intFireSolverFinfos ) / sizeof( Finfo* ),
+		&dinfo,
+		doc,
+		sizeof( doc ) / sizeof( string )
+	);
+
+	return &intFireSolverCinfo;
+}
+
+static const Cinfo* intFireSolverCinfo = IntFireSolver::initCinfo();
+
+//////////////////////////////////////////////////////////////////
+// Tables of the fields of each model.
+//////////////////////////////////////////////////////////////////
+
+namespace {
+	struct FieldEntry {
+		const char* name;
+		IntFireSolver::Var var;
+		bool writable;
+	};
+
+	const FieldEntry baseFields[] = {
+		{ "Vm", IntFireSolver::VM, true },
+		{ "initVm", IntFireSolver::INIT_VM, true },
+		{ "Em", IntFireSolver::EM, true },
+		{ "Cm", IntFireSolver::CM, true },
+		{ "Rm", IntFireSolver::RM, true },
+		{ "Ra", IntFireSolver::RA, true },
+		{ "inject", IntFireSolver::INJECT, true },
+		{ "thresh", IntFireSolver::THRESH, true },
+		{ "vReset", IntFireSolver::V_RESET, true },
+		{ "refractoryPeriod", IntFireSolver::REFRACT_T, true },
+		{ "lastEventTime", IntFireSolver::LAST_EVENT, false },
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+	const FieldEntry lifFields[] = {
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+	const FieldEntry qifFields[] = {
+		{ "vCritical", IntFireSolver::V_CRITICAL, true },
+		{ "a0", IntFireSolver::A0, true },
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+	const FieldEntry exifFields[] = {
+		{ "deltaThresh", IntFireSolver::DELTA_THRESH, true },
+		{ "vPeak", IntFireSolver::V_PEAK, true },
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+	const FieldEntry adexifFields[] = {
+		{ "deltaThresh", IntFireSolver::DELTA_THRESH, true },
+		{ "vPeak", IntFireSolver::V_PEAK, true },
+		{ "w", IntFireSolver::W, true },
+		{ "tauW", IntFireSolver::TAU_W, true },
+		{ "a0", IntFireSolver::A0, true },
+		{ "b0", IntFireSolver::B0, true },
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+	const FieldEntry adthreshifFields[] = {
+		{ "threshAdaptive", IntFireSolver::THRESH_ADAPTIVE, true },
+		{ "tauThresh", IntFireSolver::TAU_THRESH, true },
+		{ "a0", IntFireSolver::A0, true },
+		{ "threshJump", IntFireSolver::THRESH_JUMP, true },
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+	const FieldEntry izhifFields[] = {
+		{ "a0", IntFireSolver::A0, true },
+		{ "b0", IntFireSolver::B0, true },
+		{ "c0", IntFireSolver::C0, true },
+		{ "a", IntFireSolver::IZH_A, true },
+		{ "b", IntFireSolver::IZH_B, true },
+		{ "d", IntFireSolver::IZH_D, true },
+		{ "u", IntFireSolver::U, true },
+		{ "uInit", IntFireSolver::U_INIT, true },
+		{ "vPeak", IntFireSolver::V_PEAK, true },
+		{ 0, IntFireSolver::NUM_VARS, false }
+	};
+
+	const FieldEntry* modelFields( IntFireSolver::Model m )
+	{
+		switch ( m ) {
+			case IntFireSolver::LIF_MODEL: return lifFields;
+			case IntFireSolver::QIF_MODEL: return qifFields;
+			case IntFireSolver::EXIF_MODEL: return exifFields;
+			case IntFireSolver::ADEXIF_MODEL: return adexifFields;
+			case IntFireSolver::ADTHRESHIF_MODEL: return adthreshifFields;
+			case IntFireSolver::IZHIF_MODEL: return izhifFields;
+			default: return lifFields;
+		}
+	}
+
+	const Cinfo* originalCinfo( IntFireSolver::Model m )
+	{
+		switch ( m ) {
+			case IntFireSolver::LIF_MODEL: return LIF::initCinfo();
+			case IntFireSolver::QIF_MODEL: return QIF::initCinfo();
+			case IntFireSolver::EXIF_MODEL: return ExIF::initCinfo();
+			case IntFireSolver::ADEXIF_MODEL: return AdExIF::initCinfo();
+			case IntFireSolver::ADTHRESHIF_MODEL:
+				return AdThreshIF::initCinfo();
+			case IntFireSolver::IZHIF_MODEL: return IzhIF::initCinfo();
+			default: return 0;
+		}
+	}
+
+	/// Looks up the OpFunc of the set_ or get_ DestFinfo of a field.
+	const OpFunc* fieldFunc( const Cinfo* c, const string& prefix,
+					const char* field )
+	{
+		string name = prefix + field;
+		name[3] = std::toupper( name[3] );
+		const DestFinfo* df =
+			dynamic_cast< const DestFinfo* >( c->findFinfo( name ) );
+		if ( !df )
+			return 0;
+		return df->getOpFunc();
+	}
+
+	/**
+	 * The digests of all Elements talking to elm hold OpFuncs looked
+	 * up from its Cinfo, so they have to be rebuilt after a zombie swap.
+	 */
+	void rewireNeighbours( Element* elm )
+	{
+		const vector< ObjId >& mids = elm->msgIn();
+		for ( vector< ObjId >::const_iterator
+						i = mids.begin(); i != mids.end(); ++i ) {
+			const Msg* m = Msg::getMsg( *i );
+			if ( m ) {
+				m->e1()->markRewired();
+				m->e2()->markRewired();
+			}
+		}
+		elm->markRewired();
+	}
+}
+
+//////////////////////////////////////////////////////////////////
+// Class functions
+//////////////////////////////////////////////////////////////////
+
+IntFireSolver::IntFireSolver()
+	:
+		target_(),
+		model_( NUM_MODELS ),
+		numNeurons_( 0 ),
+		dt_( 1.0 ),
+		numSpikes_( 0.0 )
+{;}
+
+IntFireSolver::~IntFireSolver()
+{
+	unzombify();
+}
+
+/// Copies never own the zombies of the original.
+IntFireSolver::IntFireSolver( const IntFireSolver& other )
+	:
+		target_(),
+		model_( NUM_MODELS ),
+		numNeurons_( 0 ),
+		dt_( other.dt_ ),
+		numSpikes_( 0.0 )
+{;}
+
+IntFireSolver& IntFireSolver::operator=( const IntFireSolver& other )
+{
+	unzombify();
+	dt_ = other.dt_;
+	return *this;
+}
+
+//////////////////////////////////////////////////////////////////
+// Field access
+//////////////////////////////////////////////////////////////////
+
+void IntFireSolver::setTarget( const Eref& e, Id target )
+{
+	if ( target == target_ )
+		return;
+	unzombify();
+	if ( target == Id() )
+		return;
+	zombify( target );
+}
+
+Id IntFireSolver::getTarget( const Eref& e ) const
+{
+	return target_;
+}
+
+unsigned int IntFireSolver::getNumNeurons() const
+{
+	return numNeurons_;
+}
+
+string IntFireSolver::getModel() const
+{
+	if ( numNeurons_ == 0 )
+		return "";
+	return originalCinfo( model_ )->name();
+}
+
+double IntFireSolver::getNumSpikes() const
+{
+	return numSpikes_;
+}
+
+bool IntFireSolver::hasFired( unsigned int i ) const
+{
+	return status_[i] == FIRED;
+}
+
+double IntFireSolver::getDt() const
+{
+	return dt_;
+}
+
+//////////////////////////////////////////////////////////////////
+// Zombification
+//////////////////////////////////////////////////////////////////
+
+bool IntFireSolver::zombify( Id target )
+{
+	Element* elm = target.element();
+	if ( !elm )
+		return false;
+	const Cinfo* c = elm->cinfo();
+	Model m = NUM_MODELS;
+	for ( unsigned int k = 0; k < NUM_MODELS; ++k )
+		if ( c == originalCinfo( static_cast< Model >( k ) ) )
+			m = static_cast< Model >( k );
+	if ( m == NUM_MODELS ) {
+		cout << "Warning: IntFireSolver::setTarget: " << target.path() <<
+			" is a " << c->name() << ", not one of LIF, QIF, ExIF, "
+			"AdExIF, AdThreshIF or IzhIF. Ignored.\n";
+		return false;
+	}
+	if ( elm->numLocalData() != elm->numData() ) {
+		cout << "Warning: IntFireSolver::setTarget: " << target.path() <<
+			" is spread over several nodes. Ignored.\n";
+		return false;
+	}
+	unsigned int n = elm->numData();
+	if ( n == 0 )
+		return false;
+
+	var_.assign( NUM_VARS, vector< double >( n, 0.0 ) );
+	status_.assign( n, INTEGRATING );
+	firedList_.clear();
+	vmOutList_.clear();
+
+	const FieldEntry* tables[] = { baseFields, modelFields( m ) };
+	for ( unsigned int t = 0; t < 2; ++t ) {
+		for ( const FieldEntry* f = tables[t]; f->name; ++f ) {
+			const GetOpFuncBase< double >* get =
+				dynamic_cast< const GetOpFuncBase< double >* >(
+					fieldFunc( c, "get", f->name ) );
+			assert( get );
+			vector< double >& v = var_[ f->var ];
+			for ( unsigned int i = 0; i < n; ++i )
+				v[i] = get->returnOp( Eref( elm, i ) );
+		}
+	}
+	for ( unsigned int i = 0; i < n; ++i ) {
+		var_[ INV_RM ][i] = 1.0 / var_[ RM ][i];
+		var_[ B ][i] = var_[ INV_RM ][i];
+	}
+
+	elm->zombieSwap( ZombieIntFire::zombieCinfo( m ) );
+	for ( unsigned int i = 0; i < n; ++i ) {
+		ZombieIntFire* z =
+			reinterpret_cast< ZombieIntFire* >( Eref( elm, i ).data() );
+		z->setSolver( this, i );
+	}
+	rewireNeighbours( elm );
+
+	target_ = target;
+	model_ = m;
+	numNeurons_ = n;
+	return true;
+}
+
+void IntFireSolver::unzombify()
+{
+	Element* elm = target_.element();
+	if ( numNeurons_ > 0 && elm &&
+			elm->cinfo() == ZombieIntFire::zombieCinfo( model_ ) ) {
+		const Cinfo* c = originalCinfo( model_ );
+		elm->zombieSwap( c );
+		const FieldEntry* tables[] = { baseFields, modelFields( model_ ) };
+		for ( unsigned int t = 0; t < 2; ++t ) {
+			for ( const FieldEntry* f = tables[t]; f->name; ++f ) {
+				if ( !f->writable )
+					continue;
+				const OpFunc1Base< double >* set =
+					dynamic_cast< const OpFunc1Base< double >* >(
+						fieldFunc( c, "set", f->name ) );
+				assert( set );
+				const vector< double >& v = var_[ f->var ];
+				for ( unsigned int i = 0; i < numNeurons_; ++i )
+					set->op( Eref( elm, i ), v[i] );
+			}
+		}
+		rewireNeighbours( elm );
+	}
+	target_ = Id();
+	model_ = NUM_MODELS;
+	numNeurons_ = 0;
+	var_.clear();
+	status_.clear();
+	firedList_.clear();
+	vmOutList_.clear();
+}
+
+//////////////////////////////////////////////////////////////////
+// Dest functions
+//////////////////////////////////////////////////////////////////
+
+void IntFireSolver::reinit( const Eref& e, ProcPtr p )
+{
+	dt_ = p->dt;
+	numSpikes_ = 0.0;
+	firedList_.clear();
+	vmOutList_.clear();
+	Element* elm = target_.element();
+	if ( numNeurons_ == 0 || !elm )
+		return;
+
+	for ( unsigned int i = 0; i < numNeurons_; ++i ) {
+		var_[ ACTIVATION ][i] = 0.0;
+		var_[ LAST_EVENT ][i] = -var_[ REFRACT_T ][i];
+		var_[ VM ][i] = var_[ INIT_VM ][i];
+		var_[ A ][i] = 0.0;
+		var_[ B ][i] = var_[ INV_RM ][i];
+		var_[ IM ][i] = 0.0;
+		var_[ LAST_IM ][i] = 0.0;
+		var_[ SUM_INJECT ][i] = 0.0;
+		status_[i] = INTEGRATING;
+	}
+	if ( model_ == ADEXIF_MODEL )
+		var_[ W ].assign( numNeurons_, 0.0 );
+	else if ( model_ == ADTHRESHIF_MODEL )
+		var_[ THRESH_ADAPTIVE ].assign( numNeurons_, 0.0 );
+	else if ( model_ == IZHIF_MODEL )
+		var_[ U ] = var_[ U_INIT ];
+
+	// Only bother with Vm messages for the neurons that have targets.
+	BindIndex b = CompartmentBase::VmOut()->getBindIndex();
+	for ( unsigned int i = 0; i < numNeurons_; ++i ) {
+		Eref er( elm, i );
+		if ( !er.msgDigest( b ).empty() ) {
+			vmOutList_.push_back( i );
+			CompartmentBase::VmOut()->send( er, var_[ VM ][i] );
+		}
+	}
+}
+
+void IntFireSolver::process( const Eref& e, ProcPtr p )
+{
+	Element* elm = target_.element();
+	if ( numNeurons_ == 0 || !elm )
+		return;
+	dt_ = p->dt;
+	advanceSpikes( p->currTime, p->dt );
+	advanceSubthreshold( p->dt );
+
+	for ( vector< unsigned int >::const_iterator
+			i = firedList_.begin(); i != firedList_.end(); ++i )
+		IntFireBase::spikeOut()->send( Eref( elm, *i ), p->currTime );
+	numSpikes_ += firedList_.size();
+
+	const double* vm = &var_[ VM ][0];
+	for ( vector< unsigned int >::const_iterator
+			i = vmOutList_.begin(); i != vmOutList_.end(); ++i )
+		CompartmentBase::VmOut()->send( Eref( elm, *i ), vm[ *i ] );
+}
+
+//////////////////////////////////////////////////////////////////
+// Numerics. These follow the vProcess functions of the respective
+// classes, one loop at a time over all the neurons.
+//////////////////////////////////////////////////////////////////
+
+void IntFireSolver::advanceSpikes( double t, double dt )
+{
+	const unsigned int n = numNeurons_;
+	double* vm = &var_[ VM ][0];
+	double* act = &var_[ ACTIVATION ][0];
+	double* lastEvent = &var_[ LAST_EVENT ][0];
+	double* sumInject = &var_[ SUM_INJECT ][0];
+	double* a = &var_[ A ][0];
+	double* b = &var_[ B ][0];
+	const double* refractT = &var_[ REFRACT_T ][0];
+	const double* vReset = &var_[ V_RESET ][0];
+	const double* invRm = &var_[ INV_RM ][0];
+	unsigned char* status = &status_[0];
+
+	// The QIF and IzhIF do not use the A and B terms.
+	const bool resetAB = ( model_ != QIF_MODEL && model_ != IZHIF_MODEL );
+	// The ExIF and AdExIF fire on reaching vPeak, the others on
+	// exceeding it.
+	const bool inclusive = ( model_ == EXIF_MODEL || model_ == ADEXIF_MODEL );
+	const double* thresh = &var_[ THRESH ][0];
+	if ( model_ == EXIF_MODEL || model_ == ADEXIF_MODEL ||
+					model_ == IZHIF_MODEL )
+		thresh = &var_[ V_PEAK ][0];
+	const double* adaptive = ( model_ == ADTHRESHIF_MODEL ) ?
+		&var_[ THRESH_ADAPTIVE ][0] : 0;
+
+	firedList_.clear();
+	for ( unsigned int i = 0; i < n; ++i ) {
+		if ( t < lastEvent[i] + refractT[i] ) {
+			vm[i] = vReset[i];
+			sumInject[i] = 0.0;
+			if ( resetAB ) {
+				a[i] = 0.0;
+				b[i] = invRm[i];
+			}
+			status[i] = REFRACTORY;
+			continue;
+		}
+		// See IntFireBase::activation: a delta-fn synapse sends
+		// weight / dt, so this is integrated over the timestep.
+		vm[i] += act[i] * dt;
+		act[i] = 0.0;
+		double th = adaptive ? thresh[i] + adaptive[i] : thresh[i];
+		if ( inclusive ? ( vm[i] >= th ) : ( vm[i] > th ) ) {
+			vm[i] = vReset[i];
+			lastEvent[i] = t;
+			status[i] = FIRED;
+			firedList_.push_back( i );
+		} else {
+			status[i] = INTEGRATING;
+		}
+	}
+
+	// Jumps in the adaptation variables on firing.
+	Var jumpVar = NUM_VARS;
+	Var jumpBy = NUM_VARS;
+	if ( model_ == ADEXIF_MODEL ) {
+		jumpVar = W;
+		jumpBy = B0;
+	} else if ( model_ == ADTHRESHIF_MODEL ) {
+		jumpVar = THRESH_ADAPTIVE;
+		jumpBy = THRESH_JUMP;
+	} else if ( model_ == IZHIF_MODEL ) {
+		jumpVar = U;
+		jumpBy = IZH_D;
+	}
+	if ( jumpVar != NUM_VARS ) {
+		double* x = &var_[ jumpVar ][0];
+		const double* dx = &var_[ jumpBy ][0];
+		for ( vector< unsigned int >::const_iterator
+				i = firedList_.begin(); i != firedList_.end(); ++i )
+			x[ *i ] += dx[ *i ];
+	}
+}
+
+void IntFireSolver::advanceSubthreshold( double dt )
+{
+	const unsigned int n = numNeurons_;
+	const unsigned char* status = &status_[0];
+	double* vm = &var_[ VM ][0];
+	const double* em = &var_[ EM ][0];
+	const double* cm = &var_[ CM ][0];
+	const double* rm = &var_[ RM ][0];
+	const double* thresh = &var_[ THRESH ][0];
+	const double* a0 = &var_[ A0 ][0];
+
+	switch ( model_ ) {
+		case LIF_MODEL:
+			break;
+		case QIF_MODEL: {
+			const double* inject = &var_[ INJECT ][0];
+			const double* vCritical = &var_[ V_CRITICAL ][0];
+			double* sumInject = &var_[ SUM_INJECT ][0];
+			double* im = &var_[ IM ][0];
+			double* lastIm = &var_[ LAST_IM ][0];
+			for ( unsigned int i = 0; i < n; ++i ) {
+				if ( status[i] != INTEGRATING )
+					continue;
+				vm[i] += ( ( inject[i] + sumInject[i] ) +
+					a0[i] * ( vm[i] - em[i] ) * ( vm[i] - vCritical[i] ) /
+					rm[i] ) * dt / cm[i];
+				lastIm[i] = im[i];
+				im[i] = 0.0;
+				sumInject[i] = 0.0;
+			}
+			return;
+		}
+		case EXIF_MODEL: {
+			const double* deltaThresh = &var_[ DELTA_THRESH ][0];
+			for ( unsigned int i = 0; i < n; ++i ) {
+				if ( status[i] != INTEGRATING )
+					continue;
+				vm[i] += deltaThresh[i] *
+					exp( ( vm[i] - thresh[i] ) / deltaThresh[i] ) *
+					dt / rm[i] / cm[i];
+			}
+			break;
+		}
+		case ADEXIF_MODEL: {
+			const double* deltaThresh = &var_[ DELTA_THRESH ][0];
+			const double* tauW = &var_[ TAU_W ][0];
+			double* w = &var_[ W ][0];
+			for ( unsigned int i = 0; i < n; ++i ) {
+				if ( status[i] != INTEGRATING )
+					continue;
+				vm[i] += ( deltaThresh[i] *
+					exp( ( vm[i] - thresh[i] ) / deltaThresh[i] ) -
+					rm[i] * w[i] ) * dt / rm[i] / cm[i];
+				w[i] += ( -w[i] + a0[i] * ( vm[i] - em[i] ) ) *
+					dt / tauW[i];
+			}
+			break;
+		}
+		case ADTHRESHIF_MODEL: {
+			const double* tauThresh = &var_[ TAU_THRESH ][0];
+			double* adaptive = &var_[ THRESH_ADAPTIVE ][0];
+			for ( unsigned int i = 0; i < n; ++i ) {
+				if ( status[i] != INTEGRATING )
+					continue;
+				adaptive[i] += ( -adaptive[i] + a0[i] * ( vm[i] - em[i] ) )
+					* dt / tauThresh[i];
+			}
+			break;
+		}
+		case IZHIF_MODEL: {
+			const double* inject = &var_[ INJECT ][0];
+			const double* b0 = &var_[ B0 ][0];
+			const double* c0 = &var_[ C0 ][0];
+			const double* ia = &var_[ IZH_A ][0];
+			const double* ib = &var_[ IZH_B ][0];
+			double* u = &var_[ U ][0];
+			double* sumInject = &var_[ SUM_INJECT ][0];
+			double* im = &var_[ IM ][0];
+			double* lastIm = &var_[ LAST_IM ][0];
+			for ( unsigned int i = 0; i < n; ++i ) {
+				if ( status[i] != INTEGRATING )
+					continue;
+				vm[i] += ( ( inject[i] + sumInject[i] ) / cm[i] +
+					a0[i] * vm[i] * vm[i] + b0[i] * vm[i] + c0[i] - u[i] )
+					* dt;
+				u[i] += ia[i] * ( ib[i] * vm[i] - u[i] ) * dt;
+				lastIm[i] = im[i];
+				im[i] = 0.0;
+				sumInject[i] = 0.0;
+			}
+			return;
+		}
+		default:
+			return;
+	}
+	advanceCompartments( dt );
+}
+
+void IntFireSolver::advanceCompartments( double dt )
+{
+	const unsigned int n = numNeurons_;
+	const unsigned char* status = &status_[0];
+	double* vm = &var_[ VM ][0];
+	double* a = &var_[ A ][0];
+	double* b = &var_[ B ][0];
+	double* sumInject = &var_[ SUM_INJECT ][0];
+	double* im = &var_[ IM ][0];
+	double* lastIm = &var_[ LAST_IM ][0];
+	const double* inject = &var_[ INJECT ][0];
+	const double* em = &var_[ EM ][0];
+	const double* cm = &var_[ CM ][0];
+	const double* invRm = &var_[ INV_RM ][0];
+
+	for ( unsigned int i = 0; i < n; ++i ) {
+		if ( status[i] != INTEGRATING )
+			continue;
+		a[i] += inject[i] + sumInject[i] + em[i] * invRm[i];
+		if ( b[i] > EPSILON ) {
+			double x = exp( -b[i] * dt / cm[i] );
+			vm[i] = vm[i] * x + ( a[i] / b[i] ) * ( 1.0 - x );
+		} else {
+			vm[i] += ( a[i] - vm[i] * b[i] ) * dt / cm[i];
+		}
+		a[i] = 0.0;
+		b[i] = invRm[i];
+		lastIm[i] = im[i];
+		im[i] = 0.0;
+		sumInject[i] = 0.0;
+	}
+}
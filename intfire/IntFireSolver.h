@@ -0,0 +1,130 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _INT_FIRE_SOLVER_H
+#define _INT_FIRE_SOLVER_H
+
+namespace moose
+{
+
+/**
+ * Population solver for an array of integrate-and-fire neurons.
+ * On assigning the target, the solver takes over an Element array of
+ * one of the IntFire classes (LIF, QIF, ExIF, AdExIF, AdThreshIF or
+ * IzhIF), reads out the fields of all entries into one contiguous
+ * vector per variable, and zombifies the Element. From then on the
+ * neurons are advanced together by a single loop over these vectors,
+ * with threshold crossings collected into a list, and spikes go out
+ * into the message system only for the neurons that fired.
+ *
+ * Messages to and fields of the neurons keep working through the
+ * Zombie classes, which forward to the vectors here, much as
+ * ZombieCompartment does for the HSolve. Assigning an empty target
+ * writes the state back and restores the original class.
+ *
+ * Limitations: the Element must be entirely on this node, and the
+ * axial and raxial messages between compartments are not sent.
+ */
+class IntFireSolver
+{
+	public:
+		IntFireSolver();
+		~IntFireSolver();
+		IntFireSolver( const IntFireSolver& other );
+		IntFireSolver& operator=( const IntFireSolver& other );
+
+		/// The kinds of neuron that can be solved.
+		enum Model {
+			LIF_MODEL, QIF_MODEL, EXIF_MODEL, ADEXIF_MODEL,
+			ADTHRESHIF_MODEL, IZHIF_MODEL, NUM_MODELS
+		};
+
+		/**
+		 * The variables of the neurons. Each one is stored as a
+		 * vector over all neurons, whether or not the model uses it.
+		 */
+		enum Var {
+			VM, INIT_VM, EM, CM, RM, INV_RM, RA, INJECT, SUM_INJECT,
+			A, B, IM, LAST_IM,
+			THRESH, V_RESET, REFRACT_T, LAST_EVENT, ACTIVATION,
+			A0, B0, C0, V_CRITICAL, DELTA_THRESH, V_PEAK,
+			W, TAU_W, THRESH_ADAPTIVE, TAU_THRESH, THRESH_JUMP,
+			IZH_A, IZH_B, IZH_D, U, U_INIT,
+			NUM_VARS
+		};
+
+		////////////////////////////////////////////////////////////////
+		// Field assignment stuff.
+		////////////////////////////////////////////////////////////////
+		void setTarget( const Eref& e, Id target );
+		Id getTarget( const Eref& e ) const;
+		unsigned int getNumNeurons() const;
+		string getModel() const;
+		double getNumSpikes() const;
+
+		////////////////////////////////////////////////////////////////
+		// Dest Finfos
+		////////////////////////////////////////////////////////////////
+		void process( const Eref& e, ProcPtr p );
+		void reinit( const Eref& e, ProcPtr p );
+
+		////////////////////////////////////////////////////////////////
+		// Access from the zombies.
+		////////////////////////////////////////////////////////////////
+		double getVar( Var v, unsigned int i ) const
+		{
+			return var_[v][i];
+		}
+		void setVar( Var v, unsigned int i, double value )
+		{
+			var_[v][i] = value;
+		}
+		void addToVar( Var v, unsigned int i, double value )
+		{
+			var_[v][i] += value;
+		}
+		bool hasFired( unsigned int i ) const;
+		double getDt() const;
+
+		static const Cinfo* initCinfo();
+	private:
+		/// Takes over the target Element. Returns false on failure.
+		bool zombify( Id target );
+		/// Writes back the state and restores the original class.
+		void unzombify();
+
+		/// Handles refractory neurons, activation and threshold.
+		void advanceSpikes( double t, double dt );
+		/// Advances the neurons that neither fired nor are refractory.
+		void advanceSubthreshold( double dt );
+		/// Passive membrane update of Compartment::vProcess.
+		void advanceCompartments( double dt );
+
+		Id target_;
+		Model model_;
+		unsigned int numNeurons_;
+
+		/// var_[ Var ][ neuron ]
+		vector< vector< double > > var_;
+
+		enum Status { INTEGRATING, REFRACTORY, FIRED };
+		/// Status of each neuron on the last step.
+		vector< unsigned char > status_;
+		/// Neurons that fired on the last step.
+		vector< unsigned int > firedList_;
+		/// Neurons with targets for their VmOut messages.
+		vector< unsigned int > vmOutList_;
+
+		double dt_;
+		double numSpikes_;
+};
+
+} // namespace moose
+
+#endif // _INT_FIRE_SOLVER_H
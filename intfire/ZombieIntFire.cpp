@@ -0,0 +1,576 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include "../basecode/header.h"
+#include "../basecode/ElementValueFinfo.h"
+#include "../randnum/randnum.h"
+#include "../biophysics/CompartmentBase.h"
+#include "../biophysics/Compartment.h"
+#include "IntFireBase.h"
+#include "IntFireSolver.h"
+#include "ZombieIntFire.h"
+
+using namespace moose;
+
+typedef IntFireSolver S;
+
+/**
+ * The Finfo arrays of the zombie Cinfos must register their Finfos in
+ * the same order and with the same kinds (ElementValue, ReadOnly,
+ * Dest, Src) as the original classes, so that the FuncIds and
+ * BindIndices line up.
+ */
+const Cinfo* ZombieIntFire::initCinfo()
+{
+    static ElementValueFinfo< ZombieIntFire, double > thresh(
+        "thresh",
+        "firing threshold",
+        &ZombieIntFire::setVar< S::THRESH >,
+        &ZombieIntFire::getVar< S::THRESH >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > vReset(
+        "vReset",
+        "voltage is set to vReset after firing",
+        &ZombieIntFire::setVar< S::V_RESET >,
+        &ZombieIntFire::getVar< S::V_RESET >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > refractoryPeriod(
+        "refractoryPeriod",
+        "Minimum time between successive spikes",
+        &ZombieIntFire::setVar< S::REFRACT_T >,
+        &ZombieIntFire::getVar< S::REFRACT_T >
+    );
+    static ReadOnlyElementValueFinfo< ZombieIntFire, bool > hasFired(
+        "hasFired",
+        "The object has fired within the last timestep",
+        &ZombieIntFire::hasFired
+    );
+    static ReadOnlyElementValueFinfo< ZombieIntFire, double > lastEventTime(
+        "lastEventTime",
+        "Timestamp of last firing.",
+        &ZombieIntFire::getVar< S::LAST_EVENT >
+    );
+    static DestFinfo activation(
+        "activation",
+        "Handles value of synaptic activation arriving on this object",
+        new OpFunc1< ZombieIntFire, double >( &ZombieIntFire::activation ));
+
+    static Finfo* zombieIntFireFinfos[] =
+    {
+        &thresh,				// Value
+        &vReset,				// Value
+        &refractoryPeriod,		// Value
+        &hasFired,				// ReadOnlyValue
+        &lastEventTime,			// ReadOnlyValue
+        &activation,			// DestFinfo
+        IntFireBase::spikeOut() // MsgSrc
+    };
+
+    static string doc[] =
+    {
+        "Name", "ZombieIntFireBase",
+        "Author", "Upi Bhalla",
+        "Description", "Base class for the zombies of integrate-and-fire "
+        "neurons taken over by an IntFireSolver.",
+    };
+    static ZeroSizeDinfo< int > dinfo;
+    static Cinfo zombieIntFireCinfo(
+        "ZombieIntFireBase",
+        CompartmentBase::initCinfo(),
+        zombieIntFireFinfos,
+        sizeof( zombieIntFireFinfos ) / sizeof (Finfo*),
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+
+    return &zombieIntFireCinfo;
+}
+
+const Cinfo* ZombieIntFire::initLIFCinfo()
+{
+    static string doc[] =
+    {
+        "Name", "ZombieLIF",
+        "Author", "Upi Bhalla",
+        "Description", "Zombie of the LIF, taken over by an IntFireSolver."
+    };
+    static Dinfo< ZombieIntFire > dinfo;
+    static Cinfo zombieLIFCinfo(
+        "ZombieLIF",
+        ZombieIntFire::initCinfo(),
+        0, 0,
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+    return &zombieLIFCinfo;
+}
+
+const Cinfo* ZombieIntFire::initQIFCinfo()
+{
+    static string doc[] =
+    {
+        "Name", "ZombieQIF",
+        "Author", "Upi Bhalla",
+        "Description", "Zombie of the QIF, taken over by an IntFireSolver."
+    };
+    static ElementValueFinfo< ZombieIntFire, double > vCritical(
+        "vCritical",
+        "Critical voltage for spike initiation",
+        &ZombieIntFire::setVar< S::V_CRITICAL >,
+        &ZombieIntFire::getVar< S::V_CRITICAL >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > a0(
+        "a0",
+        "Parameter in Rm*Cm dVm/dt = a0*(Vm-Em)*(Vm-vCritical) + Rm*I, a0>0",
+        &ZombieIntFire::setVar< S::A0 >,
+        &ZombieIntFire::getVar< S::A0 >
+    );
+    static Finfo* zombieQIFFinfos[] = {
+        &vCritical,     // Value
+        &a0             // Value
+    };
+    static Dinfo< ZombieIntFire > dinfo;
+    static Cinfo zombieQIFCinfo(
+        "ZombieQIF",
+        ZombieIntFire::initCinfo(),
+        zombieQIFFinfos,
+        sizeof( zombieQIFFinfos ) / sizeof (Finfo*),
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+    return &zombieQIFCinfo;
+}
+
+const Cinfo* ZombieIntFire::initExIFCinfo()
+{
+    static string doc[] =
+    {
+        "Name", "ZombieExIF",
+        "Author", "Upi Bhalla",
+        "Description", "Zombie of the ExIF, taken over by an IntFireSolver."
+    };
+    static ElementValueFinfo< ZombieIntFire, double > deltaThresh(
+        "deltaThresh",
+        "Parameter in Vm eqn to control approach to threshold",
+        &ZombieIntFire::setVar< S::DELTA_THRESH >,
+        &ZombieIntFire::getVar< S::DELTA_THRESH >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > vPeak(
+        "vPeak",
+        "Vm is reset on reaching vPeak, different from spike thresh below",
+        &ZombieIntFire::setVar< S::V_PEAK >,
+        &ZombieIntFire::getVar< S::V_PEAK >
+    );
+    static Finfo* zombieExIFFinfos[] = {
+        &deltaThresh,   // Value
+        &vPeak,         // Value
+    };
+    static Dinfo< ZombieIntFire > dinfo;
+    static Cinfo zombieExIFCinfo(
+        "ZombieExIF",
+        ZombieIntFire::initCinfo(),
+        zombieExIFFinfos,
+        sizeof( zombieExIFFinfos ) / sizeof (Finfo*),
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+    return &zombieExIFCinfo;
+}
+
+const Cinfo* ZombieIntFire::initAdExIFCinfo()
+{
+    static string doc[] =
+    {
+        "Name", "ZombieAdExIF",
+        "Author", "Upi Bhalla",
+        "Description", "Zombie of the AdExIF, taken over by an IntFireSolver."
+    };
+    static ElementValueFinfo< ZombieIntFire, double > w(
+        "w",
+        "adaptation current with time constant tauW",
+        &ZombieIntFire::setVar< S::W >,
+        &ZombieIntFire::getVar< S::W >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > tauW(
+        "tauW",
+        "time constant of adaptation current w",
+        &ZombieIntFire::setVar< S::TAU_W >,
+        &ZombieIntFire::getVar< S::TAU_W >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > a0(
+        "a0",
+        "factor for voltage-dependent term in evolution of adaptation "
+        "current: tau_w dw/dt = a0*(Vm-Em) - w",
+        &ZombieIntFire::setVar< S::A0 >,
+        &ZombieIntFire::getVar< S::A0 >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > b0(
+        "b0",
+        "b0 is added to w, the adaptation current on each spike",
+        &ZombieIntFire::setVar< S::B0 >,
+        &ZombieIntFire::getVar< S::B0 >
+    );
+    static Finfo* zombieAdExIFFinfos[] = {
+        &w,             // Value
+        &tauW,          // Value
+        &a0,            // Value
+        &b0,            // Value
+    };
+    static Dinfo< ZombieIntFire > dinfo;
+    static Cinfo zombieAdExIFCinfo(
+        "ZombieAdExIF",
+        ZombieIntFire::initExIFCinfo(),
+        zombieAdExIFFinfos,
+        sizeof( zombieAdExIFFinfos ) / sizeof (Finfo*),
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+    return &zombieAdExIFCinfo;
+}
+
+const Cinfo* ZombieIntFire::initAdThreshIFCinfo()
+{
+    static string doc[] =
+    {
+        "Name", "ZombieAdThreshIF",
+        "Author", "Upi Bhalla",
+        "Description", "Zombie of the AdThreshIF, taken over by an "
+        "IntFireSolver."
+    };
+    static ElementValueFinfo< ZombieIntFire, double > threshAdaptive(
+        "threshAdaptive",
+        "adaptative part of the threshold that decays with time "
+        "constant tauThresh",
+        &ZombieIntFire::setVar< S::THRESH_ADAPTIVE >,
+        &ZombieIntFire::getVar< S::THRESH_ADAPTIVE >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > tauThresh(
+        "tauThresh",
+        "time constant of adaptative part of the threshold",
+        &ZombieIntFire::setVar< S::TAU_THRESH >,
+        &ZombieIntFire::getVar< S::TAU_THRESH >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > a0(
+        "a0",
+        "factor for voltage-dependent term in evolution of adaptative "
+        "threshold: tauThresh * d threshAdaptive / dt = "
+        "a0*(Vm-Em) - threshAdaptive ",
+        &ZombieIntFire::setVar< S::A0 >,
+        &ZombieIntFire::getVar< S::A0 >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > threshJump(
+        "threshJump",
+        "threshJump is added to threshAdaptive on each spike",
+        &ZombieIntFire::setVar< S::THRESH_JUMP >,
+        &ZombieIntFire::getVar< S::THRESH_JUMP >
+    );
+    static Finfo* zombieAdThreshIFFinfos[] = {
+        &threshAdaptive,    // Value
+        &tauThresh,         // Value
+        &a0,                // Value
+        &threshJump         // Value
+    };
+    static Dinfo< ZombieIntFire > dinfo;
+    static Cinfo zombieAdThreshIFCinfo(
+        "ZombieAdThreshIF",
+        ZombieIntFire::initCinfo(),
+        zombieAdThreshIFFinfos,
+        sizeof( zombieAdThreshIFFinfos ) / sizeof (Finfo*),
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+    return &zombieAdThreshIFCinfo;
+}
+
+const Cinfo* ZombieIntFire::initIzhIFCinfo()
+{
+    static string doc[] =
+    {
+        "Name", "ZombieIzhIF",
+        "Author", "Upi Bhalla",
+        "Description", "Zombie of the IzhIF, taken over by an IntFireSolver."
+    };
+    static ElementValueFinfo< ZombieIntFire, double > a0(
+        "a0",
+        "factor for Vm^2 term in evolution equation for Vm: "
+        "dVm/dt = a0*Vm^2 + b0*Vm + c0 - u + I/Cm ",
+        &ZombieIntFire::setVar< S::A0 >,
+        &ZombieIntFire::getVar< S::A0 >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > b0(
+        "b0",
+        "factor for Vm term in evolution equation for Vm: "
+        "dVm/dt = a0*Vm^2 + b0*Vm + c0 - u + I/Cm ",
+        &ZombieIntFire::setVar< S::B0 >,
+        &ZombieIntFire::getVar< S::B0 >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > c0(
+        "c0",
+        "constant term in evolution equation for Vm: "
+        "dVm/dt = a0*Vm^2 + b0*Vm + c0 - u + I/Cm ",
+        &ZombieIntFire::setVar< S::C0 >,
+        &ZombieIntFire::getVar< S::C0 >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > a(
+        "a",
+        "a as in d/dt u = a*(b*Vm-u) ",
+        &ZombieIntFire::setVar< S::IZH_A >,
+        &ZombieIntFire::getVar< S::IZH_A >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > b(
+        "b",
+        "b as in d/dt u = a*(b*Vm-u) ",
+        &ZombieIntFire::setVar< S::IZH_B >,
+        &ZombieIntFire::getVar< S::IZH_B >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > d(
+        "d",
+        "u jumps by d every time neuron spikes",
+        &ZombieIntFire::setVar< S::IZH_D >,
+        &ZombieIntFire::getVar< S::IZH_D >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > u(
+        "u",
+        "u is an adaptation variable",
+        &ZombieIntFire::setVar< S::U >,
+        &ZombieIntFire::getVar< S::U >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > uInit(
+        "uInit",
+        "Initial value of u. It is reset at reinit()",
+        &ZombieIntFire::setVar< S::U_INIT >,
+        &ZombieIntFire::getVar< S::U_INIT >
+    );
+    static ElementValueFinfo< ZombieIntFire, double > vPeak(
+        "vPeak",
+        "Vm is reset when Vm > vPeak",
+        &ZombieIntFire::setVar< S::V_PEAK >,
+        &ZombieIntFire::getVar< S::V_PEAK >
+    );
+    static Finfo* zombieIzhIFFinfos[] = {
+        &a0,            // Value
+        &b0,            // Value
+        &c0,            // Value
+        &a,             // Value
+        &b,             // Value
+        &d,             // Value
+        &u,             // Value
+        &uInit,         // Value
+        &vPeak,         // Value
+    };
+    static Dinfo< ZombieIntFire > dinfo;
+    static Cinfo zombieIzhIFCinfo(
+        "ZombieIzhIF",
+        ZombieIntFire::initCinfo(),
+        zombieIzhIFFinfos,
+        sizeof( zombieIzhIFFinfos ) / sizeof (Finfo*),
+        &dinfo,
+        doc,
+        sizeof(doc)/sizeof(string)
+    );
+    return &zombieIzhIFCinfo;
+}
+
+static const Cinfo* zombieIntFireCinfo = ZombieIntFire::initCinfo();
+static const Cinfo* zombieLIFCinfo = ZombieIntFire::initLIFCinfo();
+static const Cinfo* zombieQIFCinfo = ZombieIntFire::initQIFCinfo();
+static const Cinfo* zombieExIFCinfo = ZombieIntFire::initExIFCinfo();
+static const Cinfo* zombieAdExIFCinfo = ZombieIntFire::initAdExIFCinfo();
+static const Cinfo* zombieAdThreshIFCinfo =
+	ZombieIntFire::initAdThreshIFCinfo();
+static const Cinfo* zombieIzhIFCinfo = ZombieIntFire::initIzhIFCinfo();
+
+const Cinfo* ZombieIntFire::zombieCinfo( IntFireSolver::Model m )
+{
+    switch ( m ) {
+        case IntFireSolver::LIF_MODEL:
+            return initLIFCinfo();
+        case IntFireSolver::QIF_MODEL:
+            return initQIFCinfo();
+        case IntFireSolver::EXIF_MODEL:
+            return initExIFCinfo();
+        case IntFireSolver::ADEXIF_MODEL:
+            return initAdExIFCinfo();
+        case IntFireSolver::ADTHRESHIF_MODEL:
+            return initAdThreshIFCinfo();
+        case IntFireSolver::IZHIF_MODEL:
+            return initIzhIFCinfo();
+        default:
+            return 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Here we put the ZombieIntFire class functions.
+//////////////////////////////////////////////////////////////////
+
+ZombieIntFire::ZombieIntFire()
+    : solver_( 0 ), index_( 0 )
+{;}
+
+ZombieIntFire::~ZombieIntFire()
+{;}
+
+void ZombieIntFire::setSolver( IntFireSolver* solver, unsigned int index )
+{
+    solver_ = solver;
+    index_ = index;
+}
+
+//////////////////////////////////////////////////////////////////
+// Field access
+//////////////////////////////////////////////////////////////////
+
+void ZombieIntFire::vSetVm( const Eref& e, double Vm )
+{
+    solver_->setVar( S::VM, index_, Vm );
+}
+
+double ZombieIntFire::vGetVm( const Eref& e ) const
+{
+    return solver_->getVar( S::VM, index_ );
+}
+
+void ZombieIntFire::vSetEm( const Eref& e, double Em )
+{
+    solver_->setVar( S::EM, index_, Em );
+}
+
+double ZombieIntFire::vGetEm( const Eref& e ) const
+{
+    return solver_->getVar( S::EM, index_ );
+}
+
+void ZombieIntFire::vSetCm( const Eref& e, double Cm )
+{
+    if ( rangeWarning( "Cm", Cm ) ) return;
+    solver_->setVar( S::CM, index_, Cm );
+}
+
+double ZombieIntFire::vGetCm( const Eref& e ) const
+{
+    return solver_->getVar( S::CM, index_ );
+}
+
+void ZombieIntFire::vSetRm( const Eref& e, double Rm )
+{
+    if ( rangeWarning( "Rm", Rm ) ) return;
+    solver_->setVar( S::RM, index_, Rm );
+    solver_->setVar( S::INV_RM, index_, 1.0 / Rm );
+}
+
+double ZombieIntFire::vGetRm( const Eref& e ) const
+{
+    return solver_->getVar( S::RM, index_ );
+}
+
+void ZombieIntFire::vSetRa( const Eref& e, double Ra )
+{
+    if ( rangeWarning( "Ra", Ra ) ) return;
+    solver_->setVar( S::RA, index_, Ra );
+}
+
+double ZombieIntFire::vGetRa( const Eref& e ) const
+{
+    return solver_->getVar( S::RA, index_ );
+}
+
+double ZombieIntFire::vGetIm( const Eref& e ) const
+{
+    return solver_->getVar( S::LAST_IM, index_ );
+}
+
+void ZombieIntFire::vSetInject( const Eref& e, double inject )
+{
+    solver_->setVar( S::INJECT, index_, inject );
+}
+
+double ZombieIntFire::vGetInject( const Eref& e ) const
+{
+    return solver_->getVar( S::INJECT, index_ );
+}
+
+void ZombieIntFire::vSetInitVm( const Eref& e, double initVm )
+{
+    solver_->setVar( S::INIT_VM, index_, initVm );
+}
+
+double ZombieIntFire::vGetInitVm( const Eref& e ) const
+{
+    return solver_->getVar( S::INIT_VM, index_ );
+}
+
+bool ZombieIntFire::hasFired( const Eref& e ) const
+{
+    return solver_->hasFired( index_ );
+}
+
+//////////////////////////////////////////////////////////////////
+// Dest functions
+//////////////////////////////////////////////////////////////////
+
+void ZombieIntFire::vProcess( const Eref& e, ProcPtr p )
+{;}
+
+void ZombieIntFire::vReinit( const Eref& e, ProcPtr p )
+{;}
+
+void ZombieIntFire::vInitProc( const Eref& e, ProcPtr p )
+{;}
+
+void ZombieIntFire::vInitReinit( const Eref& e, ProcPtr p )
+{;}
+
+void ZombieIntFire::vHandleChannel( const Eref& e, double Gk, double Ek )
+{
+    solver_->addToVar( S::A, index_, Gk * Ek );
+    solver_->addToVar( S::B, index_, Gk );
+}
+
+void ZombieIntFire::vHandleRaxial( double Ra, double Vm )
+{
+    solver_->addToVar( S::A, index_, Vm / Ra );
+    solver_->addToVar( S::B, index_, 1.0 / Ra );
+    solver_->addToVar( S::IM, index_,
+        ( Vm - solver_->getVar( S::VM, index_ ) ) / Ra );
+}
+
+void ZombieIntFire::vHandleAxial( double Vm )
+{
+    double Ra = solver_->getVar( S::RA, index_ );
+    solver_->addToVar( S::A, index_, Vm / Ra );
+    solver_->addToVar( S::B, index_, 1.0 / Ra );
+    solver_->addToVar( S::IM, index_,
+        ( Vm - solver_->getVar( S::VM, index_ ) ) / Ra );
+}
+
+void ZombieIntFire::vInjectMsg( const Eref& e, double current )
+{
+    solver_->addToVar( S::SUM_INJECT, index_, current );
+    solver_->addToVar( S::IM, index_, current );
+}
+
+void ZombieIntFire::vRandInject( const Eref& e, double prob, double current )
+{
+    if ( moose::mtrand() < prob * solver_->getDt() ) {
+        solver_->addToVar( S::SUM_INJECT, index_, current );
+        solver_->addToVar( S::IM, index_, current );
+    }
+}
+
+void ZombieIntFire::activation( double val )
+{
+    solver_->addToVar( S::ACTIVATION, index_, val );
+}
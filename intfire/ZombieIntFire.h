@@ -0,0 +1,101 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _ZOMBIE_INT_FIRE_H
+#define _ZOMBIE_INT_FIRE_H
+
+namespace moose
+{
+
+/**
+ * Zombie for the neurons of an array taken over by an IntFireSolver.
+ * All its fields and message handlers forward to the state vectors of
+ * the solver. One C++ class serves all six IntFire classes; each of
+ * them has its own zombie Cinfo (ZombieLIF, ZombieQIF and so on),
+ * which lays out its Finfos in the same order as the original class so
+ * that existing messages keep their FuncIds and BindIndices across
+ * the zombie swap.
+ */
+class ZombieIntFire: public CompartmentBase
+{
+	public:
+		ZombieIntFire();
+		virtual ~ZombieIntFire();
+
+		////////////////////////////////////////////////////////////////
+		// CompartmentBase fields.
+		////////////////////////////////////////////////////////////////
+		void vSetVm( const Eref& e, double Vm );
+		double vGetVm( const Eref& e ) const;
+		void vSetEm( const Eref& e, double Em );
+		double vGetEm( const Eref& e ) const;
+		void vSetCm( const Eref& e, double Cm );
+		double vGetCm( const Eref& e ) const;
+		void vSetRm( const Eref& e, double Rm );
+		double vGetRm( const Eref& e ) const;
+		void vSetRa( const Eref& e, double Ra );
+		double vGetRa( const Eref& e ) const;
+		double vGetIm( const Eref& e ) const;
+		void vSetInject( const Eref& e, double Inject );
+		double vGetInject( const Eref& e ) const;
+		void vSetInitVm( const Eref& e, double initVm );
+		double vGetInitVm( const Eref& e ) const;
+
+		////////////////////////////////////////////////////////////////
+		// CompartmentBase Dest functions. Process and reinit do
+		// nothing, as the solver does the work.
+		////////////////////////////////////////////////////////////////
+		void vProcess( const Eref& e, ProcPtr p );
+		void vReinit( const Eref& e, ProcPtr p );
+		void vInitProc( const Eref& e, ProcPtr p );
+		void vInitReinit( const Eref& e, ProcPtr p );
+		void vHandleChannel( const Eref& e, double Gk, double Ek );
+		void vHandleRaxial( double Ra, double Vm );
+		void vHandleAxial( double Vm );
+		void vInjectMsg( const Eref& e, double current );
+		void vRandInject( const Eref& e, double prob, double current );
+
+		/// Assigns the solver and the index of this neuron on it.
+		void setSolver( IntFireSolver* solver, unsigned int index );
+
+		////////////////////////////////////////////////////////////////
+		// IntFireBase and model fields, all held by the solver.
+		////////////////////////////////////////////////////////////////
+		template< IntFireSolver::Var V >
+			void setVar( const Eref& e, double val )
+		{
+			solver_->setVar( V, index_, val );
+		}
+		template< IntFireSolver::Var V >
+			double getVar( const Eref& e ) const
+		{
+			return solver_->getVar( V, index_ );
+		}
+		bool hasFired( const Eref& e ) const;
+		void activation( double val );
+
+		/// Base Cinfo, mirroring IntFireBase.
+		static const Cinfo* initCinfo();
+		/// Zombie Cinfo for each IntFireSolver::Model.
+		static const Cinfo* zombieCinfo( IntFireSolver::Model m );
+
+		static const Cinfo* initLIFCinfo();
+		static const Cinfo* initQIFCinfo();
+		static const Cinfo* initExIFCinfo();
+		static const Cinfo* initAdExIFCinfo();
+		static const Cinfo* initAdThreshIFCinfo();
+		static const Cinfo* initIzhIFCinfo();
+	private:
+		IntFireSolver* solver_;
+		unsigned int index_;
+};
+
+} // namespace moose
+
+#endif // _ZOMBIE_INT_FIRE_H
@@ -0,0 +1,646 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment,
+** also known as GENESIS 3 base code.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+/**
+ * The expression is read by a small recursive descent parser which
+ * builds the rational form directly, so there is no syntax tree:
+ *
+ *   expr    := term ( ('+'|'-') term )*
+ *   term    := unary ( ('*'|'/') unary )*
+ *   unary   := ('-'|'+') unary | power
+ *   power   := primary ( '^' unary )?
+ *   primary := number | x<n> | t | '(' expr ')' | pow( expr, expr )
+ *
+ * Powers must have a constant exponent. Anything the parser does not
+ * know makes the build fail, and the caller falls back to exprtk.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include "FuncKernel.h"
+
+namespace
+{
+
+typedef FuncKernel::Factor Factor;
+typedef FuncKernel::Term Term;
+typedef FuncKernel::Poly Poly;
+
+// Beyond this many terms the native form is no faster than exprtk.
+const size_t maxTerms = 64;
+
+bool lessFactors( const vector< Factor >& a, const vector< Factor >& b )
+{
+    size_t n = min( a.size(), b.size() );
+    for ( size_t i = 0; i < n; ++i )
+    {
+        if ( a[i].arg != b[i].arg )
+            return a[i].arg < b[i].arg;
+        if ( a[i].power != b[i].power )
+            return a[i].power < b[i].power;
+    }
+    return a.size() < b.size();
+}
+
+bool sameFactors( const vector< Factor >& a, const vector< Factor >& b )
+{
+    if ( a.size() != b.size() )
+        return false;
+    for ( size_t i = 0; i < a.size(); ++i )
+        if ( a[i].arg != b[i].arg || a[i].power != b[i].power )
+            return false;
+    return true;
+}
+
+bool isWhole( double e )
+{
+    return e == floor( e );
+}
+
+/**
+ * Merges repeated args in a term and drops zero powers. Only whole
+ * powers are merged: x^0.5 * x^0.5 is NaN for negative x, not x.
+ */
+void normalizeTerm( Term& t )
+{
+    sort( t.factors.begin(), t.factors.end(),
+          []( const Factor& a, const Factor& b ) {
+              return a.arg < b.arg || ( a.arg == b.arg && a.power < b.power );
+          } );
+    vector< Factor > f;
+    for ( const Factor& i : t.factors )
+    {
+        if ( !f.empty() && f.back().arg == i.arg &&
+                isWhole( f.back().power ) && isWhole( i.power ) )
+            f.back().power += i.power;
+        else
+            f.push_back( i );
+    }
+    t.factors.clear();
+    for ( const Factor& i : f )
+        if ( i.power != 0.0 )
+            t.factors.push_back( i );
+}
+
+/// Sorts the terms, adds up like terms and drops zero ones.
+void normalize( Poly& p )
+{
+    for ( Term& t : p )
+        normalizeTerm( t );
+    sort( p.begin(), p.end(), []( const Term& a, const Term& b ) {
+        return lessFactors( a.factors, b.factors );
+    } );
+    Poly ret;
+    for ( const Term& t : p )
+    {
+        if ( !ret.empty() && sameFactors( ret.back().factors, t.factors ) )
+            ret.back().coeff += t.coeff;
+        else
+            ret.push_back( t );
+    }
+    p.clear();
+    for ( const Term& t : ret )
+        if ( t.coeff != 0.0 )
+            p.push_back( t );
+}
+
+bool samePoly( const Poly& a, const Poly& b )
+{
+    if ( a.size() != b.size() )
+        return false;
+    for ( size_t i = 0; i < a.size(); ++i )
+        if ( a[i].coeff != b[i].coeff ||
+                !sameFactors( a[i].factors, b[i].factors ) )
+            return false;
+    return true;
+}
+
+Poly constPoly( double c )
+{
+    Poly p;
+    if ( c != 0.0 )
+        p.push_back( Term{ c, vector< Factor >() } );
+    return p;
+}
+
+bool isConst( const Poly& p )
+{
+    return p.empty() || ( p.size() == 1 && p[0].factors.empty() );
+}
+
+double constValue( const Poly& p )
+{
+    return p.empty() ? 0.0 : p[0].coeff;
+}
+
+Poly add( const Poly& a, const Poly& b )
+{
+    Poly p( a );
+    p.insert( p.end(), b.begin(), b.end() );
+    normalize( p );
+    return p;
+}
+
+Poly mul( const Poly& a, const Poly& b )
+{
+    Poly p;
+    p.reserve( a.size() * b.size() );
+    for ( const Term& i : a )
+        for ( const Term& j : b )
+        {
+            Term t{ i.coeff * j.coeff, i.factors };
+            t.factors.insert( t.factors.end(),
+                              j.factors.begin(), j.factors.end() );
+            p.push_back( t );
+        }
+    normalize( p );
+    return p;
+}
+
+/// A rational function num/den.
+struct Frac
+{
+    Poly num;
+    Poly den;
+    bool tooBig() const
+    {
+        return num.size() > maxTerms || den.size() > maxTerms;
+    }
+};
+
+Frac constFrac( double c )
+{
+    return Frac{ constPoly( c ), constPoly( 1.0 ) };
+}
+
+Frac fracAdd( const Frac& a, const Frac& b )
+{
+    if ( samePoly( a.den, b.den ) )
+        return Frac{ add( a.num, b.num ), a.den };
+    return Frac{ add( mul( a.num, b.den ), mul( b.num, a.den ) ),
+                 mul( a.den, b.den ) };
+}
+
+Frac fracNeg( const Frac& a )
+{
+    Frac f( a );
+    for ( Term& t : f.num )
+        t.coeff = -t.coeff;
+    return f;
+}
+
+Frac fracMul( const Frac& a, const Frac& b )
+{
+    return Frac{ mul( a.num, b.num ), mul( a.den, b.den ) };
+}
+
+Frac fracDiv( const Frac& a, const Frac& b )
+{
+    return Frac{ mul( a.num, b.den ), mul( a.den, b.num ) };
+}
+
+/**
+ * Raises a single term to a real power. Fails unless the result is
+ * x^(a*e) for all x, including negative ones: (x^2)^0.5 is |x|, not x,
+ * and (x*y)^0.5 is real when x and y are both negative.
+ */
+bool termPow( const Poly& p, double e, Poly& ret )
+{
+    if ( p.empty() )
+        return false; // 0^e: leave the corner cases to exprtk.
+    Term t = p[0];
+    if ( isWhole( e ) )
+    {
+        for ( const Factor& f : t.factors )
+            if ( !isWhole( f.power ) )
+                return false;
+    }
+    else if ( t.coeff < 0.0 || t.factors.size() > 1 ||
+              ( t.factors.size() == 1 && t.factors[0].power != 1.0 ) )
+        return false;
+    t.coeff = pow( t.coeff, e );
+    for ( Factor& f : t.factors )
+        f.power *= e;
+    ret = Poly( 1, t );
+    normalize( ret );
+    return true;
+}
+
+bool fracPow( const Frac& a, double e, Frac& ret )
+{
+    // (x/y)^0.5 is also real when x and y are both negative.
+    if ( a.num.size() <= 1 && a.den.size() == 1 &&
+            ( isWhole( e ) || isConst( a.den ) ) )
+    {
+        Frac f;
+        if ( termPow( a.num, e, f.num ) && termPow( a.den, e, f.den ) )
+        {
+            ret = f;
+            return true;
+        }
+    }
+    if ( !isWhole( e ) || fabs( e ) > 4 )
+        return false;
+    Frac f = constFrac( 1.0 );
+    for ( int i = 0; i < fabs( e ); ++i )
+        f = fracMul( f, a );
+    if ( e < 0 )
+        swap( f.num, f.den );
+    ret = f;
+    return true;
+}
+
+class Parser
+{
+public:
+    Parser( const string& s, unsigned int numArgs ):
+        s_( s ), pos_( 0 ), numArgs_( numArgs )
+    {;}
+
+    bool parse( Frac& f )
+    {
+        return expr( f ) && atEnd();
+    }
+
+private:
+    void skip()
+    {
+        while ( pos_ < s_.size() && isspace( s_[pos_] ) )
+            ++pos_;
+    }
+
+    bool atEnd()
+    {
+        skip();
+        return pos_ == s_.size();
+    }
+
+    bool accept( char c )
+    {
+        skip();
+        if ( pos_ < s_.size() && s_[pos_] == c )
+        {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool expr( Frac& f )
+    {
+        if ( !term( f ) )
+            return false;
+        while ( true )
+        {
+            bool minus = false;
+            if ( !accept( '+' ) )
+            {
+                if ( !accept( '-' ) )
+                    return true;
+                minus = true;
+            }
+            Frac g;
+            if ( !term( g ) )
+                return false;
+            f = fracAdd( f, minus ? fracNeg( g ) : g );
+            if ( f.tooBig() )
+                return false;
+        }
+    }
+
+    bool term( Frac& f )
+    {
+        if ( !unary( f ) )
+            return false;
+        while ( true )
+        {
+            bool divide = false;
+            if ( !accept( '*' ) )
+            {
+                if ( !accept( '/' ) )
+                    return true;
+                divide = true;
+            }
+            Frac g;
+            if ( !unary( g ) )
+                return false;
+            f = divide ? fracDiv( f, g ) : fracMul( f, g );
+            if ( f.tooBig() )
+                return false;
+        }
+    }
+
+    bool unary( Frac& f )
+    {
+        if ( accept( '-' ) )
+        {
+            if ( !unary( f ) )
+                return false;
+            f = fracNeg( f );
+            return true;
+        }
+        if ( accept( '+' ) )
+            return unary( f );
+        return power( f );
+    }
+
+    bool power( Frac& f )
+    {
+        if ( !primary( f ) )
+            return false;
+        if ( !accept( '^' ) )
+            return true;
+        Frac e;
+        // Right associative, as in exprtk.
+        return unary( e ) && raise( f, e );
+    }
+
+    bool raise( Frac& f, const Frac& e )
+    {
+        if ( !isConst( e.num ) || !isConst( e.den ) || e.den.empty() )
+            return false;
+        return fracPow( f, constValue( e.num ) / constValue( e.den ), f ) &&
+               !f.tooBig();
+    }
+
+    bool primary( Frac& f )
+    {
+        skip();
+        if ( pos_ >= s_.size() )
+            return false;
+        char c = s_[pos_];
+        if ( isdigit( c ) || c == '.' )
+            return number( f );
+        if ( accept( '(' ) )
+            return expr( f ) && accept( ')' );
+        if ( !isalpha( c ) )
+            return false;
+
+        size_t start = pos_;
+        while ( pos_ < s_.size() &&
+                ( isalnum( s_[pos_] ) || s_[pos_] == '_' ) )
+            ++pos_;
+        string name = s_.substr( start, pos_ - start );
+        if ( name == "t" )
+        {
+            f = variable( numArgs_ );
+            return true;
+        }
+        if ( name == "pow" )
+        {
+            Frac e;
+            return accept( '(' ) && expr( f ) && accept( ',' ) &&
+                   expr( e ) && accept( ')' ) && raise( f, e );
+        }
+        if ( name.size() < 2 || name[0] != 'x' ||
+                name.find_first_not_of( "0123456789", 1 ) != string::npos )
+            return false;
+        unsigned long i = strtoul( name.c_str() + 1, 0, 10 );
+        if ( i >= numArgs_ )
+            return false;
+        f = variable( i );
+        return true;
+    }
+
+    bool number( Frac& f )
+    {
+        // strtod would also take hex and inf, which exprtk does not.
+        size_t end = pos_;
+        while ( end < s_.size() && ( isdigit( s_[end] ) || s_[end] == '.' ) )
+            ++end;
+        if ( end < s_.size() && ( s_[end] == 'e' || s_[end] == 'E' ) )
+        {
+            ++end;
+            if ( end < s_.size() && ( s_[end] == '+' || s_[end] == '-' ) )
+                ++end;
+            while ( end < s_.size() && isdigit( s_[end] ) )
+                ++end;
+        }
+        string num = s_.substr( pos_, end - pos_ );
+        char* last = 0;
+        double v = strtod( num.c_str(), &last );
+        if ( last != num.c_str() + num.size() )
+            return false;
+        pos_ = end;
+        // exprtk reads '2x0' as 2*x0. We do not.
+        if ( pos_ < s_.size() && ( isalpha( s_[pos_] ) || s_[pos_] == '_' ) )
+            return false;
+        f = constFrac( v );
+        return true;
+    }
+
+    Frac variable( unsigned int i ) const
+    {
+        Term t{ 1.0, vector< Factor >( 1, Factor{ i, 1.0 } ) };
+        return Frac{ Poly( 1, t ), constPoly( 1.0 ) };
+    }
+
+    const string& s_;
+    size_t pos_;
+    unsigned int numArgs_;
+};
+
+/**
+ * If expr is a single call to min or max, fills in its arguments.
+ */
+bool splitMinMax( const string& expr, bool& isMax, vector< string >& args )
+{
+    size_t b = expr.find_first_not_of( " \t\n" );
+    size_t e = expr.find_last_not_of( " \t\n" );
+    if ( b == string::npos || expr[e] != ')' )
+        return false;
+    string name = expr.substr( b, 3 );
+    if ( name != "min" && name != "max" )
+        return false;
+    size_t open = expr.find_first_not_of( " \t\n", b + 3 );
+    if ( open == string::npos || expr[open] != '(' )
+        return false;
+    isMax = ( name == "max" );
+    args.clear();
+    int depth = 0;
+    size_t argStart = open + 1;
+    for ( size_t i = open + 1; i < e; ++i )
+    {
+        if ( expr[i] == '(' )
+            ++depth;
+        else if ( expr[i] == ')' && --depth < 0 )
+            return false; // The call closes before the end.
+        else if ( expr[i] == ',' && depth == 0 )
+        {
+            args.push_back( expr.substr( argStart, i - argStart ) );
+            argStart = i + 1;
+        }
+    }
+    if ( depth != 0 )
+        return false;
+    args.push_back( expr.substr( argStart, e - argStart ) );
+    return args.size() >= 2;
+}
+
+bool polyUsesTime( const Poly& p, unsigned int numArgs )
+{
+    for ( const Term& t : p )
+        for ( const Factor& f : t.factors )
+            if ( f.arg == numArgs )
+                return true;
+    return false;
+}
+
+inline double intPow( double x, double p )
+{
+    if ( p == 1.0 )
+        return x;
+    if ( p == 2.0 )
+        return x * x;
+    if ( p == 3.0 )
+        return x * x * x;
+    if ( p == -1.0 )
+        return 1.0 / x;
+    return pow( x, p );
+}
+
+} // namespace
+
+FuncKernel::FuncKernel():
+    kind_( NONE ), numArgs_( 0 ), usesTime_( true ), c0_( 0.0 ),
+    isMax_( false )
+{;}
+
+void FuncKernel::clear()
+{
+    kind_ = NONE;
+    usesTime_ = true;
+    c0_ = 0.0;
+    lin_.clear();
+    num_.clear();
+    den_.clear();
+    children_.clear();
+}
+
+FuncKernel::Kind FuncKernel::kind() const
+{
+    return kind_;
+}
+
+bool FuncKernel::usesTime() const
+{
+    return usesTime_;
+}
+
+bool FuncKernel::build( const string& expr, unsigned int numArgs )
+{
+    clear();
+    numArgs_ = numArgs;
+
+    vector< string > args;
+    if ( splitMinMax( expr, isMax_, args ) )
+    {
+        children_.resize( args.size() );
+        usesTime_ = false;
+        for ( size_t i = 0; i < args.size(); ++i )
+        {
+            if ( !children_[i].build( args[i], numArgs ) )
+            {
+                clear();
+                return false;
+            }
+            usesTime_ = usesTime_ || children_[i].usesTime();
+        }
+        kind_ = MINMAX;
+        return true;
+    }
+
+    Frac f;
+    if ( !Parser( expr, numArgs ).parse( f ) )
+        return false;
+    if ( f.den.empty() )
+        return false; // Division by zero. exprtk says what happens.
+
+    usesTime_ = polyUsesTime( f.num, numArgs ) || polyUsesTime( f.den, numArgs );
+    if ( !isConst( f.den ) )
+    {
+        num_ = f.num;
+        den_ = f.den;
+        kind_ = RATIONAL;
+        return true;
+    }
+
+    double d = constValue( f.den );
+    bool affine = true;
+    for ( Term& t : f.num )
+    {
+        t.coeff /= d;
+        if ( t.factors.size() > 1 ||
+                ( t.factors.size() == 1 && t.factors[0].power != 1.0 ) )
+            affine = false;
+    }
+    if ( !affine )
+    {
+        num_ = f.num;
+        kind_ = POLYNOMIAL;
+        return true;
+    }
+    for ( const Term& t : f.num )
+    {
+        if ( t.factors.empty() )
+            c0_ = t.coeff;
+        else
+            lin_.push_back( make_pair( t.factors[0].arg, t.coeff ) );
+    }
+    kind_ = AFFINE;
+    return true;
+}
+
+double FuncKernel::evalPoly( const Poly& p, const double* S,
+                             const unsigned int* index, double t ) const
+{
+    double ret = 0.0;
+    for ( const Term& i : p )
+    {
+        double v = i.coeff;
+        for ( const Factor& f : i.factors )
+            v *= intPow( f.arg < numArgs_ ? S[ index[ f.arg ] ] : t, f.power );
+        ret += v;
+    }
+    return ret;
+}
+
+double FuncKernel::operator()( const double* S, const unsigned int* index,
+                               double t ) const
+{
+    switch ( kind_ )
+    {
+    case AFFINE:
+    {
+        double ret = c0_;
+        for ( const pair< unsigned int, double >& i : lin_ )
+            ret += i.second * ( i.first < numArgs_ ? S[ index[ i.first ] ] : t );
+        return ret;
+    }
+    case POLYNOMIAL:
+        return evalPoly( num_, S, index, t );
+    case RATIONAL:
+        return evalPoly( num_, S, index, t ) / evalPoly( den_, S, index, t );
+    case MINMAX:
+    {
+        double ret = children_[0]( S, index, t );
+        for ( size_t i = 1; i < children_.size(); ++i )
+        {
+            double v = children_[i]( S, index, t );
+            ret = isMax_ ? max( ret, v ) : min( ret, v );
+        }
+        return ret;
+    }
+    default:
+        return 0.0;
+    }
+}
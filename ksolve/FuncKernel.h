@@ -0,0 +1,89 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment,
+** also known as GENESIS 3 base code.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+#ifndef _FUNC_KERNEL_H
+#define _FUNC_KERNEL_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Native evaluation of the common forms of FuncTerm expressions, so that
+ * the solver need not go through exprtk on every rate calculation.
+ *
+ * The expression, in x0, x1, ... and t, is parsed and brought to the
+ * form p/q, with p and q sums of terms c * x_i^a * x_j^b ... This covers
+ * affine forms, polynomials, and rational forms such as Hill and
+ * Michaelis-Menten terms, including real Hill coefficients. An
+ * expression of min() or max() over such forms is also handled.
+ * Anything else (exp, conditionals, named variables ...) is left to
+ * exprtk.
+ */
+class FuncKernel
+{
+public:
+    enum Kind { NONE, AFFINE, POLYNOMIAL, RATIONAL, MINMAX };
+
+    FuncKernel();
+
+    /**
+     * Analyses expr, which has numArgs arguments x0 ... and may use t.
+     * Returns false, leaving the kernel empty, if the expression is not
+     * of a form handled here.
+     */
+    bool build( const string& expr, unsigned int numArgs );
+
+    /// Empties the kernel.
+    void clear();
+
+    Kind kind() const;
+    bool usesTime() const;
+
+    /**
+     * Evaluates the expression. Argument x_i is S[ index[i] ].
+     */
+    double operator()( const double* S, const unsigned int* index,
+                       double t ) const;
+
+    struct Factor
+    {
+        unsigned int arg;   // numArgs_ stands for t.
+        double power;
+    };
+    struct Term
+    {
+        double coeff;
+        vector< Factor > factors;
+    };
+    typedef vector< Term > Poly;
+
+private:
+    double evalPoly( const Poly& p, const double* S,
+                     const unsigned int* index, double t ) const;
+
+    Kind kind_;
+    unsigned int numArgs_;
+    bool usesTime_;
+
+    // AFFINE: c0_ + sum of lin_[i].second * x[ lin_[i].first ]
+    double c0_;
+    vector< pair< unsigned int, double > > lin_;
+
+    // POLYNOMIAL: num_. RATIONAL: num_ / den_.
+    Poly num_;
+    Poly den_;
+
+    // MINMAX: min or max of the children.
+    bool isMax_;
+    vector< FuncKernel > children_;
+};
+
+#endif // _FUNC_KERNEL_H
@@ -30,7 +30,8 @@ class FuncRate: public ExternReac
     }
 
         double operator() ( const double* S ) const {
-            double t = Field< double >::get( Id(1), "currentTime" );
+            double t = func_->usesTime() ?
+                Field< double >::get( Id(1), "currentTime" ) : 0.0;
             auto v = (*func_)( S, t ); // get rate from func calculation.
 			*(const_cast< double * >( &k_ ) ) = v;
             assert(! std::isnan(v));
@@ -113,7 +114,8 @@ class FuncReac: public FuncRate
         double operator() ( const double* S ) const
         {
             // double ret = k_ * func_( S, 0.0 ); // get rate from func calculation.
-            double t = Field< double >::get( Id(1), "currentTime" );
+            double t = func_->usesTime() ?
+                Field< double >::get( Id(1), "currentTime" ) : 0.0;
             double ret = (*func_)( S, t ); //get rate from func calculation.
 			*(const_cast< double * >( &k_ ) ) = ret;
             vector< unsigned int >::const_iterator i;
@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <sstream>
+#include <cmath>
 using namespace std;
 
 #include "FuncTerm.h"
@@ -87,9 +88,16 @@ void FuncTerm::setExpr( const string& expr )
 
     try
     {
+        kernel_.clear();
         if(! parser_.SetExpr(expr))
+        {
             MOOSE_WARN("Failed to set expression: '" << expr << "'");
+            expr_ = expr;
+            return;
+        }
         expr_ = expr;
+        if(args_)
+            buildKernel();
     }
     catch(moose::Parser::exception_type &e)
     {
@@ -98,6 +106,66 @@ void FuncTerm::setExpr( const string& expr )
     }
 }
 
+/**
+ * Looks for a native form of the expression. It is only used if it
+ * agrees with exprtk at a few sample points, so any disagreement over
+ * precedence or the like leaves the expression with exprtk. The points
+ * include zero and negative arguments, where rewrites that only hold
+ * for positive x, such as (x^2)^0.5 to x, would show up.
+ */
+void FuncTerm::buildKernel()
+{
+    const unsigned int n = reactantIndex_.size();
+    if(! kernel_.build(expr_, n))
+        return;
+
+    vector< unsigned int > index(n);
+    vector< double > x(n);
+    for(unsigned int i = 0; i < n; ++i)
+        index[i] = i;
+    // Three positive points, then all zero, all negative, and mixed.
+    for(unsigned int k = 0; k < 6; ++k)
+    {
+        for(unsigned int i = 0; i < n; ++i)
+        {
+            double v = 0.5 + 0.37 * i + 1.3 * (k % 3);
+            if(k == 3)
+                v = 0.0;
+            else if(k == 4 || (k == 5 && i % 2 == 1))
+                v = -v;
+            args_[i] = x[i] = v;
+        }
+        double t = args_[n] = (k == 3) ? 0.0 : 0.25 + 2.1 * (k % 3);
+        double expected = 0.0;
+        try
+        {
+            expected = parser_.Eval();
+        }
+        catch(moose::Parser::exception_type&)
+        {
+            kernel_.clear();
+            break;
+        }
+        double got = kernel_(x.data(), index.data(), t);
+        if(! std::isfinite(expected))
+        {
+            if(std::isfinite(got))
+            {
+                kernel_.clear();
+                break;
+            }
+            continue;
+        }
+        if(fabs(got - expected) > 1e-9 * max(1.0, fabs(expected)))
+        {
+            kernel_.clear();
+            break;
+        }
+    }
+    for(unsigned int i = 0; i <= n; ++i)
+        args_[i] = 0.0;
+}
+
 const string& FuncTerm::getExpr() const
 {
     return expr_;
@@ -123,6 +191,11 @@ double FuncTerm::getVolScale() const
     return volScale_;
 }
 
+bool FuncTerm::usesTime() const
+{
+    return kernel_.usesTime();
+}
+
 const FuncTerm& FuncTerm::operator=( const FuncTerm& other )
 {
     args_ = nullptr;  // other is still using it.
@@ -144,6 +217,9 @@ double FuncTerm::operator() ( const double* S, double t ) const
     if ( ! args_ )
         return 0.0;
 
+    if ( kernel_.kind() != FuncKernel::NONE )
+        return kernel_( S, reactantIndex_.data(), t ) * volScale_;
+
     unsigned int i = 0;
     for ( i = 0; i < reactantIndex_.size(); ++i )
         args_[i] = S[reactantIndex_[i]];
@@ -165,6 +241,12 @@ void FuncTerm::evalPool( double* S, double t ) const
     if ( !args_ || target_ == ~0U )
         return;
 
+    if ( kernel_.kind() != FuncKernel::NONE )
+    {
+        S[ target_ ] = kernel_( S, reactantIndex_.data(), t ) * volScale_;
+        return;
+    }
+
     unsigned int i;
     for ( i = 0; i < reactantIndex_.size(); ++i )
         args_[i] = S[reactantIndex_[i]];
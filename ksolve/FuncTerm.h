@@ -11,6 +11,7 @@
 #define _FUNC_TERM_H
 
 #include "../builtins/MooseParser.h"
+#include "FuncKernel.h"
 
 class FuncTerm
 {
@@ -41,6 +42,9 @@ public:
     void setVolScale( double vs );
     double getVolScale() const;
 
+    /// False if the value is known not to depend on t.
+    bool usesTime() const;
+
 private:
     // Look up reactants in the S vec.
     vector< unsigned int > reactantIndex_;
@@ -57,6 +61,11 @@ private:
 
     string expr_;
     moose::MooseParser parser_;
+
+    /// Native form of expr_, if it has one. Used in place of parser_.
+    FuncKernel kernel_;
+
+    void buildKernel();
 };
 
 #endif // _FUNC_TERM_H
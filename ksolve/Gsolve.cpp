@@ -1098,6 +1098,28 @@ void Gsolve::updateVoxelVol( vector< double > vols )
     }
 }
 
+void Gsolve::saveState( StateWriter& w ) const
+{
+    w.put( rng_.getState() );
+    w.put< uint64_t >( pools_.size() );
+    for ( unsigned int i = 0; i < pools_.size(); ++i )
+        pools_[i].saveState( w );
+}
+
+void Gsolve::restoreState( StateReader& r )
+{
+    string rng;
+    r.get( rng );
+    if ( r.ok() && !rng_.setState( rng ) )
+        r.fail();
+    uint64_t n = 0;
+    r.get( n );
+    if ( n != pools_.size() )
+        r.fail();
+    for ( unsigned int i = 0; i < pools_.size() && r.ok(); ++i )
+        pools_[i].restoreState( r );
+}
+
 void Gsolve::updateRateTerms( unsigned int index )
 {
     if ( index == ~0U )
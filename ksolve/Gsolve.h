@@ -68,6 +68,10 @@ public:
      */
     void updateVoxelVol( vector< double > vols );
 
+    /// Runtime state of all voxels, for checkpoints.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     //////////////////////////////////////////////////////////////////
     // Solver setup functions
     //////////////////////////////////////////////////////////////////
@@ -256,6 +256,29 @@ vector< unsigned int > GssaVoxelPools::numFire() const
     return numFire_;
 }
 
+void GssaVoxelPools::saveState( StateWriter& w ) const
+{
+    VoxelPoolsBase::saveState( w );
+    w.put( t_ );
+    w.put( atot_ );
+    w.put( v_ );
+    w.put( numFire_ );
+    w.put( rng_.getState() );
+}
+
+void GssaVoxelPools::restoreState( StateReader& r )
+{
+    VoxelPoolsBase::restoreState( r );
+    r.get( t_ );
+    r.get( atot_ );
+    r.get( v_ );
+    r.get( numFire_ );
+    string rng;
+    r.get( rng );
+    if ( r.ok() && !rng_.setState( rng ) )
+        r.fail();
+}
+
 /////////////////////////////////////////////////////////////////////////
 // Rate computation functions
 /////////////////////////////////////////////////////////////////////////
@@ -74,6 +74,10 @@ public:
 
     void setStoich( const Stoich* stoichPtr );
 
+    /// Runtime state for checkpoints, including the RNG.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
 private:
     /// Time at which next event will occur.
     double t_;
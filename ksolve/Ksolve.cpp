@@ -123,6 +123,41 @@ const Cinfo* Ksolve::initCinfo()
         &Ksolve::getNumThreads
     );
 
+    static ValueFinfo< Ksolve, bool > overlapJunctions (
+        "overlapJunctions",
+        "Flag. When true, the voxels that take part in junctions of "
+        "the Dsolve are advanced first, and the junctions are updated "
+        "on a separate thread while the remaining interior voxels are "
+        "advanced. The results are the same as without the flag. "
+        "Has no effect without a Dsolve with junctions, or if the "
+        "Dsolve has channels within its own compartment. "
+        "Takes effect on reinit.",
+        &Ksolve::setOverlapJunctions,
+        &Ksolve::getOverlapJunctions
+    );
+
+    static ReadOnlyValueFinfo< Ksolve, unsigned int > numBoundaryVoxels(
+        "numBoundaryVoxels",
+        "Number of voxels that take part in junctions, when "
+        "overlapJunctions is in effect. Zero otherwise.",
+        &Ksolve::getNumBoundaryVoxels
+    );
+
+    static ReadOnlyValueFinfo< Ksolve, double > junctionWaitTime(
+        "junctionWaitTime",
+        "Wall-clock time in seconds since reinit that the Ksolve has "
+        "been idle, waiting for the junction thread to finish after "
+        "advancing its interior voxels. Only used with overlapJunctions.",
+        &Ksolve::getJunctionWaitTime
+    );
+
+    static ReadOnlyValueFinfo< Ksolve, double > junctionTime(
+        "junctionTime",
+        "Wall-clock time in seconds since reinit taken by the junction "
+        "thread. Only used with overlapJunctions.",
+        &Ksolve::getJunctionTime
+    );
+
     static ValueFinfo< Ksolve, unsigned int > numPools(
         "numPools",
         "Number of molecular pools in the entire reac-diff system, "
@@ -204,6 +239,10 @@ const Cinfo* Ksolve::initCinfo()
         &epsAbs,                         // Value
         &epsRel ,                        // Value
         &numThreads,                     // Value
+        &overlapJunctions,               // Value
+        &numBoundaryVoxels,              // ReadOnlyValue
+        &junctionWaitTime,               // ReadOnlyValue
+        &junctionTime,                   // ReadOnlyValue
         &compartment,                    // Value
         &numLocalVoxels,                 // ReadOnlyValue
         &nVec,                           // LookupValue
@@ -244,7 +283,10 @@ Ksolve::Ksolve()
     pools_( 1 ),
     startVoxel_( 0 ),
     dsolve_(),
-    dsolvePtr_( nullptr )
+    dsolvePtr_( nullptr ),
+    overlapJunctions_( false ),
+    junctionWaitTime_( 0.0 ),
+    junctionTime_( 0.0 )
 {
     numThreads_ = moose::getEnvInt("MOOSE_NUM_THREADS", 1);
 
@@ -342,6 +384,31 @@ unsigned int Ksolve::getNumThreads(  ) const
     return numThreads_;
 }
 
+void Ksolve::setOverlapJunctions( bool val )
+{
+    overlapJunctions_ = val;
+}
+
+bool Ksolve::getOverlapJunctions() const
+{
+    return overlapJunctions_;
+}
+
+unsigned int Ksolve::getNumBoundaryVoxels() const
+{
+    return boundaryVoxels_.size();
+}
+
+double Ksolve::getJunctionWaitTime() const
+{
+    return junctionWaitTime_;
+}
+
+double Ksolve::getJunctionTime() const
+{
+    return junctionTime_;
+}
+
 Id Ksolve::getStoich() const
 {
     return stoich_;
@@ -481,6 +548,13 @@ vector< double > Ksolve::getNvec( unsigned int voxel) const
     return dummy;
 }
 
+const vector< double >* Ksolve::nVecStorage( unsigned int voxel ) const
+{
+    if ( voxel < pools_.size() )
+        return &const_cast< VoxelPools* >( &( pools_[ voxel ] ) )->Svec();
+    return 0;
+}
+
 void Ksolve::setNvec( unsigned int voxel, vector< double > nVec )
 {
     if ( voxel < pools_.size() )
@@ -581,6 +655,12 @@ void Ksolve::process( const Eref& e, ProcPtr p )
         setBlock( dvalues );
     }
 
+    if ( !boundaryVoxels_.empty() )
+    {
+        processOverlapped( p );
+        return;
+    }
+
     if( 1 == numThreads_ || 1 == pools_.size() )
     {
         if( numThreads_ > 1 )
@@ -652,6 +732,124 @@ size_t Ksolve::advance_chunk( const size_t begin, const size_t end, ProcPtr p )
 }
 
 
+size_t Ksolve::advance_interior( const size_t begin, const size_t end, ProcPtr p )
+{
+    size_t tot = 0;
+    for (size_t i = begin; i < std::min(end, interiorVoxels_.size()); i++)
+    {
+        pools_[ interiorVoxels_[i] ].advance( p );
+        tot += 1;
+    }
+    return tot;
+}
+
+/**
+ * Same calculations as process, but in a different order. The junction
+ * voxels are advanced and sent to the Dsolve first. Then the Dsolve
+ * updates its junctions on another thread, which only touches those
+ * voxels in the Dsolve, while we advance the interior voxels here.
+ */
+void Ksolve::processOverlapped( ProcPtr p )
+{
+    for ( auto i = boundaryVoxels_.begin(); i != boundaryVoxels_.end(); ++i )
+        pools_[ *i ].advance( p );
+    sendVoxelsToDsolve( boundaryVoxels_ );
+
+    KsolveBase* dsolve = dsolvePtr_;
+    double dt = p->dt;
+    std::future< double > junctionDone = std::async( std::launch::async,
+            [dsolve, dt]() {
+                high_resolution_clock::time_point t0 =
+                    high_resolution_clock::now();
+                dsolve->updateJunctions( dt );
+                return duration_cast< duration< double > >(
+                    high_resolution_clock::now() - t0 ).count();
+            }
+        );
+
+    if ( numThreads_ > 1 && interiorIntervals_.size() > 1 )
+    {
+        std::vector<std::future<size_t>> vecFutures;
+        for (auto interval : interiorIntervals_)
+        {
+            vecFutures.push_back(
+                    std::async( std::launch::async
+                        , &Ksolve::advance_interior
+                        , this
+                        , interval.first
+                        , interval.second, p
+                        )
+                    );
+        }
+        for (auto &v : vecFutures )
+            v.get();
+    }
+    else
+    {
+        advance_interior( 0, interiorVoxels_.size(), p );
+    }
+
+    high_resolution_clock::time_point t0 = high_resolution_clock::now();
+    junctionTime_ += junctionDone.get();
+    junctionWaitTime_ += duration_cast< duration< double > >(
+            high_resolution_clock::now() - t0 ).count();
+
+    sendVoxelsToDsolve( interiorVoxels_ );
+}
+
+/// Sends over the listed voxels, one run of adjacent voxels at a time.
+void Ksolve::sendVoxelsToDsolve( const vector< unsigned int >& voxels )
+{
+    vector< double > kvalues;
+    unsigned int numVarPools = stoichPtr_->getNumVarPools();
+    for ( size_t i = 0; i < voxels.size(); )
+    {
+        size_t j = i + 1;
+        while ( j < voxels.size() && voxels[j] == voxels[j-1] + 1 )
+            ++j;
+        kvalues.assign( 4, 0.0 );
+        kvalues[0] = voxels[i];
+        kvalues[1] = j - i;
+        kvalues[3] = numVarPools;
+        getBlock( kvalues );
+        dsolvePtr_->setBlock( kvalues );
+        i = j;
+    }
+}
+
+void Ksolve::setupOverlap()
+{
+    boundaryVoxels_.clear();
+    interiorVoxels_.clear();
+    interiorIntervals_.clear();
+    junctionWaitTime_ = 0.0;
+    junctionTime_ = 0.0;
+    if ( !overlapJunctions_ || !dsolvePtr_ )
+        return;
+    vector< unsigned int > voxels;
+    if ( !dsolvePtr_->getJunctionVoxels( voxels ) || voxels.empty() )
+        return;
+    vector< bool > isBoundary( pools_.size(), false );
+    for ( auto i = voxels.begin(); i != voxels.end(); ++i )
+    {
+        if ( *i >= pools_.size() )
+        {
+            cout << "Warning: Ksolve::setupOverlap: junction voxel " << *i
+                << " out of range. Not overlapping.\n";
+            return;
+        }
+        isBoundary[ *i ] = true;
+    }
+    boundaryVoxels_ = voxels;
+    for ( unsigned int i = 0; i < pools_.size(); ++i )
+        if ( !isBoundary[i] )
+            interiorVoxels_.push_back( i );
+    if ( numThreads_ > 1 && interiorVoxels_.size() > 1 )
+        moose::splitIntervalInNParts( interiorVoxels_.size(),
+            std::min( numThreads_, interiorVoxels_.size() ),
+            interiorIntervals_ );
+}
+
 void Ksolve::reinit( const Eref& e, ProcPtr p )
 {
     if ( !stoichPtr_ )
@@ -680,6 +878,8 @@ void Ksolve::reinit( const Eref& e, ProcPtr p )
     // Recompute the partition of interval.
     intervals_.clear();
     moose::splitIntervalInNParts(pools_.size(), numThreads_, intervals_);
+
+    setupOverlap();
 }
 
 //////////////////////////////////////////////////////////////
@@ -936,6 +1136,23 @@ void Ksolve::updateVoxelVol( vector< double > vols )
     }
 }
 
+void Ksolve::saveState( StateWriter& w ) const
+{
+    w.put< uint64_t >( pools_.size() );
+    for ( unsigned int i = 0; i < pools_.size(); ++i )
+        pools_[i].saveState( w );
+}
+
+void Ksolve::restoreState( StateReader& r )
+{
+    uint64_t n = 0;
+    r.get( n );
+    if ( n != pools_.size() )
+        r.fail();
+    for ( unsigned int i = 0; i < pools_.size() && r.ok(); ++i )
+        pools_[i].restoreState( r );
+}
+
 // cross-compartment reaction stuff.
 // Functions for setup of cross-compartment transfer.
 void Ksolve::print() const
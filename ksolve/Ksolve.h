@@ -60,6 +60,8 @@ public:
     /// Returns the vector of pool Num at the specified voxel.
     vector< double > getNvec( unsigned int voxel) const;
     void setNvec( unsigned int voxel, vector< double > vec );
+    /// Inherited virtual.
+    const vector< double >* nVecStorage( unsigned int voxel ) const;
 
     // Set number of threads to use (for deterministic case only).
     unsigned int getNumThreads( ) const;
@@ -67,6 +69,16 @@ public:
 
     size_t advance_chunk( const size_t begin, const size_t end, ProcPtr p );
 
+    /// Advances the interior voxels from begin to end.
+    size_t advance_interior( const size_t begin, const size_t end, ProcPtr p );
+
+    /// Flag: integrate interior voxels while junctions are updated.
+    bool getOverlapJunctions() const;
+    void setOverlapJunctions( bool val );
+    unsigned int getNumBoundaryVoxels() const;
+    double getJunctionWaitTime() const;
+    double getJunctionTime() const;
+
     void advance_pool( const size_t i, ProcPtr p );
 
     /**
@@ -94,6 +106,10 @@ public:
      */
     void updateVoxelVol( vector< double > vols );
 
+    /// Runtime state of all voxels, for checkpoints.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     // Solver interface functions
     unsigned int getPoolIndex( const Eref& e ) const;
     unsigned int getVoxelIndex( const Eref& e ) const;
@@ -193,6 +209,33 @@ private:
 
     vector<std::pair<size_t, size_t>> intervals_;
 
+    /**
+     * Overlap of the junction calculations with the integration.
+     * The boundary voxels are those in junctions of the Dsolve. They
+     * are advanced first and handed to the Dsolve, which then updates
+     * the junctions on another thread while the interior voxels are
+     * advanced here.
+     */
+    bool overlapJunctions_;
+    vector< unsigned int > boundaryVoxels_;
+    vector< unsigned int > interiorVoxels_;
+    vector<std::pair<size_t, size_t>> interiorIntervals_;
+
+    /// Time spent waiting for the junction thread since reinit, in sec.
+    double junctionWaitTime_;
+
+    /// Time spent by the junction thread since reinit, in sec.
+    double junctionTime_;
+
+    /// Splits the voxels into boundary and interior sets.
+    void setupOverlap();
+
+    /// Sends the values in the listed voxels to the Dsolve.
+    void sendVoxelsToDsolve( const vector< unsigned int >& voxels );
+
+    /// Process call for overlapJunctions.
+    void processOverlapped( ProcPtr p );
+
     //high_resolution_clock::time_point t0_, t1_;
 	
 	static map< Id, unsigned int > defaultPoolLookup_;
@@ -39,6 +39,12 @@ void KsolveBase::updateJunctions( double dt )
 void KsolveBase::setPrev()
 {;}
 
+bool KsolveBase::getJunctionVoxels( vector< unsigned int >& voxels ) const
+{
+    voxels.clear();
+    return false;
+}
+
 /////////////////////////////////////////////////////////////////////
 
 Id KsolveBase::getCompartment() const
@@ -64,6 +64,16 @@ public:
     /// Return a pointer to the specified VoxelPool.
     virtual VoxelPoolsBase* pools( unsigned int i ) = 0;
 
+    /**
+     * The storage behind the nVec field for index i, so that it can be
+     * read in place. For Ksolve this is # of every pool in voxel i, for
+     * Dsolve # of pool i in every voxel. Returns 0 if i is out of range
+     * or the solver does not keep such storage. It stays valid until the
+     * solver is rebuilt or its voxels or pools are changed.
+     */
+    virtual const vector< double >* nVecStorage( unsigned int i ) const
+    { return 0; }
+
     /// Return volume of voxel i.
     virtual double volume( unsigned int i ) const = 0;
 
@@ -125,6 +135,14 @@ public:
 
     /// Used to tell Dsolver to assign 'prev' values.
     virtual void setPrev();
+    /**
+     * Used by the Ksolve to find out which of its voxels take part in
+     * the junctions handled by its Dsolve. Fills in the sorted voxel
+     * indices and returns true if updateJunctions only reads and
+     * writes these voxels, so that the rest can be integrated while
+     * the junctions are being updated. Returns false otherwise.
+     */
+    virtual bool getJunctionVoxels( vector< unsigned int >& voxels ) const;
     /**
      * Informs the solver that the rate terms or volumes have changed
      * and that the parameters must be updated.
@@ -317,6 +317,43 @@ void VoxelPools::setInitDt( double dt )
 #endif
 }
 
+void VoxelPools::saveState( StateWriter& w ) const
+{
+    VoxelPoolsBase::saveState( w );
+    w.put( lsodaState_ );
+#ifdef USE_GSL
+    // The Runge-Kutta steppers keep nothing between calls but the
+    // step size.
+    w.put( driver_ ? driver_->h : 0.0 );
+#endif
+    w.put< bool >( pLSODA != nullptr );
+    if( pLSODA )
+        pLSODA->visitState( [&w]( auto& x ) { w.put( x ); } );
+}
+
+void VoxelPools::restoreState( StateReader& r )
+{
+    VoxelPoolsBase::restoreState( r );
+    r.get( lsodaState_ );
+#ifdef USE_GSL
+    double h = 0.0;
+    r.get( h );
+    if ( driver_ && h > 0.0 )
+        gsl_odeiv2_driver_reset_hstart( driver_, h );
+#endif
+    bool hasLsoda = false;
+    r.get( hasLsoda );
+    if( hasLsoda )
+    {
+        if( !pLSODA )
+        {
+            pLSODA.reset( new LSODA() );
+            pLSODA->param = (void *) this;
+        }
+        pLSODA->visitState( [&r]( auto& x ) { r.get( x ); } );
+    }
+}
+
 #ifdef USE_GSL
 // static func. This is the function that goes into the Gsl solver.
 int VoxelPools::gslFunc( double t, const double* y, double *dydt, void* params )
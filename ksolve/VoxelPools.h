@@ -53,6 +53,13 @@ public:
     /// Set initial timestep to use by the solver.
     void setInitDt( double dt );
 
+    /**
+     * Runtime state for checkpoints: the mol #s and whatever the
+     * integrator carries from one step to the next.
+     */
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
 #ifdef USE_GSL      /* -----  not USE_BOOST  ----- */
     static int gslFunc( double t, const double* y, double *dydt, void* params);
 #elif  USE_BOOST_ODE
@@ -51,6 +51,17 @@ void VoxelPoolsBase::reinit()
 	}
 }
 
+void VoxelPoolsBase::saveState( StateWriter& w ) const
+{
+	w.put( S_ );
+}
+
+/// The pools must already be set up as they were when saved.
+void VoxelPoolsBase::restoreState( StateReader& r )
+{
+	r.getFixed( S_ );
+}
+
 //////////////////////////////////////////////////////////////
 // Access functions
 //////////////////////////////////////////////////////////////
@@ -207,6 +207,10 @@ public:
 
 	void setNumVoxels( unsigned int );
 
+    /// Runtime state for checkpoints: the mol #s.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     /// Debugging utility
     void print() const;
 
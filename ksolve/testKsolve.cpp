@@ -367,6 +367,71 @@ void testFuncTerm()
     cout << "." << flush;
 }
 
+void testFuncKernel()
+{
+    FuncKernel fk;
+    double S[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    unsigned int index[] = {3, 0, 8};
+
+    // x0 = 4, x1 = 1, x2 = 9.
+    assert( fk.build( "2*x0 - x1/4 + 3", 3 ) );
+    assert( fk.kind() == FuncKernel::AFFINE );
+    assert( !fk.usesTime() );
+    assert( doubleEq( fk( S, index, 0.0 ), 10.75 ) );
+
+    assert( fk.build( "(x0 + 1)^2 * x2 - 0.5*t", 3 ) );
+    assert( fk.kind() == FuncKernel::POLYNOMIAL );
+    assert( fk.usesTime() );
+    assert( doubleEq( fk( S, index, 2.0 ), 224.0 ) );
+
+    // Hill function with a real coefficient.
+    assert( fk.build( "x2^2.5 / ( 16^2.5 + x2^2.5 )", 3 ) );
+    assert( fk.kind() == FuncKernel::RATIONAL );
+    assert( doubleEq( fk( S, index, 0.0 ), 243.0 / ( 1024.0 + 243.0 ) ) );
+
+    assert( fk.build( "max( 0, x0 - x2, min( x1, 0.5 ) )", 3 ) );
+    assert( fk.kind() == FuncKernel::MINMAX );
+    assert( doubleEq( fk( S, index, 0.0 ), 0.5 ) );
+
+    assert( !fk.build( "exp(x0)", 3 ) );
+    assert( fk.kind() == FuncKernel::NONE );
+    assert( !fk.build( "x3 + 1", 3 ) );
+    assert( !fk.build( "x0^x1", 3 ) );
+
+    // Powers that only merge for positive x are left alone.
+    double neg[] = {-4, 2, 9};
+    unsigned int negIndex[] = {0, 1, 2};
+    assert( !fk.build( "(x0^2)^0.5", 3 ) );
+    assert( !fk.build( "(x0*x1)^0.5", 3 ) );
+    assert( !fk.build( "(x0/x1)^1.5", 3 ) );
+    assert( fk.build( "x0^0.5 * x0^0.5", 3 ) );
+    assert( std::isnan( fk( neg, negIndex, 0.0 ) ) );
+    assert( fk.build( "(x0^1.5)^2", 3 ) );
+    assert( std::isnan( fk( neg, negIndex, 0.0 ) ) );
+    assert( fk.build( "(x0^3)^2 / (x2/4)^0.5", 3 ) );
+    assert( doubleEq( fk( neg, negIndex, 0.0 ), 4096.0 / 1.5 ) );
+
+    // FuncTerm must give the same answer with and without the kernel.
+    FuncTerm ft;
+    vector< unsigned int > mol( index, index + 3 );
+    ft.setReactantIndex( mol );
+    ft.setExpr( "x0*x0/(x0 + x2) + t" );
+    assert( ft.usesTime() );
+    assert( doubleEq( ft( S, 1.5 ), 16.0 / 13.0 + 1.5 ) );
+    ft.setExpr( "exp(x1 - 1) * x0" );
+    assert( ft.usesTime() );
+    assert( doubleEq( ft( S, 1.5 ), 4.0 ) );
+    // Checked against exprtk at negative points too.
+    vector< unsigned int > negMol( negIndex, negIndex + 3 );
+    ft.setReactantIndex( negMol );
+    ft.setExpr( "(x0^2)^0.5 + x1" );
+    assert( doubleEq( ft( neg, 0.0 ), 6.0 ) );
+    ft.setExpr( "x2^0.5 * x0" );
+    assert( !ft.usesTime() );
+    assert( doubleEq( ft( neg, 0.0 ), -12.0 ) );
+    cout << "." << flush;
+}
+
 void testKsolve()
 {
     testSetupReac();
@@ -374,6 +439,7 @@ void testKsolve()
     testRunKsolve();
     testRunGsolve();
     testFuncTerm();
+    testFuncKernel();
 }
 
 void testKsolveProcess()
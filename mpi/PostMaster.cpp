@@ -7,15 +7,21 @@
 ** See the file COPYING.LIB for the full notice.
 **********************************************************************/
 
+#include <set>
 #include "../basecode/header.h"
 #include "PostMaster.h"
+#include "ShmTransport.h"
 #include "../shell/Shell.h"
+#include "../shell/Wildcard.h"
+#include "../synapse/Synapse.h"
+#include "../synapse/SynHandlerBase.h"
 
 const unsigned int TgtInfo::headerSize =
 		1 + ( sizeof( TgtInfo ) - 1 )/sizeof( double );
 
 const unsigned int PostMaster::reserveBufSize = 1048576;
 const unsigned int PostMaster::setRecvBufSize = 1048576;
+const unsigned int PostMaster::maxExchangeSteps = 1000;
 const int PostMaster::MSGTAG = 1;
 const int PostMaster::SETTAG = 2;
 const int PostMaster::GETTAG = 3;
@@ -35,11 +41,23 @@ PostMaster::PostMaster()
 				isSetSent_( 1 ), // Flag. Have any pending 'set' gone?
 				isSetRecv_( 0 ), // Flag. Has some data come in?
 				setSendSize_( 0 ),
-				numRecvDone_( 0 )
+				numRecvDone_( 0 ),
+				spikeBatching_( false ),
+				minDelay_( 0.0 ),
+				exchangeInterval_( 1 ),
+				stepCount_( 0 ),
+				numExchanges_( 0.0 )
 {
 	for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
 		sendBuf_[i].resize( reserveBufSize, 0 );
 	}
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		shmRecvBuf_.resize( t->maxRecord() );
+		shmRecvDone_.resize( Shell::numNodes(), false );
+		t->barrier();
+		return;
+	}
 #ifdef USE_MPI
 	MPI_Barrier( MPI_COMM_WORLD );
 	// Post recv for set calls
@@ -100,6 +118,37 @@ const Cinfo* PostMaster::initCinfo()
 			&PostMaster::setBufferSize,
 			&PostMaster::getBufferSize
 		);
+		static ValueFinfo< PostMaster, bool > spikeBatching(
+			"spikeBatching",
+			"Flag. When true, outgoing messages are held back for as "
+			"many steps as the smallest synaptic delay allows, and then "
+			"exchanged between all nodes in one collective call, "
+			"without a barrier on every step. "
+			"Only use this when all traffic between nodes is spikes to "
+			"synapses, since other messages will also be held back. "
+			"Takes effect on reinit.",
+			&PostMaster::setSpikeBatching,
+			&PostMaster::getSpikeBatching
+		);
+		static ReadOnlyValueFinfo< PostMaster, double > minDelay(
+			"minDelay",
+			"Smallest delay of any synapse on any node, as found on "
+			"reinit when spikeBatching is on. Zero if there are none.",
+			&PostMaster::getMinDelay
+		);
+		static ReadOnlyValueFinfo< PostMaster, unsigned int >
+				exchangeInterval(
+			"exchangeInterval",
+			"Number of steps between exchanges of data between nodes. "
+			"This is 1 unless spikeBatching is on.",
+			&PostMaster::getExchangeInterval
+		);
+		static ReadOnlyValueFinfo< PostMaster, double > numExchanges(
+			"numExchanges",
+			"Number of exchanges of message data between nodes since "
+			"reinit.",
+			&PostMaster::getNumExchanges
+		);
 		//////////////////////////////////////////////////////////////
 		// MsgDest Definitions
 		//////////////////////////////////////////////////////////////
@@ -125,6 +174,10 @@ const Cinfo* PostMaster::initCinfo()
 		&numNodes,	// ReadOnlyValue
 		&myNode,	// ReadOnlyValue
 		&bufferSize,	// ReadOnlyValue
+		&spikeBatching,	// Value
+		&minDelay,	// ReadOnlyValue
+		&exchangeInterval,	// ReadOnlyValue
+		&numExchanges,	// ReadOnlyValue
 		&proc		// SharedFinfo
 	};
 
@@ -163,6 +216,31 @@ void PostMaster::finalizeSends()
  */
 void PostMaster::reinit( const Eref& e, ProcPtr p )
 {
+	stepCount_ = 0;
+	numExchanges_ = 0.0;
+	exchangeInterval_ = 1;
+	minDelay_ = 0.0;
+	if ( spikeBatching_ ) {
+		double localMin = localMinDelay();
+		double globalMin = localMin;
+		if ( ShmTransport::instance() ) {
+			globalMin = ShmTransport::instance()->allReduceMin( localMin );
+		} else {
+#ifdef USE_MPI
+			MPI_Allreduce( &localMin, &globalMin, 1, MPI_DOUBLE, MPI_MIN,
+							MPI_COMM_WORLD );
+#endif
+		}
+		// With no synapses anywhere we have nothing to go by.
+		if ( globalMin < numeric_limits< double >::max() ) {
+			minDelay_ = globalMin;
+			exchangeInterval_ = exchangeSteps( minDelay_, p->dt );
+		}
+	}
+	if ( ShmTransport::instance() ) {
+		shmExchange();
+		return;
+	}
 #ifdef USE_MPI
 	// MPI_Barrier( MPI_COMM_WORLD );
 	unsigned int reqIndex = 0;
@@ -189,6 +267,20 @@ void PostMaster::reinit( const Eref& e, ProcPtr p )
 
 void PostMaster::process( const Eref& e, ProcPtr p )
 {
+	if ( exchangeInterval_ > 1 ) {
+		// Keep set and get calls moving on the steps between exchanges.
+		clearPending();
+		if ( ++stepCount_ < exchangeInterval_ )
+			return;
+		stepCount_ = 0;
+		exchangeBatch();
+		return;
+	}
+	numExchanges_ += 1.0;
+	if ( ShmTransport::instance() ) {
+		shmExchange();
+		return;
+	}
 #ifdef USE_MPI
 	unsigned int reqIndex = 0;
 	for ( unsigned int i = 0; i < Shell::numNodes(); ++i )
@@ -212,6 +304,87 @@ void PostMaster::process( const Eref& e, ProcPtr p )
 #endif
 }
 
+/**
+ * Swaps the accumulated send buffers of all nodes in one go. The sizes
+ * go out first in an MPI_Alltoall, so that each node can size its
+ * receive buffer to suit however many steps of data arrive.
+ */
+void PostMaster::exchangeBatch()
+{
+	numExchanges_ += 1.0;
+	if ( ShmTransport::instance() ) {
+		// The rings take records of any size up to their capacity.
+		shmExchange();
+		return;
+	}
+#ifdef USE_MPI
+	unsigned int numNodes = Shell::numNodes();
+	vector< int > sendCounts( numNodes, 0 );
+	vector< int > sendDispls( numNodes, 0 );
+	vector< int > recvCounts( numNodes, 0 );
+	vector< int > recvDispls( numNodes, 0 );
+	int totSend = 0;
+	for ( unsigned int i = 0; i < numNodes; ++i ) {
+		if ( i != Shell::myNode() )
+			sendCounts[i] = sendSize_[i];
+		sendDispls[i] = totSend;
+		totSend += sendCounts[i];
+	}
+	MPI_Alltoall( &sendCounts[0], 1, MPI_INT,
+					&recvCounts[0], 1, MPI_INT, MPI_COMM_WORLD );
+	int totRecv = 0;
+	for ( unsigned int i = 0; i < numNodes; ++i ) {
+		recvDispls[i] = totRecv;
+		totRecv += recvCounts[i];
+	}
+
+	batchSendBuf_.resize( totSend + 1 );
+	for ( unsigned int i = 0; i < numNodes; ++i ) {
+		if ( sendCounts[i] > 0 )
+			memcpy( &batchSendBuf_[ sendDispls[i] ], &sendBuf_[i][0],
+							sendCounts[i] * sizeof( double ) );
+		sendSize_[i] = 0;
+	}
+	batchRecvBuf_.resize( totRecv + 1 );
+	MPI_Alltoallv( &batchSendBuf_[0], &sendCounts[0], &sendDispls[0],
+					MPI_DOUBLE,
+					&batchRecvBuf_[0], &recvCounts[0], &recvDispls[0],
+					MPI_DOUBLE, MPI_COMM_WORLD );
+
+	for ( unsigned int i = 0; i < numNodes; ++i ) {
+		if ( recvCounts[i] > 0 )
+			handleRecvBuf( &batchRecvBuf_[ recvDispls[i] ], recvCounts[i] );
+	}
+#endif // USE_MPI
+}
+
+/**
+ * The shared-memory counterpart of the exchange in process. Each node
+ * puts one record, which may be empty, in its ring to every other node,
+ * and then waits for one record from each of them. Taking exactly one
+ * record per node per exchange keeps the steps in order, and serves as
+ * the barrier.
+ */
+void PostMaster::shmExchange()
+{
+	ShmTransport* t = ShmTransport::instance();
+	std::function< void() > poll = [this]() { clearPending(); };
+	for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
+		if ( i == Shell::myNode() ) continue;
+		t->send( i, ShmTransport::MSG, &sendBuf_[i][0], sendSize_[i], poll );
+		sendSize_[i] = 0;
+		clearPending(); // Try to interleave communications.
+	}
+	while ( numRecvDone_ < Shell::numNodes() -1 )
+		clearPending();
+	numRecvDone_ = 0;
+	shmRecvDone_.assign( Shell::numNodes(), false );
+	// As with the MPI_Barrier in process. Otherwise node 0 may go on to
+	// send its next set calls, such as a start, while another node is
+	// still waiting here, and that node would handle them too early.
+	t->barrier();
+}
+
 void PostMaster::clearPending()
 {
 	if ( Shell::numNodes() == 1 )
@@ -223,11 +396,16 @@ void PostMaster::clearPending()
 void PostMaster::handleRemoteGet(
 				const Eref& e, const OpFunc* op, int requestingNode )
 {
-#ifdef USE_MPI
 	static double getReturnBuf[reserveBufSize];
 	op->opBuffer( e, &getReturnBuf[0] ); // stuff return value into buf.
 	// Send out the data. Blocking. Don't want any other gets till done
 	int size = getReturnBuf[0];
+	if ( ShmTransport::instance() ) {
+		ShmTransport::instance()->send( requestingNode,
+						ShmTransport::RETURN, &getReturnBuf[1], size );
+		return;
+	}
+#ifdef USE_MPI
 	MPI_Send(
 		&getReturnBuf[1], size, MPI_DOUBLE,
 		requestingNode, 		// Where to send to.
@@ -284,10 +462,15 @@ int innerGetVec( const Eref& e, const OpFunc* op,
 void PostMaster::handleRemoteGetVec(
 				const Eref& e, const OpFunc* op, int requestingNode )
 {
-#ifdef USE_MPI
 	static double getReturnBuf[reserveBufSize];
 	int k = innerGetVec( e, op, getReturnBuf );
 	// Send out the data. Blocking. Don't want any other gets till done
+	if ( ShmTransport::instance() ) {
+		ShmTransport::instance()->send( requestingNode,
+						ShmTransport::RETURN, &getReturnBuf[0], k );
+		return;
+	}
+#ifdef USE_MPI
 	MPI_Send(
 		&getReturnBuf[0], k, MPI_DOUBLE,
 		requestingNode, 		// Where to send to.
@@ -298,6 +481,20 @@ void PostMaster::handleRemoteGetVec(
 
 void PostMaster::clearPendingSetGet()
 {
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
+			if ( i == Shell::myNode() ) continue;
+			int count = t->recv( i, ShmTransport::SET, &setRecvBuf_[0] );
+			if ( count < 0 )
+				continue;
+			// Copy out, since we may call clearPendingSetGet recursively.
+			vector< double > temp( setRecvBuf_.begin(),
+							setRecvBuf_.begin() + count );
+			handleSetBuf( &temp[0], i );
+		}
+		return;
+	}
 #ifdef USE_MPI
 	// isSetSent_ is checked before doing another x-node set operation
 	// in dispatchSetBuf.
@@ -324,25 +521,29 @@ void PostMaster::clearPendingSetGet()
 						&setRecvReq_
 		);
 
-		double* buf = &temp[0];
-		// Handle arrived Set call
-		const TgtInfo* tgt = reinterpret_cast< const TgtInfo * >( buf );
-		const Eref& e = tgt->eref();
-		const OpFunc *op = OpFunc::lookop( tgt->bindIndex() );
-		assert( op );
-		if ( tgt->dataSize() == MooseSetHop ) {
-			op->opBuffer( e, buf + TgtInfo::headerSize );
-		} else if ( tgt->dataSize() == MooseSetVecHop ) {
-			op->opVecBuffer( e, buf + TgtInfo::headerSize );
-		} else if ( tgt->dataSize() == MooseGetHop ) {
-			handleRemoteGet( e, op, requestingNode );
-		} else if ( tgt->dataSize() == MooseGetVecHop ) {
-			handleRemoteGetVec( e, op, requestingNode );
-		}
+		handleSetBuf( &temp[0], requestingNode );
 	}
 #endif // USE_MPI
 }
 
+/// Handles an arrived Set call, or a request for a Get.
+void PostMaster::handleSetBuf( double* buf, int requestingNode )
+{
+	const TgtInfo* tgt = reinterpret_cast< const TgtInfo * >( buf );
+	const Eref& e = tgt->eref();
+	const OpFunc *op = OpFunc::lookop( tgt->bindIndex() );
+	assert( op );
+	if ( tgt->dataSize() == MooseSetHop ) {
+		op->opBuffer( e, buf + TgtInfo::headerSize );
+	} else if ( tgt->dataSize() == MooseSetVecHop ) {
+		op->opVecBuffer( e, buf + TgtInfo::headerSize );
+	} else if ( tgt->dataSize() == MooseGetHop ) {
+		handleRemoteGet( e, op, requestingNode );
+	} else if ( tgt->dataSize() == MooseGetVecHop ) {
+		handleRemoteGetVec( e, op, requestingNode );
+	}
+}
+
 /*
 // Handles incoming 'get' request and posts stuff back to requestor.
 void PostMaster::clearPendingGet()
@@ -382,6 +583,32 @@ void PostMaster::clearPendingGet()
 
 void PostMaster::clearPendingRecv()
 {
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		// Take at most one record from each node per exchange.
+		for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
+			if ( i == Shell::myNode() || shmRecvDone_[i] ||
+							!t->isPending( i, ShmTransport::MSG ) )
+				continue;
+			// The rings do not keep order between channels, so we hold
+			// off on the data until the set calls sent before it, such
+			// as those that create the targets, have been handled. These
+			// may come from any node, as the data may follow on from set
+			// calls that node 0 sent to all. We look only once the data
+			// is there, so that any such set call is there too.
+			for ( unsigned int j = 0; j < Shell::numNodes(); ++j )
+				if ( j != Shell::myNode() &&
+								t->isPending( j, ShmTransport::SET ) )
+					return;
+			int recvSize = t->recv( i, ShmTransport::MSG, &shmRecvBuf_[0] );
+			if ( recvSize < 0 )
+				continue;
+			shmRecvDone_[i] = true;
+			++numRecvDone_;
+			handleRecvBuf( &shmRecvBuf_[0], recvSize );
+		}
+		return;
+	}
 #ifdef USE_MPI
 	int done = 0;
 	bool report = false; // for debugging
@@ -396,7 +623,6 @@ void PostMaster::clearPendingRecv()
 			recvNode += 1; // Skip myNode
 		int recvSize = 0;
 		MPI_Get_count( &doneStatus_[i], MPI_DOUBLE, &recvSize );
-		int j = 0;
 		assert( recvSize <= static_cast< int >( recvBufSize_ ) );
 		double* buf = &recvBuf_[ recvNode ][0];
 		if ( report ) {
@@ -406,19 +632,7 @@ void PostMaster::clearPendingRecv()
 					   	buf[j+3] << endl;
 			}
 		}
-		while ( j < recvSize ) {
-			const TgtInfo* tgt = reinterpret_cast< const TgtInfo * >( buf );
-			const Eref& e = tgt->eref();
-			const Finfo *f =
-				e.element()->cinfo()->getSrcFinfo( tgt->bindIndex() );
-			buf += TgtInfo::headerSize;
-			const SrcFinfo* sf = dynamic_cast< const SrcFinfo* >( f );
-			assert( sf );
-			sf->sendBuffer( e, buf );
-			buf += tgt->dataSize();
-			j += TgtInfo::headerSize + tgt->dataSize();
-			assert( buf - &recvBuf_[recvNode][0] == j );
-		}
+		handleRecvBuf( buf, recvSize );
 		// Post the next Irecv.
 		unsigned int k = recvNode;
 		if ( recvNode > Shell::myNode() )
@@ -435,6 +649,25 @@ void PostMaster::clearPendingRecv()
 #endif
 }
 
+void PostMaster::handleRecvBuf( double* buf, int recvSize )
+{
+	const double* begin = buf;
+	int j = 0;
+	while ( j < recvSize ) {
+		const TgtInfo* tgt = reinterpret_cast< const TgtInfo * >( buf );
+		const Eref& e = tgt->eref();
+		const Finfo *f =
+			e.element()->cinfo()->getSrcFinfo( tgt->bindIndex() );
+		buf += TgtInfo::headerSize;
+		const SrcFinfo* sf = dynamic_cast< const SrcFinfo* >( f );
+		assert( sf );
+		sf->sendBuffer( e, buf );
+		buf += tgt->dataSize();
+		j += TgtInfo::headerSize + tgt->dataSize();
+		assert( buf - begin == j );
+	}
+}
+
 ///////////////////////////////////////////////////////////////
 // Data transfer and fillup operations.
 ///////////////////////////////////////////////////////////////
@@ -444,7 +677,12 @@ double* PostMaster::addToSendBuf( const Eref& e, unsigned int bindIndex,
 {
 	unsigned int node = e.fieldIndex(); // nasty evil wicked hack
 	unsigned int end = sendSize_[node];
-	if ( end + TgtInfo::headerSize + size > recvBufSize_ ) {
+	if ( exchangeInterval_ > 1 ) {
+		// Batched sends are sized on the fly, so just grow the buffer.
+		if ( end + TgtInfo::headerSize + size > sendBuf_[node].size() )
+			sendBuf_[node].resize(
+				2 * ( end + TgtInfo::headerSize + size ), 0 );
+	} else if ( end + TgtInfo::headerSize + size > recvBufSize_ ) {
 		// Here we need to activate the fallback second send which will
 		// deal with the big block. Also various routines for tracking
 		// send size so we don't get too big or small.
@@ -487,6 +725,22 @@ double* PostMaster::addToSetBuf( const Eref& e, unsigned int opIndex,
 void PostMaster::dispatchSetBuf( const Eref& e )
 {
 	assert ( e.element()->isGlobal() || e.getNode() != Shell::myNode() );
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		// The record is copied into the ring, so the send is done when
+		// this returns. While a ring is full we handle incoming calls,
+		// which may make set calls of their own, so send from a copy.
+		vector< double > rec( setSendBuf_.begin(),
+						setSendBuf_.begin() + setSendSize_ );
+		std::function< void() > poll = [this]() { clearPending(); };
+		for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
+			if ( i == Shell::myNode() ) continue;
+			if ( e.element()->isGlobal() || i == e.getNode() )
+				t->send( i, ShmTransport::SET, &rec[0], rec.size(), poll );
+		}
+		isSetSent_ = 1;
+		return;
+	}
 #ifdef USE_MPI
 	if ( e.element()->isGlobal() ) {
 		for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
@@ -520,6 +774,20 @@ void PostMaster::dispatchSetBuf( const Eref& e )
 double* PostMaster::remoteGet( const Eref& e, unsigned int bindIndex )
 {
 	static double getRecvBuf[setRecvBufSize];
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		double getSendBuf[TgtInfo::headerSize];
+		while ( isSetSent_ == 0 )
+			clearPending();
+		TgtInfo* tgt = reinterpret_cast< TgtInfo* >( &getSendBuf[0] );
+		tgt->set( e.objId(), bindIndex, MooseGetHop );
+		t->send( e.getNode(), ShmTransport::SET, getSendBuf,
+						TgtInfo::headerSize );
+		while ( t->recv( e.getNode(), ShmTransport::RETURN,
+								&getRecvBuf[0] ) < 0 )
+			clearPending();
+		return &getRecvBuf[0];
+	}
 #ifdef USE_MPI
 	static double getSendBuf[TgtInfo::headerSize];
 	static MPI_Request getSendReq;
@@ -579,6 +847,21 @@ void PostMaster::remoteFieldGetVec( const Eref& e, unsigned int bindIndex,
 	getRecvBuf.clear();
 	getRecvBuf.resize( reserveBufSize );
 
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		double getSendBuf[TgtInfo::headerSize];
+		while ( isSetSent_ == 0 )
+			clearPending();
+		TgtInfo* tgt = reinterpret_cast< TgtInfo* >( &getSendBuf[0] );
+		tgt->set( e.objId(), bindIndex, MooseGetVecHop );
+		t->send( targetNode, ShmTransport::SET, getSendBuf,
+						TgtInfo::headerSize );
+		while ( t->recv( targetNode, ShmTransport::RETURN,
+								&getRecvBuf[0] ) < 0 )
+			clearPending();
+		return;
+	}
+
 #ifdef USE_MPI
 	while ( isSetSent_ == 0 ) {
 			// Can't request a 'get' while old set is
@@ -636,6 +919,27 @@ void PostMaster::remoteGetVec( const Eref& e, unsigned int bindIndex,
 	getRecvBuf.clear();
 	getRecvBuf.resize( Shell::numNodes(), temp );
 
+	ShmTransport* t = ShmTransport::instance();
+	if ( t ) {
+		double getSendBuf[TgtInfo::headerSize];
+		while ( isSetSent_ == 0 )
+			clearPending();
+		TgtInfo* tgt = reinterpret_cast< TgtInfo* >( &getSendBuf[0] );
+		tgt->set( e.objId(), bindIndex, MooseGetVecHop );
+		for ( unsigned int i = 0; i < Shell::numNodes(); ++i )
+			if ( i != Shell::myNode() )
+				t->send( i, ShmTransport::SET, getSendBuf,
+								TgtInfo::headerSize );
+		for ( unsigned int i = 0; i < Shell::numNodes(); ++i ) {
+			if ( i == Shell::myNode() ) continue;
+			while ( t->recv( i, ShmTransport::RETURN,
+									&getRecvBuf[i][0] ) < 0 )
+				clearPending();
+			numOnNode[i] = getRecvBuf[i][0];
+		}
+		return;
+	}
+
 #ifdef USE_MPI
 	while ( isSetSent_ == 0 ) {
 			// Can't request a 'get' while old set is
@@ -724,3 +1028,72 @@ void PostMaster::setBufferSize( unsigned int size )
 	for ( unsigned int i =0; i < sendBuf_.size(); ++i )
 		sendBuf_[i].resize( size );
 }
+
+void PostMaster::setSpikeBatching( bool val )
+{
+	spikeBatching_ = val;
+}
+
+bool PostMaster::getSpikeBatching() const
+{
+	return spikeBatching_;
+}
+
+double PostMaster::getMinDelay() const
+{
+	return minDelay_;
+}
+
+unsigned int PostMaster::getExchangeInterval() const
+{
+	return exchangeInterval_;
+}
+
+double PostMaster::getNumExchanges() const
+{
+	return numExchanges_;
+}
+
+///////////////////////////////////////////////////////////////
+// Utility functions for spike batching
+///////////////////////////////////////////////////////////////
+
+unsigned int PostMaster::exchangeSteps( double minDelay, double dt )
+{
+	if ( dt <= 0.0 || minDelay < dt )
+		return 1;
+	// A spike sent on the first step of a batch goes out on its last
+	// step and is seen by the synapse on the step after, which must not
+	// be later than the delay.
+	double steps = floor( minDelay / dt + 1.0e-6 );
+	if ( steps > maxExchangeSteps )
+		return maxExchangeSteps;
+	return steps;
+}
+
+double PostMaster::localMinDelay()
+{
+	double ret = numeric_limits< double >::max();
+	vector< ObjId > handlers;
+	wildcardFind( "/##[ISA=SynHandlerBase]", handlers );
+	set< Id > done;
+	for ( vector< ObjId >::const_iterator
+			i = handlers.begin(); i != handlers.end(); ++i ) {
+		if ( !done.insert( i->id ).second )
+			continue;
+		Element* elm = i->element();
+		unsigned int start = elm->localDataStart();
+		unsigned int end = start + elm->numLocalData();
+		for ( unsigned int j = start; j < end; ++j ) {
+			SynHandlerBase* sh = reinterpret_cast< SynHandlerBase* >(
+							Eref( elm, j ).data() );
+			unsigned int n = sh->getNumSynapses();
+			for ( unsigned int k = 0; k < n; ++k ) {
+				double d = sh->getSynapse( k )->getDelay();
+				if ( d < ret )
+					ret = d;
+			}
+		}
+	}
+	return ret;
+}
@@ -60,6 +60,22 @@
  * that was filled when the digestMessages detected that a majority of
  * target nodes received a given message. A setup time complication, not
  * a runtime problem.
+ *
+ * Batched spike exchange.
+ * When the only traffic between nodes is spikes to synapses, we do not
+ * need to swap buffers on every step: a spike sent at time t is not
+ * used before t + delay. With spikeBatching on, reinit finds the
+ * smallest synaptic delay over all nodes, and process lets the send
+ * buffers fill up for as many steps as fit within it. Then the lot is
+ * exchanged in one MPI_Alltoallv, which also serves to synchronize the
+ * nodes, so there is no barrier on the intervening steps.
+ *
+ * Shared-memory transport.
+ * On a single host the nodes may instead be forked worker processes
+ * that talk through the POSIX shared-memory rings of ShmTransport,
+ * which needs no MPI install. This is chosen at startup, and the
+ * PostMaster then moves the very same buffers through the rings in
+ * place of the MPI calls. See ShmTransport.h.
  */
 
 #ifndef _POST_MASTER_H
@@ -108,6 +124,11 @@ class PostMaster {
 		unsigned int getMyNode() const;
 		unsigned int getBufferSize() const;
 		void setBufferSize( unsigned int size );
+		void setSpikeBatching( bool val );
+		bool getSpikeBatching() const;
+		double getMinDelay() const;
+		unsigned int getExchangeInterval() const;
+		double getNumExchanges() const;
 		void reinit( const Eref& e, ProcPtr p );
 		void process( const Eref& e, ProcPtr p );
 
@@ -119,6 +140,18 @@ class PostMaster {
 		void clearPendingRecv();
 		/// Checks that all sends have gone out
 		void finalizeSends();
+		/// Swaps all pending send buffers in one collective call.
+		void exchangeBatch();
+		/// Swaps the send buffers through the shared-memory rings.
+		void shmExchange();
+
+		/**
+		 * Returns the number of steps of size dt that spikes may be held
+		 * back, given the smallest synaptic delay. At least 1.
+		 */
+		static unsigned int exchangeSteps( double minDelay, double dt );
+		/// Smallest delay of any synapse on this node.
+		static double localMinDelay();
 
 		/// Handles 'get' calls from another node, to an object on mynode.
 		void handleRemoteGet( const Eref& e,
@@ -145,6 +178,7 @@ class PostMaster {
 				vector< double >& getRecvBuf );
 
 		static const unsigned int reserveBufSize;
+		static const unsigned int maxExchangeSteps;
 		static const unsigned int setRecvBufSize;
 		static const int MSGTAG;
 		static const int SETTAG;
@@ -154,6 +188,11 @@ class PostMaster {
 		static const int DIETAG;
 		static const Cinfo* initCinfo();
 	private:
+		/// Passes on the messages in a buffer that came from another node
+		void handleRecvBuf( double* buf, int recvSize );
+		/// Carries out a set, or answers a get, from another node.
+		void handleSetBuf( double* buf, int requestingNode );
+
 		unsigned int recvBufSize_;
 		// Used on master for sending, on others for receiving.
 		vector< double > setSendBuf_;
@@ -177,6 +216,21 @@ class PostMaster {
 		int isSetRecv_;
 		int setSendSize_;
 		unsigned int numRecvDone_;
+
+		bool spikeBatching_;
+		double minDelay_;
+		/// Number of steps between exchanges. 1 for the original scheme.
+		unsigned int exchangeInterval_;
+		unsigned int stepCount_;
+		double numExchanges_;
+		/// Packed buffers for the collective exchange.
+		vector< double > batchSendBuf_;
+		vector< double > batchRecvBuf_;
+
+		/// Receive buffer for the shared-memory transport.
+		vector< double > shmRecvBuf_;
+		/// Flags the nodes whose record for this exchange has come in.
+		vector< bool > shmRecvDone_;
 };
 
 #endif	// _POST_MASTER_H
@@ -0,0 +1,319 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include <thread>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#include "../basecode/header.h"
+#include "ShmTransport.h"
+
+static const size_t cacheLine = 64;
+
+static size_t roundUp( size_t n )
+{
+	return cacheLine * ( 1 + ( n - 1 ) / cacheLine );
+}
+
+/**
+ * The head and tail are on separate cache lines, since they are
+ * written by different processes.
+ */
+struct ShmTransport::Ring
+{
+	std::atomic< unsigned long long > head;
+	char pad1[ cacheLine - sizeof( std::atomic< unsigned long long > ) ];
+	std::atomic< unsigned long long > tail;
+	char pad2[ cacheLine - sizeof( std::atomic< unsigned long long > ) ];
+};
+
+/**
+ * The barrier state, followed by a slot per node for reductions.
+ */
+struct ShmTransport::Header
+{
+	std::atomic< unsigned int > count;
+	std::atomic< unsigned int > sense;
+	char pad[ cacheLine - 2 * sizeof( std::atomic< unsigned int > ) ];
+};
+
+ShmTransport* ShmTransport::instance_ = 0;
+
+ShmTransport::ShmTransport( unsigned int numNodes, unsigned int capacity )
+	:
+		numNodes_( numNodes ),
+		myNode_( 0 ),
+		capacity_( capacity ),
+		ringBytes_( roundUp( sizeof( Ring ) + capacity * sizeof( double ) ) ),
+		segmentBytes_( 0 ),
+		segment_( 0 ),
+		header_( 0 ),
+		sense_( 0 )
+{
+#ifndef _WIN32
+	size_t headerBytes = sizeof( Header ) +
+			roundUp( numNodes_ * sizeof( double ) );
+	segmentBytes_ = headerBytes +
+			ringBytes_ * numNodes_ * numNodes_ * NUM_CHANNELS;
+
+	stringstream ss;
+	ss << "/moose-shm-" << getpid() << "-" << this;
+	string name = ss.str();
+	int fd = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+	if ( fd < 0 ) {
+		cerr << "Error: ShmTransport: unable to open shared memory " <<
+			name << ": " << strerror( errno ) << endl;
+		return;
+	}
+	// The mapping outlives the name, so nothing is left behind however
+	// the processes end.
+	shm_unlink( name.c_str() );
+	if ( ftruncate( fd, segmentBytes_ ) != 0 ) {
+		cerr << "Error: ShmTransport: unable to size shared memory to " <<
+			segmentBytes_ << " bytes: " << strerror( errno ) << endl;
+		close( fd );
+		return;
+	}
+	void* p = mmap( 0, segmentBytes_, PROT_READ | PROT_WRITE, MAP_SHARED,
+					fd, 0 );
+	close( fd );
+	if ( p == MAP_FAILED ) {
+		cerr << "Error: ShmTransport: unable to map shared memory: " <<
+			strerror( errno ) << endl;
+		return;
+	}
+	segment_ = reinterpret_cast< char* >( p );
+	header_ = new( segment_ ) Header();
+	header_->count.store( 0 );
+	header_->sense.store( 0 );
+	char* rings = segment_ + headerBytes;
+	for ( unsigned int i = 0; i < numNodes_ * numNodes_ * NUM_CHANNELS; ++i ) {
+		Ring* r = new( rings + i * ringBytes_ ) Ring();
+		r->head.store( 0 );
+		r->tail.store( 0 );
+	}
+#endif // _WIN32
+}
+
+ShmTransport::~ShmTransport()
+{
+#ifndef _WIN32
+	if ( segment_ )
+		munmap( segment_, segmentBytes_ );
+#endif
+}
+
+unsigned int ShmTransport::launch( unsigned int numNodes,
+				unsigned int capacity )
+{
+#ifndef _WIN32
+	if ( instance_ || numNodes < 2 )
+		return 0;
+	ShmTransport* t = new ShmTransport( numNodes, capacity );
+	if ( !t->segment_ ) {
+		delete t;
+		return 0;
+	}
+	instance_ = t;
+	// Else anything still buffered is printed once by each worker.
+	cout << flush;
+	cerr << flush;
+	for ( unsigned int i = 1; i < numNodes; ++i ) {
+		pid_t pid = fork();
+		if ( pid == 0 ) {
+#ifdef __linux__
+			// Don't spin on if the parent dies.
+			prctl( PR_SET_PDEATHSIG, SIGTERM );
+#endif
+			t->myNode_ = i;
+			t->workers_.clear();
+			return i;
+		}
+		if ( pid < 0 ) {
+			cerr << "Error: ShmTransport::launch: fork failed for node " <<
+				i << ": " << strerror( errno ) << endl;
+			for ( unsigned int j = 0; j < t->workers_.size(); ++j )
+				kill( t->workers_[j], SIGTERM );
+			exit( 1 );
+		}
+		t->workers_.push_back( pid );
+	}
+#endif // _WIN32
+	return 0;
+}
+
+ShmTransport* ShmTransport::instance()
+{
+	return instance_;
+}
+
+bool ShmTransport::finalize()
+{
+	if ( !instance_ )
+		return true;
+	bool ret = true;
+#ifndef _WIN32
+	for ( unsigned int i = 0; i < instance_->workers_.size(); ++i ) {
+		int status = 0;
+		waitpid( instance_->workers_[i], &status, 0 );
+		if ( !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 ) {
+			cerr << "Error: ShmTransport::finalize: node " << i + 1 <<
+				" failed\n";
+			ret = false;
+		}
+	}
+#endif
+	delete instance_;
+	instance_ = 0;
+	return ret;
+}
+
+///////////////////////////////////////////////////////////////
+// Fields
+///////////////////////////////////////////////////////////////
+
+unsigned int ShmTransport::numNodes() const
+{
+	return numNodes_;
+}
+
+unsigned int ShmTransport::myNode() const
+{
+	return myNode_;
+}
+
+void ShmTransport::setMyNode( unsigned int node )
+{
+	assert( node < numNodes_ );
+	myNode_ = node;
+}
+
+unsigned int ShmTransport::maxRecord() const
+{
+	return capacity_ - 1;
+}
+
+///////////////////////////////////////////////////////////////
+// Data transfer
+///////////////////////////////////////////////////////////////
+
+ShmTransport::Ring* ShmTransport::ring( unsigned int src, unsigned int tgt,
+				unsigned int channel ) const
+{
+	assert( src < numNodes_ && tgt < numNodes_ && channel < NUM_CHANNELS );
+	size_t headerBytes = sizeof( Header ) +
+			roundUp( numNodes_ * sizeof( double ) );
+	size_t i = ( src * numNodes_ + tgt ) * NUM_CHANNELS + channel;
+	return reinterpret_cast< Ring* >(
+					segment_ + headerBytes + i * ringBytes_ );
+}
+
+double* ShmTransport::ringData( const Ring* r ) const
+{
+	return reinterpret_cast< double* >(
+		const_cast< char* >( reinterpret_cast< const char* >( r ) ) +
+		sizeof( Ring ) );
+}
+
+void ShmTransport::send( unsigned int tgt, unsigned int channel,
+		const double* buf, unsigned int size,
+		const std::function< void() >& poll )
+{
+	if ( size > maxRecord() ) {
+		cerr << "Error: ShmTransport::send on node " << myNode_ <<
+			": Data size (" << size << ") goes past end of buffer\n";
+		assert( 0 );
+		return;
+	}
+	Ring* r = ring( myNode_, tgt, channel );
+	double* data = ringData( r );
+	// The poll may send records of its own on this ring, so the head
+	// has to be read again each time round.
+	unsigned long long head;
+	while ( capacity_ - ( ( head = r->head.load( std::memory_order_relaxed ) )
+				- r->tail.load( std::memory_order_acquire ) ) < size + 1ULL ) {
+		if ( poll )
+			poll();
+		else
+			std::this_thread::yield();
+	}
+	data[ head % capacity_ ] = size;
+	unsigned int begin = ( head + 1 ) % capacity_;
+	unsigned int first = min( size, capacity_ - begin );
+	memcpy( data + begin, buf, first * sizeof( double ) );
+	memcpy( data, buf + first, ( size - first ) * sizeof( double ) );
+	r->head.store( head + size + 1, std::memory_order_release );
+}
+
+int ShmTransport::recv( unsigned int src, unsigned int channel,
+				double* buf )
+{
+	Ring* r = ring( src, myNode_, channel );
+	double* data = ringData( r );
+	unsigned long long tail = r->tail.load( std::memory_order_relaxed );
+	if ( r->head.load( std::memory_order_acquire ) == tail )
+		return -1;
+	unsigned int size = data[ tail % capacity_ ];
+	unsigned int begin = ( tail + 1 ) % capacity_;
+	unsigned int first = min( size, capacity_ - begin );
+	memcpy( buf, data + begin, first * sizeof( double ) );
+	memcpy( buf + first, data, ( size - first ) * sizeof( double ) );
+	r->tail.store( tail + size + 1, std::memory_order_release );
+	return size;
+}
+
+bool ShmTransport::isPending( unsigned int src, unsigned int channel ) const
+{
+	const Ring* r = ring( src, myNode_, channel );
+	return r->head.load( std::memory_order_acquire ) !=
+			r->tail.load( std::memory_order_relaxed );
+}
+
+///////////////////////////////////////////////////////////////
+// Collectives
+///////////////////////////////////////////////////////////////
+
+/**
+ * Sense-reversing barrier: the last node to arrive resets the count
+ * and flips the shared sense, which releases the others.
+ */
+void ShmTransport::barrier()
+{
+	sense_ = 1 - sense_;
+	if ( header_->count.fetch_add( 1, std::memory_order_acq_rel ) + 1
+					== numNodes_ ) {
+		header_->count.store( 0, std::memory_order_relaxed );
+		header_->sense.store( sense_, std::memory_order_release );
+	} else {
+		while ( header_->sense.load( std::memory_order_acquire ) != sense_ )
+			std::this_thread::yield();
+	}
+}
+
+double ShmTransport::allReduceMin( double val )
+{
+	double* slots = reinterpret_cast< double* >(
+					segment_ + sizeof( Header ) );
+	slots[ myNode_ ] = val;
+	barrier();
+	double ret = slots[0];
+	for ( unsigned int i = 1; i < numNodes_; ++i )
+		ret = min( ret, slots[i] );
+	// Nobody may write the slots again until all have read them.
+	barrier();
+	return ret;
+}
@@ -0,0 +1,121 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _SHM_TRANSPORT_H
+#define _SHM_TRANSPORT_H
+
+#include <atomic>
+#include <functional>
+
+/**
+ * Shared-memory transport for the PostMaster, for running several
+ * nodes as forked processes on one host without MPI.
+ *
+ * The parent process makes one POSIX shared memory segment and then
+ * forks a worker for each of the other nodes, so all of them map the
+ * same segment. The segment holds a ring buffer for each ordered pair
+ * of nodes and each channel. Each ring has a single writer and a
+ * single reader, so it needs no locks: the writer owns the head and
+ * the reader owns the tail.
+ *
+ * A ring carries records, each of which is a size followed by that
+ * many doubles. These are exactly the buffers that the PostMaster
+ * would otherwise hand to MPI, with the same TgtInfo headers, so the
+ * PostMaster packs and unpacks them the same way for both.
+ *
+ * The channels stand in for the MPI tags: MSG for the per-step
+ * message traffic, SET for set and get requests, and RETURN for the
+ * values that come back from a get.
+ */
+class ShmTransport
+{
+	public:
+		enum Channel { MSG = 0, SET = 1, RETURN = 2, NUM_CHANNELS = 3 };
+
+		/**
+		 * Makes and maps the segment, with rings of the given capacity
+		 * in doubles. The caller is node 0 until it forks.
+		 */
+		ShmTransport( unsigned int numNodes, unsigned int capacity );
+		~ShmTransport();
+
+		/**
+		 * Sets up the transport for numNodes nodes, and forks the
+		 * workers. Returns the node of the calling process: 0 in the
+		 * parent, 1 to numNodes - 1 in the workers. Returns 0 and does
+		 * nothing if the segment cannot be made.
+		 */
+		static unsigned int launch( unsigned int numNodes,
+						unsigned int capacity );
+
+		/// The transport in use, or 0 if the nodes are not on shm.
+		static ShmTransport* instance();
+
+		/**
+		 * Releases the transport at the end of the run. In the parent
+		 * this first waits for the workers to exit. Returns false if
+		 * any of them failed.
+		 */
+		static bool finalize();
+
+		unsigned int numNodes() const;
+		unsigned int myNode() const;
+		/// Used by the forked workers to record which node they are.
+		void setMyNode( unsigned int node );
+		/// Largest record that fits in a ring.
+		unsigned int maxRecord() const;
+
+		/**
+		 * Writes a record to node tgt on the channel. If the ring is
+		 * full this waits for the reader, calling poll meanwhile so
+		 * that the caller can keep clearing its own incoming rings.
+		 */
+		void send( unsigned int tgt, unsigned int channel,
+				const double* buf, unsigned int size,
+				const std::function< void() >& poll =
+						std::function< void() >() );
+
+		/**
+		 * Reads the next record from node src on the channel into buf.
+		 * Returns the size of the record, or -1 if there is none yet.
+		 * buf must have room for maxRecord() doubles.
+		 */
+		int recv( unsigned int src, unsigned int channel, double* buf );
+
+		/// True if a record from node src is waiting on the channel.
+		bool isPending( unsigned int src, unsigned int channel ) const;
+
+		/// Blocks until all nodes have arrived.
+		void barrier();
+
+		/// Smallest of the values given by each node, on all nodes.
+		double allReduceMin( double val );
+	private:
+		struct Ring;
+		struct Header;
+		Ring* ring( unsigned int src, unsigned int tgt,
+						unsigned int channel ) const;
+		double* ringData( const Ring* r ) const;
+
+		unsigned int numNodes_;
+		unsigned int myNode_;
+		unsigned int capacity_;
+		size_t ringBytes_;
+		size_t segmentBytes_;
+		char* segment_;
+		Header* header_;
+		/// Local copy of the barrier sense of this node.
+		unsigned int sense_;
+		/// Process ids of the workers, in the parent.
+		vector< int > workers_;
+
+		static ShmTransport* instance_;
+};
+
+#endif // _SHM_TRANSPORT_H
@@ -7,7 +7,174 @@
 ** See the file COPYING.LIB for the full notice.
 **********************************************************************/
 
-void testMpi()
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "../basecode/header.h"
+#include "../randnum/randnum.h"
+#include "../shell/Shell.h"
+#include "PostMaster.h"
+#include "ShmTransport.h"
+
+void testExchangeSteps()
+{
+	// Delays shorter than a step force an exchange every step.
+	assert( PostMaster::exchangeSteps( 0.0, 1e-4 ) == 1 );
+	assert( PostMaster::exchangeSteps( 5e-5, 1e-4 ) == 1 );
+	// Rounding must not push a batch past the delay.
+	assert( PostMaster::exchangeSteps( 1e-3, 25e-6 ) == 40 );
+	assert( PostMaster::exchangeSteps( 1.05e-3, 25e-6 ) == 42 );
+	assert( PostMaster::exchangeSteps( 0.999e-3, 25e-6 ) == 39 );
+	assert( PostMaster::exchangeSteps( 1e3, 25e-6 ) ==
+					PostMaster::maxExchangeSteps );
+	assert( PostMaster::exchangeSteps( 1e-3, 0.0 ) == 1 );
+	cout << "." << flush;
+}
+
+/**
+ * Forks a worker that sends records of growing size through a small
+ * ring, so that they wrap around and the writer has to wait for the
+ * reader. Then checks the barrier and the reduction.
+ */
+void testShmTransport()
 {
+#if !defined( _WIN32 ) && !defined( USE_MPI )
+	const unsigned int capacity = 64;
+	const unsigned int numRecords = 50;
+	ShmTransport t( 2, capacity );
+	cout << flush;
+	pid_t pid = fork();
+	assert( pid >= 0 );
+	if ( pid == 0 ) {
+		t.setMyNode( 1 );
+		vector< double > buf( capacity, 0.0 );
+		for ( unsigned int i = 0; i < numRecords; ++i ) {
+			unsigned int size = i % 20;
+			for ( unsigned int j = 0; j < size; ++j )
+				buf[j] = i * 100 + j;
+			t.send( 0, ShmTransport::MSG, &buf[0], size );
+		}
+		t.barrier();
+		double m = t.allReduceMin( 3.0 );
+		t.send( 0, ShmTransport::RETURN, &m, 1 );
+		_exit( 0 );
+	}
+	vector< double > buf( capacity, 0.0 );
+	for ( unsigned int i = 0; i < numRecords; ++i ) {
+		int size;
+		while ( ( size = t.recv( 1, ShmTransport::MSG, &buf[0] ) ) < 0 )
+			;
+		assert( size == static_cast< int >( i % 20 ) );
+		for ( int j = 0; j < size; ++j )
+			assert( doubleEq( buf[j], i * 100 + j ) );
+	}
+	assert( t.recv( 1, ShmTransport::MSG, &buf[0] ) == -1 );
+	t.barrier();
+	assert( doubleEq( t.allReduceMin( 2.0 ), 2.0 ) );
+	while ( t.recv( 1, ShmTransport::RETURN, &buf[0] ) < 0 )
 		;
+	assert( doubleEq( buf[0], 2.0 ) );
+	int status = 1;
+	waitpid( pid, &status, 0 );
+	assert( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+	cout << "." << flush;
+#endif
+}
+
+void testMpi()
+{
+	testExchangeSteps();
+	testShmTransport();
+}
+
+/**
+ * Makes a small IntFire network spread over all the nodes, runs it and
+ * returns the final Vm of every cell. The shortest delay is five steps.
+ */
+static vector< double > runBatchNet( bool spikeBatching )
+{
+	const unsigned int size = 128;
+	const unsigned int runsteps = 100;
+	const double timestep = 0.2;
+	const double delayMin = 1.0;
+	const double delayMax = 2.0;
+	const double weightMax = 0.2;
+	Shell* shell = reinterpret_cast< Shell* >( Id().eref().data() );
+	ObjId pm( 3 );
+
+	Id fire = shell->doCreate( "IntFire", Id(), "batchnet", size );
+	Id syns = shell->doCreate( "SimpleSynHandler", fire, "syns", size );
+	Id synId( syns.value() + 1 );
+	ObjId mid = shell->doAddMsg( "Sparse", fire, "spikeOut",
+					ObjId( synId, 0 ), "addSpike" );
+	SetGet2< double, long >::set( mid, "setRandomConnectivity", 0.1, 5489L );
+	mid = shell->doAddMsg( "OneToOne", syns, "activationOut",
+					fire, "activation" );
+	assert( !mid.bad() );
+
+	vector< double > temp( size, 0.8 );
+	Field< double >::setVec( fire, "thresh", temp );
+	temp.assign( size, 0.4 );
+	Field< double >::setVec( fire, "refractoryPeriod", temp );
+
+	moose::mtseed( 5489UL );
+	vector< unsigned int > numSynVec;
+	Field< unsigned int >::getVec( syns, "numSynapses", numSynVec );
+	assert( numSynVec.size() == size );
+	for ( unsigned int i = 0; i < size; ++i ) {
+		vector< double > weight( numSynVec[i] );
+		vector< double > delay( numSynVec[i] );
+		for ( unsigned int j = 0; j < numSynVec[i]; ++j ) {
+			weight[j] = moose::mtrand() * weightMax;
+			delay[j] = delayMin + moose::mtrand() * ( delayMax - delayMin );
+		}
+		Field< double >::setVec( ObjId( synId, i ), "weight", weight );
+		Field< double >::setVec( ObjId( synId, i ), "delay", delay );
+	}
+	vector< double > initVm( size );
+	for ( unsigned int i = 0; i < size; ++i )
+		initVm[i] = moose::mtrand();
+
+	shell->doUseClock( "/batchnet/syns", "process", 0 );
+	shell->doUseClock( "/batchnet", "process", 1 );
+	shell->doSetClock( 0, timestep );
+	shell->doSetClock( 1, timestep );
+	shell->doSetClock( 9, timestep );
+	Field< bool >::set( pm, "spikeBatching", spikeBatching );
+	shell->doReinit();
+	Field< double >::setVec( fire, "Vm", initVm );
+	shell->doStart( timestep * runsteps );
+
+	// The postmaster is only scheduled when there is more than one node.
+	if ( Shell::numNodes() > 1 ) {
+		unsigned int interval = spikeBatching ? 5 : 1;
+		assert( Field< unsigned int >::get( pm, "exchangeInterval" ) ==
+						interval );
+		assert( doubleEq( Field< double >::get( pm, "numExchanges" ),
+								runsteps / interval ) );
+	}
+	vector< double > Vm;
+	Field< double >::getVec( fire, "Vm", Vm );
+	assert( Vm.size() == size );
+	// The run must have made some of the cells fire.
+	assert( Vm != initVm );
+
+	Field< bool >::set( pm, "spikeBatching", false );
+	shell->doDelete( fire );
+	return Vm;
+}
+
+/**
+ * Runs the same network with an exchange on every step and with
+ * spikeBatching on, and checks that the two agree. Needs two or more
+ * nodes to exercise the exchange at all.
+ */
+void testMpiSpikeBatch()
+{
+	vector< double > Vm0 = runBatchNet( false );
+	vector< double > Vm1 = runBatchNet( true );
+	for ( unsigned int i = 0; i < Vm0.size(); ++i )
+		assert( doubleEq( Vm0[i], Vm1[i] ) );
+	cout << "." << flush;
 }
@@ -15,6 +15,7 @@
 #include "OneToAllMsg.h"
 #include "../basecode/SparseMatrix.h"
 #include "SparseMsg.h"
+#include "MsgPool.h"
 #include "../shell/Shell.h" // For the myNode() and numNodes() definitions
 #include "../basecode/MsgElement.h"
 
@@ -329,6 +330,8 @@ void Msg::clearAllMsgs()
         Msg* m = reinterpret_cast< Msg* >( SparseMsg::lookupMsg( i ) );
         if ( m ) delete m;
     }
+    MsgPool< SingleMsg >::clear();
+    MsgPool< SparseMsg >::clear();
 }
 
 /**
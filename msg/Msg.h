@@ -55,6 +55,20 @@ class Msg
 		  */
 		 virtual void targets( vector< vector< Eref > >& v ) const = 0;
 
+		 /**
+		  * Hook for Msgs whose forward traffic has been handed over to
+		  * a router object which takes care of the fan-out itself.
+		  * If so, fills v with one router Eref per data entry on e1,
+		  * and returns the OpFunc to call on it in place of the target
+		  * functions. Otherwise returns 0, and delivery goes to the
+		  * targets as usual.
+		  */
+		 virtual const OpFunc* routedTargets(
+				vector< vector< Eref > >& v ) const
+		 {
+			 return 0;
+		 }
+
 		/**
 		 * Return the first element
 		 */
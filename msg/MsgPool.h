@@ -0,0 +1,137 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2003-2010 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _MSG_POOL_H
+#define _MSG_POOL_H
+
+#include <new>
+
+/**
+ * Slab allocator for the small, numerous Msg subclasses.
+ * Each Msg used to be a separately heap-allocated object, and in
+ * network models with millions of SingleMsgs the malloc bookkeeping and
+ * scattering of these objects across the heap dominate both memory use
+ * and setup time. Here we carve Msgs out of large contiguous blocks,
+ * and keep a free list of released slots so that deleted Msgs are
+ * recycled in place.
+ *
+ * Msg classes use this by overriding their class-level operator new
+ * and operator delete:
+ *		static void* operator new( size_t sz ) {
+ *			return MsgPool< SingleMsg >::alloc( sz );
+ *		}
+ *		static void operator delete( void* p, size_t sz ) {
+ *			MsgPool< SingleMsg >::release( p, sz );
+ *		}
+ * The pool is not thread-safe, but neither is Msg creation, which
+ * always happens on the Shell thread.
+ */
+template< class T > class MsgPool
+{
+	public:
+		/**
+		 * Returns storage for one object of type T. Falls back to the
+		 * global heap if asked for a larger size, which happens if
+		 * a subclass of T does not have its own pool.
+		 */
+		static void* alloc( size_t sz )
+		{
+			if ( sz > sizeof( Slot ) )
+				return ::operator new( sz );
+			if ( !freeList_ )
+				addBlock();
+			Slot* s = freeList_;
+			freeList_ = s->next;
+			++numInUse_;
+			return s;
+		}
+
+		/**
+		 * Returns the slot to the free list. The size must be the one
+		 * passed to alloc, so that oversize requests which were served
+		 * from the global heap go back there.
+		 */
+		static void release( void* p, size_t sz )
+		{
+			if ( !p )
+				return;
+			if ( sz > sizeof( Slot ) ) {
+				::operator delete( p );
+				return;
+			}
+			Slot* s = static_cast< Slot* >( p );
+			s->next = freeList_;
+			freeList_ = s;
+			--numInUse_;
+		}
+
+		/**
+		 * Frees all blocks. Only to be called when every object in
+		 * the pool has already been destroyed, as in
+		 * Msg::clearAllMsgs. Otherwise the blocks are kept, so that
+		 * the live objects stay valid, and a warning is printed.
+		 */
+		static void clear()
+		{
+			assert( numInUse_ == 0 );
+			if ( numInUse_ != 0 ) {
+				cerr << "Warning: MsgPool::clear: " << numInUse_ <<
+					" Msgs are still in use. Not freeing the pool.\n";
+				return;
+			}
+			for ( unsigned int i = 0; i < blocks_.size(); ++i )
+				::operator delete( blocks_[i] );
+			blocks_.clear();
+			freeList_ = 0;
+		}
+
+		/// Number of slots currently handed out.
+		static unsigned int numInUse()
+		{
+			return numInUse_;
+		}
+
+		/// Number of bytes reserved by the pool.
+		static size_t reservedBytes()
+		{
+			return blocks_.size() * BlockSize * sizeof( Slot );
+		}
+
+	private:
+		union Slot {
+			Slot* next;
+			alignas( T ) char data[ sizeof( T ) ];
+		};
+
+		static const unsigned int BlockSize = 4096;
+
+		static void addBlock()
+		{
+			Slot* block = static_cast< Slot* >(
+				::operator new( BlockSize * sizeof( Slot ) ) );
+			blocks_.push_back( block );
+			// Thread the free list so that the lowest address is
+			// handed out first. Keeps consecutive Msgs adjacent.
+			for ( unsigned int i = 0; i < BlockSize - 1; ++i )
+				block[i].next = &block[i + 1];
+			block[ BlockSize - 1 ].next = freeList_;
+			freeList_ = block;
+		}
+
+		static vector< Slot* > blocks_;
+		static Slot* freeList_;
+		static unsigned int numInUse_;
+};
+
+template< class T > vector< typename MsgPool< T >::Slot* >
+	MsgPool< T >::blocks_;
+template< class T > typename MsgPool< T >::Slot* MsgPool< T >::freeList_ = 0;
+template< class T > unsigned int MsgPool< T >::numInUse_ = 0;
+
+#endif // _MSG_POOL_H
@@ -143,6 +143,16 @@ Msg* OneToOneMsg::copy( Id origSrc, Id newSrc, Id newTgt,
 	return ret;
 }
 
+DataId OneToOneMsg::getI1() const
+{
+	return i1_;
+}
+
+DataId OneToOneMsg::getI2() const
+{
+	return i2_;
+}
+
 /// Static function for Msg access
 unsigned int OneToOneMsg::numMsg()
 {
@@ -38,6 +38,12 @@ class OneToOneMsg: public Msg
 		Msg* copy( Id origSrc, Id newSrc, Id newTgt,
 			FuncId fid, unsigned int b, unsigned int n ) const;
 
+		/// Returns the DataId of e1 used when e2 is a FieldElement.
+		DataId getI1() const;
+
+		/// Returns the DataId of e2 used when e2 is a FieldElement.
+		DataId getI2() const;
+
 		/// Msg lookup functions
 		static unsigned int numMsg();
 		static char* lookupMsg( unsigned int index );
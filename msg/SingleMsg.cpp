@@ -9,6 +9,7 @@
 
 #include "../basecode/header.h"
 #include "SingleMsg.h"
+#include "MsgPool.h"
 
 // Initializing static variables
 Id SingleMsg::managerId_;
@@ -43,6 +44,16 @@ SingleMsg::~SingleMsg()
     msg_[ mid_.dataIndex ] = 0; // ensure deleted ptr isn't reused.
 }
 
+void* SingleMsg::operator new( size_t sz )
+{
+    return MsgPool< SingleMsg >::alloc( sz );
+}
+
+void SingleMsg::operator delete( void* p, size_t sz )
+{
+    MsgPool< SingleMsg >::release( p, sz );
+}
+
 Eref SingleMsg::firstTgt( const Eref& src ) const
 {
     if ( src.element() == e1_ )
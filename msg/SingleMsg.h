@@ -24,6 +24,13 @@ class SingleMsg: public Msg
 		SingleMsg( const Eref& e1, const Eref& e2, unsigned int msgIndex );
 		~SingleMsg();
 
+		/**
+		 * SingleMsgs are allocated from a pool, as large network
+		 * models can have millions of them.
+		 */
+		static void* operator new( size_t sz );
+		static void operator delete( void* p, size_t sz );
+
 		Eref firstTgt( const Eref& src ) const;
 
 		void sources( vector< vector< Eref > >& v ) const;
@@ -13,6 +13,7 @@
 #include "../shell/Shell.h"
 #include "../basecode/SparseMatrix.h"
 #include "SparseMsg.h"
+#include "MsgPool.h"
 
 // Initializing static variables
 Id SparseMsg::managerId_;
@@ -375,6 +376,48 @@ void SparseMsg::tripletFill1( vector< unsigned int > v )
     tripletFill( src, dest, fieldIndex );
 }
 
+bool SparseMsg::batchFill( const unsigned int* src, const unsigned int* dest,
+                           const unsigned int* field, size_t n )
+{
+    unsigned int numSrc = e1()->numData();
+    unsigned int numDest = e2()->numData();
+    if ( n >= ~0U )
+    {
+        cout << "Warning: SparseMsg::batchFill: " << n <<
+             " entries is too many. Aborting\n";
+        return false;
+    }
+    // Number of field entries needed on each dest.
+    vector< unsigned int > numField( numDest, 0 );
+    for ( size_t i = 0; i < n; ++i )
+    {
+        if ( src[i] >= numSrc || dest[i] >= numDest )
+        {
+            cout << "Warning: SparseMsg::batchFill: entry " << i <<
+                 " ( " << src[i] << ", " << dest[i] <<
+                 " ) exceeds array sizes ( " << numSrc << ", " <<
+                 numDest << " ). Aborting\n";
+            return false;
+        }
+        if ( numField[ dest[i] ] <= field[i] )
+            numField[ dest[i] ] = field[i] + 1;
+    }
+
+    matrix_.setSize( numSrc, numDest );
+    matrix_.countingFill( src, dest, field, n );
+
+    unsigned int startData = e2_->localDataStart();
+    unsigned int endData = startData + e2_->numLocalData();
+    for ( unsigned int i = startData; i < endData; ++i )
+    {
+        if ( numField[i] > e2_->numField( i - startData ) )
+            e2_->resizeField( i - startData, numField[i] );
+    }
+    e1()->markRewired();
+    e2()->markRewired();
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////
 //    Here are the actual class functions
 //////////////////////////////////////////////////////////////////
@@ -385,6 +428,7 @@ SparseMsg::SparseMsg( Element* e1, Element* e2, unsigned int msgIndex )
       numThreads_( 1 ),
       nrows_( 0 ),
       p_( 0.0 ),
+      routerFunc_( 0 ),
       seed_(-1)
 {
     unsigned int nrows = 0;
@@ -417,6 +461,16 @@ SparseMsg::~SparseMsg()
     msg_[ mid_.dataIndex ] = 0; // ensure deleted ptr isn't reused.
 }
 
+void* SparseMsg::operator new( size_t sz )
+{
+    return MsgPool< SparseMsg >::alloc( sz );
+}
+
+void SparseMsg::operator delete( void* p, size_t sz )
+{
+    MsgPool< SparseMsg >::release( p, sz );
+}
+
 unsigned int rowIndex( const Element* e, const DataId& d )
 {
     // FieldDataHandlerBase* fdh = dynamic_cast< FieldDataHandlerBase* >( e->dataHandler() );
@@ -425,6 +479,31 @@ unsigned int rowIndex( const Element* e, const DataId& d )
 }
 
 
+void SparseMsg::setRouter( ObjId router, const OpFunc* func )
+{
+    router_ = router;
+    routerFunc_ = func;
+    if ( !func )
+        router_ = ObjId();
+    e1()->markRewired();
+}
+
+ObjId SparseMsg::getRouter() const
+{
+    return router_;
+}
+
+const OpFunc* SparseMsg::routedTargets( vector< vector< Eref > >& v ) const
+{
+    if ( !routerFunc_ || !router_.element() )
+        return 0;
+    v.clear();
+    v.resize( e1()->numData() );
+    for ( unsigned int i = 0; i < v.size(); ++i )
+        v[i].push_back( Eref( router_.element(), router_.dataIndex, i ) );
+    return routerFunc_;
+}
+
 Eref SparseMsg::firstTgt( const Eref& src ) const
 {
     if ( matrix_.nEntries() == 0 )
@@ -52,10 +52,25 @@ public:
     SparseMsg( Element* e1, Element* e2, unsigned int msgIndex );
     ~SparseMsg();
 
+    /// SparseMsgs are carved out of their own MsgPool< SparseMsg >.
+    static void* operator new( size_t sz );
+    static void operator delete( void* p, size_t sz );
+
     Eref firstTgt( const Eref& src ) const;
 
     void sources( vector< vector< Eref > >& v ) const;
     void targets( vector< vector< Eref > >& v ) const;
+    const OpFunc* routedTargets( vector< vector< Eref > >& v ) const;
+
+    /**
+     * Hands delivery of all forward traffic on this Msg to a router
+     * object, which is called with the func instead of the targets.
+     * The router Eref carries the index of the source entry as its
+     * fieldIndex. Passing a zero func restores normal delivery.
+     * The matrix is untouched, so introspection works as before.
+     */
+    void setRouter( ObjId router, const OpFunc* func );
+    ObjId getRouter() const;
 
     unsigned int randomConnect( double probability );
 
@@ -128,6 +143,17 @@ public:
      */
     void tripletFill1( vector< unsigned int > entries );
 
+    /**
+     * Fills up the entire message from n triplets of
+     * src,destDataIndex,destFieldIndex held in plain arrays, as passed
+     * in from numpy. The matrix is built in linear time, and each dest
+     * field array is grown to hold the largest field index that uses
+     * it. Returns false, leaving the message as it was, if an index is
+     * out of range.
+     */
+    bool batchFill( const unsigned int* src, const unsigned int* dest,
+                    const unsigned int* field, size_t n );
+
     /**
      * Utility function to update all sorts of values after we've
      * rebuilt the matrix.
@@ -145,6 +171,8 @@ private:
     unsigned int numThreads_; // Number of threads to partition
     unsigned int nrows_; // The original size of the matrix.
     double p_;
+    ObjId router_; // Object that has taken over the fan-out, if any.
+    const OpFunc* routerFunc_;
     static Id managerId_; // The Element that manages Sparse Msgs.
     static vector< SparseMsg* > msg_;
 
@@ -11,6 +11,10 @@
 #include "../builtins/Arith.h"
 
 #include "../shell/Shell.h"
+#include "SingleMsg.h"
+#include "../basecode/SparseMatrix.h"
+#include "SparseMsg.h"
+#include "MsgPool.h"
 
 void testAssortedMsg()
 {
@@ -367,10 +371,94 @@ void benchmarkMsg( unsigned int n, string msgType )
 	shell->doDelete( a1 );
 }
 
+/**
+ * Checks that batches of single connections end up in one SparseMsg
+ * which can still be traversed like individual Msgs, and that pooled
+ * SingleMsgs recycle their slots.
+ */
+void testMsgBatch()
+{
+	Eref sheller = Id().eref();
+	Shell* shell = reinterpret_cast< Shell* >( sheller.data() );
+	Id a1 = shell->doCreate( "Arith", ObjId(), "a1", 5 );
+	Id a2 = shell->doCreate( "Arith", ObjId(), "a2", 5 );
+
+	vector< unsigned int > src = { 0, 1, 3 };
+	vector< unsigned int > dest = { 4, 3, 1 };
+	vector< unsigned int > none;
+	ObjId mid = shell->doAddMsgBatch( a1, "output", a2, "arg1",
+		src, dest, none );
+	assert( !mid.bad() );
+	const Msg* m = Msg::getMsg( mid );
+	assert( dynamic_cast< const SparseMsg* >( m ) != 0 );
+	assert( Field< unsigned int >::get( mid, "numEntries" ) == 3 );
+	for ( unsigned int i = 0; i < src.size(); ++i ) {
+		ObjId f = m->findOtherEnd( ObjId( a1, src[i] ) );
+		assert( f == ObjId( a2, dest[i] ) );
+	}
+	// Mismatched lengths are rejected.
+	dest.pop_back();
+	assert( shell->doAddMsgBatch( a1, "output", a2, "arg1",
+		src, dest, none ).bad() );
+
+	// Plain arrays onto synapses, with weights and delays.
+	Id syns = shell->doCreate( "SimpleSynHandler", ObjId(), "syns", 4 );
+	Id synId( syns.value() + 1 );
+	unsigned int bs[] = { 0, 4, 2, 2, 1 };
+	unsigned int bd[] = { 3, 3, 0, 3, 1 };
+	double bw[] = { 0.5, 1.5, 2.5, 3.5, 4.5 };
+	double bdelay[] = { 1, 2, 3, 4, 5 };
+	ObjId bm = shell->doAddMsgBatch( a1, "output", synId, "addSpike", 5,
+		bs, bd, 0, bw, bdelay );
+	assert( !bm.bad() );
+	assert( Field< unsigned int >::get( bm, "numEntries" ) == 5 );
+	assert( Field< unsigned int >::get( ObjId( syns, 3 ), "numSynapses" ) == 3 );
+	assert( Field< unsigned int >::get( ObjId( syns, 0 ), "numSynapses" ) == 1 );
+	assert( Field< unsigned int >::get( ObjId( syns, 2 ), "numSynapses" ) == 0 );
+	// Dest 3 gets field entries in the order its connections come.
+	assert( doubleEq( Field< double >::get( ObjId( synId, 3, 0 ), "weight" ), 0.5 ) );
+	assert( doubleEq( Field< double >::get( ObjId( synId, 3, 1 ), "weight" ), 1.5 ) );
+	assert( doubleEq( Field< double >::get( ObjId( synId, 3, 2 ), "delay" ), 4 ) );
+	assert( doubleEq( Field< double >::get( ObjId( synId, 1, 0 ), "delay" ), 5 ) );
+	vector< unsigned int > rowStart =
+		Field< vector< unsigned int > >::get( bm, "rowStart" );
+	vector< unsigned int > colIndex =
+		Field< vector< unsigned int > >::get( bm, "columnIndex" );
+	assert( rowStart.size() == 6 && rowStart[2] == 2 && rowStart[3] == 4 );
+	assert( colIndex[2] == 0 && colIndex[3] == 3 );
+	// An out of range index leaves no message behind.
+	bd[4] = 4;
+	assert( shell->doAddMsgBatch( a1, "output", synId, "addSpike", 5,
+		bs, bd, 0 ).bad() );
+	shell->doDelete( syns );
+
+	// A deleted Msg gives its slot back to the pool, and a new Msg reuses
+	// it without the pool growing. The MsgId is not reused.
+	unsigned int numInUse = MsgPool< SingleMsg >::numInUse();
+	size_t reserved = MsgPool< SingleMsg >::reservedBytes();
+	ObjId m1 = shell->doAddMsg( "Single",
+		ObjId( a1, 2 ), "output", ObjId( a2, 2 ), "arg1" );
+	assert( MsgPool< SingleMsg >::numInUse() == numInUse + 1 );
+	shell->doDelete( m1 );
+	assert( MsgPool< SingleMsg >::numInUse() == numInUse );
+	assert( Msg::getMsg( m1 ) == 0 );
+	ObjId m2 = shell->doAddMsg( "Single",
+		ObjId( a1, 2 ), "output", ObjId( a2, 2 ), "arg1" );
+	assert( m2 != m1 );
+	assert( Msg::getMsg( m2 )->mid() == m2 );
+	assert( MsgPool< SingleMsg >::numInUse() == numInUse + 1 );
+	assert( MsgPool< SingleMsg >::reservedBytes() == reserved );
+
+	shell->doDelete( a1 );
+	shell->doDelete( a2 );
+	cout << "." << flush;
+}
+
 void testMsg()
 {
     testAssortedMsg();
     testMsgElementListing();
+    testMsgBatch();
 }
 
 void testMpiMsg( )
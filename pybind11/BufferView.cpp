@@ -0,0 +1,88 @@
+// =====================================================================================
+//
+//       Filename:  BufferView.cpp
+//
+//    Description:  Read-only views of MOOSE storage through the Python
+//                  buffer protocol.
+//
+//   Organization:  NCBS Bangalore
+//
+// =====================================================================================
+
+#include "../basecode/header.h"
+#include "../builtins/TableBase.h"
+#include "../ksolve/KsolveBase.h"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+#include "BufferView.h"
+#include "helper.h"
+
+BufferView::BufferView(const ObjId& oid, unsigned int index)
+    : oid_(oid), index_(index)
+{
+    // Fail early on objects that have no such storage.
+    storage();
+}
+
+const vector<double>& BufferView::storage() const
+{
+    if(oid_.bad() || !oid_.isDataHere())
+        throw py::value_error("moose.view: no data for " + oid_.path());
+
+    const Cinfo* cinfo = oid_.element()->cinfo();
+    if(cinfo->isA("TableBase")) {
+        TableBase* tb = reinterpret_cast<TableBase*>(oid_.data());
+        // A Table past its ringSize has its older entries on disk, which
+        // a view of the memory would silently leave out.
+        if(tb->getVecSize() != tb->data().size())
+            throw py::value_error("moose.view: " + oid_.path() +
+                                  " has entries spilled to disk. Use its"
+                                  " vector field instead.");
+        return tb->data();
+    }
+
+    if(cinfo->isA("Ksolve") || cinfo->isA("Dsolve")) {
+        const KsolveBase* ks = reinterpret_cast<KsolveBase*>(oid_.data());
+        const vector<double>* v = ks->nVecStorage(index_);
+        if(!v)
+            throw py::index_error("moose.view: index " + to_string(index_) +
+                                  " is out of range on " + oid_.path());
+        return *v;
+    }
+    throw py::type_error("moose.view: " + cinfo->name() +
+                         " has no storage that can be viewed.");
+}
+
+py::buffer_info BufferView::buffer() const
+{
+    // The storage may grow, and so move, under a running simulation.
+    if(mooseIsRunningWithoutGil())
+        throw py::value_error("moose.view: cannot view " + oid_.path() +
+                              " while moose.start is running.");
+    const vector<double>& v = storage();
+    // An empty vector may have no storage at all.
+    static double empty = 0.0;
+    double* ptr = v.empty() ? &empty : const_cast<double*>(v.data());
+    return py::buffer_info(ptr, sizeof(double),
+                           py::format_descriptor<double>::format(), 1,
+                           {(py::ssize_t)v.size()}, {(py::ssize_t)sizeof(double)},
+                           true);
+}
+
+size_t BufferView::size() const
+{
+    return storage().size();
+}
+
+const ObjId& BufferView::obj() const
+{
+    return oid_;
+}
+
+unsigned int BufferView::index() const
+{
+    return index_;
+}
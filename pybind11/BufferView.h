@@ -0,0 +1,71 @@
+// =====================================================================================
+//
+//       Filename:  BufferView.h
+//
+//    Description:  Read-only views of MOOSE storage through the Python
+//                  buffer protocol.
+//
+//   Organization:  NCBS Bangalore
+//
+// =====================================================================================
+
+#ifndef BUFFER_VIEW_H
+#define BUFFER_VIEW_H
+
+#include "../basecode/header.h"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/**
+ * @brief A view of the values an object keeps in a vector<double>, handed
+ * to Python without copying them:
+ *
+ *   Table (or any TableBase): the vector field. A Table that has spilled
+ *   entries to disk (see ringSize) cannot be viewed, since the view would
+ *   hold only the entries still in memory.
+ *   Ksolve: nVec of voxel `index`, that is # of every pool in the voxel.
+ *   Dsolve: nVec of pool `index`, that is # of the pool in every voxel.
+ *
+ * The storage is looked up afresh each time Python takes a buffer from the
+ * view, so np.asarray(view) always sees the current values. The array it
+ * returns aliases the storage, and is valid only as long as the storage is
+ * not resized:
+ *
+ *   Table: until the next reinit, start or clearVec. The vector grows as
+ *   the simulation runs, which may move it.
+ *   Ksolve and Dsolve: until the next reinit, or until the solver is
+ *   rebuilt (new path, compartment or stoich).
+ *
+ * Take a new array from the view after any of these. The buffer is read
+ * only; use the fields to change values.
+ *
+ * While moose.start runs on another thread, taking a buffer raises
+ * ValueError, and arrays taken before the run must not be read until it
+ * returns. Use a Snapshot to watch a running simulation.
+ */
+class BufferView
+{
+public:
+    BufferView(const ObjId& oid, unsigned int index);
+
+    py::buffer_info buffer() const;
+
+    size_t size() const;
+
+    const ObjId& obj() const;
+
+    unsigned int index() const;
+
+private:
+    // The storage, or an exception if there is none.
+    const vector<double>& storage() const;
+
+    ObjId oid_;
+    unsigned int index_;
+};
+
+#endif /* end of include guard: BUFFER_VIEW_H */
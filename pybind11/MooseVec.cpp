@@ -149,7 +149,7 @@ py::object MooseVec::getAttribute(const string& name)
     if(rttType == "unsigned int")
         return getAttributeNumpy<unsigned int>(name);
     if(rttType == "int")
-        return getAttributeNumpy<unsigned int>(name);
+        return getAttributeNumpy<int>(name);
 
     vector<py::object> res(size());
     for(unsigned int i = 0; i < size(); i++)
@@ -185,6 +185,13 @@ bool MooseVec::setAttribute(const string& name, const py::object& val)
     if(py::isinstance<py::iterable>(val) && (! py::isinstance<py::str>(val)))
         isVector = true;
 
+    if(isVector && py::isinstance<py::array>(val)) {
+        if(rttType == "double")
+            return setAttrFromArray<double>(name, val.cast<py::array>());
+        if(rttType == "unsigned int")
+            return setAttrFromArray<unsigned int>(name, val.cast<py::array>());
+    }
+
     if(isVector) {
         if(rttType == "double")
             return setAttrOneToOne<double>(name, val.cast<vector<double>>());
@@ -87,6 +87,10 @@ public:
 
         bool isSameType = (expectedType == givenType);
 
+        // Stride 0 assigns val to every entry.
+        if (isSameType && Field<T>::setBulk(oid_, name, &val, size(), 0))
+            return true;
+
         bool res = true;
         for (size_t i = 0; i < size(); i++)
         {
@@ -124,6 +128,9 @@ public:
                 "Expected " +
                 to_string(size()) + ", got " + to_string(val.size()));
 
+        if (isSameType && Field<T>::setBulk(oid_, name, val.data(), size()))
+            return true;
+
         bool res = true;
         for (size_t i = 0; i < size(); i++)
         {
@@ -144,6 +151,25 @@ public:
         return res;
     }
 
+    // Set from a 1-D numpy array of the field's own type, reading it in
+    // place even if it is strided. Other arrays go through the vector path.
+    template <typename T>
+    bool setAttrFromArray(const string& name, const py::array& val)
+    {
+        auto finfo = oid_.element()->cinfo()->findFinfo(name);
+        assert(finfo);
+        if (val.ndim() == 1 && py::isinstance<py::array_t<T>>(val) &&
+            finfo->rttiType() == Conv<T>::rttiType() &&
+            (size_t)val.shape(0) == size() &&
+            val.strides(0) % (py::ssize_t)sizeof(T) == 0) {
+            auto arr = py::reinterpret_borrow<py::array_t<T>>(val);
+            if (Field<T>::setBulk(oid_, name, arr.data(), size(),
+                                  arr.strides(0) / (py::ssize_t)sizeof(T)))
+                return true;
+        }
+        return setAttrOneToOne<T>(name, val.cast<vector<T>>());
+    }
+
     // Get attributes.
     py::object getAttribute(const string& key);
 
@@ -155,10 +181,14 @@ public:
     template <typename T>
     py::array_t<T> getAttributeNumpy(const string& name)
     {
-        vector<T> res(size());
-        for (unsigned int i = 0; i < size(); i++)
-            res[i] = Field<T>::get(getItem(i), name);
-        return py::array_t<T>(res.size(), res.data());
+        const size_t n = size();
+        py::array_t<T> res(n);
+        T* data = res.mutable_data();
+        if (Field<T>::getBulk(oid_, name, data, n))
+            return res;
+        for (size_t i = 0; i < n; i++)
+            data[i] = Field<T>::get(getItem(i), name);
+        return res;
     }
 
     ObjId connectToSingle(const string& srcfield, const ObjId& tgt,
@@ -205,6 +205,8 @@ void PyRun::trigger(const Eref &e, double input)
         return;
     }
 
+    // Input comes during a run, when moose.start has released the GIL.
+    PyGILState_STATE gstate = PyGILState_Ensure();
     PyObject *value = PyDict_GetItemString(locals_, inputvar_.c_str());
     if (value) {
         Py_DECREF(value);
@@ -229,10 +231,13 @@ void PyRun::trigger(const Eref &e, double input)
             outputOut()->send(e, output);
         }
     }
+    PyGILState_Release(gstate);
 }
 
 void PyRun::run(const Eref &e, string statement)
 {
+    // May come during a run, when moose.start has released the GIL.
+    PyGILState_STATE gstate = PyGILState_Ensure();
     PyRun_SimpleString(statement.c_str());
     PyObject *value = PyDict_GetItemString(locals_, outputvar_.c_str());
     if (value) {
@@ -242,32 +247,34 @@ void PyRun::run(const Eref &e, string statement)
         else
             outputOut()->send(e, output);
     }
+    PyGILState_Release(gstate);
 }
 
 void PyRun::process(const Eref &e, ProcPtr p)
 {
-    // Make sure the get the GIL. Ksolve/Gsolve can be multithreaded.
-    PyGILState_STATE gstate = PyGILState_Ensure();
-
     // PyRun_String(runstr_.c_str(), 0, globals_, locals_);
     // PyRun_SimpleString(runstr_.c_str());
     if (!runcompiled_ || mode_ == 2) {
         return;
     }
 
+    // Make sure the get the GIL. moose.start releases it, and Ksolve/Gsolve
+    // can be multithreaded. Every path below must release it again.
+    PyGILState_STATE gstate = PyGILState_Ensure();
+
     PyEval_EvalCode(runcompiled_, globals_, locals_);
     if (PyErr_Occurred()) {
         PyErr_Print();
+        PyGILState_Release(gstate);
         return;
     }
 
     PyObject *value = PyDict_GetItemString(locals_, outputvar_.c_str());
     if (value) {
         double output = PyFloat_AsDouble(value);
-        if (PyErr_Occurred()) {
+        if (PyErr_Occurred())
             PyErr_Print();
-            return;
-        } else
+        else
             outputOut()->send(e, output);
     }
 
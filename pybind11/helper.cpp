@@ -178,6 +178,24 @@ ObjId loadModelInternal(const string& fname, const string& modelpath,
     return ObjId(model);
 }
 
+void saveModelInternal(const ObjId& model, const string& fname)
+{
+    if(!getShellPtr()->doSaveModel(model.id, fname))
+        throw runtime_error("could not save model");
+}
+
+void saveCheckpointInternal(const ObjId& model, const string& fname)
+{
+    if(!getShellPtr()->doSaveCheckpoint(model.id, fname))
+        throw runtime_error("could not save checkpoint");
+}
+
+void loadCheckpointInternal(const ObjId& model, const string& fname)
+{
+    if(!getShellPtr()->doLoadCheckpoint(model.id, fname))
+        throw runtime_error("could not load checkpoint");
+}
+
 ObjId getElementField(const ObjId objid, const string& fname)
 {
     return ObjId(objid.path() + '/' + fname);
@@ -224,6 +242,52 @@ ObjId shellConnectToVec(const ObjId& src, const string& srcField,
     return getShellPtr()->doAddMsg(msgType, src, srcField, tgt.obj(), tgtField);
 }
 
+using IndexArray =
+    py::array_t<unsigned int, py::array::c_style | py::array::forcecast>;
+using ValueArray =
+    py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// Converts arr, unless it is None, and checks it has n entries. The
+// conversion copies only if the dtype or layout differ.
+template <typename A>
+static const typename A::value_type* batchArray(const py::object& arr,
+                                                const char* name, size_t n,
+                                                A& holder)
+{
+    if (arr.is_none()) return nullptr;
+    holder = A::ensure(arr);
+    if (!holder || holder.ndim() != 1 || (size_t)holder.size() != n)
+        throw py::value_error(string(name) + " must be a 1-d array of " +
+                              to_string(n) + " entries.");
+    return holder.data();
+}
+
+ObjId shellConnectBatch(const ObjId& src, const string& srcField,
+                        const ObjId& tgt, const string& tgtField,
+                        const py::object& srcIndex, const py::object& tgtIndex,
+                        const py::object& fieldIndex, const py::object& weight,
+                        const py::object& delay)
+{
+    IndexArray s, t, f;
+    ValueArray w, d;
+    if (srcIndex.is_none() || tgtIndex.is_none())
+        throw py::value_error("srcIndex and destIndex are required.");
+    size_t n = py::len(srcIndex);
+    const unsigned int* ps = batchArray(srcIndex, "srcIndex", n, s);
+    const unsigned int* pt = batchArray(tgtIndex, "destIndex", n, t);
+    const unsigned int* pf = batchArray(fieldIndex, "fieldIndex", n, f);
+    const double* pw = batchArray(weight, "weight", n, w);
+    const double* pd = batchArray(delay, "delay", n, d);
+    // Keep the GIL: the arrays may be the caller's own numpy buffers, and
+    // another thread must not edit the model while the messages are made.
+    ObjId mid = getShellPtr()->doAddMsgBatch(src, srcField, tgt, tgtField,
+                                             n, ps, pt, pf, pw, pd);
+    if (mid.bad())
+        throw py::value_error("could not connect " + src.path() + " to " +
+                              tgt.path() + ", see the log for why.");
+    return mid;
+}
+
 #if 0
 void mooseMoveId(const Id& a, const ObjId& b)
 {
@@ -348,6 +412,16 @@ void mooseReinit()
     getShellPtr()->doReinit();
 }
 
+// Set and cleared by mooseStart while it holds the GIL, so that code
+// holding the GIL can tell whether the simulation is running on another
+// thread. Clock::isRunning is written by the simulation thread itself.
+static bool runningWithoutGil = false;
+
+bool mooseIsRunningWithoutGil()
+{
+    return runningWithoutGil;
+}
+
 /* --------------------------------------------------------------------------*/
 /**
  * @Synopsis  Register and signal handler and start the simulation. When ctrl+c
@@ -369,6 +443,14 @@ void mooseStart(double runtime, bool notify = false)
     sigHandler.sa_flags = 0;
     sigaction(SIGINT, &sigHandler, NULL);
 #endif    
+    // Let other Python threads run while the simulation does. Objects that
+    // call into Python (PyRun) take the GIL back for themselves. Use
+    // Snapshot objects to watch the run from other threads.
+    struct RunFlag {
+        RunFlag() { runningWithoutGil = true; }
+        ~RunFlag() { runningWithoutGil = false; }
+    } flag;
+    py::gil_scoped_release release;
     getShellPtr()->doStart(runtime, notify);
 }
 
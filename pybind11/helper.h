@@ -156,6 +156,12 @@ inline ObjId mooseCreateFromMooseVec(const string& type, const MooseVec& vec,
 ObjId loadModelInternal(const string& fname, const string& modelpath,
                         const string& solverclass);
 
+void saveModelInternal(const ObjId& model, const string& fname);
+
+void saveCheckpointInternal(const ObjId& model, const string& fname);
+
+void loadCheckpointInternal(const ObjId& model, const string& fname);
+
 ObjId getElementField(const ObjId objid, const string& fname);
 
 ObjId getElementFieldItem(const ObjId& objid, const string& fname,
@@ -169,6 +175,13 @@ ObjId shellConnectToVec(const ObjId& src, const string& srcField,
                         const MooseVec& tgt, const string& tgtField,
                         const string& msgType);
 
+// Connect a batch of entries given as numpy arrays, as one SparseMsg.
+ObjId shellConnectBatch(const ObjId& src, const string& srcField,
+                        const ObjId& tgt, const string& tgtField,
+                        const py::object& srcIndex, const py::object& tgtIndex,
+                        const py::object& fieldIndex, const py::object& weight,
+                        const py::object& delay);
+
 inline bool mooseDeleteObj(const ObjId& oid)
 {
     return getShellPtr()->doDelete(oid);
@@ -206,6 +219,9 @@ void handleKeyboardInterrupts(int signum);
 
 void mooseStart(double runtime, bool notify);
 
+// True while mooseStart runs the simulation with the GIL released.
+bool mooseIsRunningWithoutGil();
+
 void mooseStop();
 
 py::cpp_function getPropertyDestFinfo(const ObjId& oid, const Finfo* finfo);
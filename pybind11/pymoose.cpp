@@ -14,6 +14,7 @@
 #include "pymoose.h"
 #include "Finfo.h"
 #include "MooseVec.h"
+#include "BufferView.h"
 #include "helper.h"
 
 #include "../basecode/global.h"
@@ -397,6 +398,13 @@ PYBIND11_MODULE(_moose, m)
         // Wrapped object.
         .def_property_readonly("objid", &MooseVec::obj);
 
+    py::class_<BufferView>(m, "BufferView", py::buffer_protocol())
+        .def(py::init<const ObjId &, unsigned int>(), "obj"_a, "index"_a = 0)
+        .def_buffer(&BufferView::buffer)
+        .def("__len__", &BufferView::size)
+        .def_property_readonly("obj", &BufferView::obj)
+        .def_property_readonly("index", &BufferView::index);
+
     /**
      * MODULE FUNCTIONS such as moose.seed(10) etc.
      */
@@ -429,6 +437,10 @@ PYBIND11_MODULE(_moose, m)
     m.def("reinit", &mooseReinit);
     m.def("start", &mooseStart, "runtime"_a, "notify"_a = false);
     m.def("stop", &mooseStop);
+    m.def("loadBalance", &Shell::loadBalance, "path"_a = "/",
+          "apply"_a = true,
+          "Partition distributed elements under path between nodes by "
+          "compute load and message traffic. Returns a report.");
 
     m.def("isRunning", &mooseIsRunning);
 
@@ -443,6 +455,9 @@ PYBIND11_MODULE(_moose, m)
     m.def("listmsg", &mooseListMsg);
 
     m.def("loadModelInternal", &loadModelInternal);
+    m.def("saveModelInternal", &saveModelInternal);
+    m.def("saveCheckpointInternal", &saveCheckpointInternal);
+    m.def("loadCheckpointInternal", &loadCheckpointInternal);
 
     m.def("getFieldNames", &mooseGetFieldNames);
 
@@ -462,6 +477,30 @@ PYBIND11_MODULE(_moose, m)
 
     m.def("version_info", &mooseVersionInfo);
 
+    m.def("connectBatch", &shellConnectBatch, "src"_a, "srcfield"_a,
+          "dest"_a, "destfield"_a, "srcIndex"_a, "destIndex"_a,
+          "fieldIndex"_a = py::none(), "weight"_a = py::none(),
+          "delay"_a = py::none(),
+          "Connect src[srcIndex[i]] to dest[destIndex[i]] for every i, as "
+          "a single SparseMsg built in one call. For synapses, fieldIndex "
+          "picks the synapse on each dest (by default they are numbered "
+          "in order), the synapse arrays are grown to fit, and weight and "
+          "delay, if given, are assigned. Takes numpy arrays, which are "
+          "used in place if they are contiguous uint32 and float64. "
+          "Returns the SparseMsg.");
+
+    m.def("view",
+          [](const ObjId &oid, unsigned int index) {
+              return BufferView(oid, index);
+          },
+          "obj"_a, "index"_a = 0,
+          "Read-only view of the vector of a Table, or of nVec[index] of a "
+          "Ksolve or Dsolve, without copying. np.asarray(view) aliases the "
+          "storage and is valid until the next reinit or start, or until "
+          "the storage is resized. Raises ValueError while moose.start is "
+          "running on another thread, or for a Table that has spilled "
+          "entries to disk. See BufferView.");
+
     // Attributes.
     m.attr("NA") = NA;
     m.attr("PI") = PI;
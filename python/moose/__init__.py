@@ -353,6 +353,11 @@ def start(runtime, notify=False):
     `moose.start(t)` as many time as you like. This will continue the
     simulation from the last state for `t` time.
 
+    The GIL is released while the simulation runs, so other Python threads
+    keep running. They may read moose.Snapshot objects, and call
+    moose.isRunning() or moose.stop(), but must not change the model
+    until the run is over.
+
     Parameters
     ----------
     t : float
@@ -447,7 +452,8 @@ def setClock(clockid, dt):
 
 
 def loadModel(filename, modelpath, solverclass="gsl"):
-    """loadModel: Load model (genesis/cspace) from a file to a specified path.
+    """loadModel: Load model (genesis/cspace/snapshot) from a file to a
+    specified path.
 
     Parameters
     ----------
@@ -474,6 +480,79 @@ def loadModel(filename, modelpath, solverclass="gsl"):
     return model_utils.mooseReadKkitGenesis(filename, modelpath, solverclass)
 
 
+def saveModel(model, filename):
+    """saveModel: Save the model tree under `model` to a binary snapshot.
+
+    The snapshot holds the objects, their fields, the messages between
+    them and the clock settings, and loads back quickly with `loadModel`.
+    Solvers such as a Stoich or an HSolve are saved with the paths they
+    were set up on, and are set up again on the loaded copy.
+
+    Parameters
+    ----------
+    model: str, moose object
+        Root of the model to save.
+    filename: str
+        Output file. Must end with `.msnap`.
+
+    Raises
+    ------
+    ValueError
+        If `filename` does not end with `.msnap`.
+    RuntimeError
+        If the model could not be written.
+    """
+    if os.path.splitext(filename)[1] != ".msnap":
+        raise ValueError("Snapshot file name must end with .msnap")
+    _moose.saveModelInternal(element(model), filename)
+
+
+def saveCheckpoint(model, filename):
+    """saveCheckpoint: Save the runtime state of the model tree under
+    `model`, along with the clock, so that the run can be resumed later.
+
+    The state includes the solvers (with their integrator history and
+    random number generators), synaptic event queues and table contents.
+    Call it between `moose.start` calls.
+
+    Parameters
+    ----------
+    model: str, moose object
+        Root of the model.
+    filename: str
+        Output file.
+
+    See also
+    --------
+    moose.loadCheckpoint
+    """
+    _moose.saveCheckpointInternal(element(model), filename)
+
+
+def loadCheckpoint(model, filename):
+    """loadCheckpoint: Restore a checkpoint saved by `saveCheckpoint`.
+
+    The model under `model` must be built the same way as the one that
+    was saved, with the same clocks and solvers. It is reinited and then
+    set to the saved state, so that the next `moose.start` continues
+    from the time of the checkpoint and gives exactly the same results
+    as a run that was never stopped.
+
+    Parameters
+    ----------
+    model: str, moose object
+        Root of the model.
+    filename: str
+        Checkpoint file.
+
+    Raises
+    ------
+    RuntimeError
+        If the file is not a checkpoint of this model.
+    """
+    _moose.loadCheckpointInternal(element(model), filename)
+
+
 def copy(src, dest, name="", n=1, toGlobal=False, copyExtMsg=False):
     """Make copies of a moose object.
 
@@ -163,6 +163,10 @@ def mooseReadKkitGenesis(filename, modelpath, solverclass="gsl"):
     if ext in [".swc", ".p"]:
         return _moose.loadModelInternal(filename, modelpath, solverclass)
 
+    if ext == ".msnap":
+        # Snapshots carry their own solvers.
+        return _moose.loadModelInternal(filename, modelpath, "")
+
     if ext in [".g", ".cspace"]:
         # only if genesis or cspace file and method != ee then only
         # mooseAddChemSolver is called.
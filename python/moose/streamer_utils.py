@@ -16,6 +16,7 @@ import os
 import numpy as np
 import math
 import struct
+import mmap
 from collections import defaultdict
 
 def bytes_to_np_arr(data):
@@ -47,6 +48,158 @@ def decode_data(data):
     assert int(arr[0]) == ord('H'), "First char must be H"
     return np_array_to_data(arr)
 
+class MCFReader(object):
+    """Reader for the chunked, compressed columnar files written by a
+    Streamer with format 'mcf'. See utility/mcf.hpp for the layout.
+
+    The file is memory mapped, so only the pages holding the header, the
+    index and the chunks of the requested column that overlap the requested
+    time range are read and decoded.
+
+    >>> r = MCFReader('data.mcf')
+    >>> t, v = r.read('soma', tmin=1.0, tmax=2.0)
+    >>> r.close()
+    """
+
+    def __init__(self, path):
+        self.path = path
+        with open(path, 'rb') as f:
+            self._data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, version, ncols = struct.unpack_from('<8sII', self._data, 0)
+        assert magic == b'MOOSEMCF', 'Not a mcf file: %s' % path
+        pos = 16
+        self.columns = []
+        for i in range(ncols):
+            n, = struct.unpack_from('<I', self._data, pos)
+            self.columns.append(self._data[pos+4:pos+4+n].decode())
+            pos += 4 + n
+        self._headerEnd = pos
+        self.chunks = self._read_footer() or self._scan_chunks()
+
+    def _read_footer(self):
+        d = self._data
+        if len(d) < self._headerEnd + 24 or d[-8:] != b'MCFINDEX':
+            return None
+        nchunks, offset = struct.unpack_from('<QQ', d, len(d) - 24)
+        chunks = []
+        pos = offset
+        for i in range(nchunks):
+            _, firstRow, nrows, t0, t1 = struct.unpack_from('<QQIdd', d, pos)
+            pos += 36
+            cols = []
+            for j in range(len(self.columns)):
+                cols.append(struct.unpack_from('<QIB', d, pos))
+                pos += 13
+            chunks.append((firstRow, nrows, t0, t1, cols))
+        return chunks
+
+    def _scan_chunks(self):
+        # A file that was not closed has no footer.
+        d = self._data
+        chunks = []
+        pos = self._headerEnd
+        while pos + 36 <= len(d) and d[pos:pos+4] == b'CHNK':
+            firstRow, nrows, t0, t1 = struct.unpack_from('<QIdd', d, pos + 4)
+            q = pos + 32
+            cols = []
+            for j in range(len(self.columns)):
+                if q + 5 > len(d):
+                    return chunks
+                codec, nbytes = struct.unpack_from('<BI', d, q)
+                cols.append((q + 5, nbytes, codec))
+                q += 5 + nbytes
+            if q > len(d):
+                break
+            chunks.append((firstRow, nrows, t0, t1, cols))
+            pos = q
+        return chunks
+
+    def close(self):
+        self._data.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    @property
+    def num_rows(self):
+        if not self.chunks:
+            return 0
+        return self.chunks[-1][0] + self.chunks[-1][1]
+
+    def _decode(self, col, n):
+        offset, nbytes, codec = col
+        raw = self._data[offset:offset+nbytes]
+        if codec == 0:
+            return np.frombuffer(raw, '<f8').copy()
+        planes = np.frombuffer(lz_decompress(raw, 8 * n), np.uint8).reshape(8, n)
+        d = np.zeros(n, np.uint64)
+        for b in range(8):
+            d |= planes[b].astype(np.uint64) << np.uint64(8 * b)
+        if codec == 2:
+            # Second order: d is the change in the step from value 1 on,
+            # so summing it from there gives back the steps.
+            d[1:] = np.cumsum(d[1:], dtype=np.uint64)
+        return np.cumsum(d, dtype=np.uint64).view(np.float64)
+
+    def read(self, column, tmin=-np.inf, tmax=np.inf):
+        """Return (time, values) of the column, by name or position, in
+        the rows with tmin <= time <= tmax."""
+        j = column if isinstance(column, int) else self.columns.index(column)
+        ts, vs = [], []
+        for firstRow, n, t0, t1, cols in self.chunks:
+            if t1 < tmin or t0 > tmax:
+                continue
+            t = self._decode(cols[0], n)
+            v = self._decode(cols[j], n)
+            sel = (t >= tmin) & (t <= tmax)
+            ts.append(t[sel])
+            vs.append(v[sel])
+        if not ts:
+            return np.array([]), np.array([])
+        return np.concatenate(ts), np.concatenate(vs)
+
+def lz_decompress(data, expected):
+    """Decompress the LZ stage of the mcf codec."""
+    out = bytearray()
+    p, end = 0, len(data)
+    while p < end:
+        token = data[p]
+        p += 1
+        nlit = token >> 4
+        if nlit == 15:
+            while True:
+                b = data[p]
+                p += 1
+                nlit += b
+                if b != 255:
+                    break
+        out += data[p:p+nlit]
+        p += nlit
+        if p >= end:
+            break
+        offset = data[p] | (data[p+1] << 8)
+        p += 2
+        mlen = token & 0x0f
+        if mlen == 15:
+            while True:
+                b = data[p]
+                p += 1
+                mlen += b
+                if b != 255:
+                    break
+        mlen += 4
+        start = len(out) - offset
+        if offset >= mlen:
+            out += out[start:start+mlen]
+        else:
+            # Overlapping match repeats the last offset bytes.
+            out += (out[start:] * (mlen // offset + 1))[:mlen]
+    assert len(out) == expected, 'Corrupt mcf chunk'
+    return bytes(out)
+
 def test():
     with open(sys.argv[1], 'rb') as f:
         data = f.read()
@@ -8,6 +8,7 @@
  *        License:  MIT License
  */
 
+#include <sstream>
 #include "RNG.h"
 
 namespace moose {
@@ -71,4 +72,41 @@ double RNG::uniform( void )
     return dist_( rng_ );
 }
 
+/**
+ * @brief State of the engine and the distribution as text, which the
+ * standard library guarantees to read back into the same state.
+ *
+ * @return state string.
+ */
+string RNG::getState( void ) const
+{
+    stringstream ss;
+    ss.precision( 17 );
+    ss << seed_ << ' ' << rng_ << ' ' << dist_;
+    return ss.str();
+}
+
+/**
+ * @brief Restore a state made by getState.
+ *
+ * @param state
+ *
+ * @return false if the string was not a valid state. The RNG is then
+ * left as it was.
+ */
+bool RNG::setState( const string& state )
+{
+    stringstream ss( state );
+    double seed;
+    MOOSE_RNG_DEFAULT_ENGINE rng;
+    MOOSE_UNIFORM_DISTRIBUTION<double> dist;
+    ss >> seed >> rng >> dist;
+    if( ss.fail() )
+        return false;
+    seed_ = seed;
+    rng_ = rng;
+    dist_ = dist;
+    return true;
+}
+
 }
@@ -22,6 +22,7 @@
 #include <limits>
 #include <iostream>
 #include <random>
+#include <string>
 #include <cassert>
 
 #include "Definitions.h"
@@ -56,6 +57,11 @@ class RNG
 
         double uniform( void );
 
+        /* The engine and distribution state in text form, for checkpoints. */
+        string getState( void ) const;
+
+        bool setState( const string& state );
+
 
     private:
         /* ====================  DATA MEMBERS  ======================================= */
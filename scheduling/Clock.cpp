@@ -360,6 +360,7 @@ const Cinfo* Clock::initCinfo()
         "   STDPSynHandler       1       50e-6\n"
         "   GraupnerBrunel2012CaPlasticitySynHandler    1        50e-6\n"
         "   SeqSynHandler        1       50e-6\n"
+        "   SpikeRouter          1       50e-6\n"
         "    CaConc              1       50e-6\n"
         "    CaConcBase          1       50e-6\n"
         "    DifShell            1       50e-6\n"
@@ -378,6 +379,7 @@ const Cinfo* Clock::initCinfo()
         "    AdExIF              2       50e-6\n"
         "    AdThreshIF          2       50e-6\n"
         "    IzhIF               2       50e-6\n"
+        "    IntFireSolver       2       50e-6\n"
         "    IzhikevichNrn       2       50e-6\n"        
         "    MarkovGslSolver     2       50e-6\n"
         "    MarkovRateTable     2       50e-6\n"
@@ -403,12 +405,14 @@ const Cinfo* Clock::initCinfo()
         "    SpikeStats           7      50e-6\n"
         "    Table                8      0.1e-3\n"
         "    TimeTable            8      0.1e-3\n"
+        "    Snapshot             8      0.1e-3\n"
 
         "    Dsolve               10     0.01\n"
         "    Adaptor              11     0.1\n"
         "    Func                 12     0.1\n"
         "    Function             12     0.1\n"
         "    Arith                12     0.1\n"
+        "    NativePlugin         12     0.1\n"
         "    Gsolve (init)        15     0.1\n"
         "    Ksolve (init)        15     0.1\n"
         "    Gsolve               16     0.1\n"
@@ -547,6 +551,29 @@ bool Clock::isDoingReinit() const
     return doingReinit_;
 }
 
+void Clock::saveState( StateWriter& w ) const
+{
+    w.put( runTime_ );
+    w.put( currentTime_ );
+    w.put( nSteps_ );
+    w.put( currentStep_ );
+    w.put( info_ );
+}
+
+/**
+ * Picks up from the saved step, so the next start continues from there
+ * as it would have without the checkpoint. The ticks are rebuilt on that
+ * start as usual.
+ */
+void Clock::restoreState( StateReader& r )
+{
+    r.get( runTime_ );
+    r.get( currentTime_ );
+    r.get( nSteps_ );
+    r.get( currentStep_ );
+    r.get( info_ );
+}
+
 bool Clock::checkTickNum( const string& funcName, unsigned int i ) const
 {
     if ( isRunning_ || doingReinit_)
@@ -880,6 +907,7 @@ void Clock::buildDefaultTick()
     defaultTick_["STDPSynHandler"] = 1;
     defaultTick_["GraupnerBrunel2012CaPlasticitySynHandler"] = 1;
     defaultTick_["SeqSynHandler"] = 1;
+    defaultTick_["SpikeRouter"] = 1;
     defaultTick_["CaConc"] = 1;
     defaultTick_["CaConcBase"] = 1;
     defaultTick_["DifShell"] = 1;
@@ -898,6 +926,7 @@ void Clock::buildDefaultTick()
     defaultTick_["AdExIF"] = 2;
     defaultTick_["AdThreshIF"] = 2;
     defaultTick_["IzhIF"] = 2;
+    defaultTick_["IntFireSolver"] = 2;
     defaultTick_["IzhikevichNrn"] = 2;
     defaultTick_["MarkovOdeSolver"] = 2;
     defaultTick_["MarkovRateTable"] = 2;
@@ -920,11 +949,13 @@ void Clock::buildDefaultTick()
     defaultTick_["SpikeStats"] = 7;
     defaultTick_["Table"] = 8;
     defaultTick_["TimeTable"] = 8;
+    defaultTick_["Snapshot"] = 8;
     defaultTick_["Dsolve"] = 10;
     defaultTick_["Adaptor"] = 11;
     defaultTick_["Func"] = 12;
     defaultTick_["Function"] = 12;
     defaultTick_["Arith"] = 12;
+    defaultTick_["NativePlugin"] = 12;
     defaultTick_["Gsolve"] = 16; // Note this uses an 'init' at t-1
     defaultTick_["Ksolve"] = 16; // Note this uses an 'init' at t-1
     defaultTick_["Stats"] = 17;
@@ -85,6 +85,10 @@ class Clock
      */
     bool isDoingReinit() const;
 
+    /// Runtime state for checkpoints: the time and step reached.
+    void saveState( StateWriter& w ) const;
+    void restoreState( StateReader& r );
+
     /**
      * Utility function to tell us about the scheduling
      */
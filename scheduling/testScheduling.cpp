@@ -180,8 +180,32 @@ void testClockMessaging()
 	cout << "." << flush;
 }
 
+/**
+ * Check that classes added to the default tick table are scheduled there
+ * on creation, without the unknown className warning.
+ */
+void testDefaultTick()
+{
+	Shell* shell = reinterpret_cast< Shell* >( Id().eref().data() );
+	const char* classes[] = { "Snapshot", "NativePlugin" };
+	const int ticks[] = { 8, 12 };
+	for ( unsigned int i = 0; i < sizeof( ticks ) / sizeof( int ); ++i ) {
+		assert( Clock::lookupDefaultTick( classes[i] ) ==
+			static_cast< unsigned int >( ticks[i] ) );
+		stringstream ss;
+		streambuf* old = cout.rdbuf( ss.rdbuf() );
+		Id id = shell->doCreate( classes[i], Id(), "defaultTick", 1 );
+		cout.rdbuf( old );
+		assert( ss.str().find( "unknown className" ) == string::npos );
+		assert( Field< int >::get( id, "tick" ) == ticks[i] );
+		shell->doDelete( id );
+	}
+	cout << "." << flush;
+}
+
 void testScheduling()
 {
+	testDefaultTick();
 	testClockMessaging();
 	testClock();
 }
@@ -0,0 +1,1606 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <set>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "../basecode/header.h"
+#include "../basecode/SparseMatrix.h"
+#include "../msg/SingleMsg.h"
+#include "../msg/DiagonalMsg.h"
+#include "../msg/OneToOneMsg.h"
+#include "../msg/OneToOneDataIndexMsg.h"
+#include "../msg/OneToAllMsg.h"
+#include "../msg/SparseMsg.h"
+#include "../scheduling/Clock.h"
+#include "../randnum/randnum.h"
+#include "Shell.h"
+#include "BinaryModel.h"
+
+namespace {
+
+const char snapMagic[] = "MOOSESNP";
+const uint32_t snapVersion = 1;
+const char ckpMagic[] = "MOOSECKP";
+const uint32_t ckpVersion = 1;
+
+enum SectionKind {
+	SNAP_STRINGS = 1,
+	SNAP_CLASSES,
+	SNAP_ELEMENTS,
+	SNAP_FIELDS,
+	SNAP_MSGS,
+	SNAP_SPARSE,
+	SNAP_BINDINGS,
+	SNAP_CLOCK,
+	SNAP_STATE,
+	SNAP_STATE_INDEX,
+	SNAP_GLOBAL
+};
+
+enum MsgKind {
+	SNAP_SINGLE = 1,
+	SNAP_ONE_TO_ONE,
+	SNAP_ONE_TO_ONE_DATA_INDEX,
+	SNAP_ONE_TO_ALL,
+	SNAP_DIAGONAL,
+	SNAP_SPARSE_MSG
+};
+
+const uint64_t FIELD_ELEMENT = 1;
+const uint64_t GLOBAL_ELEMENT = 2;
+const uint64_t NO_PARENT = ~0ULL;
+
+struct SnapHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t numSections;
+};
+
+/// Offset and size are in bytes from the start of the file.
+struct SectionEntry {
+	uint32_t kind;
+	uint32_t reserved;
+	uint64_t offset;
+	uint64_t size;
+};
+
+/**
+ * Elements are stored parents first, so that each can be created
+ * under one made before it. The fields of its entries start at word
+ * 'fields' of the FIELDS section.
+ */
+struct ElementRecord {
+	uint64_t name;
+	uint64_t cls;
+	uint64_t parent;
+	uint64_t parentData;
+	uint64_t numData;
+	int64_t tick;
+	uint64_t flags;
+	uint64_t fields;
+};
+
+/// SparseMsg entries are numSparse src, then dest, then field indices.
+struct MsgRecord {
+	uint64_t kind;
+	uint64_t e1;
+	uint64_t e2;
+	uint64_t i1;
+	uint64_t i2;
+	uint64_t field;
+	int64_t stride;
+	uint64_t sparse;
+	uint64_t numSparse;
+};
+
+/// A src field on elm that calls a dest field on the other end of msg.
+struct BindingRecord {
+	uint64_t msg;
+	uint64_t elm;
+	uint64_t srcField;
+	uint64_t destField;
+};
+
+struct ClockRecord {
+	uint64_t tick;
+	double dt;
+};
+
+/// The state of one data entry, at byte offset in the STATE section.
+struct StateRecord {
+	uint64_t elm;
+	uint64_t data;
+	uint64_t offset;
+	uint64_t size;
+};
+
+/**
+ * Fields that a solver fills in for itself when it is set up, so they
+ * are not saved.
+ */
+const char* const solverFields[][2] = {
+	{ "Ksolve", "numPools" },
+	{ "Ksolve", "numAllVoxels" },
+	{ "Gsolve", "stoich" },
+	{ "Gsolve", "numPools" },
+	{ "Gsolve", "numAllVoxels" },
+	{ "Dsolve", "stoich" },
+	{ "Dsolve", "numPools" },
+	{ "Dsolve", "path" },
+};
+
+/**
+ * Fields that only gather up others which are saved. Assigning them
+ * again would rebuild what those have already set.
+ */
+const char* const derivedFields[][2] = {
+	{ "HHGate", "alphaParms" },
+};
+
+/**
+ * Paths that set up a solver over the model. These are assigned after
+ * everything else, with the old model path swapped for the new one.
+ */
+const char* const setupFields[][2] = {
+	{ "Stoich", "reacSystemPath" },
+	{ "HSolve", "target" },
+};
+
+/**
+ * Fields that a checkpoint has in the state of the object, and so
+ * leaves out of its fields. A checkpoint also leaves out setupFields,
+ * as the solvers are already set up on the model it restores onto.
+ */
+const char* const stateFields[][2] = {
+	{ "Table", "vector" },
+	{ "TimeTable", "vector" },
+};
+
+bool inTable( const char* const table[][2], size_t n,
+		const Cinfo* c, const string& field )
+{
+	for ( size_t i = 0; i < n; ++i )
+		if ( field == table[i][1] && c->isA( table[i][0] ) )
+			return true;
+	return false;
+}
+
+bool isSolverField( const Cinfo* c, const string& field )
+{
+	return inTable( solverFields,
+			sizeof( solverFields ) / sizeof( solverFields[0] ), c, field );
+}
+
+bool isDerivedField( const Cinfo* c, const string& field )
+{
+	return inTable( derivedFields,
+			sizeof( derivedFields ) / sizeof( derivedFields[0] ), c, field );
+}
+
+bool isSetupField( const Cinfo* c, const string& field )
+{
+	return inTable( setupFields,
+			sizeof( setupFields ) / sizeof( setupFields[0] ), c, field );
+}
+
+bool isStateField( const Cinfo* c, const string& field )
+{
+	return inTable( stateFields,
+			sizeof( stateFields ) / sizeof( stateFields[0] ), c, field );
+}
+
+/**
+ * The class a zombie was made from, such as Compartment for a
+ * ZombieCompartment, or 0 if it is not a zombie. A snapshot saves the
+ * zombies of a solver as their native class, since the solver makes
+ * them into zombies again when it is set up on loading.
+ */
+const Cinfo* nativeCinfo( const Cinfo* c )
+{
+	if ( c->name().substr( 0, 6 ) != "Zombie" )
+		return 0;
+	return Cinfo::find( c->name().substr( 6 ) );
+}
+
+/// The Stoich makes this message to its ksolve when it is set up.
+bool isSolverMsg( const Element* src, const string& srcField,
+		const Element* dest )
+{
+	return srcField == "voxelVolOut" &&
+		( dest->cinfo()->isA( "Ksolve" ) || dest->cinfo()->isA( "Gsolve" ) );
+}
+
+class StringTable
+{
+	public:
+		uint64_t add( const string& s )
+		{
+			map< string, uint64_t >::iterator i = index_.find( s );
+			if ( i != index_.end() )
+				return i->second;
+			index_[s] = strings_.size();
+			strings_.push_back( s );
+			return strings_.size() - 1;
+		}
+
+		const string& get( uint64_t i ) const
+		{
+			static const string empty;
+			return i < strings_.size() ? strings_[i] : empty;
+		}
+
+		/// Word 0 is the count, then count + 1 byte offsets, then chars.
+		void pack( vector< uint64_t >& words ) const
+		{
+			words.assign( 2 + strings_.size(), 0 );
+			words[0] = strings_.size();
+			uint64_t len = 0;
+			for ( size_t i = 0; i < strings_.size(); ++i ) {
+				words[i + 1] = len;
+				len += strings_[i].length();
+			}
+			words[ strings_.size() + 1 ] = len;
+			size_t start = words.size();
+			words.resize( start + ( len + 7 ) / 8, 0 );
+			char* c = reinterpret_cast< char* >( &words[start] );
+			for ( size_t i = 0; i < strings_.size(); ++i ) {
+				memcpy( c, strings_[i].data(), strings_[i].length() );
+				c += strings_[i].length();
+			}
+		}
+
+		bool unpack( const uint64_t* words, size_t n )
+		{
+			if ( n < 1 || words[0] + 2 > n )
+				return false;
+			uint64_t num = words[0];
+			const char* c = reinterpret_cast< const char* >( words + num + 2 );
+			if ( words[num + 1] > ( n - num - 2 ) * 8 )
+				return false;
+			strings_.resize( num );
+			for ( uint64_t i = 0; i < num; ++i ) {
+				if ( words[i + 1] > words[i + 2] )
+					return false;
+				strings_[i].assign( c + words[i + 1],
+						words[i + 2] - words[i + 1] );
+			}
+			return true;
+		}
+
+	private:
+		vector< string > strings_;
+		map< string, uint64_t > index_;
+};
+
+/**
+ * Maps the elements of the model to their place in the file, so that
+ * Id and ObjId fields can refer to them. Objects outside the model
+ * are referred to by path.
+ */
+struct SnapIds
+{
+	map< const Element*, uint64_t > index; // Filled in when saving
+	vector< Id > ids;                      // Filled in when loading
+	StringTable* strings;
+};
+
+/**
+ * The saved values of one field over entries of an element. Each points
+ * at the size word that comes before the value.
+ */
+typedef vector< pair< Eref, const double* > > FieldBatch;
+
+/**
+ * Saves and assigns a value field of one type. Values are stored as
+ * their size in doubles, then the value in Conv buffer form.
+ */
+class FieldCodec
+{
+	public:
+		virtual ~FieldCodec()
+		{;}
+		virtual void save( const Eref& er, const DestFinfo* get,
+				SnapIds& ids, vector< double >& buf ) const = 0;
+
+		/// Assigns the value, unless the field already holds it.
+		virtual void load( const Eref& er, const DestFinfo* get,
+				const DestFinfo* set, const SnapIds& ids,
+				const double* buf, uint64_t size ) const = 0;
+
+		/**
+		 * Assigns the values of all the entries of dest, in order, as
+		 * Field::setBulk does. Returns false without assigning any if
+		 * this cannot be done, and then load is used on each entry.
+		 */
+		virtual bool loadBulk( const ObjId& dest, const string& field,
+				const DestFinfo* set, const FieldBatch& vals ) const
+		{
+			return false;
+		}
+};
+
+template< class F > void appendValue( const F& val, vector< double >& buf )
+{
+	unsigned int n = Conv< F >::size( val );
+	buf.push_back( n );
+	size_t start = buf.size();
+	buf.resize( start + n, 0.0 );
+	double* p = &buf[start];
+	Conv< F >::val2buf( val, &p );
+}
+
+template< class F > F getValue( const Eref& er, const DestFinfo* get )
+{
+	const GetOpFuncBase< F >* op =
+		dynamic_cast< const GetOpFuncBase< F >* >( get->getOpFunc() );
+	assert( op );
+	return op->returnOp( er );
+}
+
+template< class F > void setValue( const Eref& er, const DestFinfo* set,
+		const F& val )
+{
+	const OpFunc1Base< F >* op =
+		dynamic_cast< const OpFunc1Base< F >* >( set->getOpFunc() );
+	if ( op )
+		op->op( er, val );
+}
+
+template< class F > class ConvCodec: public FieldCodec
+{
+	public:
+		void save( const Eref& er, const DestFinfo* get,
+				SnapIds& ids, vector< double >& buf ) const
+		{
+			appendValue( getValue< F >( er, get ), buf );
+		}
+
+		void load( const Eref& er, const DestFinfo* get,
+				const DestFinfo* set, const SnapIds& ids,
+				const double* buf, uint64_t size ) const
+		{
+			vector< double > old;
+			appendValue( getValue< F >( er, get ), old );
+			if ( old[0] == size &&
+					memcmp( &old[1], buf, size * sizeof( double ) ) == 0 )
+				return;
+			double* p = const_cast< double* >( buf );
+			F val = Conv< F >::buf2val( &p );
+			setValue( er, set, val );
+		}
+};
+
+/**
+ * Types that Conv stores in one double. The old values are fetched
+ * with getBulk, and if any differ the new ones go in with setBulk.
+ */
+template< class F > class ScalarCodec: public ConvCodec< F >
+{
+	public:
+		bool loadBulk( const ObjId& dest, const string& field,
+				const DestFinfo* set, const FieldBatch& vals ) const
+		{
+			size_t n = vals.size();
+			for ( size_t i = 0; i < n; ++i )
+				if ( vals[i].second[0] != 1 )
+					return false;
+			unique_ptr< F[] > have( new F[n] );
+			if ( !Field< F >::getBulk( dest, field, have.get(), n ) )
+				return false;
+
+			unique_ptr< F[] > want( new F[n] );
+			vector< size_t > changed;
+			for ( size_t i = 0; i < n; ++i ) {
+				double old = 0.0;
+				double* p = &old;
+				Conv< F >::val2buf( have[i], &p );
+				p = const_cast< double* >( vals[i].second + 1 );
+				want[i] = Conv< F >::buf2val( &p );
+				if ( memcmp( &old, vals[i].second + 1, sizeof( double ) ) != 0 )
+					changed.push_back( i );
+			}
+			if ( changed.size() == n )
+				return Field< F >::setBulk( dest, field, want.get(), n );
+			for ( size_t i = 0; i < changed.size(); ++i )
+				setValue( vals[ changed[i] ].first, set, want[ changed[i] ] );
+			return true;
+		}
+};
+
+/**
+ * Stored as 4 words: 0 and the element index, or 1 and the string
+ * index of the path for objects outside the model, then the dataIndex
+ * and fieldIndex.
+ */
+template< class F > class ObjIdCodec: public FieldCodec
+{
+	public:
+		void save( const Eref& er, const DestFinfo* get,
+				SnapIds& ids, vector< double >& buf ) const
+		{
+			ObjId val( getValue< F >( er, get ) );
+			if ( !val.element() ) // Object has been deleted.
+				val = ObjId();
+			buf.push_back( 4 );
+			map< const Element*, uint64_t >::const_iterator i =
+				ids.index.find( val.element() );
+			if ( i != ids.index.end() ) {
+				buf.push_back( 0 );
+				buf.push_back( i->second );
+			} else {
+				buf.push_back( 1 );
+				buf.push_back( ids.strings->add( val.id.path() ) );
+			}
+			buf.push_back( val.dataIndex );
+			buf.push_back( val.fieldIndex );
+		}
+
+		void load( const Eref& er, const DestFinfo* get,
+				const DestFinfo* set, const SnapIds& ids,
+				const double* buf, uint64_t size ) const
+		{
+			if ( size != 4 )
+				return;
+			Id id;
+			uint64_t i = buf[1];
+			if ( buf[0] == 0 && i < ids.ids.size() )
+				id = ids.ids[i];
+			else if ( buf[0] == 1 )
+				id = Id( ids.strings->get( i ) );
+			ObjId val( id, DataId( buf[2] ), (unsigned int)buf[3] );
+			if ( ObjId( getValue< F >( er, get ) ) == val )
+				return;
+			setValue( er, set, fromObjId( val ) );
+		}
+
+	private:
+		static F fromObjId( const ObjId& oid );
+};
+
+template<> Id ObjIdCodec< Id >::fromObjId( const ObjId& oid )
+{
+	return oid.id;
+}
+
+template<> ObjId ObjIdCodec< ObjId >::fromObjId( const ObjId& oid )
+{
+	return oid;
+}
+
+const FieldCodec* findCodec( const string& rttiType )
+{
+	static map< string, const FieldCodec* > codecs;
+	if ( codecs.empty() ) {
+		static ScalarCodec< double > doubleCodec;
+		static ScalarCodec< float > floatCodec;
+		static ScalarCodec< int > intCodec;
+		static ScalarCodec< unsigned int > uintCodec;
+		static ScalarCodec< bool > boolCodec;
+		static ConvCodec< string > stringCodec;
+		static ConvCodec< vector< double > > vecDoubleCodec;
+		static ConvCodec< vector< int > > vecIntCodec;
+		static ConvCodec< vector< unsigned int > > vecUintCodec;
+		static ConvCodec< vector< string > > vecStringCodec;
+		static ConvCodec< vector< vector< double > > > vecVecDoubleCodec;
+		static ObjIdCodec< Id > idCodec;
+		static ObjIdCodec< ObjId > objIdCodec;
+		codecs[ Conv< double >::rttiType() ] = &doubleCodec;
+		codecs[ Conv< float >::rttiType() ] = &floatCodec;
+		codecs[ Conv< int >::rttiType() ] = &intCodec;
+		codecs[ Conv< unsigned int >::rttiType() ] = &uintCodec;
+		codecs[ Conv< bool >::rttiType() ] = &boolCodec;
+		codecs[ Conv< string >::rttiType() ] = &stringCodec;
+		codecs[ Conv< vector< double > >::rttiType() ] = &vecDoubleCodec;
+		codecs[ Conv< vector< int > >::rttiType() ] = &vecIntCodec;
+		codecs[ Conv< vector< unsigned int > >::rttiType() ] = &vecUintCodec;
+		codecs[ Conv< vector< string > >::rttiType() ] = &vecStringCodec;
+		codecs[ Conv< vector< vector< double > > >::rttiType() ] =
+			&vecVecDoubleCodec;
+		codecs[ Conv< Id >::rttiType() ] = &idCodec;
+		codecs[ Conv< ObjId >::rttiType() ] = &objIdCodec;
+	}
+	map< string, const FieldCodec* >::const_iterator i =
+		codecs.find( rttiType );
+	return i == codecs.end() ? 0 : i->second;
+}
+
+const DestFinfo* findAccessor( const Cinfo* c, const string& prefix,
+		const string& field )
+{
+	string name = prefix + field;
+	name[ prefix.length() ] = std::toupper( name[ prefix.length() ] );
+	return dynamic_cast< const DestFinfo* >( c->findFinfo( name ) );
+}
+
+struct SavedField
+{
+	string name;
+	string rttiType;
+	const DestFinfo* get;
+	const DestFinfo* set;
+	const FieldCodec* codec;
+	bool isSetup;
+};
+
+struct SavedClass
+{
+	const Cinfo* cinfo;
+	vector< SavedField > fields;
+};
+
+BindIndex childBindIndex()
+{
+	static const SrcFinfo* cf = dynamic_cast< const SrcFinfo* >(
+			Neutral::initCinfo()->findFinfo( "childOut" ) );
+	return cf->getBindIndex();
+}
+
+/**
+ * The children of all entries of e, in order. Neutral::children lists a
+ * FieldElement once for each entry of its parent, so repeats are dropped.
+ */
+void children( Element* e, vector< Id >& kids )
+{
+	vector< Id > all;
+	Neutral::children( Eref( e, ALLDATA ), all );
+	set< Id > seen;
+	for ( vector< Id >::const_iterator i = all.begin(); i != all.end(); ++i )
+		if ( seen.insert( *i ).second )
+			kids.push_back( *i );
+}
+
+/**
+ * Gathers the model into the sections of the snapshot. For a
+ * checkpoint it gathers the runtime state instead of the messages.
+ */
+class SnapWriter
+{
+	public:
+		SnapWriter( bool checkpoint = false )
+			: checkpoint_( checkpoint )
+		{
+			ids_.strings = &strings_;
+		}
+
+		bool write( Id model, const string& fname );
+		bool writeCheckpoint( Id model, const string& fname );
+
+	private:
+		bool addTree( Id id, uint64_t parent, uint64_t parentData );
+		uint64_t addClass( const Cinfo* c );
+		void addFields( uint64_t elm );
+		void addBindings( uint64_t elm );
+		bool addMsg( const Msg* m, uint64_t& ret );
+		void addState( uint64_t elm );
+		void packClasses( vector< uint64_t >& classes );
+		bool writeFile( const string& fname, const char* magic,
+				uint32_t version, vector< SectionEntry >& table,
+				const vector< pair< const char*, size_t > >& data ) const;
+
+		bool checkpoint_;
+
+		StringTable strings_;
+		SnapIds ids_;
+		vector< Element* > elms_;
+		vector< ElementRecord > elmRecords_;
+		vector< SavedClass > classes_;
+		map< const Cinfo*, uint64_t > classIndex_;
+		vector< double > fields_;
+		vector< MsgRecord > msgs_;
+		map< ObjId, uint64_t > msgIndex_;
+		vector< unsigned int > sparse_;
+		vector< BindingRecord > bindings_;
+		vector< char > state_;
+		vector< StateRecord > stateIndex_;
+};
+
+uint64_t SnapWriter::addClass( const Cinfo* c )
+{
+	map< const Cinfo*, uint64_t >::iterator i = classIndex_.find( c );
+	if ( i != classIndex_.end() )
+		return i->second;
+
+	SavedClass sc;
+	sc.cinfo = c;
+	// Neutral's own fields describe the tree, which is saved separately.
+	for ( unsigned int j = Neutral::initCinfo()->getNumValueFinfo();
+			j < c->getNumValueFinfo(); ++j ) {
+		const Finfo* f = c->getValueFinfo( j );
+		const string& name = f->name();
+		if ( isSolverField( c, name ) || isDerivedField( c, name ) ||
+				( checkpoint_ &&
+				( isSetupField( c, name ) || isStateField( c, name ) ) ) )
+			continue;
+		SavedField sf;
+		sf.name = name;
+		sf.rttiType = f->rttiType();
+		sf.get = findAccessor( c, "get", name );
+		sf.set = findAccessor( c, "set", name );
+		sf.codec = findCodec( sf.rttiType );
+		sf.isSetup = isSetupField( c, name );
+		if ( sf.get && sf.set && sf.codec )
+			sc.fields.push_back( sf );
+	}
+	classes_.push_back( sc );
+	classIndex_[c] = classes_.size() - 1;
+	return classes_.size() - 1;
+}
+
+bool SnapWriter::addTree( Id id, uint64_t parent, uint64_t parentData )
+{
+	Element* e = id.element();
+	const string& cname = e->cinfo()->name();
+	if ( !checkpoint_ && cname.substr( 0, 6 ) == "Zombie" &&
+			!nativeCinfo( e->cinfo() ) ) {
+		cout << "Warning: writeBinaryModel: '" << id.path() <<
+			"' is run by a solver as a " << cname <<
+			". Save the model before setting up the solver.\n";
+		return false;
+	}
+
+	ElementRecord rec;
+	rec.name = strings_.add( e->getName() );
+	rec.cls = addClass( e->cinfo() );
+	rec.parent = parent;
+	rec.parentData = parentData;
+	rec.numData = e->numData();
+	rec.tick = e->getTick();
+	rec.flags = ( e->hasFields() ? FIELD_ELEMENT : 0 ) |
+		( e->isGlobal() ? GLOBAL_ELEMENT : 0 );
+	rec.fields = 0;
+	uint64_t elm = elms_.size();
+	ids_.index[e] = elm;
+	elms_.push_back( e );
+	elmRecords_.push_back( rec );
+
+	vector< Id > kids;
+	children( e, kids );
+	for ( vector< Id >::iterator i = kids.begin(); i != kids.end(); ++i ) {
+		ObjId pa = Neutral::parent( *i );
+		if ( !addTree( *i, elm, pa.dataIndex ) )
+			return false;
+	}
+	return true;
+}
+
+/**
+ * A FieldElement starts with the number of fields on each data entry.
+ * Then, for each entry, the values of the saved fields of its class.
+ */
+void SnapWriter::addFields( uint64_t elm )
+{
+	Element* e = elms_[elm];
+	const SavedClass& sc = classes_[ elmRecords_[elm].cls ];
+	elmRecords_[elm].fields = fields_.size();
+	unsigned int start = e->localDataStart();
+	unsigned int num = e->numData();
+	bool hasFields = e->hasFields();
+	if ( hasFields )
+		for ( unsigned int i = 0; i < num; ++i )
+			fields_.push_back( e->numField( i - start ) );
+
+	for ( unsigned int i = 0; i < num; ++i ) {
+		unsigned int nf = hasFields ? e->numField( i - start ) : 1;
+		for ( unsigned int j = 0; j < nf; ++j ) {
+			Eref er( e, i, j );
+			for ( vector< SavedField >::const_iterator
+					k = sc.fields.begin(); k != sc.fields.end(); ++k )
+				k->codec->save( er, k->get, ids_, fields_ );
+		}
+	}
+}
+
+bool SnapWriter::addMsg( const Msg* m, uint64_t& ret )
+{
+	map< ObjId, uint64_t >::iterator i = msgIndex_.find( m->mid() );
+	if ( i != msgIndex_.end() ) {
+		ret = i->second;
+		return true;
+	}
+
+	MsgRecord rec;
+	memset( &rec, 0, sizeof( rec ) );
+	rec.e1 = ids_.index[ m->e1() ];
+	rec.e2 = ids_.index[ m->e2() ];
+	if ( const SingleMsg* sm = dynamic_cast< const SingleMsg* >( m ) ) {
+		rec.kind = SNAP_SINGLE;
+		rec.i1 = sm->getI1();
+		rec.i2 = sm->getI2();
+		rec.field = sm->getTargetField();
+	} else if ( const OneToOneMsg* om =
+			dynamic_cast< const OneToOneMsg* >( m ) ) {
+		rec.kind = SNAP_ONE_TO_ONE;
+		rec.i1 = om->getI1();
+		rec.i2 = om->getI2();
+	} else if ( dynamic_cast< const OneToOneDataIndexMsg* >( m ) ) {
+		rec.kind = SNAP_ONE_TO_ONE_DATA_INDEX;
+	} else if ( const OneToAllMsg* am =
+			dynamic_cast< const OneToAllMsg* >( m ) ) {
+		rec.kind = SNAP_ONE_TO_ALL;
+		rec.i1 = am->getI1();
+	} else if ( const DiagonalMsg* dm =
+			dynamic_cast< const DiagonalMsg* >( m ) ) {
+		rec.kind = SNAP_DIAGONAL;
+		rec.stride = dm->getStride();
+	} else if ( const SparseMsg* sm =
+			dynamic_cast< const SparseMsg* >( m ) ) {
+		rec.kind = SNAP_SPARSE_MSG;
+		const SparseMatrix< unsigned int >& mat =
+			const_cast< SparseMsg* >( sm )->getMatrix();
+		vector< unsigned int > src;
+		vector< unsigned int > dest;
+		vector< unsigned int > field;
+		for ( unsigned int r = 0; r < mat.nRows(); ++r ) {
+			const unsigned int* entry = 0;
+			const unsigned int* col = 0;
+			unsigned int n = mat.getRow( r, &entry, &col );
+			for ( unsigned int j = 0; j < n; ++j ) {
+				src.push_back( r );
+				dest.push_back( col[j] );
+				field.push_back( entry[j] );
+			}
+		}
+		rec.sparse = sparse_.size();
+		rec.numSparse = src.size();
+		sparse_.insert( sparse_.end(), src.begin(), src.end() );
+		sparse_.insert( sparse_.end(), dest.begin(), dest.end() );
+		sparse_.insert( sparse_.end(), field.begin(), field.end() );
+	} else {
+		cout << "Warning: writeBinaryModel: cannot save message from " <<
+			m->e1()->getName() << " to " << m->e2()->getName() << endl;
+		return false;
+	}
+	ret = msgs_.size();
+	msgIndex_[ m->mid() ] = ret;
+	msgs_.push_back( rec );
+	return true;
+}
+
+/**
+ * Saves the messages that go out of this element to others in the
+ * model. Messages to the clock and other objects outside are left out.
+ */
+void SnapWriter::addBindings( uint64_t elm )
+{
+	Element* e = elms_[elm];
+	const Cinfo* c = e->cinfo();
+	for ( BindIndex b = 0; b < c->numBindIndex(); ++b ) {
+		if ( b == childBindIndex() )
+			continue;
+		const vector< MsgFuncBinding >* mfb = e->getMsgAndFunc( b );
+		if ( !mfb )
+			continue;
+		for ( vector< MsgFuncBinding >::const_iterator
+				i = mfb->begin(); i != mfb->end(); ++i ) {
+			const Msg* m = Msg::getMsg( i->mid );
+			if ( !m )
+				continue;
+			const Element* other = ( m->e1() == e ) ? m->e2() : m->e1();
+			if ( ids_.index.find( other ) == ids_.index.end() )
+				continue;
+			const string& src = c->srcFinfoName( b );
+			if ( isSolverMsg( e, src, other ) )
+				continue;
+			BindingRecord rec;
+			if ( !addMsg( m, rec.msg ) )
+				continue;
+			rec.elm = elm;
+			rec.srcField = strings_.add( src );
+			rec.destField = strings_.add(
+					other->cinfo()->destFinfoName( i->fid ) );
+			bindings_.push_back( rec );
+		}
+	}
+}
+
+/**
+ * Saves the state of each data entry of classes that have it. Entries
+ * of FieldElements are saved along with their parents.
+ */
+void SnapWriter::addState( uint64_t elm )
+{
+	Element* e = elms_[elm];
+	const DinfoBase* d = e->cinfo()->dinfo();
+	if ( e->hasFields() || !d->hasState() )
+		return;
+	for ( unsigned int i = 0; i < e->numData(); ++i ) {
+		StateRecord rec;
+		rec.elm = elm;
+		rec.data = i;
+		rec.offset = state_.size();
+		StateWriter w( state_ );
+		d->saveState( Eref( e, i ).data(), w );
+		rec.size = state_.size() - rec.offset;
+		stateIndex_.push_back( rec );
+	}
+}
+
+template< class T > void appendSection( vector< SectionEntry >& table,
+		vector< pair< const char*, size_t > >& data,
+		uint32_t kind, const vector< T >& v )
+{
+	SectionEntry s;
+	s.kind = kind;
+	s.reserved = 0;
+	s.offset = 0;
+	s.size = v.size() * sizeof( T );
+	table.push_back( s );
+	data.push_back( pair< const char*, size_t >(
+			reinterpret_cast< const char* >( v.data() ), s.size ) );
+}
+
+bool SnapWriter::write( Id model, const string& fname )
+{
+	// String 0 is the path of the model when saved.
+	strings_.add( model.path() );
+	ObjId pa = Neutral::parent( model );
+	if ( !addTree( model, NO_PARENT, pa.dataIndex ) )
+		return false;
+	for ( uint64_t i = 0; i < elms_.size(); ++i ) {
+		addFields( i );
+		addBindings( i );
+	}
+
+	vector< uint64_t > classes;
+	packClasses( classes );
+
+	set< int > ticks;
+	for ( vector< Element* >::const_iterator
+			i = elms_.begin(); i != elms_.end(); ++i )
+		if ( ( *i )->getTick() >= 0 )
+			ticks.insert( ( *i )->getTick() );
+	vector< ClockRecord > clock;
+	for ( set< int >::const_iterator i = ticks.begin(); i != ticks.end(); ++i ) {
+		ClockRecord r;
+		r.tick = *i;
+		r.dt = LookupField< unsigned int, double >::get(
+				ObjId( 1 ), "tickDt", *i );
+		clock.push_back( r );
+	}
+
+	vector< uint64_t > strings;
+	strings_.pack( strings );
+
+	vector< SectionEntry > table;
+	vector< pair< const char*, size_t > > data;
+	appendSection( table, data, SNAP_STRINGS, strings );
+	appendSection( table, data, SNAP_CLASSES, classes );
+	appendSection( table, data, SNAP_ELEMENTS, elmRecords_ );
+	appendSection( table, data, SNAP_FIELDS, fields_ );
+	appendSection( table, data, SNAP_MSGS, msgs_ );
+	appendSection( table, data, SNAP_SPARSE, sparse_ );
+	appendSection( table, data, SNAP_BINDINGS, bindings_ );
+	appendSection( table, data, SNAP_CLOCK, clock );
+	return writeFile( fname, snapMagic, snapVersion, table, data );
+}
+
+/**
+ * A checkpoint has the same tree and field sections as a snapshot, so
+ * that it can be checked against the model it is restored onto, and
+ * then the state of each entry and of the clock and global RNG.
+ */
+bool SnapWriter::writeCheckpoint( Id model, const string& fname )
+{
+	if ( reinterpret_cast< Clock* >( Id( 1 ).eref().data() )->isRunning() ) {
+		cout << "Warning: writeCheckpoint: cannot save while the "
+			"simulation is running\n";
+		return false;
+	}
+	strings_.add( model.path() );
+	ObjId pa = Neutral::parent( model );
+	addTree( model, NO_PARENT, pa.dataIndex );
+	for ( uint64_t i = 0; i < elms_.size(); ++i ) {
+		addFields( i );
+		addState( i );
+	}
+	vector< uint64_t > classes;
+	packClasses( classes );
+
+	vector< char > global;
+	StateWriter w( global );
+	w.put( moose::rng.getState() );
+	Eref clock = Id( 1 ).eref();
+	clock.element()->cinfo()->dinfo()->saveState( clock.data(), w );
+
+	vector< uint64_t > strings;
+	strings_.pack( strings );
+
+	vector< SectionEntry > table;
+	vector< pair< const char*, size_t > > data;
+	appendSection( table, data, SNAP_STRINGS, strings );
+	appendSection( table, data, SNAP_CLASSES, classes );
+	appendSection( table, data, SNAP_ELEMENTS, elmRecords_ );
+	appendSection( table, data, SNAP_FIELDS, fields_ );
+	appendSection( table, data, SNAP_STATE, state_ );
+	appendSection( table, data, SNAP_STATE_INDEX, stateIndex_ );
+	appendSection( table, data, SNAP_GLOBAL, global );
+	return writeFile( fname, ckpMagic, ckpVersion, table, data );
+}
+
+void SnapWriter::packClasses( vector< uint64_t >& classes )
+{
+	for ( vector< SavedClass >::const_iterator
+			i = classes_.begin(); i != classes_.end(); ++i ) {
+		const Cinfo* native = checkpoint_ ? 0 : nativeCinfo( i->cinfo );
+		classes.push_back( strings_.add(
+					( native ? native : i->cinfo )->name() ) );
+		classes.push_back( i->fields.size() );
+		for ( vector< SavedField >::const_iterator
+				j = i->fields.begin(); j != i->fields.end(); ++j ) {
+			classes.push_back( strings_.add( j->name ) );
+			classes.push_back( strings_.add( j->rttiType ) );
+		}
+	}
+}
+
+bool SnapWriter::writeFile( const string& fname, const char* magic,
+		uint32_t version, vector< SectionEntry >& table,
+		const vector< pair< const char*, size_t > >& data ) const
+{
+	uint64_t offset = sizeof( SnapHeader ) + table.size() * sizeof( SectionEntry );
+	for ( vector< SectionEntry >::iterator
+			i = table.begin(); i != table.end(); ++i ) {
+		i->offset = offset;
+		offset += ( i->size + 7 ) & ~7ULL;
+	}
+
+	ofstream fout( fname.c_str(), ios::out | ios::binary | ios::trunc );
+	if ( !fout ) {
+		cout << "Warning: " << ( checkpoint_ ? "writeCheckpoint" :
+				"writeBinaryModel" ) << ": could not open file " <<
+			fname << endl;
+		return false;
+	}
+	SnapHeader h;
+	memcpy( h.magic, magic, sizeof( h.magic ) );
+	h.version = version;
+	h.numSections = table.size();
+	fout.write( reinterpret_cast< const char* >( &h ), sizeof( h ) );
+	fout.write( reinterpret_cast< const char* >( table.data() ),
+			table.size() * sizeof( SectionEntry ) );
+	static const char pad[8] = { 0 };
+	for ( size_t i = 0; i < data.size(); ++i ) {
+		fout.write( data[i].first, data[i].second );
+		fout.write( pad, ( 8 - data[i].second % 8 ) % 8 );
+	}
+	return fout.good();
+}
+
+/**
+ * Loads a snapshot mapped into memory. The sections are used in place,
+ * so only the pages that are looked at are read from the file.
+ */
+class SnapReader
+{
+	public:
+		SnapReader()
+			: data_( 0 ), bytes_( 0 ), map_( 0 )
+		{
+			ids_.strings = &strings_;
+		}
+
+		~SnapReader()
+		{
+#ifndef _WIN32
+			if ( map_ )
+				munmap( map_, bytes_ );
+#endif
+		}
+
+		Id read( const string& fname, const string& modelName, ObjId parent );
+		bool check( Id model, const string& fname );
+		bool restore();
+
+	private:
+		bool open( const string& fname, const char* magic, uint32_t version,
+				const char* caller );
+		template< class T > const T* section( uint32_t kind, size_t& n ) const;
+		bool readClasses();
+		bool matchTree( Id id, uint64_t parent );
+		bool restoreState();
+		bool makeElements( const string& modelName, ObjId parent );
+		bool makeMsgs();
+		void setFields();
+		void loadBatch( const ObjId& dest, size_t num, const SavedClass& sc,
+				vector< FieldBatch >& batch ) const;
+		void setSetupField( const Eref& er, const SavedField& f,
+				const double* buf ) const;
+
+		const char* data_;
+		size_t bytes_;
+		void* map_;
+		vector< uint64_t > file_; // Holds the file where there is no mmap.
+		StringTable strings_;
+		SnapIds ids_;
+		vector< SavedClass > classes_;
+		const ElementRecord* elms_;
+		size_t numElms_;
+		const double* fields_;
+		size_t numFields_;
+};
+
+template< class T >
+const T* SnapReader::section( uint32_t kind, size_t& n ) const
+{
+	const SnapHeader* h = reinterpret_cast< const SnapHeader* >( data_ );
+	const SectionEntry* table =
+		reinterpret_cast< const SectionEntry* >( h + 1 );
+	n = 0;
+	for ( uint32_t i = 0; i < h->numSections; ++i ) {
+		if ( table[i].kind != kind )
+			continue;
+		if ( table[i].offset % 8 != 0 ||
+				table[i].offset + table[i].size > bytes_ )
+			return 0;
+		n = table[i].size / sizeof( T );
+		return reinterpret_cast< const T* >( data_ + table[i].offset );
+	}
+	return 0;
+}
+
+bool SnapReader::readClasses()
+{
+	size_t n = 0;
+	const uint64_t* w = section< uint64_t >( SNAP_CLASSES, n );
+	const uint64_t* end = w + n;
+	while ( w && w + 2 <= end ) {
+		SavedClass sc;
+		const string& cname = strings_.get( *w++ );
+		sc.cinfo = Cinfo::find( cname );
+		if ( !sc.cinfo ) {
+			cout << "Error: readBinaryModel: unknown class " << cname << endl;
+			return false;
+		}
+		uint64_t numFields = *w++;
+		if ( w + 2 * numFields > end )
+			return false;
+		for ( uint64_t i = 0; i < numFields; ++i ) {
+			const string& name = strings_.get( *w++ );
+			const string& rtti = strings_.get( *w++ );
+			const Finfo* f = sc.cinfo->findFinfo( name );
+			SavedField sf;
+			sf.name = name;
+			sf.rttiType = rtti;
+			sf.get = findAccessor( sc.cinfo, "get", name );
+			sf.set = findAccessor( sc.cinfo, "set", name );
+			sf.codec = findCodec( rtti );
+			sf.isSetup = isSetupField( sc.cinfo, name );
+			// Fields since dropped from the class are skipped on loading.
+			if ( !( f && f->rttiType() == rtti && sf.get && sf.set ) )
+				sf.codec = 0;
+			sc.fields.push_back( sf );
+		}
+		classes_.push_back( sc );
+	}
+	return true;
+}
+
+/**
+ * Makes each element with its whole data array in one allocation.
+ * FieldElements are made along with their parents, and only need
+ * their field arrays resized.
+ */
+bool SnapReader::makeElements( const string& modelName, ObjId parent )
+{
+	Shell* shell = reinterpret_cast< Shell* >( Id().eref().data() );
+	for ( size_t i = 0; i < numElms_; ++i ) {
+		const ElementRecord& rec = elms_[i];
+		if ( rec.cls >= classes_.size() || rec.fields > numFields_ ||
+				( i > 0 && rec.parent >= i ) ) {
+			cout << "Error: readBinaryModel: bad element record " << i << endl;
+			return false;
+		}
+		ObjId pa = ( i == 0 ) ? parent :
+			ObjId( ids_.ids[ rec.parent ], rec.parentData );
+		string name = ( i == 0 ) ? modelName : strings_.get( rec.name );
+		Id id;
+		if ( rec.flags & FIELD_ELEMENT ) {
+			id = Neutral::child( pa.eref(), name );
+			if ( id == Id() ) {
+				cout << "Error: readBinaryModel: no field " << name <<
+					" on " << pa.path() << endl;
+				return false;
+			}
+			Element* e = id.element();
+			const double* numField = fields_ + rec.fields;
+			unsigned int start = e->localDataStart();
+			for ( unsigned int j = 0; j < e->numData() &&
+					rec.fields + j < numFields_; ++j )
+				if ( e->numField( j - start ) != numField[j] )
+					e->resizeField( j - start, numField[j] );
+		} else {
+			const Cinfo* c = classes_[ rec.cls ].cinfo;
+			id = shell->doCreate( c->name(), pa, name, rec.numData,
+					( rec.flags & GLOBAL_ELEMENT ) ? MooseGlobal :
+					MooseBlockBalance );
+			if ( id == Id() )
+				return false;
+		}
+		ids_.ids.push_back( id );
+	}
+	return true;
+}
+
+bool SnapReader::makeMsgs()
+{
+	size_t numMsgs = 0;
+	size_t numSparse = 0;
+	size_t numBindings = 0;
+	const MsgRecord* msgs = section< MsgRecord >( SNAP_MSGS, numMsgs );
+	const unsigned int* sparse =
+		section< unsigned int >( SNAP_SPARSE, numSparse );
+	const BindingRecord* bindings =
+		section< BindingRecord >( SNAP_BINDINGS, numBindings );
+
+	vector< Msg* > made( numMsgs, 0 );
+	for ( size_t i = 0; i < numMsgs; ++i ) {
+		const MsgRecord& r = msgs[i];
+		if ( r.e1 >= ids_.ids.size() || r.e2 >= ids_.ids.size() )
+			return false;
+		Element* e1 = ids_.ids[ r.e1 ].element();
+		Element* e2 = ids_.ids[ r.e2 ].element();
+		// Only these kinds use the data indices; the others store 0.
+		bool usesI1 = r.kind == SNAP_SINGLE || r.kind == SNAP_ONE_TO_ONE ||
+			r.kind == SNAP_ONE_TO_ALL;
+		bool usesI2 = r.kind == SNAP_SINGLE || r.kind == SNAP_ONE_TO_ONE;
+		if ( ( usesI1 && r.i1 >= e1->numData() ) ||
+				( usesI2 && r.i2 >= e2->numData() ) ) {
+			cout << "Error: readBinaryModel: message " << i <<
+				" from " << e1->getName() << "[" << r.i1 << "] to " <<
+				e2->getName() << "[" << r.i2 << "] is out of range" << endl;
+			return false;
+		}
+		switch ( r.kind ) {
+			case SNAP_SINGLE:
+			{
+				SingleMsg* sm = new SingleMsg(
+						Eref( e1, r.i1 ), Eref( e2, r.i2 ), 0 );
+				sm->setTargetField( r.field );
+				made[i] = sm;
+				break;
+			}
+			case SNAP_ONE_TO_ONE:
+				made[i] = new OneToOneMsg(
+						Eref( e1, r.i1 ), Eref( e2, r.i2 ), 0 );
+				break;
+			case SNAP_ONE_TO_ONE_DATA_INDEX:
+				made[i] = new OneToOneDataIndexMsg(
+						Eref( e1, 0 ), Eref( e2, 0 ), 0 );
+				break;
+			case SNAP_ONE_TO_ALL:
+				made[i] = new OneToAllMsg( Eref( e1, r.i1 ), e2, 0 );
+				break;
+			case SNAP_DIAGONAL:
+			{
+				DiagonalMsg* dm = new DiagonalMsg( e1, e2, 0 );
+				dm->setStride( r.stride );
+				made[i] = dm;
+				break;
+			}
+			case SNAP_SPARSE_MSG:
+			{
+				SparseMsg* sm = new SparseMsg( e1, e2, 0 );
+				made[i] = sm;
+				if ( r.sparse + 3 * r.numSparse > numSparse )
+					return false;
+				const unsigned int* s = sparse + r.sparse;
+				if ( !sm->batchFill( s, s + r.numSparse,
+							s + 2 * r.numSparse, r.numSparse ) )
+					return false;
+				break;
+			}
+			default:
+				cout << "Error: readBinaryModel: unknown message type " <<
+					r.kind << endl;
+				return false;
+		}
+	}
+
+	for ( size_t i = 0; i < numBindings; ++i ) {
+		const BindingRecord& b = bindings[i];
+		if ( b.msg >= numMsgs || b.elm >= ids_.ids.size() )
+			return false;
+		const Msg* m = made[ b.msg ];
+		Element* e = ids_.ids[ b.elm ].element();
+		const Element* other = ( m->e1() == e ) ? m->e2() : m->e1();
+		const SrcFinfo* sf = dynamic_cast< const SrcFinfo* >(
+				e->cinfo()->findFinfo( strings_.get( b.srcField ) ) );
+		const DestFinfo* df = dynamic_cast< const DestFinfo* >(
+				other->cinfo()->findFinfo( strings_.get( b.destField ) ) );
+		if ( !sf || !df ) {
+			cout << "Warning: readBinaryModel: dropped message " <<
+				e->getName() << "." << strings_.get( b.srcField ) <<
+				" to " << other->getName() << "." <<
+				strings_.get( b.destField ) << endl;
+			continue;
+		}
+		e->addMsgAndFunc( m->mid(), df->getFid(), sf->getBindIndex() );
+	}
+
+	for ( size_t i = 0; i < numMsgs; ++i ) {
+		const Msg* m = made[i];
+		SetGet1< ObjId >::set( m->e1()->id(), "notifyAddMsgSrc", m->mid() );
+		SetGet1< ObjId >::set( m->e2()->id(), "notifyAddMsgDest", m->mid() );
+	}
+	return true;
+}
+
+void SnapReader::setSetupField( const Eref& er, const SavedField& f,
+		const double* buf ) const
+{
+	double* p = const_cast< double* >( buf );
+	string path = Conv< string >::buf2val( &p );
+	if ( path.empty() )
+		return;
+	const string& oldRoot = strings_.get( 0 );
+	string newRoot = ids_.ids[0].path();
+	for ( string::size_type pos = path.find( oldRoot );
+			pos != string::npos; pos = path.find( oldRoot, pos ) ) {
+		path.replace( pos, oldRoot.length(), newRoot );
+		pos += newRoot.length();
+	}
+	setValue( er, f.set, path );
+}
+
+/**
+ * Assigns the values gathered for each field of sc. If they cover all
+ * num entries of dest they go in together, otherwise one at a time. A
+ * lone entry is also done on its own, which saves looking up the field.
+ */
+void SnapReader::loadBatch( const ObjId& dest, size_t num,
+		const SavedClass& sc, vector< FieldBatch >& batch ) const
+{
+	for ( size_t i = 0; i < batch.size(); ++i ) {
+		const SavedField& f = sc.fields[i];
+		FieldBatch& b = batch[i];
+		if ( b.empty() )
+			continue;
+		if ( b.size() != num || num < 2 ||
+				!f.codec->loadBulk( dest, f.name, f.set, b ) )
+			for ( FieldBatch::const_iterator j = b.begin(); j != b.end(); ++j )
+				f.codec->load( j->first, f.get, f.set, ids_,
+						j->second + 1, j->second[0] );
+		b.clear();
+	}
+}
+
+/**
+ * Assigns fields element by element, parents first, so that for
+ * example the pools in a compartment see its final volume. Within an
+ * element each field is assigned over all the entries at once, or over
+ * the field entries of one data entry of a FieldElement. Solvers are
+ * set up last, over the finished model.
+ */
+void SnapReader::setFields()
+{
+	vector< pair< Eref, pair< const SavedField*, const double* > > > setup;
+	const double* end = fields_ + numFields_;
+	vector< FieldBatch > batch;
+	bool truncated = false;
+	for ( size_t i = 0; i < numElms_ && !truncated; ++i ) {
+		const ElementRecord& rec = elms_[i];
+		const SavedClass& sc = classes_[ rec.cls ];
+		Element* e = ids_.ids[i].element();
+		unsigned int start = e->localDataStart();
+		const double* p = fields_ + rec.fields;
+		bool hasFields = rec.flags & FIELD_ELEMENT;
+		const double* numField = p;
+		if ( hasFields )
+			p += rec.numData;
+		batch.resize( sc.fields.size() );
+		for ( uint64_t j = 0; j < rec.numData && p < end && !truncated; ++j ) {
+			uint64_t nf = hasFields ? numField[j] : 1;
+			for ( uint64_t k = 0; k < nf && !truncated; ++k ) {
+				bool here = j < e->numData() &&
+					( !hasFields || k < e->numField( j - start ) );
+				Eref er( e, j, k );
+				for ( size_t f = 0; f < sc.fields.size(); ++f ) {
+					uint64_t size = ( p < end ) ? *p : 0;
+					if ( p >= end || p + 1 + size > end ) {
+						truncated = true;
+						break;
+					}
+					const SavedField& sf = sc.fields[f];
+					if ( here && sf.codec ) {
+						if ( sf.isSetup )
+							setup.push_back( make_pair( er,
+										make_pair( &sf, p + 1 ) ) );
+						else
+							batch[f].push_back( make_pair( er, p ) );
+					}
+					p += 1 + size;
+				}
+			}
+			if ( hasFields && j < e->numData() )
+				loadBatch( ObjId( ids_.ids[i], j ),
+						e->numField( j - start ), sc, batch );
+		}
+		if ( !hasFields )
+			loadBatch( ObjId( ids_.ids[i] ), e->numData(), sc, batch );
+	}
+	if ( truncated )
+		return;
+	for ( size_t i = 0; i < setup.size(); ++i )
+		setSetupField( setup[i].first, *setup[i].second.first,
+				setup[i].second.second );
+}
+
+bool SnapReader::open( const string& fname, const char* magic,
+		uint32_t version, const char* caller )
+{
+#ifndef _WIN32
+	int fd = ::open( fname.c_str(), O_RDONLY );
+	struct stat st;
+	if ( fd < 0 || fstat( fd, &st ) != 0 ) {
+		if ( fd >= 0 )
+			::close( fd );
+		cout << "Error: " << caller << ": could not open file " <<
+			fname << endl;
+		return false;
+	}
+	bytes_ = st.st_size;
+	if ( bytes_ >= sizeof( SnapHeader ) ) {
+		map_ = mmap( 0, bytes_, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( map_ == MAP_FAILED )
+			map_ = 0;
+	}
+	::close( fd );
+	data_ = static_cast< const char* >( map_ );
+	bool ok = map_ != 0;
+#else
+	ifstream fin( fname.c_str(), ios::in | ios::binary );
+	if ( !fin ) {
+		cout << "Error: " << caller << ": could not open file " <<
+			fname << endl;
+		return false;
+	}
+	fin.seekg( 0, ios::end );
+	bytes_ = fin.tellg();
+	fin.seekg( 0, ios::beg );
+	file_.resize( ( bytes_ + 7 ) / 8 + 1, 0 );
+	fin.read( reinterpret_cast< char* >( &file_[0] ), bytes_ );
+	data_ = reinterpret_cast< const char* >( &file_[0] );
+	bool ok = fin.good();
+#endif
+
+	const SnapHeader* h = reinterpret_cast< const SnapHeader* >( data_ );
+	if ( !ok || bytes_ < sizeof( SnapHeader ) ||
+			memcmp( h->magic, magic, sizeof( h->magic ) ) != 0 ||
+			sizeof( SnapHeader ) + h->numSections * sizeof( SectionEntry )
+			> bytes_ ) {
+		cout << "Error: " << caller << ": " << fname << " is not a MOOSE " <<
+			( magic == ckpMagic ? "checkpoint\n" : "snapshot\n" );
+		return false;
+	}
+	if ( h->version != version ) {
+		cout << "Error: " << caller << ": " << fname << " has version " <<
+			h->version << ", expected " << version << endl;
+		return false;
+	}
+	return true;
+}
+
+Id SnapReader::read( const string& fname, const string& modelName,
+		ObjId parent )
+{
+	if ( !open( fname, snapMagic, snapVersion, "readBinaryModel" ) )
+		return Id();
+
+	size_t n = 0;
+	const uint64_t* strings = section< uint64_t >( SNAP_STRINGS, n );
+	elms_ = section< ElementRecord >( SNAP_ELEMENTS, numElms_ );
+	fields_ = section< double >( SNAP_FIELDS, numFields_ );
+	if ( !strings || !strings_.unpack( strings, n ) || !elms_ ||
+			numElms_ == 0 || !fields_ || !readClasses() ||
+			!makeElements( modelName, parent ) || !makeMsgs() ) {
+		cout << "Error: readBinaryModel: could not load " << fname << endl;
+		if ( !ids_.ids.empty() ) {
+			Shell* shell = reinterpret_cast< Shell* >( Id().eref().data() );
+			shell->doDelete( ids_.ids[0] );
+		}
+		return Id();
+	}
+	setFields();
+
+	for ( size_t i = 0; i < numElms_; ++i ) {
+		Element* e = ids_.ids[i].element();
+		if ( e->getTick() != elms_[i].tick )
+			e->setTick( elms_[i].tick );
+	}
+	const ClockRecord* clock = section< ClockRecord >( SNAP_CLOCK, n );
+	for ( size_t i = 0; i < n; ++i )
+		LookupField< unsigned int, double >::set(
+				ObjId( 1 ), "tickDt", (unsigned int)clock[i].tick,
+				clock[i].dt );
+	return ids_.ids[0];
+}
+
+/**
+ * Walks the model as the writer did, checking that each element is the
+ * one saved at that place, and collects their Ids.
+ */
+bool SnapReader::matchTree( Id id, uint64_t parent )
+{
+	uint64_t i = ids_.ids.size();
+	Element* e = id.element();
+	if ( i >= numElms_ ) {
+		cout << "Error: readCheckpoint: model has more elements than the "
+			"checkpoint, such as " << id.path() << endl;
+		return false;
+	}
+	const ElementRecord& rec = elms_[i];
+	if ( rec.cls >= classes_.size() ||
+			classes_[ rec.cls ].cinfo != e->cinfo() ||
+			( i > 0 && strings_.get( rec.name ) != e->getName() ) ||
+			rec.parent != parent || rec.numData != e->numData() ||
+			( ( rec.flags & FIELD_ELEMENT ) != 0 ) != e->hasFields() ||
+			rec.fields + ( e->hasFields() ? rec.numData : 0 ) > numFields_ ) {
+		cout << "Error: readCheckpoint: " << id.path() <<
+			" does not match the checkpoint\n";
+		return false;
+	}
+	if ( e->hasFields() ) {
+		const double* numField = fields_ + rec.fields;
+		unsigned int start = e->localDataStart();
+		for ( unsigned int j = 0; j < e->numData(); ++j ) {
+			if ( e->numField( j - start ) != numField[j] ) {
+				cout << "Error: readCheckpoint: " << id.path() <<
+					" does not match the checkpoint\n";
+				return false;
+			}
+		}
+	}
+	ids_.ids.push_back( id );
+
+	vector< Id > kids;
+	children( e, kids );
+	for ( vector< Id >::iterator j = kids.begin(); j != kids.end(); ++j )
+		if ( !matchTree( *j, i ) )
+			return false;
+	return true;
+}
+
+bool SnapReader::restoreState()
+{
+	size_t numBytes = 0;
+	size_t numStates = 0;
+	const char* state = section< char >( SNAP_STATE, numBytes );
+	const StateRecord* index =
+		section< StateRecord >( SNAP_STATE_INDEX, numStates );
+	for ( size_t i = 0; i < numStates; ++i ) {
+		const StateRecord& rec = index[i];
+		if ( rec.elm >= ids_.ids.size() ||
+				rec.offset + rec.size > numBytes ) {
+			cout << "Error: readCheckpoint: bad state record " << i << endl;
+			return false;
+		}
+		Element* e = ids_.ids[ rec.elm ].element();
+		const DinfoBase* d = e->cinfo()->dinfo();
+		StateReader r( state + rec.offset, rec.size );
+		if ( e->hasFields() || rec.data >= e->numData() || !d->hasState() ||
+				!d->restoreState( Eref( e, rec.data ).data(), r ) ||
+				!r.done() ) {
+			cout << "Error: readCheckpoint: could not restore the state of " <<
+				ObjId( e->id(), rec.data ).path() << endl;
+			return false;
+		}
+	}
+
+	size_t n = 0;
+	const char* global = section< char >( SNAP_GLOBAL, n );
+	StateReader r( global, global ? n : 0 );
+	string rngState;
+	r.get( rngState );
+	Eref clock = Id( 1 ).eref();
+	if ( !r.ok() || !moose::rng.setState( rngState ) ||
+			!clock.element()->cinfo()->dinfo()->restoreState(
+				clock.data(), r ) || !r.done() ) {
+		cout << "Error: readCheckpoint: could not restore the clock\n";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Checks a checkpoint against the model it is to be restored onto,
+ * which must be the one it was saved from or one built the same way.
+ * Nothing is changed here, so a failed check leaves the model as it was.
+ */
+bool SnapReader::check( Id model, const string& fname )
+{
+	if ( reinterpret_cast< Clock* >( Id( 1 ).eref().data() )->isRunning() ) {
+		cout << "Error: readCheckpoint: cannot restore while the "
+			"simulation is running\n";
+		return false;
+	}
+	if ( !open( fname, ckpMagic, ckpVersion, "readCheckpoint" ) )
+		return false;
+
+	size_t n = 0;
+	const uint64_t* strings = section< uint64_t >( SNAP_STRINGS, n );
+	elms_ = section< ElementRecord >( SNAP_ELEMENTS, numElms_ );
+	fields_ = section< double >( SNAP_FIELDS, numFields_ );
+	if ( !strings || !strings_.unpack( strings, n ) || !elms_ ||
+			!fields_ || !readClasses() || !matchTree( model, NO_PARENT ) ) {
+		cout << "Error: readCheckpoint: could not restore " << fname <<
+			" onto " << model.path() << endl;
+		return false;
+	}
+	if ( ids_.ids.size() != numElms_ ) {
+		cout << "Error: readCheckpoint: " << model.path() <<
+			" has fewer elements than the checkpoint\n";
+		return false;
+	}
+
+	size_t numStates = 0;
+	section< StateRecord >( SNAP_STATE_INDEX, numStates );
+	size_t expected = 0;
+	for ( size_t i = 0; i < numElms_; ++i ) {
+		Element* e = ids_.ids[i].element();
+		if ( !e->hasFields() && e->cinfo()->dinfo()->hasState() )
+			expected += e->numData();
+	}
+	if ( numStates != expected ) {
+		cout << "Error: readCheckpoint: " << fname <<
+			" does not have the state of every object in " <<
+			model.path() << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Restores a checkpoint that has passed check. The value fields are
+ * assigned as for a snapshot, and the state of each entry is put back
+ * over them.
+ */
+bool SnapReader::restore()
+{
+	setFields();
+	return restoreState();
+}
+
+} // namespace
+
+bool writeBinaryModel( Id model, const string& fname )
+{
+	SnapWriter w;
+	return w.write( model, fname );
+}
+
+Id readBinaryModel( const string& fname, const string& modelName,
+		ObjId parent )
+{
+	SnapReader r;
+	return r.read( fname, modelName, parent );
+}
+
+bool writeCheckpoint( Id model, const string& fname )
+{
+	SnapWriter w( true );
+	return w.writeCheckpoint( model, fname );
+}
+
+bool readCheckpoint( Id model, const string& fname )
+{
+	SnapReader r;
+	if ( !r.check( model, fname ) )
+		return false;
+	reinterpret_cast< Shell* >( Id().eref().data() )->doReinit();
+	return r.restore();
+}
@@ -0,0 +1,67 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+#ifndef _BINARY_MODEL_H
+#define _BINARY_MODEL_H
+
+/**
+ * Binary snapshots of a model tree, for loading the same model many
+ * times without parsing it. The snapshot holds the elements with their
+ * class names and array sizes, the value fields of every entry, the
+ * messages within the tree, and the clock ticks and their dt.
+ *
+ * The file is a fixed header, a table of sections, and the sections
+ * themselves, each starting on an 8 byte boundary so that a reader can
+ * use them in place from a single read or an mmap:
+ *
+ *   header:   magic "MOOSESNP", version, number of sections
+ *   sections: { kind, offset, size } for each
+ *   STRINGS   names of elements, classes and fields
+ *   CLASSES   for each class, the fields saved for it
+ *   ELEMENTS  one fixed size record per element, parents first
+ *   FIELDS    field values of all entries, in Conv buffer form
+ *   MSGS      one record per message, plus SPARSE for SparseMsg entries
+ *   BINDINGS  the src and dest fields each message carries
+ *   CLOCK     dt of the ticks in use
+ *
+ * Solvers are set up again on loading from their fields, rather than
+ * saved. The zombies of a solver are saved as the classes they were
+ * made from, with the field values the solver holds for them, and the
+ * solver turns them into zombies again when it is set up.
+ *
+ * A checkpoint uses the same layout with magic "MOOSECKP". In place of
+ * MSGS, BINDINGS and CLOCK it has
+ *
+ *   STATE        runtime state of each data entry, from its saveState
+ *   STATE_INDEX  { element, data index, offset, size } for each entry
+ *   GLOBAL       state of the global RNG and the clock
+ *
+ * The value fields are restored first and then the state, which holds
+ * what the fields do not show, such as integrator history and pending
+ * events. Solvers and their zombies are saved as they are. A checkpoint
+ * is restored onto the same model built in the same way. The file is
+ * checked against the whole model first, and only then is the model
+ * reinit and restored, so that a run resumed from it gives exactly the
+ * numbers it would have given without stopping.
+ */
+
+/// Saves the tree under model. Returns false on failure.
+bool writeBinaryModel( Id model, const string& fname );
+
+/// Loads a saved tree as modelName under parent. Returns its root.
+Id readBinaryModel( const string& fname, const string& modelName,
+		ObjId parent );
+
+/// Saves the runtime state of the tree under model. False on failure.
+bool writeCheckpoint( Id model, const string& fname );
+
+/// Checks a checkpoint against the tree under model, then reinits and
+/// restores it. False on failure. If it does not fit, nothing changes.
+bool readCheckpoint( Id model, const string& fname );
+
+#endif // _BINARY_MODEL_H
@@ -0,0 +1,468 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include <set>
+#include <iomanip>
+#include "../basecode/header.h"
+#include "../msg/Msg.h"
+#include "Neutral.h"
+#include "Shell.h"
+#include "Wildcard.h"
+#include "LoadBalance.h"
+
+LoadBalancer::LoadBalancer( unsigned int numNodes )
+	:
+		numNodes_( numNodes > 0 ? numNodes : 1 ),
+		offset_( 1, 0 ),
+		load_( numNodes_, 0.0 ),
+		evenCut_( 0.0 ),
+		evenImbalance_( 1.0 ),
+		numMoves_( 0 )
+{;}
+
+/**
+ * Rough relative costs per timestep, from the number of state
+ * variables and table lookups involved. More specific classes must
+ * come first.
+ */
+double LoadBalancer::classCost( const Cinfo* c )
+{
+	static const pair< const char*, double > costs[] = {
+		{ "HHChannel2D", 6.0 },
+		{ "MarkovChannel", 6.0 },
+		{ "HHChannelBase", 4.0 },
+		{ "ChanBase", 2.0 },
+		{ "CompartmentBase", 3.0 },
+		{ "CaConcBase", 1.0 },
+		{ "IntFireBase", 2.0 },
+		{ "SynHandlerBase", 1.0 },
+		{ "PoolBase", 1.0 },
+		{ "EnzBase", 1.0 },
+		{ "SpikeGen", 0.5 },
+		{ "TableBase", 0.5 },
+	};
+	for ( unsigned int i = 0; i < sizeof( costs ) / sizeof( costs[0] ); ++i )
+		if ( c->isA( costs[i].first ) )
+			return costs[i].second;
+	return 1.0;
+}
+
+unsigned int LoadBalancer::addElement( Id id, unsigned int numData,
+				double cost )
+{
+	ids_.push_back( id );
+	cost_.push_back( cost );
+	offset_.push_back( offset_.back() + numData );
+	adj_.resize( offset_.back() );
+	return ids_.size() - 1;
+}
+
+void LoadBalancer::addEdge( unsigned int e1, unsigned int i1,
+				unsigned int e2, unsigned int i2, double weight )
+{
+	unsigned int v1 = offset_[e1] + i1;
+	unsigned int v2 = offset_[e2] + i2;
+	assert( v1 < adj_.size() && v2 < adj_.size() );
+	if ( v1 == v2 )
+		return;
+	adj_[v1].push_back( pair< unsigned int, double >( v2, weight ) );
+	adj_[v2].push_back( pair< unsigned int, double >( v1, weight ) );
+}
+
+void LoadBalancer::build( const string& path )
+{
+	static const Finfo* pf = Neutral::initCinfo()->findFinfo( "parentMsg" );
+	static const FuncId pafid =
+		dynamic_cast< const DestFinfo* >( pf )->getFid();
+
+	vector< ObjId > found;
+	if ( path == "/" || path.empty() )
+		wildcardFind( "/##", found );
+	else
+		wildcardFind( path + "," + path + "/##", found );
+
+	// Index the distributed Elements, and note their FieldElements.
+	map< Id, unsigned int > index;
+	vector< Id > fieldElms;
+	set< ObjId > treeMsgs;
+	for ( vector< ObjId >::const_iterator
+			i = found.begin(); i != found.end(); ++i ) {
+		Element* elm = i->element();
+		if ( index.find( i->id ) != index.end() )
+			continue;
+		treeMsgs.insert( elm->findCaller( pafid ) );
+		if ( elm->hasFields() ) {
+			fieldElms.push_back( i->id );
+			continue;
+		}
+		if ( !dynamic_cast< LocalDataElement* >( elm ) ||
+				elm->numData() == 0 )
+			continue;
+		index[ i->id ] = addElement( i->id, elm->numData(),
+						classCost( elm->cinfo() ) );
+	}
+	for ( vector< Id >::const_iterator
+			i = fieldElms.begin(); i != fieldElms.end(); ++i ) {
+		Id pa = Neutral::parent( ObjId( *i, 0 ) ).id;
+		map< Id, unsigned int >::const_iterator j = index.find( pa );
+		if ( j != index.end() )
+			index[ *i ] = j->second;
+	}
+
+	// Every connection between indexed entries is an edge.
+	set< ObjId > msgs;
+	for ( map< Id, unsigned int >::const_iterator
+			i = index.begin(); i != index.end(); ++i ) {
+		const vector< ObjId >& m = i->first.element()->msgIn();
+		msgs.insert( m.begin(), m.end() );
+	}
+	for ( set< ObjId >::const_iterator
+			i = msgs.begin(); i != msgs.end(); ++i ) {
+		if ( treeMsgs.find( *i ) != treeMsgs.end() )
+			continue;
+		const Msg* m = Msg::getMsg( *i );
+		if ( !m || m->e1()->hasFields() )
+			continue;
+		map< Id, unsigned int >::const_iterator src =
+			index.find( m->e1()->id() );
+		if ( src == index.end() )
+			continue;
+		vector< vector< Eref > > tgts;
+		m->targets( tgts );
+		for ( unsigned int j = 0; j < tgts.size(); ++j ) {
+			for ( vector< Eref >::const_iterator
+					k = tgts[j].begin(); k != tgts[j].end(); ++k ) {
+				map< Id, unsigned int >::const_iterator dest =
+					index.find( k->id() );
+				if ( dest == index.end() )
+					continue;
+				unsigned int di = k->dataIndex();
+				if ( di >= offset_[ dest->second + 1 ] -
+								offset_[ dest->second ] )
+					continue;
+				addEdge( src->second, j, dest->second, di, 1.0 );
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////
+// Partitioning
+//////////////////////////////////////////////////////////////////
+
+void LoadBalancer::evenSplit()
+{
+	start_.resize( ids_.size() );
+	node_.assign( offset_.back(), 0 );
+	load_.assign( numNodes_, 0.0 );
+	for ( unsigned int e = 0; e < ids_.size(); ++e ) {
+		unsigned int n = offset_[e + 1] - offset_[e];
+		unsigned int numPerNode = 1 + ( n - 1 ) / numNodes_;
+		vector< unsigned int >& s = start_[e];
+		s.resize( numNodes_ + 1 );
+		for ( unsigned int k = 0; k <= numNodes_; ++k )
+			s[k] = min( k * numPerNode, n );
+		for ( unsigned int k = 0; k < numNodes_; ++k ) {
+			for ( unsigned int i = s[k]; i < s[k + 1]; ++i )
+				node_[ offset_[e] + i ] = k;
+			load_[k] += cost_[e] * ( s[k + 1] - s[k] );
+		}
+	}
+}
+
+double LoadBalancer::linkTo( unsigned int v, unsigned int n ) const
+{
+	double ret = 0.0;
+	for ( vector< pair< unsigned int, double > >::const_iterator
+			i = adj_[v].begin(); i != adj_[v].end(); ++i )
+		if ( node_[ i->first ] == n )
+			ret += i->second;
+	return ret;
+}
+
+/**
+ * Boundary k sits between the blocks on nodes k-1 and k. Shifting it
+ * left moves the last entry of node k-1 onto node k, and shifting it
+ * right moves the first entry of node k onto node k-1.
+ */
+bool LoadBalancer::tryMove( unsigned int e, unsigned int k, bool left,
+				double maxLoad, bool balanceOnly )
+{
+	vector< unsigned int >& s = start_[e];
+	unsigned int from, to, i;
+	if ( left ) {
+		if ( s[k - 1] >= s[k] )
+			return false;
+		from = k - 1;
+		to = k;
+		i = s[k] - 1;
+	} else {
+		if ( s[k] >= s[k + 1] )
+			return false;
+		from = k;
+		to = k - 1;
+		i = s[k];
+	}
+	double w = cost_[e];
+	unsigned int v = offset_[e] + i;
+	if ( balanceOnly ) {
+		if ( load_[from] <= maxLoad || load_[to] + w >= load_[from] )
+			return false;
+	} else {
+		if ( load_[to] + w > maxLoad )
+			return false;
+		double gain = linkTo( v, to ) - linkTo( v, from );
+		if ( gain <= 1e-12 )
+			return false;
+	}
+	if ( left )
+		--s[k];
+	else
+		++s[k];
+	node_[v] = to;
+	load_[from] -= w;
+	load_[to] += w;
+	++numMoves_;
+	return true;
+}
+
+void LoadBalancer::partition( double tolerance, unsigned int maxPasses )
+{
+	evenSplit();
+	evenCut_ = cutSize();
+	evenImbalance_ = imbalance();
+	numMoves_ = 0;
+	if ( numNodes_ == 1 || ids_.empty() )
+		return;
+
+	double total = 0.0;
+	for ( unsigned int k = 0; k < numNodes_; ++k )
+		total += load_[k];
+	double maxLoad = ( 1.0 + tolerance ) * total / numNodes_;
+	// An entry heavier than the slack must still fit somewhere.
+	for ( unsigned int e = 0; e < ids_.size(); ++e )
+		maxLoad = max( maxLoad, total / numNodes_ + cost_[e] );
+
+	for ( unsigned int pass = 0; pass < maxPasses; ++pass ) {
+		unsigned int before = numMoves_;
+		for ( unsigned int phase = 0; phase < 2; ++phase ) {
+			bool balanceOnly = ( phase == 0 );
+			for ( unsigned int e = 0; e < ids_.size(); ++e ) {
+				unsigned int n = offset_[e + 1] - offset_[e];
+				for ( unsigned int k = 1; k < numNodes_; ++k ) {
+					for ( unsigned int j = 0; j < n; ++j )
+						if ( !tryMove( e, k, true, maxLoad, balanceOnly ) )
+							break;
+					for ( unsigned int j = 0; j < n; ++j )
+						if ( !tryMove( e, k, false, maxLoad, balanceOnly ) )
+							break;
+				}
+			}
+		}
+		if ( numMoves_ == before )
+			break;
+	}
+}
+
+/**
+ * An entry that moves to another node arrives there at its default
+ * values, so its data would be lost. Here we look over the entries
+ * that apply() would send off this node, and compare each field that
+ * can be assigned, and any runtime state kept for checkpoints, with
+ * those of a default entry of the same class. The fields of Neutral,
+ * such as the name, are the same for all entries and are skipped.
+ */
+bool LoadBalancer::holdsData() const
+{
+	unsigned int myNode = Shell::myNode();
+	unsigned int numNeutral = Neutral::initCinfo()->getNumValueFinfo();
+	for ( unsigned int e = 0; e < ids_.size(); ++e ) {
+		LocalDataElement* elm =
+			dynamic_cast< LocalDataElement* >( ids_[e].element() );
+		if ( !elm || myNode >= numNodes_ )
+			continue;
+		unsigned int first = elm->localDataStart();
+		unsigned int last = first + elm->numLocalData();
+		unsigned int newFirst = start_[e][ myNode ];
+		unsigned int newLast = start_[e][ myNode + 1 ];
+		if ( first >= newFirst && last <= newLast )
+			continue;
+
+		const Cinfo* c = elm->cinfo();
+		const DinfoBase* d = c->dinfo();
+		Id probe = Id::nextId();
+		new GlobalDataElement( probe, c, "probe", 1 );
+		vector< string > fields;
+		vector< string > values;
+		for ( unsigned int j = numNeutral; j < c->getNumValueFinfo(); ++j ) {
+			const Finfo* f = c->getValueFinfo( j );
+			if ( f->innerDest().size() < 2 )
+				continue; // Read-only.
+			string val;
+			f->strGet( Eref( probe.element(), 0 ), f->name(), val );
+			fields.push_back( f->name() );
+			values.push_back( val );
+		}
+		vector< char > probeState;
+		if ( d->hasState() ) {
+			StateWriter w( probeState );
+			d->saveState( probe.element()->data( 0 ), w );
+		}
+
+		bool found = false;
+		for ( unsigned int i = first; i < last && !found; ++i ) {
+			if ( i >= newFirst && i < newLast )
+				continue;
+			Eref er( elm, i );
+			for ( unsigned int j = 0; j < fields.size() && !found; ++j ) {
+				string val;
+				const Finfo* f = c->findFinfo( fields[j] );
+				f->strGet( er, fields[j], val );
+				if ( val != values[j] ) {
+					cout << "Warning: LoadBalancer: " << elm->getName() <<
+						"[" << i << "]." << fields[j] << " has been set\n";
+					found = true;
+				}
+			}
+			if ( !found && d->hasState() ) {
+				vector< char > state;
+				StateWriter w( state );
+				d->saveState( elm->data( i - first ), w );
+				if ( state != probeState ) {
+					cout << "Warning: LoadBalancer: " << elm->getName() <<
+						"[" << i << "] holds runtime state\n";
+					found = true;
+				}
+			}
+		}
+		probe.destroy();
+		if ( found )
+			return true;
+	}
+	return false;
+}
+
+unsigned int LoadBalancer::apply() const
+{
+	unsigned int ret = 0;
+	for ( unsigned int e = 0; e < ids_.size(); ++e ) {
+		LocalDataElement* elm =
+			dynamic_cast< LocalDataElement* >( ids_[e].element() );
+		if ( !elm )
+			continue;
+		unsigned int n = offset_[e + 1] - offset_[e];
+		unsigned int numPerNode = 1 + ( n - 1 ) / numNodes_;
+		bool isEven = true;
+		for ( unsigned int k = 0; k <= numNodes_; ++k )
+			isEven &= ( start_[e][k] == min( k * numPerNode, n ) );
+		if ( !isEven )
+			ret += elm->setNodeBlocks( start_[e] );
+	}
+	// The digests hold the node of each target, so all go.
+	for ( unsigned int e = 0; e < ids_.size(); ++e ) {
+		Element* elm = ids_[e].element();
+		if ( !elm )
+			continue;
+		elm->markRewired();
+		const vector< ObjId >& m = elm->msgIn();
+		for ( vector< ObjId >::const_iterator
+				i = m.begin(); i != m.end(); ++i ) {
+			const Msg* msg = Msg::getMsg( *i );
+			if ( msg ) {
+				msg->e1()->markRewired();
+				msg->e2()->markRewired();
+			}
+		}
+	}
+	return ret;
+}
+
+//////////////////////////////////////////////////////////////////
+// Results
+//////////////////////////////////////////////////////////////////
+
+double LoadBalancer::cutSize() const
+{
+	double ret = 0.0;
+	for ( unsigned int v = 0; v < adj_.size(); ++v )
+		for ( vector< pair< unsigned int, double > >::const_iterator
+				i = adj_[v].begin(); i != adj_[v].end(); ++i )
+			if ( node_[v] != node_[ i->first ] )
+				ret += i->second;
+	return ret / 2.0; // Each edge is listed at both ends.
+}
+
+double LoadBalancer::totalEdgeWeight() const
+{
+	double ret = 0.0;
+	for ( unsigned int v = 0; v < adj_.size(); ++v )
+		for ( vector< pair< unsigned int, double > >::const_iterator
+				i = adj_[v].begin(); i != adj_[v].end(); ++i )
+			ret += i->second;
+	return ret / 2.0;
+}
+
+vector< double > LoadBalancer::nodeLoad() const
+{
+	return load_;
+}
+
+double LoadBalancer::imbalance() const
+{
+	double total = 0.0;
+	double biggest = 0.0;
+	for ( unsigned int k = 0; k < load_.size(); ++k ) {
+		total += load_[k];
+		biggest = max( biggest, load_[k] );
+	}
+	if ( total <= 0.0 )
+		return 1.0;
+	return biggest * load_.size() / total;
+}
+
+const vector< unsigned int >& LoadBalancer::blocks( unsigned int e ) const
+{
+	assert( e < start_.size() );
+	return start_[e];
+}
+
+unsigned int LoadBalancer::nodeOf( unsigned int e, unsigned int i ) const
+{
+	return node_[ offset_[e] + i ];
+}
+
+unsigned int LoadBalancer::numElements() const
+{
+	return ids_.size();
+}
+
+unsigned int LoadBalancer::numVertices() const
+{
+	return offset_.back();
+}
+
+string LoadBalancer::report() const
+{
+	stringstream ss;
+	double tot = totalEdgeWeight();
+	ss << "Load balance over " << numNodes_ << " nodes: " <<
+		numVertices() << " entries on " << numElements() <<
+		" Elements, " << tot << " connections\n";
+	ss << setprecision( 4 );
+	ss << "    even split: cut = " << evenCut_ <<
+		", imbalance = " << evenImbalance_ << "\n";
+	ss << "    partition:  cut = " << cutSize() <<
+		", imbalance = " << imbalance() <<
+		", after " << numMoves_ << " moves\n";
+	ss << "    node loads:";
+	for ( unsigned int k = 0; k < load_.size(); ++k )
+		ss << " " << load_[k];
+	ss << "\n";
+	return ss.str();
+}
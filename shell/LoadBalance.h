@@ -0,0 +1,124 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _LOAD_BALANCE_H
+#define _LOAD_BALANCE_H
+
+/**
+ * Partitions the data entries of a model between nodes.
+ *
+ * The model is treated as a graph. Each data entry of each distributed
+ * Element is a vertex, weighted by an estimate of its compute cost
+ * per timestep. Each message connection between two entries is an
+ * edge, weighted by how many connections there are. Connections to
+ * FieldElements, such as synapses, count against the parent entry.
+ *
+ * A LocalDataElement keeps a contiguous block of its entries on each
+ * node, in node order, so a partition here is a set of block
+ * boundaries for each Element. We start from the even split that the
+ * LocalDataElement makes by default, and then refine the boundaries
+ * one entry at a time in the manner of Fiduccia-Mattheyses. A move
+ * is taken if it relieves a node that is over the load tolerance, or
+ * if it reduces the cut without pushing a node over the tolerance.
+ * The commonest gain is from lining up the blocks of Elements of
+ * different sizes that talk to each other, such as compartments and
+ * their channels, or neurons and their synapse handlers.
+ */
+class LoadBalancer
+{
+	public:
+		LoadBalancer( unsigned int numNodes );
+
+		/**
+		 * Builds the graph from all distributed Elements on and below
+		 * path, and the messages between them.
+		 */
+		void build( const string& path );
+
+		/**
+		 * Adds an Element with numData entries of the given cost each.
+		 * Returns its index. Used by build, and directly in tests.
+		 */
+		unsigned int addElement( Id id, unsigned int numData, double cost );
+
+		/// Adds weight to the edge between two entries.
+		void addEdge( unsigned int e1, unsigned int i1,
+						unsigned int e2, unsigned int i2, double weight );
+
+		/**
+		 * Computes the partition. The tolerance is the fraction by which
+		 * the load on a node may exceed the mean.
+		 */
+		void partition( double tolerance = 0.05,
+						unsigned int maxPasses = 50 );
+
+		/**
+		 * Assigns the blocks to the LocalDataElements, and marks all
+		 * messages for rebuilding. Returns the number of entries that
+		 * came onto this node from elsewhere. These are left at their
+		 * default values, so fields should be assigned after this call.
+		 */
+		unsigned int apply() const;
+
+		/**
+		 * True if any entry that apply() would move off this node
+		 * holds data other than its defaults, which the move would
+		 * lose. Prints the first such entry.
+		 */
+		bool holdsData() const;
+
+		/// Total weight of the edges that cross between nodes.
+		double cutSize() const;
+		/// Total weight of all edges.
+		double totalEdgeWeight() const;
+		/// Estimated load on each node.
+		vector< double > nodeLoad() const;
+		/// Ratio of the largest load on any node to the mean load.
+		double imbalance() const;
+		/// Block boundaries of Element e, numNodes + 1 entries.
+		const vector< unsigned int >& blocks( unsigned int e ) const;
+		/// Node on which entry i of Element e is placed.
+		unsigned int nodeOf( unsigned int e, unsigned int i ) const;
+		unsigned int numElements() const;
+		unsigned int numVertices() const;
+
+		/// Cut and balance before and after, load per node.
+		string report() const;
+
+		/// Estimated cost per timestep of an entry of this class.
+		static double classCost( const Cinfo* c );
+	private:
+		/// Sets up the even split used by LocalDataElement.
+		void evenSplit();
+		/// Tries to shift boundary k of Element e by one entry.
+		bool tryMove( unsigned int e, unsigned int k, bool left,
+						double maxLoad, bool balanceOnly );
+		/// Sum of edge weights from vertex v to entries on node n.
+		double linkTo( unsigned int v, unsigned int n ) const;
+
+		unsigned int numNodes_;
+		vector< Id > ids_;
+		/// Cost per entry of each Element.
+		vector< double > cost_;
+		/// Vertex index of the first entry of each Element.
+		vector< unsigned int > offset_;
+		/// Edges of each vertex, as vertex and weight.
+		vector< vector< pair< unsigned int, double > > > adj_;
+		/// Block boundaries of each Element.
+		vector< vector< unsigned int > > start_;
+		/// Node of each vertex.
+		vector< unsigned int > node_;
+		vector< double > load_;
+
+		double evenCut_;
+		double evenImbalance_;
+		unsigned int numMoves_;
+};
+
+#endif // _LOAD_BALANCE_H
@@ -13,6 +13,7 @@
 #include "../utility/strutil.h"
 #include "../utility/Vec.h"
 #include "LoadModels.h" // For the ModelType enum.
+#include "BinaryModel.h"
 
 #include "../biophysics/ReadCell.h"
 #include "../biophysics/SwcSegment.h"
@@ -29,6 +30,10 @@ ModelType findModelType( string filename, ifstream& fin, string& line )
     if ( filename.substr( filename.length() - 4 ) == ".swc" )
         return SWC;
 
+    if ( filename.length() > 6 &&
+            filename.substr( filename.length() - 6 ) == ".msnap" )
+        return BINARY;
+
     getline( fin, line );
     line = moose::trim(line);
     if ( line == "//genesis" )
@@ -181,6 +186,8 @@ Id Shell::doLoadModel( const string& fileName, const string& modelPath, const st
         rc.makePlots( 1.0 );
         return ret;
     }
+    case BINARY:
+        return readBinaryModel( fileName, modelName, parentId );
     case UNKNOWN:
     default:
         cout << "Error: Shell::doLoadModel: File type of '" <<
@@ -188,3 +195,9 @@ Id Shell::doLoadModel( const string& fileName, const string& modelPath, const st
     }
     return Id();
 }
+
+bool Shell::doLoadCheckpoint( Id model, const string& fileName )
+{
+    // This does the reinit once the file is known to fit the model.
+    return readCheckpoint( model, fileName );
+}
@@ -15,5 +15,6 @@ enum ModelType {
 	NINEML,
 	SEDML,
 	CSPACE,
-	SWC
+	SWC,
+	BINARY
 };
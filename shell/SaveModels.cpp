@@ -10,6 +10,7 @@
 #include <fstream>
 #include "../basecode/header.h"
 #include "Shell.h"
+#include "BinaryModel.h"
 
 // Defined in kinetics/WriteKkit.cpp
 extern void writeKkit( Id model, const string& fname );
@@ -20,6 +21,7 @@ extern void writeCspace (Id model, const string& fname );
  * filename extension. Currently known filetypes are:
  * .g: Kkit model
  * .cspace: cspace model
+ * .msnap: binary snapshot, see BinaryModel.h
  *
  * Still to come:
  * .p: GENESIS neuron morphology and channel spec file
@@ -27,8 +29,11 @@ extern void writeCspace (Id model, const string& fname );
  * .nml: NeuroML file
  * .9ml: NineML file
  * .snml: SigNeurML
+ *
+ * Returns false if the file type is unknown or the model could not be
+ * written.
  */
-void Shell::doSaveModel( Id model, const string& fileName, bool qFlag )
+bool Shell::doSaveModel( Id model, const string& fileName, bool qFlag )
 	   	const
 {
 	// string modelFamily = Field< string >::get( model, "modelFamily" );
@@ -38,8 +43,8 @@ void Shell::doSaveModel( Id model, const string& fileName, bool qFlag )
 	// 	return;
 	// }
 
-	unsigned int pos = fileName.find( "." );
-	string fileType = fileName.substr( pos );
+	string::size_type pos = fileName.find_last_of( "." );
+	string fileType = ( pos == string::npos ) ? "" : fileName.substr( pos );
 
 	if ( fileType == ".g" ) { // kkit model requested.
 			// cout << "Cannot write kkit model at this point\n";
@@ -47,8 +52,18 @@ void Shell::doSaveModel( Id model, const string& fileName, bool qFlag )
 	} else if (fileType == ".cspace"){
             // writeCspace( model, fileName );
             cout << "Cannot write cspace model at this point\n";
-    } else {
+            return false;
+	} else if ( fileType == ".msnap" ) {
+		return writeBinaryModel( model, fileName );
+	} else {
 		cout << "Warning: Shell::doSaveModel: Do not know how to save "
 				"model of file type '" << fileType << "'.\n";
+		return false;
 	}
+	return true;
+}
+
+bool Shell::doSaveCheckpoint( Id model, const string& fileName ) const
+{
+	return writeCheckpoint( model, fileName );
 }
@@ -297,6 +297,87 @@ ObjId Shell::doAddMsg(const string& msgType, ObjId src, const string& srcField,
     // return Msg::lastMsg()->mid();
 }
 
+ObjId Shell::doAddMsgBatch(ObjId src, const string& srcField, ObjId dest,
+                           const string& destField,
+                           const vector<unsigned int>& srcIndex,
+                           const vector<unsigned int>& destIndex,
+                           const vector<unsigned int>& destFieldIndex)
+{
+    if (srcIndex.size() != destIndex.size() ||
+        (destFieldIndex.size() != 0 &&
+         destFieldIndex.size() != srcIndex.size())) {
+        cout << myNode_ << ": Error: Shell::doAddMsgBatch: index vectors "
+             << "differ in length: " << srcIndex.size() << ", "
+             << destIndex.size() << ", " << destFieldIndex.size() << endl;
+        return ObjId(0, BADINDEX);
+    }
+    return doAddMsgBatch(
+        src, srcField, dest, destField, srcIndex.size(), srcIndex.data(),
+        destIndex.data(),
+        destFieldIndex.size() == 0 ? 0 : destFieldIndex.data());
+}
+
+/// Assigns a double field on each entry of a batch of connections.
+static bool setBatchField(Element* e, const string& field,
+                          const unsigned int* dataIndex,
+                          const unsigned int* fieldIndex, const double* vals,
+                          size_t n)
+{
+    const DestFinfo* df =
+        dynamic_cast<const DestFinfo*>(e->cinfo()->findFinfo(field));
+    const OpFunc1Base<double>* op =
+        df ? dynamic_cast<const OpFunc1Base<double>*>(df->getOpFunc()) : 0;
+    if (!op) {
+        cout << "Error: Shell::doAddMsgBatch: " << e->getName()
+             << " has no field '" << field << "'\n";
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        Eref er(e, dataIndex[i], fieldIndex[i]);
+        if (er.isDataHere()) op->op(er, vals[i]);
+    }
+    return true;
+}
+
+ObjId Shell::doAddMsgBatch(ObjId src, const string& srcField, ObjId dest,
+                           const string& destField, size_t n,
+                           const unsigned int* srcIndex,
+                           const unsigned int* destIndex,
+                           const unsigned int* destFieldIndex,
+                           const double* weight, const double* delay)
+{
+    // The SparseMsg spans the whole src and dest Elements, the entries
+    // pick out the pairs.
+    ObjId mid = doAddMsg("Sparse", ObjId(src.id), srcField, ObjId(dest.id),
+                         destField);
+    if (mid.bad()) return mid;
+    SparseMsg* sm = const_cast<SparseMsg*>(
+        dynamic_cast<const SparseMsg*>(Msg::getMsg(mid)));
+    assert(sm);
+
+    // Without field indices, each dest takes field entries 0, 1, 2...
+    // in the order its connections come.
+    vector<unsigned int> autoField;
+    if (!destFieldIndex) {
+        vector<unsigned int> numAtDest(dest.element()->numData(), 0);
+        autoField.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            if (destIndex[i] < numAtDest.size())
+                autoField[i] = numAtDest[destIndex[i]]++;
+        destFieldIndex = autoField.data();
+    }
+
+    if (!sm->batchFill(srcIndex, destIndex, destFieldIndex, n) ||
+        (weight && !setBatchField(dest.element(), "setWeight", destIndex,
+                                  destFieldIndex, weight, n)) ||
+        (delay && !setBatchField(dest.element(), "setDelay", destIndex,
+                                 destFieldIndex, delay, n))) {
+        doDelete(mid);
+        return ObjId(0, BADINDEX);
+    }
+    return mid;
+}
+
 void Shell::doQuit()
 {
     SetGet0::set(ObjId(), "quit");
@@ -321,6 +402,15 @@ void Shell::doStart(double runtime, bool notify)
         Streamer* pStreamer = reinterpret_cast<Streamer*>(itr->data());
         pStreamer->cleanUp();
     }
+    // And whatever Tables have handed to the background writer.
+    StreamWriter::shared().flush();
+    // NSDFWriter2 may still be writing its last lot on its own thread.
+    vector<ObjId> writers;
+    wildcardFind("/##[TYPE=NSDFWriter2]", writers);
+    for (vector<ObjId>::const_iterator itr = writers.begin();
+         itr != writers.end(); itr++)
+        SetGet0::set(*itr, "finished");
+    StreamerBase::closeOutFiles();
 
     // Print the stats collected by profiling map.
     char* p = getenv("MOOSE_SHOW_SOLVER_PERF");
@@ -621,6 +711,35 @@ bool Shell::adopt(Id parent, Id child, unsigned int msgIndex)
     return adopt(ObjId(parent), child, msgIndex);
 }
 
+/**
+ * Sending the notice on to the node that holds the data would deliver
+ * it once per node, and could reach an object that its own node has
+ * already deleted.
+ */
+static const OpFunc* localNotifyOp(ObjId& oid, const string& field)
+{
+    if (oid.isOffNode() && !oid.isGlobal())
+        return 0;
+    FuncId fid;
+    return SetGet::checkSet(field, oid, fid);
+}
+
+void Shell::notifyHere(ObjId oid, const string& field)
+{
+    const OpFunc0Base* op =
+        dynamic_cast<const OpFunc0Base*>(localNotifyOp(oid, field));
+    if (op)
+        op->op(oid.eref());
+}
+
+void Shell::notifyHere(ObjId oid, const string& field, ObjId arg)
+{
+    const OpFunc1Base<ObjId>* op =
+        dynamic_cast<const OpFunc1Base<ObjId>*>(localNotifyOp(oid, field));
+    if (op)
+        op->op(oid.eref(), arg);
+}
+
 /**
  * This function actually creates the object. Runs on all nodes.
  * Assumes we've already done all the argument checking.
@@ -648,7 +767,7 @@ void Shell::innerCreate(string type, ObjId parent, Id newElm, string name,
         assert(ret);
         adopt(parent, newElm, msgIndex);
         ret->setTick(Clock::lookupDefaultTick(c->name()));
-		SetGet1< ObjId >::set( newElm, "notifyCreate", parent );
+		notifyHere( newElm, "notifyCreate", parent );
     } 
     else
         assert(0);
@@ -660,7 +779,7 @@ void Shell::destroy(const Eref& e, ObjId oid)
     assert(n);
     // cout << myNode_ << ": Shell::destroy done for element id: " << eid << ",
     // name = " << eid.element()->getName() << endl;
-	SetGet0::set( oid, "notifyDestroy" );
+	notifyHere( oid, "notifyDestroy" );
     n->destroy(oid.eref(), 0);
     if (cwe_.id == oid.id) cwe_ = ObjId();
 }
@@ -731,8 +850,8 @@ const Msg* Shell::innerAddMsg(string msgType, ObjId src, string srcField,
     }
     if (m) {
         if (f1->addMsg(f2, m->mid(), src.id.element())) {
-			SetGet1< ObjId >::set( src, "notifyAddMsgSrc", m->mid() );
-			SetGet1< ObjId >::set( dest, "notifyAddMsgDest", m->mid() );
+			notifyHere( src, "notifyAddMsgSrc", m->mid() );
+			notifyHere( dest, "notifyAddMsgDest", m->mid() );
             return m;
         }
         delete m;
@@ -766,7 +885,7 @@ bool Shell::innerMove(Id orig, ObjId newParent)
              << orig.element()->getName() << "\n";
         return 0;
     }
-	SetGet1< ObjId >::set( orig, "notifyMove", newParent );
+	notifyHere( orig, "notifyMove", newParent );
     return 1;
 }
 
@@ -109,6 +109,40 @@ public:
                     ObjId src, const string& srcField,
                     ObjId dest, const string& destField );
 
+    /**
+     * Sets up a whole batch of connections of the same type between
+     * entries of src and dest, as would otherwise be done by making
+     * one SingleMsg per pair. The batch is stored as a single
+     * SparseMsg, so the connections cost a few index arrays rather
+     * than one Msg object each. Entry i connects
+     * src[ srcIndex[i] ] to dest[ destIndex[i] ], on field entry
+     * destFieldIndex[i] if the dest is a FieldElement. If
+     * destFieldIndex is empty the field indices are assigned
+     * automatically, as in SparseMsg::pairFill.
+     * Returns the ObjId of the SparseMsg.
+     */
+    ObjId doAddMsgBatch( ObjId src, const string& srcField,
+                         ObjId dest, const string& destField,
+                         const vector< unsigned int >& srcIndex,
+                         const vector< unsigned int >& destIndex,
+                         const vector< unsigned int >& destFieldIndex );
+
+    /**
+     * As above, for n connections held in plain arrays such as numpy
+     * buffers, and without going through SetGet. destFieldIndex may be
+     * null. If weight or delay are given, entry i sets the weight or
+     * delay field of the synapse it connects to. The synapse arrays
+     * are grown to fit. The message is removed again and a bad ObjId
+     * returned if an index is out of range or the dest lacks a field.
+     */
+    ObjId doAddMsgBatch( ObjId src, const string& srcField,
+                         ObjId dest, const string& destField, size_t n,
+                         const unsigned int* srcIndex,
+                         const unsigned int* destIndex,
+                         const unsigned int* destFieldIndex,
+                         const double* weight = 0,
+                         const double* delay = 0 );
+
     /**
      * Cleanly quits simulation, wrapping up all nodes and threads.
      */
@@ -198,6 +232,7 @@ public:
      * Saves specified model to specified file, using filetype
      * identified by filename extension. Currently known filetypes are:
      * .g: Kkit model
+     * .msnap: binary snapshot, see BinaryModel.h
      *
      * Still to come:
      * .p: GENESIS neuron morphology and channel spec file
@@ -205,8 +240,26 @@ public:
      * .nml: NeuroML file
      * .9ml: NineML file
      * .snml: SigNeurML
+     *
+     * Returns false if the file type is unknown or the model could not
+     * be written.
+     */
+    bool doSaveModel( Id model, const string& fileName, bool qflag = 0 ) const;
+
+    /**
+     * Saves the runtime state of the model to a checkpoint file, see
+     * BinaryModel.h. Returns false on failure.
      */
-    void doSaveModel( Id model, const string& fileName, bool qflag = 0 ) const;
+    bool doSaveCheckpoint( Id model, const string& fileName ) const;
+
+    /**
+     * Checks a checkpoint against the model, which must be built the
+     * same way as the one it was saved from, and then reinits and
+     * restores it. The next doStart continues from the time of the
+     * checkpoint. Returns false on failure, and leaves the model as it
+     * was if the checkpoint does not fit it.
+     */
+    bool doLoadCheckpoint( Id model, const string& fileName );
 
     /**
      * This function synchronizes fieldDimension on the DataHandler
@@ -393,10 +446,11 @@ public:
     static unsigned int numProcessThreads();
 
     /**
-     * Stub for eventual function to handle load balancing. This must
-     * be called to set up default groups.
+     * Partitions the distributed Elements on and below path between
+     * the nodes, by compute load and message traffic. Called on all
+     * nodes. Returns a report of the partition.
      */
-    static void loadBalance();
+    static string loadBalance( const string& path = "/", bool apply = true );
 
     static void launchParser();
 
@@ -459,6 +513,14 @@ public:
     static bool adopt( ObjId parent, Id child, unsigned int msgIndex );
     static bool adopt( Id parent, Id child, unsigned int msgIndex );
 
+    /**
+     * Calls a notify hook such as notifyCreate on oid, but only where
+     * its data is on this node. Every node runs the calls that make and
+     * change objects for itself, so each one notifies only its own data.
+     */
+    static void notifyHere( ObjId oid, const string& field );
+    static void notifyHere( ObjId oid, const string& field, ObjId arg );
+
     static const unsigned int OkStatus;
     static const unsigned int ErrorStatus;
 
@@ -17,6 +17,8 @@
 #include "../basecode/header.h"
 #include "Shell.h"
 #include "../basecode/Dinfo.h"
+#include "LoadBalance.h"
+#include "../mpi/ShmTransport.h"
 
 #define USE_NODES 1
 
@@ -54,18 +56,44 @@ void Shell::setHardware( unsigned int numCores, unsigned int numNodes,
 }
 
 /**
- * Regular shell function that requires that the information about the
- * hardware have been loaded in. For now the function just assigns SimGroups
+ * Partitions the data entries of the distributed Elements on and below
+ * path between the nodes, so as to balance the estimated compute load
+ * and cut as few messages as possible. See LoadBalancer for the method.
+ * Every node builds the same graph and so gets the same partition,
+ * which must therefore be called on all nodes together. Entries that
+ * move to another node are default-constructed there, so this should
+ * be called after the model structure is set up but before the field
+ * values are assigned. If any node would send off an entry that
+ * already holds data, the partition is not applied on any node.
+ * The messages are rebuilt on the next reinit.
+ * Returns a report of the cut size and balance before and after.
  */
-void Shell::loadBalance()
+string Shell::loadBalance( const string& path, bool apply )
 {
-	// Need more info here on how to set up groups distributed over
-	// nodes. In fact this will have to be computed _after_ the
-	// simulation is loaded. Will also need quite a bit of juggling between
-	// nodes when things get really scaled up.
-	//
-	// Note that the messages have to be rebuilt after this call.
-	// Note that this function is called independently on each node.
+	LoadBalancer lb( numNodes_ );
+	lb.build( path );
+	lb.partition();
+	if ( apply && numNodes_ > 1 ) {
+		// 1 if this node may go ahead, reduced so that all agree.
+		double clean = lb.holdsData() ? 0.0 : 1.0;
+		double allClean = clean;
+		if ( ShmTransport::instance() ) {
+			allClean = ShmTransport::instance()->allReduceMin( clean );
+		} else {
+#ifdef USE_MPI
+			MPI_Allreduce( &clean, &allClean, 1, MPI_DOUBLE, MPI_MIN,
+							MPI_COMM_WORLD );
+#endif
+		}
+		if ( allClean > 0.5 )
+			lb.apply();
+		else
+			cout << "Warning: Shell::loadBalance: " << path <<
+				": entries that would move already hold data, so the "
+				"partition is not applied. Call this before assigning "
+				"fields.\n";
+	}
+	return lb.report();
 }
 
 unsigned int Shell::numCores()
@@ -21,6 +21,7 @@
 #include "../msg/SingleMsg.h"
 #include "../msg/OneToAllMsg.h"
 #include "Wildcard.h"
+#include "LoadBalance.h"
 
 const bool TEST_WARNING = false;
 
@@ -1808,6 +1809,100 @@ void testFilterOffNodeTargets()
 
 extern void testWildcard();
 
+/**
+ * Partitions a synthetic graph: A[i] talks to B[i+20], so the even
+ * split of the two Elements is out of step by 20 entries.
+ */
+void testLoadBalance()
+{
+    LoadBalancer lb(4);
+    unsigned int a = lb.addElement(Id(), 100, 1.0);
+    unsigned int b = lb.addElement(Id(), 120, 1.0);
+    for (unsigned int i = 0; i < 100; ++i)
+        lb.addEdge(a, i, b, i + 20, 1.0);
+    assert(lb.numElements() == 2);
+    assert(lb.numVertices() == 220);
+    assert(doubleEq(lb.totalEdgeWeight(), 100.0));
+
+    lb.partition(0.05);
+    assert(lb.cutSize() < 1.0);
+    assert(lb.imbalance() <= 1.05);
+    vector<double> load = lb.nodeLoad();
+    assert(load.size() == 4);
+    assert(doubleEq(load[0] + load[1] + load[2] + load[3], 220.0));
+    for (unsigned int e = 0; e < 2; ++e) {
+        const vector<unsigned int>& s = lb.blocks(e);
+        assert(s.size() == 5);
+        assert(s[0] == 0);
+        assert(s[4] == (e == a ? 100u : 120u));
+        for (unsigned int k = 1; k < 5; ++k)
+            assert(s[k] >= s[k - 1]);
+    }
+    for (unsigned int i = 0; i < 100; ++i)
+        assert(lb.nodeOf(a, i) == lb.nodeOf(b, i + 20));
+
+    // Nothing to gain on one node.
+    LoadBalancer one(1);
+    one.addElement(Id(), 10, 1.0);
+    one.addEdge(0, 0, 0, 9, 1.0);
+    one.partition();
+    assert(doubleEq(one.cutSize(), 0.0));
+    assert(one.blocks(0)[1] == 10);
+
+    cout << "." << flush;
+}
+
+// Entries that stay on a node keep their fields when the blocks are
+// applied, and entries that would move may not hold data.
+void testLoadBalanceData()
+{
+    unsigned int numCores = Shell::numCores();
+    Shell::setHardware(numCores, 2, 0);
+    Id a = Id::nextId();
+    new LocalDataElement(a, Arith::initCinfo(), "lba", 10);
+    Id b = Id::nextId();
+    new LocalDataElement(b, Arith::initCinfo(), "lbb", 16);
+    assert(a.element()->numLocalData() == 5);
+    assert(b.element()->numLocalData() == 8);
+
+    LoadBalancer lb(2);
+    lb.addElement(a, 10, 1.0);
+    lb.addElement(b, 16, 1.0);
+    for (unsigned int i = 0; i < 10; ++i)
+        lb.addEdge(0, i, 1, i + 6, 1.0);
+    lb.partition(0.05);
+    // Find an entry that leaves node 0 and one that stays.
+    unsigned int e = 0;
+    unsigned int i = 0;
+    while (e < 2 && lb.nodeOf(e, i) == 0) {
+        if (++i == (e == 0 ? 5u : 8u)) {
+            ++e;
+            i = 0;
+        }
+    }
+    assert(e < 2);
+    ObjId leaving(e == 0 ? a : b, i);
+    ObjId staying(a, 0);
+    assert(lb.nodeOf(0, 0) == 0);
+
+    Field<double>::set(staying, "outputValue", 1.5);
+    assert(!lb.holdsData());
+    Field<double>::set(leaving, "outputValue", 2.5);
+    assert(lb.holdsData());
+    Field<double>::set(leaving, "outputValue", 0.0);
+    assert(!lb.holdsData());
+
+    lb.apply();
+    assert(a.element()->numLocalData() == lb.blocks(0)[1]);
+    assert(b.element()->numLocalData() == lb.blocks(1)[1]);
+    assert(doubleEq(Field<double>::get(staying, "outputValue"), 1.5));
+
+    a.destroy();
+    b.destroy();
+    Shell::setHardware(numCores, 1, 0);
+    cout << "." << flush;
+}
+
 void testShell()
 {
     testExtractIndices();
@@ -1818,6 +1913,8 @@ void testShell()
     ////// testShellParserQuit();
     testGetMsgs();  // Tests getting Msg info from Neutral.
     testGetMsgSrcAndTarget();
+    testLoadBalance();
+    testLoadBalanceData();
 
     // This is a multinode test, but only needs to run on master node.
     testFilterOffNodeTargets();
@@ -11,6 +11,7 @@
 #include "../basecode/header.h"
 #include "Synapse.h"
 #include "SynEvent.h" // only using the SynEvent class from this
+#include "SynEventRing.h"
 #include "SynHandlerBase.h"
 #include "STDPSynapse.h"
 #include "STDPSynHandler.h"
@@ -23,7 +24,9 @@ const Cinfo* STDPSynHandler::initCinfo()
 		"Author", "Aditya Gilra",
 		"Description",
 		"The STDPSynHandler handles synapses with spike timing dependent plasticity (STDP). "
-		"It uses two priority queues to manage pre and post spikes."
+		"It uses two priority queues to manage pre and post spikes. "
+		"Pre spikes can optionally go into a ring buffer with one slot "
+		"per timestep of delay instead."
 	};
 
     static ValueFinfo< STDPSynHandler, double > aMinus(
@@ -77,6 +80,24 @@ const Cinfo* STDPSynHandler::initCinfo()
 		&STDPSynHandler::getWeightMin
     );
 
+    static ValueFinfo< STDPSynHandler, bool > useRingBuffer(
+        "useRingBuffer",
+        "Flag: when true, pending pre-synaptic spikes are kept in a ring "
+        "buffer with one slot per timestep, sized on reinit to cover the "
+        "largest synaptic delay. Spikes further ahead than the ring "
+        "reaches go onto the priority queue as usual. Takes effect on "
+        "reinit. Defaults to false.",
+		&STDPSynHandler::setUseRingBuffer,
+		&STDPSynHandler::getUseRingBuffer
+    );
+
+    static ReadOnlyValueFinfo< STDPSynHandler, unsigned int > numRingSlots(
+        "numRingSlots",
+        "Number of slots in the ring buffer, set up on reinit. "
+        "Zero if the ring buffer is not in use.",
+		&STDPSynHandler::getNumRingSlots
+    );
+
     static DestFinfo addPostSpike( "addPostSpike",
         "Handles arriving spike messages from post-synaptic neuron, inserts into postEvent queue.",
         new EpFunc1< STDPSynHandler, double >( &STDPSynHandler::addPostSpike ) );
@@ -110,7 +131,9 @@ const Cinfo* STDPSynHandler::initCinfo()
 		&aPlus0,	        // Field
 		&tauPlus,	        // Field
         &weightMax,         // Field
-        &weightMin          // Field
+        &weightMin,         // Field
+        &useRingBuffer,     // Field
+        &numRingSlots       // ReadOnlyField
 	};
 
 	static Dinfo< STDPSynHandler > dinfo;
@@ -138,6 +161,7 @@ STDPSynHandler::STDPSynHandler()
     aPlus0_ = 0.0;
     weightMin_ = 0.0;
     weightMax_ = 0.0;
+    useRingBuffer_ = false;
 }
 
 STDPSynHandler::~STDPSynHandler()
@@ -150,10 +174,10 @@ STDPSynHandler& STDPSynHandler::operator=( const STDPSynHandler& ssh)
 					i = synapses_.begin(); i != synapses_.end(); ++i )
 			i->setHandler( this );
 
-	// For no apparent reason, priority queues don't have a clear operation.
-	while( !events_.empty() )
-		events_.pop();
+	useRingBuffer_ = ssh.useRingBuffer_;
+	events_.reinit( 0, 1.0, 0.0 );
 
+	// For no apparent reason, priority queues don't have a clear operation.
 	while( !postEvents_.empty() )
 		postEvents_.pop();
 
@@ -192,9 +216,7 @@ void STDPSynHandler::addSpike(
 
 double STDPSynHandler::getTopSpike( unsigned int index ) const
 {
-	if ( events_.empty() )
-		return 0.0;
-	return events_.top().time;
+	return events_.topTime();
 }
 
 void STDPSynHandler::addPostSpike( const Eref& e, double time )
@@ -207,8 +229,10 @@ void STDPSynHandler::vProcess( const Eref& e, ProcPtr p )
 	double activation = 0.0;
 
     // process pre-synaptic spike events for activation and STDP
-	while( !events_.empty() && events_.top().time <= p->currTime ) {
-        PreSynEvent currEvent = events_.top();
+	events_.pop( p->currTime, dueEvents_ );
+	for ( vector< PreSynEvent >::const_iterator
+			i = dueEvents_.begin(); i != dueEvents_.end(); ++i ) {
+        const PreSynEvent& currEvent = *i;
 
         unsigned int synIndex = currEvent.synIndex;
         // Warning, coder! 'STDPSynapse currSyn = synapses_[synIndex];' is wrong,
@@ -243,8 +267,6 @@ void STDPSynHandler::vProcess( const Eref& e, ProcPtr p )
         double newWeight = currEvent.weight + aMinus_;
         newWeight = std::max(weightMin_, std::min(newWeight, weightMax_));
         currSynPtr->setWeight( newWeight );
-
-		events_.pop();
 	}
 	if ( activation != 0.0 )
 		SynHandlerBase::activationOut()->send( e, activation );
@@ -294,9 +316,16 @@ void STDPSynHandler::vProcess( const Eref& e, ProcPtr p )
 
 void STDPSynHandler::vReinit( const Eref& e, ProcPtr p )
 {
+	unsigned int numSlots = 0;
+	if ( useRingBuffer_ ) {
+		double maxDelay = 0.0;
+		for ( unsigned int i = 0; i < synapses_.size(); ++i )
+			maxDelay = std::max( maxDelay, synapses_[i].getDelay() );
+		numSlots = SynEventRingBase::slotsForDelay( maxDelay, p->dt );
+	}
+	events_.reinit( numSlots, p->dt, p->currTime );
+
 	// For no apparent reason, priority queues don't have a clear operation.
-	while( !events_.empty() )
-		events_.pop();
 	while( !postEvents_.empty() )
 		postEvents_.pop();
 }
@@ -387,3 +416,30 @@ double STDPSynHandler::getWeightMin() const
 {
 	return weightMin_;
 }
+
+void STDPSynHandler::setUseRingBuffer( const bool v )
+{
+	useRingBuffer_ = v;
+}
+
+bool STDPSynHandler::getUseRingBuffer() const
+{
+	return useRingBuffer_;
+}
+
+unsigned int STDPSynHandler::getNumRingSlots() const
+{
+	return events_.numSlots();
+}
+
+void STDPSynHandler::saveState( StateWriter& w ) const
+{
+	events_.saveState( w );
+	w.put( heapOf( const_cast< STDPSynHandler* >( this )->postEvents_ ) );
+}
+
+void STDPSynHandler::restoreState( StateReader& r )
+{
+	events_.restoreState( r );
+	r.get( heapOf( postEvents_ ) );
+}
@@ -101,10 +101,20 @@ class STDPSynHandler: public SynHandlerBase
 		void setWeightMin( double v );
 		double getWeightMin() const;
 
+		void setUseRingBuffer( bool v );
+		bool getUseRingBuffer() const;
+		unsigned int getNumRingSlots() const;
+
+		/// Pending pre and post synaptic events, for checkpoints.
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+
 		static const Cinfo* initCinfo();
 	private:
 		vector< STDPSynapse > synapses_;
-		priority_queue< PreSynEvent, vector< PreSynEvent >, CompareSynEvent > events_;
+		PreSynEventRing events_;
+		vector< PreSynEvent > dueEvents_; /// Scratch space for vProcess
+		bool useRingBuffer_;
 		priority_queue< PostSynEvent, vector< PostSynEvent >, ComparePostSynEvent > postEvents_;
 		double aMinus_;
 		double aMinus0_;
@@ -11,6 +11,7 @@
 #include "../basecode/header.h"
 #include "Synapse.h"
 #include "SynEvent.h"
+#include "SynEventRing.h"
 #include "SynHandlerBase.h"
 #include "SimpleSynHandler.h"
 
@@ -19,14 +20,34 @@ const Cinfo* SimpleSynHandler::initCinfo()
     static string doc[] = {
         "Name", "SimpleSynHandler", "Author", "Upi Bhalla", "Description",
         "The SimpleSynHandler handles simple synapses without plasticity. "
-        "It uses a priority queue to manage them."};
+        "It uses a priority queue to manage them, or optionally a "
+        "ring buffer with one slot per timestep of delay."};
+
+    static ValueFinfo<SimpleSynHandler, bool> useRingBuffer(
+        "useRingBuffer",
+        "Flag: when true, pending spikes are summed into a ring buffer "
+        "with one slot per timestep, sized on reinit to cover the "
+        "largest synaptic delay. Spikes further ahead than the ring "
+        "reaches go onto the priority queue as usual. Takes effect on "
+        "reinit. Defaults to false.",
+        &SimpleSynHandler::setUseRingBuffer,
+        &SimpleSynHandler::getUseRingBuffer);
+
+    static ReadOnlyValueFinfo<SimpleSynHandler, unsigned int> numRingSlots(
+        "numRingSlots",
+        "Number of slots in the ring buffer, set up on reinit. "
+        "Zero if the ring buffer is not in use.",
+        &SimpleSynHandler::getNumRingSlots);
 
     static FieldElementFinfo<SynHandlerBase, Synapse> synFinfo(
         "synapse", "Sets up field Elements for synapse", Synapse::initCinfo(),
         &SynHandlerBase::getSynapse, &SynHandlerBase::setNumSynapses,
         &SynHandlerBase::getNumSynapses);
 
-    static Finfo* synHandlerFinfos[] = {&synFinfo  // FieldElement
+    static Finfo* synHandlerFinfos[] = {
+        &synFinfo,       // FieldElement
+        &useRingBuffer,  // Field
+        &numRingSlots,   // ReadOnlyField
     };
 
     static Dinfo<SimpleSynHandler> dinfo;
@@ -40,7 +61,7 @@ const Cinfo* SimpleSynHandler::initCinfo()
 
 static const Cinfo* synHandlerCinfo = SimpleSynHandler::initCinfo();
 
-SimpleSynHandler::SimpleSynHandler()
+SimpleSynHandler::SimpleSynHandler() : useRingBuffer_(false)
 {
     ;
 }
@@ -56,8 +77,8 @@ SimpleSynHandler& SimpleSynHandler::operator=(const SimpleSynHandler& ssh)
     for (auto i = synapses_.begin(); i != synapses_.end(); ++i)
         i->setHandler(this);
 
-    // For no apparent reason, priority queues don't have a clear operation.
-    while (!events_.empty()) events_.pop();
+    useRingBuffer_ = ssh.useRingBuffer_;
+    events_.reinit(0, 1.0, 0.0);
 
     return *this;
 }
@@ -86,36 +107,62 @@ Synapse* SimpleSynHandler::vGetSynapse(unsigned int i)
 void SimpleSynHandler::addSpike(unsigned int index, double time, double weight)
 {
     assert(index < synapses_.size());
-    events_.push(SynEvent(time, weight));
+    events_.push(time, weight);
 }
 
 double SimpleSynHandler::getTopSpike(unsigned int index) const
 {
-    if (events_.empty()) return 0.0;
-    return events_.top().time;
+    return events_.topTime();
 }
 
 void SimpleSynHandler::vProcess(const Eref& e, ProcPtr p)
 {
-    double activation = 0.0;
-    while (!events_.empty() && events_.top().time <= p->currTime) {
-        // Send out weight / dt for every spike
-        //      Since it is an impulse active only for one dt,
-        //      need to send it divided by dt.
-        // Can connect activation to SynChan (double exp)
-        //      or to LIF as an impulse to voltage.
-        // See:
-        // http://www.genesis-sim.org/GENESIS/Hyperdoc/Manual-26.html#synchan
-        activation += events_.top().weight / p->dt;
-        events_.pop();
-    }
+    // Send out weight / dt for every spike
+    //      Since it is an impulse active only for one dt,
+    //      need to send it divided by dt.
+    // Can connect activation to SynChan (double exp)
+    //      or to LIF as an impulse to voltage.
+    // See:
+    // http://www.genesis-sim.org/GENESIS/Hyperdoc/Manual-26.html#synchan
+    double activation = events_.pop(p->currTime, p->dt);
     if (activation != 0.0) SynHandlerBase::activationOut()->send(e, activation);
 }
 
 void SimpleSynHandler::vReinit(const Eref& e, ProcPtr p)
 {
-    // For no apparent reason, priority queues don't have a clear operation.
-    while (!events_.empty()) events_.pop();
+    unsigned int numSlots = 0;
+    if (useRingBuffer_) {
+        double maxDelay = 0.0;
+        for (auto i = synapses_.begin(); i != synapses_.end(); ++i)
+            maxDelay = std::max(maxDelay, i->getDelay());
+        numSlots = SynEventRingBase::slotsForDelay(maxDelay, p->dt);
+    }
+    events_.reinit(numSlots, p->dt, p->currTime);
+}
+
+void SimpleSynHandler::setUseRingBuffer(bool v)
+{
+    useRingBuffer_ = v;
+}
+
+bool SimpleSynHandler::getUseRingBuffer() const
+{
+    return useRingBuffer_;
+}
+
+unsigned int SimpleSynHandler::getNumRingSlots() const
+{
+    return events_.numSlots();
+}
+
+void SimpleSynHandler::saveState(StateWriter& w) const
+{
+    events_.saveState(w);
+}
+
+void SimpleSynHandler::restoreState(StateReader& r)
+{
+    events_.restoreState(r);
 }
 
 unsigned int SimpleSynHandler::addSynapse()
@@ -43,6 +43,9 @@ struct CompareSynEvent
  * This handles simple synapses without plasticity. It uses a priority
  * queue to manage them. This gets inefficient for large numbers of
  * synapses but is pretty robust.
+ * Optionally the events can go into a ring buffer of per-timestep
+ * weight sums instead, with the priority queue only used for events
+ * beyond the reach of the ring. See SynEventRing.
  */
 class SimpleSynHandler: public SynHandlerBase
 {
@@ -65,10 +68,19 @@ class SimpleSynHandler: public SynHandlerBase
 		void addSpike( unsigned int index, double time, double weight );
 		double getTopSpike( unsigned int index ) const;
 		////////////////////////////////////////////////////////////////
+		void setUseRingBuffer( bool v );
+		bool getUseRingBuffer() const;
+		unsigned int getNumRingSlots() const;
+
+		/// Pending events, for checkpoints.
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+
 		static const Cinfo* initCinfo();
 	private:
 		vector< Synapse > synapses_;
-		priority_queue< SynEvent, vector< SynEvent >, CompareSynEvent > events_;
+		SynWeightRing events_;
+		bool useRingBuffer_;
 };
 
 #endif // _SIMPLE_SYN_HANDLER_H
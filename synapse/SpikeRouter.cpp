@@ -0,0 +1,382 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include <cmath>
+#include "../basecode/header.h"
+#include "../basecode/ElementValueFinfo.h"
+#include "../basecode/SparseMatrix.h"
+#include "../msg/SparseMsg.h"
+#include "../shell/Shell.h"
+#include "Synapse.h"
+#include "SynHandlerBase.h"
+#include "SpikeRouter.h"
+
+/// Tolerance for rounding times onto the timestep grid.
+static const double EPSILON = 1.0e-6;
+
+/**
+ * OpFunc that the SparseMsg calls instead of Synapse::addSpike.
+ * The Eref is that of the router, with the index of the spiking source
+ * entry in its fieldIndex.
+ */
+class SpikeRouterFunc: public OpFunc1Base< double >
+{
+	public:
+		void op( const Eref& e, double time ) const
+		{
+			SpikeRouter* sr = reinterpret_cast< SpikeRouter* >(
+				e.element()->data( e.dataIndex() ) );
+			sr->routeSpike( e.fieldIndex(), time );
+		}
+};
+
+const OpFunc* SpikeRouter::routerFunc()
+{
+	static SpikeRouterFunc func;
+	return &func;
+}
+
+const Cinfo* SpikeRouter::initCinfo()
+{
+	//////////////////////////////////////////////////////////////////
+	// Field definitions
+	//////////////////////////////////////////////////////////////////
+	static ElementValueFinfo< SpikeRouter, ObjId > sparseMsg(
+		"sparseMsg",
+		"SparseMsg whose spikes are delivered by this router. The Msg "
+		"must go to the synapses of an array of SimpleSynHandlers. "
+		"Assigning it takes over the spike traffic of the Msg, "
+		"assigning an empty ObjId hands it back.",
+		&SpikeRouter::setSparseMsg,
+		&SpikeRouter::getSparseMsg
+	);
+	static ReadOnlyValueFinfo< SpikeRouter, unsigned int > numTargets(
+		"numTargets",
+		"Number of SynHandlers that the router delivers to.",
+		&SpikeRouter::getNumTargets
+	);
+	static ReadOnlyValueFinfo< SpikeRouter, unsigned int > numSynapses(
+		"numSynapses",
+		"Number of synapses in the routing table.",
+		&SpikeRouter::getNumSynapses
+	);
+	static ReadOnlyValueFinfo< SpikeRouter, unsigned int > numSlots(
+		"numSlots",
+		"Number of timesteps spanned by the time-wheel. This is set on "
+		"reinit from the longest synaptic delay.",
+		&SpikeRouter::getNumSlots
+	);
+	static ReadOnlyValueFinfo< SpikeRouter, double > numSpikes(
+		"numSpikes",
+		"Number of spikes received since reinit.",
+		&SpikeRouter::getNumSpikes
+	);
+	static ReadOnlyValueFinfo< SpikeRouter, double > numEvents(
+		"numEvents",
+		"Number of synaptic events distributed since reinit.",
+		&SpikeRouter::getNumEvents
+	);
+	//////////////////////////////////////////////////////////////////
+	// Shared definitions
+	//////////////////////////////////////////////////////////////////
+	static DestFinfo process( "process",
+		"Handles 'process' call. Sends out the activation due at this "
+		"timestep from each of the target SynHandlers.",
+		new ProcOpFunc< SpikeRouter >( &SpikeRouter::process ) );
+	static DestFinfo reinit( "reinit",
+		"Handles 'reinit' call. Reads in the connection matrix, weights "
+		"and delays, and clears the time-wheel.",
+		new ProcOpFunc< SpikeRouter >( &SpikeRouter::reinit ) );
+	static Finfo* processShared[] =
+	{
+		&process, &reinit
+	};
+	static SharedFinfo proc( "proc",
+		"Shared Finfo to receive Process messages from the clock.",
+		processShared, sizeof( processShared ) / sizeof( Finfo* )
+	);
+
+	static Finfo* spikeRouterFinfos[] =
+	{
+		&sparseMsg,		// ElementValue
+		&numTargets,	// ReadOnlyValue
+		&numSynapses,	// ReadOnlyValue
+		&numSlots,		// ReadOnlyValue
+		&numSpikes,		// ReadOnlyValue
+		&numEvents,		// ReadOnlyValue
+		&proc,			// SharedFinfo
+	};
+
+	static string doc[] =
+	{
+		"Name", "SpikeRouter",
+		"Author", "Upi Bhalla",
+		"Description",
+		"Delivers the spikes of a SparseMsg to the synapses of an array "
+		"of SimpleSynHandlers. It uses the connection matrix of the Msg "
+		"directly, accumulating weights into a time-wheel with one slot "
+		"per timestep of delay, instead of sending each spike to each "
+		"Synapse and queueing it there. Weights and delays are read on "
+		"reinit, so this is only for non-plastic synapses. Single node "
+		"only.",
+	};
+
+	static Dinfo< SpikeRouter > dinfo;
+	static Cinfo spikeRouterCinfo (
+		"SpikeRouter",
+		Neutral::initCinfo(),
+		spikeRouterFinfos,
+		sizeof( spikeRouterFinfos ) / sizeof ( Finfo* ),
+		&dinfo,
+		doc,
+		sizeof( doc ) / sizeof( string )
+	);
+
+	return &spikeRouterCinfo;
+}
+
+static const Cinfo* spikeRouterCinfo = SpikeRouter::initCinfo();
+
+///////////////////////////////////////////////////////////////////////
+
+SpikeRouter::SpikeRouter()
+	:
+		attached_( false ),
+		handlerElm_( 0 ),
+		numTargets_( 0 ),
+		numSlots_( 0 ),
+		currSlot_( 0 ),
+		dt_( 1.0 ),
+		currTime_( 0.0 ),
+		numSpikes_( 0.0 ),
+		numEvents_( 0.0 )
+{;}
+
+SpikeRouter::~SpikeRouter()
+{
+	detach();
+}
+
+/**
+ * Copies do not take over the Msg: only one router may handle it.
+ */
+SpikeRouter& SpikeRouter::operator=( const SpikeRouter& other )
+{
+	detach();
+	return *this;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Field access
+///////////////////////////////////////////////////////////////////////
+
+void SpikeRouter::setSparseMsg( const Eref& e, ObjId msg )
+{
+	detach();
+	if ( msg.bad() || msg == ObjId() )
+		return;
+
+	if ( Shell::numNodes() > 1 ) {
+		cout << "Warning: SpikeRouter::setSparseMsg: " <<
+			"only works on a single node.\n";
+		return;
+	}
+	if ( !msg.element()->cinfo()->isA( "SparseMsg" ) ) {
+		cout << "Warning: SpikeRouter::setSparseMsg: " << msg.path() <<
+			" is not a SparseMsg.\n";
+		return;
+	}
+	SparseMsg* sm = const_cast< SparseMsg* >(
+		dynamic_cast< const SparseMsg* >( Msg::getMsg( msg ) ) );
+	if ( !sm ) {
+		cout << "Warning: SpikeRouter::setSparseMsg: Msg not found.\n";
+		return;
+	}
+	if ( !sm->e2()->cinfo()->isA( "Synapse" ) ) {
+		cout << "Warning: SpikeRouter::setSparseMsg: Msg target " <<
+			sm->e2()->getName() << " is not a Synapse.\n";
+		return;
+	}
+	ObjId pa = Neutral::parent( Eref( sm->e2(), 0 ) );
+	if ( !pa.element()->cinfo()->isA( "SimpleSynHandler" ) ) {
+		cout << "Warning: SpikeRouter::setSparseMsg: " <<
+			pa.element()->getName() << " is a " <<
+			pa.element()->cinfo()->name() << ". Can only route spikes " <<
+			"to SimpleSynHandlers.\n";
+		return;
+	}
+	msg_ = msg;
+	self_ = e.objId();
+	handlerElm_ = pa.element();
+	attached_ = true;
+	sm->setRouter( e.objId(), routerFunc() );
+}
+
+ObjId SpikeRouter::getSparseMsg( const Eref& e ) const
+{
+	if ( attached_ )
+		return msg_;
+	return ObjId();
+}
+
+unsigned int SpikeRouter::getNumTargets() const
+{
+	return numTargets_;
+}
+
+unsigned int SpikeRouter::getNumSynapses() const
+{
+	return target_.size();
+}
+
+unsigned int SpikeRouter::getNumSlots() const
+{
+	return numSlots_;
+}
+
+double SpikeRouter::getNumSpikes() const
+{
+	return numSpikes_;
+}
+
+double SpikeRouter::getNumEvents() const
+{
+	return numEvents_;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Utility functions
+///////////////////////////////////////////////////////////////////////
+
+SparseMsg* SpikeRouter::sparseMsg() const
+{
+	if ( !attached_ || Msg::isLastTrump() )
+		return 0;
+	// Returns zero if the Msg has been deleted.
+	const Msg* m = reinterpret_cast< const Msg* >( msg_.data() );
+	return const_cast< SparseMsg* >( dynamic_cast< const SparseMsg* >( m ) );
+}
+
+void SpikeRouter::detach()
+{
+	SparseMsg* sm = sparseMsg();
+	if ( sm && sm->getRouter() == self_ )
+		sm->setRouter( ObjId(), 0 );
+	attached_ = false;
+	handlerElm_ = 0;
+	rowStart_.clear();
+	target_.clear();
+	weight_.clear();
+	delay_.clear();
+	wheel_.clear();
+	numTargets_ = 0;
+	numSlots_ = 0;
+}
+
+bool SpikeRouter::buildTables( double dt )
+{
+	SparseMsg* sm = sparseMsg();
+	if ( !sm )
+		return false;
+	dt_ = dt;
+	const SparseMatrix< unsigned int >& mat = sm->getMatrix();
+	numTargets_ = handlerElm_->numData();
+	rowStart_.assign( sm->e1()->numData() + 1, 0 );
+	target_.clear();
+	weight_.clear();
+	delay_.clear();
+	target_.reserve( mat.nEntries() );
+	weight_.reserve( mat.nEntries() );
+	delay_.reserve( mat.nEntries() );
+	unsigned int maxDelay = 0;
+	for ( unsigned int i = 0; i < sm->e1()->numData(); ++i ) {
+		rowStart_[i] = target_.size();
+		const unsigned int* synIndex;
+		const unsigned int* colIndex;
+		unsigned int n = mat.getRow( i, &synIndex, &colIndex );
+		for ( unsigned int j = 0; j < n; ++j ) {
+			assert( colIndex[j] < numTargets_ );
+			SynHandlerBase* sh = reinterpret_cast< SynHandlerBase* >(
+				handlerElm_->data( colIndex[j] ) );
+			if ( synIndex[j] >= sh->getNumSynapses() )
+				continue;
+			const Synapse* syn = sh->getSynapse( synIndex[j] );
+			unsigned int d = ceil( syn->getDelay() / dt - EPSILON );
+			if ( d > maxDelay )
+				maxDelay = d;
+			target_.push_back( colIndex[j] );
+			weight_.push_back( syn->getWeight() );
+			delay_.push_back( d );
+		}
+	}
+	rowStart_.back() = target_.size();
+
+	// One slot for the current step, one for the spikes that come in
+	// from objects that are processed later on the same timestep.
+	numSlots_ = maxDelay + 2;
+	wheel_.assign( numSlots_ * numTargets_, 0.0 );
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Dest functions
+///////////////////////////////////////////////////////////////////////
+
+void SpikeRouter::routeSpike( unsigned int src, double time )
+{
+	if ( wheel_.size() == 0 || src + 1 >= rowStart_.size() )
+		return;
+	numSpikes_ += 1.0;
+	// Steps from the current slot until the spike time. Usually 0,
+	// or 1 if the source was processed before us on this timestep.
+	int base = ceil( ( time - currTime_ ) / dt_ - EPSILON );
+	unsigned int begin = rowStart_[src];
+	unsigned int end = rowStart_[src + 1];
+	for ( unsigned int j = begin; j < end; ++j ) {
+		int m = base + static_cast< int >( delay_[j] );
+		if ( m < 1 )
+			m = 1;
+		else if ( m >= static_cast< int >( numSlots_ ) )
+			m = numSlots_ - 1;
+		unsigned int slot = ( currSlot_ + m ) % numSlots_;
+		wheel_[ slot * numTargets_ + target_[j] ] += weight_[j];
+	}
+	numEvents_ += end - begin;
+}
+
+void SpikeRouter::process( const Eref& e, ProcPtr p )
+{
+	if ( wheel_.size() == 0 )
+		return;
+	if ( !sparseMsg() ) { // The Msg has been deleted.
+		detach();
+		return;
+	}
+	currSlot_ = ( currSlot_ + 1 ) % numSlots_;
+	currTime_ = p->currTime;
+	double* bin = &wheel_[ currSlot_ * numTargets_ ];
+	for ( unsigned int i = 0; i < numTargets_; ++i ) {
+		if ( bin[i] != 0.0 ) {
+			// Same as the SimpleSynHandler: an impulse lasting one dt.
+			SynHandlerBase::activationOut()->send(
+				Eref( handlerElm_, i ), bin[i] / p->dt );
+			bin[i] = 0.0;
+		}
+	}
+}
+
+void SpikeRouter::reinit( const Eref& e, ProcPtr p )
+{
+	currSlot_ = 0;
+	currTime_ = p->currTime;
+	numSpikes_ = 0.0;
+	numEvents_ = 0.0;
+	if ( attached_ && !buildTables( p->dt ) )
+		detach();
+}
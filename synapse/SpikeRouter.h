@@ -0,0 +1,99 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _SPIKE_ROUTER_H
+#define _SPIKE_ROUTER_H
+
+class SparseMsg;
+
+/**
+ * Spike fan-out engine for a SparseMsg going to the synapses of an array
+ * of SimpleSynHandlers.
+ * The regular path delivers each spike to each target Synapse through
+ * the message system, and each SynHandler then pushes it onto a
+ * priority queue. Here the SpikeRouter takes over the forward traffic
+ * of the SparseMsg. It keeps its own copy of the connection matrix in
+ * CSR form, with the synaptic weights and delays (in timesteps) stored
+ * contiguously alongside. Each incoming spike walks one row of the
+ * matrix and adds the weights into a time-wheel of per-target bins,
+ * one ring slot per timestep of delay. On each process call the
+ * current slot is sent out as activation from the respective
+ * SynHandlers, exactly as they would have done, and cleared.
+ *
+ * Weights and delays are read from the Synapses on reinit, so the
+ * router is only suitable for non-plastic synapses. It only runs on a
+ * single node.
+ */
+class SpikeRouter
+{
+	public:
+		SpikeRouter();
+		~SpikeRouter();
+		SpikeRouter& operator=( const SpikeRouter& other );
+
+		////////////////////////////////////////////////////////////////
+		// Field assignment stuff.
+		////////////////////////////////////////////////////////////////
+		void setSparseMsg( const Eref& e, ObjId msg );
+		ObjId getSparseMsg( const Eref& e ) const;
+		unsigned int getNumTargets() const;
+		unsigned int getNumSynapses() const;
+		unsigned int getNumSlots() const;
+		double getNumSpikes() const;
+		double getNumEvents() const;
+
+		////////////////////////////////////////////////////////////////
+		// Dest Finfos
+		////////////////////////////////////////////////////////////////
+		void process( const Eref& e, ProcPtr p );
+		void reinit( const Eref& e, ProcPtr p );
+
+		/**
+		 * Distributes a spike from the specified source entry into
+		 * the time-wheel.
+		 */
+		void routeSpike( unsigned int src, double time );
+
+		/// OpFunc handed to the SparseMsg in place of the Synapse funcs
+		static const OpFunc* routerFunc();
+		static const Cinfo* initCinfo();
+	private:
+		/// Builds the CSR tables and the time-wheel for timestep dt.
+		bool buildTables( double dt );
+		/// Returns the routed SparseMsg, or 0 if it has gone away.
+		SparseMsg* sparseMsg() const;
+		/// Restores regular delivery on the SparseMsg.
+		void detach();
+
+		ObjId msg_;
+		ObjId self_; /// Needed to check that the Msg is still ours.
+		bool attached_;
+		Element* handlerElm_;
+
+		vector< unsigned int > rowStart_; /// CSR row start per source
+		vector< unsigned int > target_; /// Target entry for each synapse
+		vector< double > weight_; /// Weight of each synapse
+		vector< unsigned int > delay_; /// Delay of each synapse, in dt.
+
+		/**
+		 * Accumulated weights, indexed as
+		 * wheel_[ slot * numTargets_ + target ].
+		 */
+		vector< double > wheel_;
+		unsigned int numTargets_;
+		unsigned int numSlots_;
+		unsigned int currSlot_;
+		double dt_;
+		double currTime_;
+
+		double numSpikes_;
+		double numEvents_;
+};
+
+#endif // _SPIKE_ROUTER_H
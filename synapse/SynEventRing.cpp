@@ -0,0 +1,240 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#include <queue>
+#include <algorithm>
+#include "../basecode/header.h"
+#include "SynEvent.h"
+#include "SynEventRing.h"
+
+const unsigned int SynEventRingBase::MaxSlots = 4096;
+
+// Tolerance for roundoff when event times are multiples of dt.
+static const double EPSILON = 1e-6;
+
+static bool earlier( const PreSynEvent& a, const PreSynEvent& b )
+{
+	return a.time < b.time;
+}
+
+SynEventRingBase::SynEventRingBase()
+	: numSlots_( 0 ), head_( 0 ), dt_( 1.0 ), lastTime_( 0.0 )
+{;}
+
+unsigned int SynEventRingBase::numSlots() const
+{
+	return numSlots_;
+}
+
+unsigned int SynEventRingBase::slotsForDelay( double maxDelay, double dt )
+{
+	if ( dt <= 0.0 || maxDelay < 0.0 )
+		return 0;
+	// One slot for the delay itself, one for a spike sent earlier on the
+	// same timestep, and one spare for roundoff.
+	double n = ceil( maxDelay / dt - EPSILON ) + 2;
+	if ( n > MaxSlots )
+		return MaxSlots;
+	return n;
+}
+
+double SynEventRingBase::stepsAhead( double t ) const
+{
+	double steps = ceil( ( t - lastTime_ ) / dt_ - EPSILON );
+	if ( steps < 1.0 )
+		return 1.0;
+	return steps;
+}
+
+void SynEventRingBase::advance( double currTime )
+{
+	if ( numSlots_ > 0 )
+		head_ = ( head_ + 1 ) % numSlots_;
+	lastTime_ = currTime;
+}
+
+void SynEventRingBase::setup( unsigned int numSlots, double dt,
+				double currTime )
+{
+	numSlots_ = dt > 0.0 ? numSlots : 0;
+	head_ = 0;
+	dt_ = dt > 0.0 ? dt : 1.0;
+	lastTime_ = currTime;
+}
+
+void SynEventRingBase::saveBase( StateWriter& w ) const
+{
+	w.put( numSlots_ );
+	w.put( head_ );
+	w.put( dt_ );
+	w.put( lastTime_ );
+}
+
+void SynEventRingBase::restoreBase( StateReader& r )
+{
+	r.get( numSlots_ );
+	r.get( head_ );
+	r.get( dt_ );
+	r.get( lastTime_ );
+	if ( numSlots_ > MaxSlots || ( numSlots_ > 0 && head_ >= numSlots_ ) )
+		r.fail();
+}
+
+///////////////////////////////////////////////////////////////////////
+// SynWeightRing
+///////////////////////////////////////////////////////////////////////
+
+void SynWeightRing::reinit( unsigned int numSlots, double dt,
+				double currTime )
+{
+	setup( numSlots, dt, currTime );
+	slot_.assign( numSlots_, 0.0 );
+	clear();
+}
+
+void SynWeightRing::clear()
+{
+	std::fill( slot_.begin(), slot_.end(), 0.0 );
+	while ( !overflow_.empty() )
+		overflow_.pop();
+}
+
+void SynWeightRing::push( double time, double weight )
+{
+	double steps = stepsAhead( time );
+	if ( steps < numSlots_ )
+		slot_[ slotIndex( steps ) ] += weight;
+	else
+		overflow_.push( SynEvent( time, weight ) );
+}
+
+double SynWeightRing::pop( double currTime, double dt )
+{
+	double ret = 0.0;
+	if ( numSlots_ > 0 ) {
+		ret = slot_[ head_ ] / dt;
+		slot_[ head_ ] = 0.0;
+	}
+	// Scaled one event at a time, so that with no ring the sum comes
+	// out exactly as it did with the plain priority queue.
+	while ( !overflow_.empty() && overflow_.top().time <= currTime ) {
+		ret += overflow_.top().weight / dt;
+		overflow_.pop();
+	}
+	advance( currTime );
+	return ret;
+}
+
+double SynWeightRing::topTime() const
+{
+	for ( unsigned int k = 1; k < numSlots_; ++k ) {
+		if ( slot_[ slotIndex( k ) ] != 0.0 ) {
+			double t = lastTime_ + k * dt_;
+			if ( !overflow_.empty() && overflow_.top().time < t )
+				return overflow_.top().time;
+			return t;
+		}
+	}
+	if ( overflow_.empty() )
+		return 0.0;
+	return overflow_.top().time;
+}
+
+void SynWeightRing::saveState( StateWriter& w ) const
+{
+	saveBase( w );
+	w.put( slot_ );
+	w.put( heapOf( const_cast< SynWeightRing* >( this )->overflow_ ) );
+}
+
+void SynWeightRing::restoreState( StateReader& r )
+{
+	restoreBase( r );
+	r.get( slot_ );
+	r.get( heapOf( overflow_ ) );
+	if ( slot_.size() != numSlots_ )
+		r.fail();
+}
+
+///////////////////////////////////////////////////////////////////////
+// PreSynEventRing
+///////////////////////////////////////////////////////////////////////
+
+void PreSynEventRing::reinit( unsigned int numSlots, double dt,
+				double currTime )
+{
+	setup( numSlots, dt, currTime );
+	slot_.resize( numSlots_ );
+	clear();
+}
+
+void PreSynEventRing::clear()
+{
+	for ( unsigned int i = 0; i < slot_.size(); ++i )
+		slot_[i].clear();
+	while ( !overflow_.empty() )
+		overflow_.pop();
+}
+
+void PreSynEventRing::push( const PreSynEvent& ev )
+{
+	double steps = stepsAhead( ev.time );
+	if ( steps < numSlots_ )
+		slot_[ slotIndex( steps ) ].push_back( ev );
+	else
+		overflow_.push( ev );
+}
+
+void PreSynEventRing::pop( double currTime, vector< PreSynEvent >& due )
+{
+	due.clear();
+	// Swapping hands the emptied vector back to the ring, so that the
+	// slots and the due list keep their capacity from step to step.
+	if ( numSlots_ > 0 )
+		due.swap( slot_[ head_ ] );
+	while ( !overflow_.empty() && overflow_.top().time <= currTime ) {
+		due.push_back( overflow_.top() );
+		overflow_.pop();
+	}
+	// Deliver in order of time, as the priority queue would have done.
+	if ( due.size() > 1 )
+		std::stable_sort( due.begin(), due.end(), earlier );
+	advance( currTime );
+}
+
+double PreSynEventRing::topTime() const
+{
+	double ret = overflow_.empty() ? 0.0 : overflow_.top().time;
+	for ( unsigned int k = 1; k < numSlots_; ++k ) {
+		const vector< PreSynEvent >& s = slot_[ slotIndex( k ) ];
+		if ( s.empty() )
+			continue;
+		for ( unsigned int i = 0; i < s.size(); ++i )
+			if ( ret == 0.0 || s[i].time < ret )
+				ret = s[i].time;
+		break;
+	}
+	return ret;
+}
+
+void PreSynEventRing::saveState( StateWriter& w ) const
+{
+	saveBase( w );
+	w.put( slot_ );
+	w.put( heapOf( const_cast< PreSynEventRing* >( this )->overflow_ ) );
+}
+
+void PreSynEventRing::restoreState( StateReader& r )
+{
+	restoreBase( r );
+	r.get( slot_ );
+	r.get( heapOf( overflow_ ) );
+	if ( slot_.size() != numSlots_ )
+		r.fail();
+}
@@ -0,0 +1,157 @@
+/**********************************************************************
+** This program is part of 'MOOSE', the
+** Messaging Object Oriented Simulation Environment.
+**           Copyright (C) 2026 Upinder S. Bhalla. and NCBS
+** It is made available under the terms of the
+** GNU Lesser General Public License version 2.1
+** See the file COPYING.LIB for the full notice.
+**********************************************************************/
+
+#ifndef _SYN_EVENT_RING_H
+#define _SYN_EVENT_RING_H
+
+#include <queue>
+
+/**
+ * The array behind a priority_queue, in heap order. Saving and restoring
+ * this, rather than popping and pushing the events, gives back a queue
+ * that pops events with equal times in the same order as before.
+ */
+template< class Q > typename Q::container_type& heapOf( Q& q )
+{
+	struct Access: Q
+	{
+		static typename Q::container_type& get( Q& q )
+		{
+			return q.*( &Access::c );
+		}
+	};
+	return Access::get( q );
+}
+
+/**
+ * Calendar queues for the pending events of a SynHandler.
+ * Synaptic delays are bounded and the handler is called once every dt,
+ * so rather than keeping the events in a priority queue at O(log n) per
+ * push and pop, we drop each one into a ring of per-timestep slots.
+ * Slot k holds the events that fall due on the k'th process call from
+ * now. Events that lie further ahead than the ring reaches go onto a
+ * fallback priority queue, and are merged in when they come due.
+ *
+ * A ring with zero slots, which is what we have until the first
+ * reinit, sends everything to the priority queue, and so behaves
+ * exactly like the original handlers.
+ */
+class SynEventRingBase
+{
+	public:
+		SynEventRingBase();
+
+		/// Number of ring slots, not counting the fallback queue.
+		unsigned int numSlots() const;
+
+		/// Picks the number of slots needed to cover maxDelay at dt.
+		static unsigned int slotsForDelay( double maxDelay, double dt );
+
+		/// Upper bound on the ring size, beyond which we use the queue.
+		static const unsigned int MaxSlots;
+	protected:
+		/**
+		 * Returns how many process calls ahead the event at time t
+		 * falls due, at least 1. A return value of numSlots_ or more
+		 * means the event does not fit in the ring.
+		 */
+		double stepsAhead( double t ) const;
+
+		/// Converts a number of steps ahead to a ring index.
+		unsigned int slotIndex( unsigned int steps ) const
+		{
+			return ( head_ + steps - 1 ) % numSlots_;
+		}
+
+		/// Moves on by one timestep.
+		void advance( double currTime );
+
+		void setup( unsigned int numSlots, double dt, double currTime );
+
+		/// Runtime state of the ring position, for checkpoints.
+		void saveBase( StateWriter& w ) const;
+		void restoreBase( StateReader& r );
+
+		unsigned int numSlots_;
+		unsigned int head_; /// Slot for the next process call
+		double dt_;
+		double lastTime_; /// Time of the last process call
+};
+
+/**
+ * Ring for handlers that only need the summed weight of the events
+ * due on each timestep, as in the SimpleSynHandler. The weights are
+ * accumulated straight into the slots.
+ */
+class SynWeightRing: public SynEventRingBase
+{
+	public:
+		/**
+		 * Sets up numSlots slots for timestep dt, and discards any
+		 * pending events.
+		 */
+		void reinit( unsigned int numSlots, double dt, double currTime );
+		void clear();
+		void push( double time, double weight );
+
+		/**
+		 * Returns the summed weight / dt of all events due at or before
+		 * currTime, and moves the ring on by one step. Must be called
+		 * once per timestep.
+		 */
+		double pop( double currTime, double dt );
+
+		/**
+		 * Returns the time of the earliest pending event, or 0 if
+		 * there are none. For events in the ring this is the time at
+		 * which they fall due, as their own times are not kept.
+		 */
+		double topTime() const;
+
+		/// All pending events, for checkpoints.
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+	private:
+		vector< double > slot_;
+		priority_queue< SynEvent, vector< SynEvent >, CompareSynEvent >
+			overflow_;
+};
+
+/**
+ * Ring for handlers that need the individual events, as in the
+ * STDPSynHandler which updates the weight of each synapse that gets a
+ * spike.
+ */
+class PreSynEventRing: public SynEventRingBase
+{
+	public:
+		void reinit( unsigned int numSlots, double dt, double currTime );
+		void clear();
+		void push( const PreSynEvent& ev );
+
+		/**
+		 * Fills in the events due at or before currTime, in order of
+		 * time, and moves the ring on by one step. Must be called once
+		 * per timestep.
+		 */
+		void pop( double currTime, vector< PreSynEvent >& due );
+
+		/// Returns the time of the earliest pending event, or 0.
+		double topTime() const;
+
+		/// All pending events, for checkpoints.
+		void saveState( StateWriter& w ) const;
+		void restoreState( StateReader& r );
+	private:
+		vector< vector< PreSynEvent > > slot_;
+		priority_queue< PreSynEvent, vector< PreSynEvent >,
+			CompareSynEvent > overflow_;
+};
+
+#endif // _SYN_EVENT_RING_H
@@ -13,6 +13,7 @@
 #include "../basecode/header.h"
 #include "Synapse.h"
 #include "SynEvent.h"
+#include "SynEventRing.h"
 #include "SynHandlerBase.h"
 #include "SimpleSynHandler.h"
 #include "RollingMatrix.h"
@@ -199,6 +200,81 @@ void testSeqSynapse()
 	shell->doDelete( sid );
 }
 
+// Checks that the ring buffers deliver spikes on the same timestep as
+// the priority queue would, including those beyond the ring.
+void testSynEventRing()
+{
+	double dt = 0.1;
+	SynWeightRing ring;
+	SynWeightRing queue;
+	assert( SynEventRingBase::slotsForDelay( 0.5, dt ) == 7 );
+	ring.reinit( 7, dt, 0.0 );
+	queue.reinit( 0, dt, 0.0 );
+	assert( ring.numSlots() == 7 );
+	assert( queue.numSlots() == 0 );
+	double t[] = { 0.0, 0.1, 0.25, 0.3, 0.3, 0.45, 0.7, 1.2, 3.05 };
+	for ( unsigned int i = 0; i < sizeof( t ) / sizeof( double ); ++i ) {
+		ring.push( t[i], i + 1.0 );
+		queue.push( t[i], i + 1.0 );
+	}
+	assert( doubleEq( queue.topTime(), 0.0 ) );
+	assert( doubleEq( ring.topTime(), 0.1 ) );
+	double total = 0.0;
+	for ( unsigned int step = 1; step <= 40; ++step ) {
+		double currTime = step * dt;
+		double x = ring.pop( currTime, dt );
+		double y = queue.pop( currTime, dt );
+		assert( doubleEq( x, y ) );
+		total += x * dt;
+		// Late arrivals go on the next step.
+		if ( step == 10 ) {
+			ring.push( currTime - dt, 100.0 );
+			queue.push( currTime - dt, 100.0 );
+		}
+	}
+	assert( doubleEq( total, 145.0 ) );
+	assert( doubleEq( ring.topTime(), 0.0 ) );
+
+	// With no ring, the activation must be bitwise what the handlers
+	// got from summing weight / dt over a plain priority queue.
+	priority_queue< SynEvent, vector< SynEvent >, CompareSynEvent > pq;
+	queue.reinit( 0, dt, 0.0 );
+	double w[] = { 0.1, 0.7, 0.3, 1e-9, 0.2 };
+	for ( unsigned int i = 0; i < sizeof( w ) / sizeof( double ); ++i ) {
+		queue.push( 0.3, w[i] );
+		pq.push( SynEvent( 0.3, w[i] ) );
+	}
+	double expected = 0.0;
+	while ( !pq.empty() ) {
+		expected += pq.top().weight / dt;
+		pq.pop();
+	}
+	assert( queue.pop( 0.3, dt ) == expected );
+
+	PreSynEventRing pre;
+	vector< PreSynEvent > due;
+	pre.reinit( 4, dt, 0.0 );
+	pre.push( PreSynEvent( 2, 0.2, 1.0 ) );
+	pre.push( PreSynEvent( 1, 0.15, 2.0 ) );
+	pre.push( PreSynEvent( 0, 1.0, 3.0 ) ); // Off the end of the ring.
+	assert( doubleEq( pre.topTime(), 0.15 ) );
+	pre.pop( 0.1, due );
+	assert( due.size() == 0 );
+	pre.pop( 0.2, due );
+	assert( due.size() == 2 );
+	assert( due[0].synIndex == 1 );
+	assert( due[1].synIndex == 2 );
+	assert( doubleEq( pre.topTime(), 1.0 ) );
+	for ( unsigned int step = 3; step < 10; ++step ) {
+		pre.pop( step * dt, due );
+		assert( due.size() == 0 );
+	}
+	pre.pop( 1.0, due );
+	assert( due.size() == 1 );
+	assert( due[0].synIndex == 0 );
+	cout << "." << flush;
+}
+
 #endif // DO_UNIT_TESTS
 
 // This tests stuff without using the messaging.
@@ -208,6 +284,7 @@ void testSynapse()
 	testRollingMatrix();
 	testRollingMatrix2();
 	testSeqSynapse();
+	testSynEventRing();
 #endif // DO_UNIT_TESTS
 }
 
@@ -0,0 +1,234 @@
+# -*- coding: utf-8 -*-
+# test_binary_model.py ---
+# Saves a model to a binary snapshot, loads it back and runs both copies.
+
+import os
+import tempfile
+import numpy as np
+import moose
+
+def make_model(path):
+    model = moose.Neutral(path)
+    compt = moose.CubeMesh(path + '/compt')
+    compt.volume = 1e-18
+    a = moose.Pool(path + '/compt/a')
+    b = moose.Pool(path + '/compt/b')
+    a.concInit = 1.0
+    reac = moose.Reac(path + '/compt/reac')
+    reac.Kf = 0.2
+    reac.Kb = 0.05
+    moose.connect(reac, 'sub', a, 'reac')
+    moose.connect(reac, 'prd', b, 'reac')
+
+    soma = moose.Compartment(path + '/soma', 3)
+    for c in moose.vec(soma):
+        c.Rm = 1e8
+        c.Cm = 1e-11
+        c.Em = -0.065
+        c.initVm = -0.065
+    soma.vec[0].inject = 1e-10
+    moose.connect(soma.vec, 'axialOut', soma.vec, 'handleAxial', 'Diagonal')
+    m = moose.connect(soma.vec, 'raxialOut', soma.vec, 'handleRaxial',
+                      'Diagonal')
+    m.stride = -1
+
+    moose.Table2(path + '/plotB')
+    moose.connect(path + '/plotB', 'requestOut', b, 'getConc')
+    moose.Table(path + '/plotVm', 3)
+    moose.connect(moose.vec(path + '/plotVm'), 'requestOut',
+                  soma.vec, 'getVm', 'OneToOne')
+    return model
+
+def test_binary_model():
+    make_model('/m1')
+    moose.setClock(18, 0.05)
+    fname = os.path.join(tempfile.mkdtemp(), 'model.msnap')
+    moose.saveModel('/m1', fname)
+    assert os.path.getsize(fname) > 0
+
+    m2 = moose.loadModel(fname, '/m2')
+    assert m2.path == '/m2'
+    assert moose.element('/m2/compt').className == 'CubeMesh'
+    assert np.isclose(moose.element('/m2/compt').volume, 1e-18)
+    assert np.isclose(moose.element('/m2/compt/a').concInit, 1.0)
+    assert np.isclose(moose.element('/m2/compt/reac').Kf, 0.2)
+    assert len(moose.vec('/m2/soma')) == 3
+    assert np.isclose(moose.vec('/m2/soma')[0].inject, 1e-10)
+    assert np.isclose(moose.vec('/m2/soma')[1].inject, 0.0)
+    assert moose.element('/m2/compt/reac').neighbors['sub'][0].path == \
+        '/m2/compt/a[0]'
+    assert moose.element('/m2/plotB').tick == moose.element('/m1/plotB').tick
+
+    moose.reinit()
+    moose.start(10.0)
+    for p1, p2 in [('/m1/plotB', '/m2/plotB'),
+                   ('/m1/plotVm[1]', '/m2/plotVm[1]')]:
+        v1 = moose.element(p1).vector
+        v2 = moose.element(p2).vector
+        assert len(v1) > 1
+        assert np.allclose(v1, v2), (p1, v1[-1], v2[-1])
+    moose.delete('/m1')
+    moose.delete('/m2')
+
+def make_ksolve_model(path):
+    moose.Neutral(path)
+    compt = moose.CubeMesh(path + '/compt')
+    compt.volume = 1e-18
+    a = moose.Pool(path + '/compt/a')
+    b = moose.Pool(path + '/compt/b')
+    a.concInit = 1.0
+    reac = moose.Reac(path + '/compt/reac')
+    reac.Kf = 0.2
+    reac.Kb = 0.05
+    moose.connect(reac, 'sub', a, 'reac')
+    moose.connect(reac, 'prd', b, 'reac')
+    ksolve = moose.Ksolve(path + '/compt/ksolve')
+    ksolve.method = 'lsoda'
+    stoich = moose.Stoich(path + '/compt/stoich')
+    stoich.compartment = compt
+    stoich.ksolve = ksolve
+    stoich.reacSystemPath = path + '/compt/##'
+    moose.Table2(path + '/plotB')
+    moose.connect(path + '/plotB', 'requestOut', b, 'getConc')
+
+def make_gate(chan, gate, power, params):
+    setattr(chan, gate[-1] + 'power', power)
+    moose.element(chan.path + '/' + gate).setupAlpha(
+        params + [3000, -0.1, 0.05])
+
+def make_hsolve_model(path):
+    erest = -0.07
+    moose.Neutral(path)
+    compts = []
+    for i in range(4):
+        c = moose.Compartment(path + '/c%d' % i)
+        c.Rm = 1e9
+        c.Ra = 1e7
+        c.Cm = 1e-11
+        c.Em = c.initVm = erest
+        if compts:
+            moose.connect(compts[-1], 'raxial', c, 'axial')
+        compts.append(c)
+        na = moose.HHChannel(c.path + '/Na')
+        na.Ek = 0.045
+        na.Gbar = 1e-6
+        make_gate(na, 'gateX', 3,
+                  [1e5 * (25e-3 + erest), -1e5, -1.0, -25e-3 - erest,
+                   -10e-3, 4e3, 0.0, 0.0, -erest, 18e-3])
+        make_gate(na, 'gateY', 1,
+                  [70.0, 0.0, 0.0, -erest, 0.02,
+                   1.0, 0.0, 1.0, -30e-3 - erest, -10e-3])
+        moose.connect(na, 'channel', c, 'channel')
+        k = moose.HHChannel(c.path + '/K')
+        k.Ek = -0.082
+        k.Gbar = 3e-7
+        make_gate(k, 'gateX', 4,
+                  [1e4 * (10e-3 + erest), -1e4, -1.0, -10e-3 - erest,
+                   -10e-3, 0.125e3, 0.0, 0.0, -erest, 80e-3])
+        moose.connect(k, 'channel', c, 'channel')
+    compts[0].inject = 2e-10
+    hsolve = moose.HSolve(path + '/hsolve')
+    hsolve.dt = 50e-6
+    hsolve.target = compts[0].path
+    tab = moose.Table(path + '/plotVm')
+    moose.connect(tab, 'requestOut', compts[-1], 'getVm')
+
+def check_same_run(plot, runtime):
+    moose.reinit()
+    moose.start(runtime)
+    v1 = moose.element('/m1/' + plot).vector
+    v2 = moose.element('/m2/' + plot).vector
+    assert len(v1) > 1
+    assert np.allclose(v1, v2), (plot, v1[-1], v2[-1])
+
+def test_ksolve_model():
+    make_ksolve_model('/m1')
+    fname = os.path.join(tempfile.mkdtemp(), 'ksolve.msnap')
+    moose.saveModel('/m1', fname)
+    moose.loadModel(fname, '/m2')
+    stoich = moose.element('/m2/compt/stoich')
+    assert stoich.reacSystemPath == '/m2/compt/##'
+    assert stoich.ksolve.path.startswith('/m2')
+    assert stoich.numVarPools == 2
+    check_same_run('plotB', 10.0)
+    moose.delete('/m1')
+    moose.delete('/m2')
+
+def test_hsolve_model():
+    make_hsolve_model('/m1')
+    fname = os.path.join(tempfile.mkdtemp(), 'hsolve.msnap')
+    moose.saveModel('/m1', fname)
+    moose.loadModel(fname, '/m2')
+    assert moose.element('/m2/hsolve').target.startswith('/m2')
+    # The HSolve has taken over the loaded compartments again.
+    assert moose.element('/m2/c0').className == 'ZombieCompartment'
+    assert moose.element('/m2/c0/K').className == 'ZombieHHChannel'
+    check_same_run('plotVm', 0.1)
+    moose.delete('/m1')
+    moose.delete('/m2')
+
+def test_save_fails():
+    make_model('/m1')
+    fname = os.path.join(tempfile.mkdtemp(), 'no_such_dir', 'model.msnap')
+    try:
+        moose.saveModel('/m1', fname)
+        assert False, 'Saved to a missing directory'
+    except RuntimeError:
+        pass
+    moose.delete('/m1')
+
+def test_synapse_arrays():
+    # Each handler has its own number of synapses, so the synapse
+    # FieldElement is saved once with a field array per handler.
+    moose.Neutral('/m1')
+    syns = moose.vec(moose.SimpleSynHandler('/m1/syn', 3))
+    for i in range(3):
+        s = moose.element(syns[i])
+        s.numSynapses = 4 + i
+        for j in range(4 + i):
+            s.synapse[j].weight = 0.1 * (i + 1) + j
+            s.synapse[j].delay = 1e-3 * j
+    fname = os.path.join(tempfile.mkdtemp(), 'syn.msnap')
+    moose.saveModel('/m1', fname)
+    moose.loadModel(fname, '/m2')
+    syns2 = moose.vec('/m2/syn')
+    assert list(syns2.numSynapses) == [4, 5, 6]
+    for i in range(3):
+        s = moose.element(syns2[i])
+        for j in range(4 + i):
+            assert s.synapse[j].weight == 0.1 * (i + 1) + j
+            assert s.synapse[j].delay == 1e-3 * j
+    moose.delete('/m1')
+    moose.delete('/m2')
+
+def test_bad_extension():
+    make_model('/m1')
+    try:
+        moose.saveModel('/m1', os.path.join(tempfile.mkdtemp(), 'model.g'))
+        assert False, 'Saved a snapshot without the .msnap extension'
+    except ValueError:
+        pass
+    moose.delete('/m1')
+
+def test_not_a_snapshot():
+    fname = os.path.join(tempfile.mkdtemp(), 'bad.msnap')
+    with open(fname, 'wb') as f:
+        f.write(b'not a snapshot at all')
+    try:
+        moose.loadModel(fname, '/bad')
+        assert False, 'Loaded a bad snapshot'
+    except RuntimeError:
+        pass
+    assert not moose.exists('/bad')
+
+def main():
+    test_binary_model()
+    test_ksolve_model()
+    test_hsolve_model()
+    test_save_fails()
+    test_synapse_arrays()
+    test_bad_extension()
+    test_not_a_snapshot()
+
+if __name__ == '__main__':
+    main()
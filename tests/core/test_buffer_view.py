@@ -0,0 +1,106 @@
+# -*- coding: utf-8 -*-
+"""test_buffer_view.py:
+
+Test zero-copy views of Table, Ksolve and Dsolve storage.
+
+"""
+
+import threading
+import numpy as np
+import moose
+
+def makeChem():
+    compt = moose.CylMesh('/model/compt')
+    compt.x1 = 10e-6
+    compt.diffLength = 1e-6
+    a = moose.Pool('/model/compt/a')
+    b = moose.Pool('/model/compt/b')
+    reac = moose.Reac('/model/compt/reac')
+    moose.connect(reac, 'sub', a, 'reac')
+    moose.connect(reac, 'prd', b, 'reac')
+    reac.Kf = 0.1
+    reac.Kb = 0.05
+    a.concInit = 1e-3
+    a.diffConst = 1e-12
+    b.diffConst = 1e-12
+    ksolve = moose.Ksolve('/model/compt/ksolve')
+    dsolve = moose.Dsolve('/model/dsolve')
+    stoich = moose.Stoich('/model/compt/stoich')
+    stoich.compartment = compt
+    stoich.ksolve = ksolve
+    stoich.dsolve = dsolve
+    stoich.reacSystemPath = '/model/compt/##'
+    return a, ksolve, dsolve
+
+def test_table_view():
+    moose.Neutral('/model')
+    a, ksolve, dsolve = makeChem()
+    tab = moose.Table2('/model/tab')
+    moose.connect(tab, 'requestOut', a.vec[0], 'getConc')
+    moose.reinit()
+    moose.start(10.0)
+
+    view = moose.view(tab)
+    arr = np.asarray(view)
+    assert len(view) == len(tab.vector) > 0
+    assert np.array_equal(arr, tab.vector)
+    assert not arr.flags.writeable
+
+    # Solver state: all pools in a voxel, one pool in all voxels.
+    nvox = dsolve.numVoxels
+    assert np.array_equal(np.asarray(moose.view(ksolve, 3)), ksolve.nVec[3])
+    assert np.array_equal(np.asarray(moose.view(dsolve, 0)), dsolve.nVec[0])
+    assert len(moose.view(dsolve, 0)) == nvox
+
+    # The view reads live values: a new array after more steps differs.
+    before = np.asarray(moose.view(dsolve, 1)).copy()
+    moose.start(10.0)
+    after = np.asarray(moose.view(dsolve, 1))
+    assert not np.array_equal(before, after)
+    assert np.array_equal(after, dsolve.nVec[1])
+
+    try:
+        moose.view(dsolve, 1000)
+        assert False, "Expected IndexError"
+    except IndexError:
+        pass
+    try:
+        moose.view(a)
+        assert False, "Expected TypeError"
+    except TypeError:
+        pass
+    moose.delete('/model')
+
+def test_view_while_running():
+    moose.Neutral('/model')
+    pg = moose.PulseGen('/model/pg')
+    pg.baseLevel = 1.0
+    tab = moose.Table('/model/tab')
+    moose.connect(tab, 'requestOut', pg, 'getOutputValue')
+    moose.reinit()
+
+    refused = []
+    done = threading.Event()
+
+    def reader():
+        while not done.is_set():
+            if moose.isRunning():
+                try:
+                    np.asarray(moose.view(tab))
+                except ValueError:
+                    refused.append(True)
+
+    t = threading.Thread(target=reader)
+    t.start()
+    moose.start(1.0)
+    done.set()
+    t.join()
+
+    # The table grew during the run, so the reader was never let in.
+    assert refused
+    assert np.array_equal(np.asarray(moose.view(tab)), tab.vector)
+    moose.delete('/model')
+
+if __name__ == '__main__':
+    test_table_view()
+    test_view_while_running()
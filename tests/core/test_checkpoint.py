@@ -0,0 +1,246 @@
+# -*- coding: utf-8 -*-
+# test_checkpoint.py ---
+# Saves the state of a running model, restores it onto a fresh copy of the
+# model and checks that the resumed run matches an uninterrupted one.
+
+import os
+import tempfile
+import numpy as np
+import moose
+
+def make_model(path):
+    model = moose.Neutral(path)
+    compt = moose.CubeMesh(path + '/compt')
+    compt.volume = 1e-20
+    a = moose.Pool(path + '/compt/a')
+    b = moose.Pool(path + '/compt/b')
+    a.nInit = 100
+    reac = moose.Reac(path + '/compt/reac')
+    reac.numKf = 20
+    reac.numKb = 10
+    moose.connect(reac, 'sub', a, 'reac')
+    moose.connect(reac, 'prd', b, 'reac')
+    gsolve = moose.Gsolve(path + '/compt/gsolve')
+    stoich = moose.Stoich(path + '/compt/stoich')
+    stoich.compartment = compt
+    stoich.ksolve = gsolve
+    stoich.reacSystemPath = path + '/compt/##'
+
+    soma = moose.Compartment(path + '/soma')
+    soma.Rm = 1e8
+    soma.Cm = 1e-11
+    soma.Em = -0.065
+    soma.initVm = -0.065
+    syn = moose.SynChan(path + '/soma/syn')
+    syn.Gbar = 1e-9
+    syn.tau1 = 2e-3
+    syn.tau2 = 5e-3
+    moose.connect(soma, 'channel', syn, 'channel')
+    handler = moose.SimpleSynHandler(path + '/soma/syn/sh')
+    handler.synapse.num = 1
+    handler.synapse[0].weight = 1.0
+    handler.synapse[0].delay = 7e-3
+    moose.connect(handler, 'activationOut', syn, 'activation')
+    spikes = moose.RandSpike(path + '/rs')
+    spikes.rate = 80
+    moose.connect(spikes, 'spikeOut', handler.synapse[0], 'addSpike')
+
+    plotVm = moose.Table(path + '/plotVm')
+    plotVm.ringSize = 300
+    moose.connect(plotVm, 'requestOut', soma, 'getVm')
+    plotB = moose.Table(path + '/plotB')
+    moose.connect(plotB, 'requestOut', b, 'getN')
+    return model
+
+def results():
+    return [moose.element('/m/plotVm').vector,
+            moose.element('/m/plotVm').times,
+            moose.element('/m/plotB').vector,
+            np.array([moose.element('/m/soma').Vm,
+                      moose.element('/m/compt/b').n])]
+
+def test_checkpoint():
+    fname = os.path.join(tempfile.mkdtemp(), 'run.mckp')
+    moose.seed(7)
+    make_model('/m')
+    moose.reinit()
+    moose.start(0.2)
+    moose.saveCheckpoint('/m', fname)
+    moose.start(0.3)
+    ref = results()
+    moose.delete('/m')
+
+    moose.seed(99)
+    make_model('/m')
+    moose.loadCheckpoint('/m', fname)
+    assert np.isclose(moose.element('/clock').currentTime, 0.2)
+    moose.start(0.3)
+    for v1, v2 in zip(ref, results()):
+        assert len(v1) > 1
+        assert np.array_equal(v1, v2)
+    moose.delete('/m')
+
+def test_wrong_model():
+    fname = os.path.join(tempfile.mkdtemp(), 'run.mckp')
+    make_model('/m')
+    moose.reinit()
+    moose.start(0.1)
+    moose.saveCheckpoint('/m', fname)
+    moose.delete('/m/rs')
+    moose.start(0.05)
+    before = results()
+    t = moose.element('/clock').currentTime
+    try:
+        moose.loadCheckpoint('/m', fname)
+        assert False, 'Restored onto a different model'
+    except RuntimeError:
+        pass
+    # The failed load must not have reinit or otherwise touched the model.
+    assert moose.element('/clock').currentTime == t
+    for v1, v2 in zip(before, results()):
+        assert np.array_equal(v1, v2)
+    moose.delete('/m')
+
+def check_resume(make, plots, t1, t2):
+    """Runs the model made by make for t1, saves a checkpoint, and runs on
+    for t2. Then runs a fresh copy of it for t2 from the checkpoint, and
+    checks that the plots match."""
+    fname = os.path.join(tempfile.mkdtemp(), 'run.mckp')
+    make('/r')
+    moose.reinit()
+    moose.start(t1)
+    moose.saveCheckpoint('/r', fname)
+    moose.start(t2)
+    ref = [moose.element(p).vector for p in plots]
+    moose.delete('/r')
+
+    make('/r')
+    moose.loadCheckpoint('/r', fname)
+    moose.start(t2)
+    for p, v in zip(plots, ref):
+        assert len(v) > 1, p
+        assert np.array_equal(v, moose.element(p).vector), p
+    moose.delete('/r')
+
+def make_reacs(path, compt, solver):
+    a = moose.Pool(compt.path + '/a')
+    b = moose.Pool(compt.path + '/b')
+    c = moose.Pool(compt.path + '/c')
+    a.concInit = 1.0
+    b.concInit = 0.5
+    r1 = moose.Reac(compt.path + '/r1')
+    r1.Kf = 2.0
+    r1.Kb = 0.1
+    moose.connect(r1, 'sub', a, 'reac')
+    moose.connect(r1, 'sub', b, 'reac')
+    moose.connect(r1, 'prd', c, 'reac')
+    r2 = moose.Reac(compt.path + '/r2')
+    r2.Kf = 0.3
+    r2.Kb = 0.0
+    moose.connect(r2, 'sub', c, 'reac')
+    moose.connect(r2, 'prd', a, 'reac')
+    stoich = moose.Stoich(compt.path + '/stoich')
+    stoich.compartment = compt
+    stoich.ksolve = solver
+    return stoich
+
+def make_ksolve(method):
+    def make(path):
+        moose.Neutral(path)
+        compt = moose.CubeMesh(path + '/compt')
+        compt.volume = 1e-18
+        ksolve = moose.Ksolve(path + '/compt/ksolve')
+        ksolve.method = method
+        stoich = make_reacs(path, compt, ksolve)
+        stoich.reacSystemPath = path + '/compt/##'
+        for name in ('a', 'c'):
+            tab = moose.Table2(path + '/plot_' + name)
+            moose.connect(tab, 'requestOut', path + '/compt/' + name,
+                          'getConc')
+    return make
+
+def make_dsolve(path):
+    moose.Neutral(path)
+    compt = moose.CylMesh(path + '/compt')
+    compt.r0 = compt.r1 = 1e-6
+    compt.x1 = 10e-6
+    compt.diffLength = 1e-6
+    ksolve = moose.Ksolve(path + '/compt/ksolve')
+    dsolve = moose.Dsolve(path + '/compt/dsolve')
+    stoich = make_reacs(path, compt, ksolve)
+    stoich.dsolve = dsolve
+    for name in ('a', 'b', 'c'):
+        moose.element(path + '/compt/' + name).diffConst = 1e-12
+    stoich.reacSystemPath = path + '/compt/##'
+    a = moose.element(path + '/compt/a')
+    for i in range(len(a.vec)):
+        a.vec[i].concInit = 2.0 * i / len(a.vec)
+    for i in (0, 9):
+        tab = moose.Table2(path + '/plot_a%d' % i)
+        moose.connect(tab, 'requestOut', a.vec[i], 'getConc')
+
+def make_gate(chan, gate, power, params):
+    setattr(chan, gate[-1] + 'power', power)
+    vdivs, vmin, vmax = 3000, -0.1, 0.05
+    moose.element(chan.path + '/' + gate).setupAlpha(
+        params + [vdivs, vmin, vmax])
+
+def make_hsolve(path):
+    erest = -0.07
+    moose.Neutral(path)
+    compts = []
+    for i in range(4):
+        c = moose.Compartment(path + '/c%d' % i)
+        c.Rm = 1e9
+        c.Ra = 1e7
+        c.Cm = 1e-11
+        c.Em = c.initVm = erest
+        if compts:
+            moose.connect(compts[-1], 'raxial', c, 'axial')
+        compts.append(c)
+        na = moose.HHChannel(c.path + '/Na')
+        na.Ek = 0.045
+        na.Gbar = 1e-6
+        make_gate(na, 'gateX', 3,
+                  [1e5 * (25e-3 + erest), -1e5, -1.0, -25e-3 - erest,
+                   -10e-3, 4e3, 0.0, 0.0, -erest, 18e-3])
+        make_gate(na, 'gateY', 1,
+                  [70.0, 0.0, 0.0, -erest, 0.02,
+                   1.0, 0.0, 1.0, -30e-3 - erest, -10e-3])
+        moose.connect(na, 'channel', c, 'channel')
+        k = moose.HHChannel(c.path + '/K')
+        k.Ek = -0.082
+        k.Gbar = 3e-7
+        make_gate(k, 'gateX', 4,
+                  [1e4 * (10e-3 + erest), -1e4, -1.0, -10e-3 - erest,
+                   -10e-3, 0.125e3, 0.0, 0.0, -erest, 80e-3])
+        moose.connect(k, 'channel', c, 'channel')
+    compts[0].inject = 2e-10
+    hsolve = moose.HSolve(path + '/hsolve')
+    hsolve.dt = 50e-6
+    hsolve.target = compts[0].path
+    tab = moose.Table(path + '/plotVm')
+    moose.connect(tab, 'requestOut', compts[-1], 'getVm')
+
+def test_resume_ksolve_lsoda():
+    check_resume(make_ksolve('lsoda'), ['/r/plot_a', '/r/plot_c'], 5.0, 10.0)
+
+def test_resume_ksolve_gsl():
+    check_resume(make_ksolve('gsl'), ['/r/plot_a', '/r/plot_c'], 5.0, 10.0)
+
+def test_resume_dsolve():
+    check_resume(make_dsolve, ['/r/plot_a0', '/r/plot_a9'], 5.0, 10.0)
+
+def test_resume_hsolve():
+    check_resume(make_hsolve, ['/r/plotVm'], 0.05, 0.1)
+
+def main():
+    test_checkpoint()
+    test_wrong_model()
+    test_resume_ksolve_lsoda()
+    test_resume_ksolve_gsl()
+    test_resume_dsolve()
+    test_resume_hsolve()
+
+if __name__ == '__main__':
+    main()
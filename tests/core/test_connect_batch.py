@@ -0,0 +1,62 @@
+# -*- coding: utf-8 -*-
+# test_connect_batch.py ---
+# Builds synaptic connections from numpy arrays with moose.connectBatch.
+
+import numpy as np
+import moose
+
+N = 50
+
+def make(path):
+    moose.Neutral(path)
+    moose.IntFire('%s/nrn' % path, N)
+    moose.SimpleSynHandler('%s/syn' % path, N)
+    return moose.element('%s/nrn' % path), moose.element('%s/syn' % path)
+
+def test_connect_batch():
+    nrn, syn = make('/batch')
+    rng = np.random.default_rng(1)
+    n = 1000
+    src = rng.integers(0, N, n).astype(np.uint32)
+    dest = rng.integers(0, N, n)        # int64, converted on the way in
+    weight = rng.random(n)
+    delay = rng.random(n) * 1e-3
+    m = moose.connectBatch(nrn, 'spikeOut', moose.element('/batch/syn/synapse'),
+                           'addSpike', src, dest, weight=weight, delay=delay)
+    assert m.numEntries == n
+
+    syns = moose.vec('/batch/syn')
+    counts = np.bincount(dest, minlength=N)
+    assert (np.array(syns.numSynapses) == counts).all()
+
+    # Synapses on each dest are numbered in the order they come.
+    seen = np.zeros(N, dtype=int)
+    for i in range(n):
+        j = seen[dest[i]]
+        seen[dest[i]] += 1
+        if i % 37 == 0:
+            s = moose.element(syns[int(dest[i])]).synapse[int(j)]
+            assert np.isclose(s.weight, weight[i])
+            assert np.isclose(s.delay, delay[i])
+
+    # Explicit field indices, and bad input.
+    nrn2, syn2 = make('/batch2')
+    field = np.arange(N, dtype=np.uint32)[::-1].copy()
+    moose.connectBatch(nrn2, 'spikeOut', moose.element('/batch2/syn/synapse'),
+                       'addSpike', np.arange(N), np.arange(N), field)
+    assert list(moose.vec('/batch2/syn').numSynapses) == list(field + 1)
+    try:
+        moose.connectBatch(nrn2, 'spikeOut',
+                           moose.element('/batch2/syn/synapse'), 'addSpike',
+                           np.arange(N), np.arange(N - 1))
+        assert False, 'length mismatch not caught'
+    except ValueError:
+        pass
+    moose.delete('/batch')
+    moose.delete('/batch2')
+
+def main():
+    test_connect_batch()
+
+if __name__ == '__main__':
+    main()
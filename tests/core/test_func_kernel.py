@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+# test_func_kernel.py ---
+# Under a Ksolve, pool Functions are evaluated natively where the
+# expression allows it. Builds the same set of Functions with and without
+# a solver, so that one copy goes through the native kernel and the other
+# through exprtk, and checks that they agree, including at zero inputs.
+
+import numpy as np
+import moose
+
+EXPRS = [
+    '2*x0 - x1/4 + 3',
+    '(x0 + 1)^2 * x2 - 0.5*x1',
+    'x2^2.5 / (16^2.5 + x2^2.5)',
+    'x0*x1 / (0.5 + x0)',
+    'max(0, x0 - x2, min(x1, 0.5))',
+    '(x0^2)^0.5 + x1',
+    'x1^0.5 * x1^0.5',
+    '(x0*x2)^1.5 / (1 + x1^3)',
+    'pow(x2/4, 0.5) * x0',
+    'exp(-x1) * x2',
+]
+
+INPUTS = [[3.0, 0.0, 9.0], [0.0, 2.5, 4.0], [1.5, 7.0, 0.0]]
+
+def build(path, inputs, solve):
+    moose.Neutral(path)
+    compt = moose.CubeMesh(path + '/c')
+    compt.volume = 1e-18
+    xs = []
+    for i, v in enumerate(inputs):
+        x = moose.BufPool('%s/c/x%d' % (path, i))
+        x.nInit = v
+        xs.append(x)
+    ys = []
+    for k, expr in enumerate(EXPRS):
+        y = moose.BufPool('%s/c/y%d' % (path, k))
+        f = moose.Function(y.path + '/f')
+        f.expr = expr
+        f.x.num = len(xs)
+        for i, x in enumerate(xs):
+            moose.connect(x, 'nOut', f.x[i], 'input')
+        moose.connect(f, 'valueOut', y, 'setN')
+        ys.append(y)
+    if solve:
+        ksolve = moose.Ksolve(path + '/c/ksolve')
+        stoich = moose.Stoich(path + '/c/stoich')
+        stoich.compartment = compt
+        stoich.ksolve = ksolve
+        stoich.reacSystemPath = path + '/c/##'
+    return ys
+
+def test_native_matches_exprtk():
+    for inputs in INPUTS:
+        native = build('/native', inputs, True)
+        ref = build('/ref', inputs, False)
+        moose.reinit()
+        moose.start(1.0)
+        for expr, a, b in zip(EXPRS, native, ref):
+            assert np.isfinite(b.n), (expr, inputs, b.n)
+            assert np.isclose(a.n, b.n, rtol=1e-9, atol=0), \
+                (expr, inputs, a.n, b.n)
+        moose.delete('/native')
+        moose.delete('/ref')
+
+def main():
+    test_native_matches_exprtk()
+
+if __name__ == '__main__':
+    main()
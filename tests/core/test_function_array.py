@@ -0,0 +1,91 @@
+# -*- coding: utf-8 -*-
+# test_function_array.py ---
+# An array of Functions is processed as one batch. Check that each entry
+# still gets its own inputs and outputs, with and without feedback into
+# the array, which turns the batch off.
+
+import numpy as np
+import moose
+
+N = 40
+
+def build(path, feedback):
+    moose.Neutral(path)
+    moose.Function('%s/f' % path, N)
+    f = moose.vec('%s/f' % path)
+    for i in range(N):
+        e = moose.element(f[i])
+        e.expr = 'x0 * 2 + y0'
+        e.x[0].value = i
+    moose.CubeMesh('%s/c' % path)
+    moose.Pool('%s/c/p' % path, N)
+    pools = moose.vec('%s/c/p' % path)
+    pools.nInit = np.arange(N) * 10.0
+    moose.connect(f, 'requestOut', pools, 'getN', 'OneToOne')
+    moose.Table('%s/tab' % path, N)
+    tabs = moose.vec('%s/tab' % path)
+    moose.connect(f, 'valueOut', tabs, 'input', 'OneToOne')
+    if feedback:
+        # Entry i feeds x0 of entry i + 1.
+        for i in range(N - 1):
+            moose.connect(f[i], 'valueOut', moose.element(f[i + 1]).x[0], 'input')
+    for obj in (f, pools, tabs):
+        moose.setClock(obj.tick, 0.1)
+    return f, tabs
+
+def test_function_array():
+    f, tabs = build('/fa', False)
+    g, gtabs = build('/fb', True)
+    moose.reinit()
+    moose.start(1.0)
+    for i in range(N):
+        v = tabs[i].vector
+        assert len(v) > 5
+        # y0 lags x0 by one step.
+        assert np.isclose(v[0], 2 * i), (i, v[0])
+        assert np.isclose(v[-1], 2 * i + 10 * i), (i, v[-1])
+    # In the chain, entry i has had i steps of doubling passed down to it.
+    assert np.isclose(gtabs[0].vector[-1], 0.0)
+    assert np.isclose(gtabs[1].vector[-1], 2 * gtabs[0].vector[-1] + 10)
+    moose.delete('/fa')
+    moose.delete('/fb')
+
+def test_chained_pools():
+    # Entry i sets pool i, which entry i + 1 reads through requestOut, so
+    # the entries must run in order within a step. As y0 lags by one step,
+    # entry i reaches i + 1 after i + 1 steps. Processing the array in one
+    # batch would read pool i before entry i has set it, and lag further.
+    moose.Neutral('/fc')
+    moose.Function('/fc/f', N)
+    f = moose.vec('/fc/f')
+    for i in range(N):
+        moose.element(f[i]).expr = 'y0 + 1'
+    moose.CubeMesh('/fc/c')
+    src = moose.BufPool('/fc/c/src')
+    moose.BufPool('/fc/c/p', N)
+    pools = moose.vec('/fc/c/p')
+    moose.connect(f, 'valueOut', pools, 'setN', 'OneToOne')
+    moose.connect(f[0], 'requestOut', src, 'getN')
+    for i in range(1, N):
+        moose.connect(f[i], 'requestOut', pools[i - 1], 'getN')
+    moose.Table('/fc/tab', N)
+    tabs = moose.vec('/fc/tab')
+    moose.connect(f, 'valueOut', tabs, 'input', 'OneToOne')
+    for obj in (f, tabs):
+        moose.setClock(obj.tick, 0.1)
+    moose.reinit()
+    moose.start(1.0)
+    for i in range(N):
+        v = tabs[i].vector
+        steps = np.arange(1, len(v) + 1)
+        assert len(v) > 5
+        assert np.allclose(v, np.minimum(steps, i + 1)), (i, v)
+        assert np.isclose(pools[i].n, min(len(v), i + 1)), (i, pools[i].n)
+    moose.delete('/fc')
+
+def main():
+    test_function_array()
+    test_chained_pools()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,31 @@
+# -*- coding: utf-8 -*-
+# test_function_cache.py ---
+# Functions with the same expression share one compile, but each one
+# evaluates on its own variables.
+
+import numpy as np
+import moose
+
+def test_shared_expr():
+    moose.Neutral('/fc')
+    funcs = []
+    for i in range(50):
+        f = moose.Function('/fc/f%d' % i)
+        f.expr = 'x0 * 2 + alpha + 0.5'
+        funcs.append(f)
+    for i, f in enumerate(funcs):
+        f.x[0].value = i
+        f.x[1].value = 10 * i
+    for i, f in enumerate(funcs):
+        assert np.isclose(f.value, 2 * i + 10 * i + 0.5), (i, f.value)
+    # Changing one expression leaves the rest alone.
+    funcs[3].expr = 'x0 - alpha'
+    assert np.isclose(funcs[3].value, 3 - 30)
+    assert np.isclose(funcs[4].value, 8 + 40 + 0.5)
+    moose.delete('/fc')
+
+def main():
+    test_shared_expr()
+
+if __name__ == '__main__':
+    main()
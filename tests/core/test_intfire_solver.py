@@ -0,0 +1,105 @@
+# -*- coding: utf-8 -*-
+# test_intfire_solver.py ---
+# Compares arrays of integrate-and-fire neurons run by the
+# IntFireSolver with the same arrays run on their own.
+
+import numpy as np
+import moose
+print( 'Using moose from %s' % moose.__file__ )
+
+N = 20
+
+def make_array(path, cls):
+    moose.Neutral(path)
+    getattr(moose, cls)('%s/nrn' % path, N)
+    nrn = moose.vec('%s/nrn' % path)
+    nrn.Rm = 1e8
+    nrn.Cm = 1e-10
+    nrn.Em = -0.065
+    nrn.initVm = -0.065
+    nrn.vReset = -0.07
+    nrn.thresh = -0.05
+    nrn.refractoryPeriod = 2e-3
+    nrn.inject = np.linspace(1e-10, 5e-10, N)
+    if cls == 'AdExIF':
+        nrn.vPeak = -0.04
+        nrn.deltaThresh = 2e-3
+        nrn.a0 = 1e-9
+        nrn.b0 = 5e-11
+        nrn.tauW = 0.05
+    elif cls == 'IzhIF':
+        nrn.a0 = 0.04e3
+        nrn.b0 = 5.0
+        nrn.c0 = 140e-3
+        nrn.a = 0.02e3
+        nrn.b = 0.2e3
+        nrn.d = 8.0
+        nrn.vPeak = 0.03
+        nrn.vReset = -0.065
+        nrn.uInit = -14.0
+
+    # A few recurrent synapses, to check that spikes get delivered.
+    moose.SimpleSynHandler('%s/syn' % path, N)
+    syn = moose.vec('%s/syn' % path)
+    syn.numSynapses = 1
+    moose.connect(syn, 'activationOut', nrn, 'activation', 'OneToOne')
+    for i in range(N):
+        sh = moose.element(syn[i])
+        sh.synapse[0].weight = 5e-3
+        sh.synapse[0].delay = 1e-3
+        moose.connect(nrn[(i + 1) % N], 'spikeOut', sh.synapse[0], 'addSpike')
+
+    moose.Table('%s/vm' % path, N)
+    vmtab = moose.vec('%s/vm' % path)
+    moose.connect(vmtab, 'requestOut', nrn, 'getVm', 'OneToOne')
+    moose.Table('%s/spikes' % path, N)
+    spiketab = moose.vec('%s/spikes' % path)
+    moose.connect(nrn, 'spikeOut', spiketab, 'spike', 'OneToOne')
+    return nrn, vmtab, spiketab
+
+def run_pair(cls):
+    path = '/test_%s' % cls
+    moose.Neutral(path)
+    plain = make_array('%s/plain' % path, cls)
+    solved = make_array('%s/solved' % path, cls)
+    solver = moose.IntFireSolver('%s/solver' % path)
+    solver.target = solved[0]
+    assert solver.numNeurons == N, solver.numNeurons
+    assert solver.model == cls, solver.model
+    assert moose.element(solved[0][0]).className == 'Zombie' + cls
+
+    moose.reinit()
+    moose.start(0.2)
+
+    nspikes = sum(len(moose.element(x).vector) for x in plain[2])
+    assert nspikes > 0, 'Plain %s network is silent' % cls
+    assert solver.numSpikes == nspikes, (solver.numSpikes, nspikes)
+    for a, b in zip(plain[2], solved[2]):
+        assert np.allclose(moose.element(a).vector, moose.element(b).vector)
+    for a, b in zip(plain[1], solved[1]):
+        assert np.allclose(moose.element(a).vector, moose.element(b).vector,
+                atol=1e-9)
+
+    # Fields go through the zombie to the solver.
+    solved[0][3].Em = -0.06
+    assert np.isclose(solved[0][3].Em, -0.06)
+    vm = np.array(solved[0].Vm)
+
+    # Letting go writes the state back and restores the class.
+    solver.target = moose.element('/').id
+    assert solver.numNeurons == 0
+    assert moose.element(solved[0][0]).className == cls
+    assert np.isclose(solved[0][3].Em, -0.06)
+    assert np.allclose(solved[0].Vm, vm)
+    moose.delete(path)
+
+def test_intfire_solver():
+    for cls in ['LIF', 'AdExIF', 'IzhIF']:
+        run_pair(cls)
+        print('%s ok' % cls)
+
+def main():
+    test_intfire_solver()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+# test_ksolve_overlap.py ---
+# Two abutting cylinders, with diffusion and a reaction in each. The
+# Ksolve overlapJunctions mode must give the same answers as the
+# default, since it only changes the order of the calculations.
+
+import numpy as np
+import moose
+print( '[INFO] Using moose from %s' % moose.__file__ )
+
+NUM_VOXELS = 20
+
+def makeCompt( name, x0, x1, overlap ):
+    compt = moose.CylMesh( '/model/' + name )
+    compt.x0 = x0
+    compt.x1 = x1
+    compt.r0 = compt.r1 = 1e-6
+    compt.diffLength = ( x1 - x0 ) / NUM_VOXELS
+    a = moose.Pool( compt.path + '/a' )
+    b = moose.Pool( compt.path + '/b' )
+    reac = moose.Reac( compt.path + '/reac' )
+    moose.connect( reac, 'sub', a, 'reac' )
+    moose.connect( reac, 'prd', b, 'reac' )
+    reac.Kf = 0.1
+    reac.Kb = 0.05
+    a.diffConst = 1e-12
+    b.diffConst = 5e-13
+    ksolve = moose.Ksolve( compt.path + '/ksolve' )
+    ksolve.overlapJunctions = overlap
+    dsolve = moose.Dsolve( compt.path + '/dsolve' )
+    stoich = moose.Stoich( compt.path + '/stoich' )
+    stoich.compartment = compt
+    stoich.ksolve = ksolve
+    stoich.dsolve = dsolve
+    stoich.reacSystemPath = compt.path + '/##'
+    return compt, ksolve, dsolve
+
+def run( overlap ):
+    moose.Neutral( '/model' )
+    c1, k1, d1 = makeCompt( 'c1', 0.0, 20e-6, overlap )
+    c2, k2, d2 = makeCompt( 'c2', 20e-6, 40e-6, overlap )
+    d1.buildMeshJunctions( d2 )
+    a1 = moose.vec( '/model/c1/a' )
+    a1.concInit = 0.0
+    a1[NUM_VOXELS - 1].concInit = 1.0
+    for i in range( 10, 20 ):
+        moose.setClock( i, 0.1 )
+    moose.reinit()
+    moose.start( 50.0 )
+    ret = [ np.array( moose.vec( '/model/%s/%s' % ( c, m ) ).n )
+            for c in [ 'c1', 'c2' ] for m in [ 'a', 'b' ] ]
+    numBoundary = k1.numBoundaryVoxels
+    waitTime = k1.junctionWaitTime
+    moose.delete( '/model' )
+    return ret, numBoundary, waitTime
+
+def test_ksolve_overlap():
+    ref, nb, wait = run( False )
+    assert nb == 0, nb
+    assert wait == 0.0
+    # Something must have diffused across into the second cylinder.
+    assert ref[2].sum() > 0.0
+    ret, nb, wait = run( True )
+    assert nb == 1, nb
+    assert wait >= 0.0
+    for x, y in zip( ref, ret ):
+        assert np.allclose( x, y, rtol = 1e-10, atol = 0 ), ( x, y )
+
+if __name__ == '__main__':
+    test_ksolve_overlap()
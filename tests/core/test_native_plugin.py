@@ -0,0 +1,76 @@
+# -*- coding: utf-8 -*-
+# test_native_plugin.py ---
+# Builds the sample plugin in examples/plugins and runs it in a NativePlugin.
+
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import numpy as np
+import pytest
+import moose
+
+sdir_ = os.path.dirname(os.path.realpath(__file__))
+root_ = os.path.join(sdir_, '..', '..')
+
+def build_plugin(outdir):
+    cc = shutil.which('cc') or shutil.which('gcc') or shutil.which('clang')
+    if cc is None or sys.platform == 'win32':
+        pytest.skip('No C compiler to build the sample plugin')
+    ext = '.dylib' if sys.platform == 'darwin' else '.so'
+    lib = os.path.join(outdir, 'libpi_controller' + ext)
+    shared = '-dynamiclib' if sys.platform == 'darwin' else '-shared'
+    subprocess.check_call([cc, '-O2', shared, '-fPIC',
+        '-I', os.path.join(root_, 'builtins'),
+        os.path.join(root_, 'examples', 'plugins', 'pi_controller.c'),
+        '-o', lib])
+    return lib
+
+def test_native_plugin():
+    lib = build_plugin(tempfile.mkdtemp())
+    moose.Neutral('/np')
+    moose.NativePlugin('/np/pi', 3)
+    pis = moose.vec('/np/pi')
+    for i in range(3):
+        p = moose.element(pis[i])
+        p.config = 'kp=2 ki=%g' % (0.5 * i)
+        p.library = lib
+        assert p.pluginName == 'pi_controller'
+        assert list(p.inputNames) == ['setpoint', 'measured']
+        assert list(p.outputNames) == ['command', 'error']
+        assert p.numOutputs == 2
+        p.x[0].value = 1.0
+        p.x[1].value = 0.25
+
+    moose.Table('/np/tab', 3)
+    tabs = moose.vec('/np/tab')
+    moose.connect(pis, 'valueOut', tabs, 'input', 'OneToOne')
+    dt = 0.1
+    # Plugins run with the Functions, not on the electrical tick 0.
+    assert moose.element(pis[0]).tick == 12
+    moose.setClock(pis.tick, dt)
+    moose.setClock(tabs.tick, dt)
+    moose.reinit()
+    moose.start(1.0)
+
+    # Each entry has its own gains and its own integral, over 1 s.
+    for i in range(3):
+        p = moose.element(pis[i])
+        expected = 2 * 0.75 + 0.5 * i * 0.75 * 1.0
+        assert np.isclose(p.value, expected), (i, p.value, expected)
+        assert np.isclose(p.outputs[1], 0.75)
+        assert np.isclose(tabs[i].vector[-1], p.value)
+
+    # A bad library leaves the object unloaded.
+    bad = moose.NativePlugin('/np/bad')
+    bad.library = os.path.join(tempfile.mkdtemp(), 'nonexistent.so')
+    assert bad.library == ''
+    assert bad.numOutputs == 0
+    moose.delete('/np')
+
+def main():
+    test_native_plugin()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,56 @@
+# -*- coding: utf-8 -*-
+"""test_snapshot.py:
+
+Read a Snapshot from another thread while moose.start runs.
+
+"""
+
+import threading
+import moose
+
+def test_snapshot_thread():
+    model = moose.Neutral('/model')
+    pg = moose.PulseGen('/model/pg')
+    pg.baseLevel = 1.0
+    pg.level[0] = 2.0
+    pg.delay[0] = 0.5
+    pg.width[0] = 1e9
+    snap = moose.Snapshot('/model/snap')
+    moose.connect(snap, 'requestOut', pg, 'getOutputValue')
+    # Snapshots sit with the electrical Tables, off the PulseGen's tick.
+    assert snap.tick == 8, snap.tick
+    assert pg.tick == 0
+    moose.setClock(pg.tick, 1e-4)
+    moose.setClock(snap.tick, 1e-4)
+    moose.reinit()
+    assert snap.count == 1
+
+    seen = []
+    done = threading.Event()
+
+    def monitor():
+        while not done.is_set():
+            if moose.isRunning():
+                vals = snap.values
+                seen.append((snap.count, snap.time, list(vals)))
+
+    t = threading.Thread(target=monitor)
+    t.start()
+    moose.start(1.0)
+    done.set()
+    t.join()
+
+    # The monitor ran while the simulation did.
+    assert len(seen) > 1, len(seen)
+    counts = [c for c, _, _ in seen]
+    assert counts == sorted(counts)
+    for c, tm, vals in seen:
+        assert len(vals) == 1
+        assert vals[0] in (1.0, 2.0), (tm, vals)
+    assert list(snap.values) == [2.0]
+    assert abs(snap.time - 1.0) < 1e-6
+    assert snap.count == 10001
+    moose.delete('/model')
+
+if __name__ == '__main__':
+    test_snapshot_thread()
@@ -0,0 +1,78 @@
+# -*- coding: utf-8 -*-
+"""test_spike_router.py:
+
+Checks that a SpikeRouter delivering the spikes of a SparseMsg gives the
+same result as the regular per-synapse delivery.
+"""
+
+import numpy as np
+import moose
+
+numSrc = 20
+numTgt = 10
+dt = 1e-4
+
+
+def makeNetwork(path, useRouter):
+    model = moose.Neutral(path)
+    src = moose.LIF(path + '/src', numSrc)
+    src.vec.Rm = 1e8
+    src.vec.Cm = 1e-10
+    src.vec.thresh = 0.02
+    src.vec.refractoryPeriod = 0.002
+    src.vec.inject = np.linspace(2.1e-10, 4e-10, numSrc)
+
+    tgt = moose.LIF(path + '/tgt', numTgt)
+    tgt.vec.Rm = 1e8
+    tgt.vec.Cm = 1e-10
+    tgt.vec.thresh = 10.0  # Never fires, so Vm sums the inputs.
+    syn = moose.SimpleSynHandler(path + '/tgt/syn', numTgt)
+    moose.connect(syn, 'activationOut', tgt, 'activation', 'OneToOne')
+
+    synv = moose.vec(syn.path + '/synapse')
+    m = moose.element(moose.connect(src, 'spikeOut', synv, 'addSpike',
+                                    'Sparse'))
+    m.setRandomConnectivity(0.5, 4321)
+    for i, s in enumerate(syn.vec):
+        n = s.numSynapses
+        s.synapse.vec.weight = 1e-3 * (1 + np.arange(n) % 3)
+        s.synapse.vec.delay = 1e-3 * ((i + np.arange(n)) % 5)
+
+    tab = moose.Table(path + '/vm', numTgt)
+    moose.connect(tab, 'requestOut', tgt, 'getVm', 'OneToOne')
+
+    router = None
+    if useRouter:
+        router = moose.SpikeRouter(path + '/router')
+        router.sparseMsg = m
+        assert router.sparseMsg == m
+    return tab, router
+
+
+def test_spike_router():
+    tabA, _ = makeNetwork('/plain', False)
+    tabB, router = makeNetwork('/routed', True)
+    for i in range(10):
+        moose.setClock(i, dt)
+    moose.reinit()
+    assert router.numTargets == numTgt
+    assert router.numSynapses > 0
+    assert router.numSlots == 42
+    moose.start(0.2)
+    assert router.numSpikes > 0
+    for a, b in zip(tabA.vec, tabB.vec):
+        assert np.allclose(a.vector, b.vector), (a.vector, b.vector)
+
+    # Handing the Msg back restores the regular delivery.
+    router.sparseMsg = moose.element('/')
+    moose.reinit()
+    moose.start(0.2)
+    assert router.numSpikes == 0
+    for a, b in zip(tabA.vec, tabB.vec):
+        assert np.allclose(a.vector, b.vector)
+    moose.delete('/plain')
+    moose.delete('/routed')
+
+
+if __name__ == '__main__':
+    test_spike_router()
@@ -120,9 +120,70 @@ def test_abit_more():
     for i, name in enumerate(npData.dtype.names):
         assert (csvData[:,i] == npData[name]).all()
 
+def test_background_writer():
+    # Writing on the simulation thread and on the background writer must
+    # give the same file.
+    result = {}
+    for nbuf in [1, 2, 3]:
+        st = buildSystem('data_buf%d.npy' % nbuf)
+        st.numBuffers = nbuf
+        assert st.numBuffers == nbuf
+        moose.reinit()
+        moose.start(100)
+        assert st.stallTime >= 0.0
+        assert st.writeTime > 0.0
+        assert st.throughput > 0.0
+        result[nbuf] = np.load(st.outfile)
+    for nbuf in [2, 3]:
+        assert result[nbuf].shape == result[1].shape
+        for name in result[1].dtype.names:
+            assert (result[nbuf][name] == result[1][name]).all(), name
+
+def test_mapped_npy():
+    # The npy file can be loaded while it is being written, and a second
+    # run appends to it.
+    st = buildSystem('data_mapped.npy')
+    moose.reinit()
+    moose.start(50)
+    first = np.load(st.outfile, mmap_mode='r')
+    n = first.shape[0]
+    assert n > 0
+    moose.start(50)
+    second = np.load(st.outfile, mmap_mode='r')
+    assert second.shape[0] > n, (second.shape, n)
+    assert (second['time'][:n] == first['time']).all()
+    assert (np.diff(second['time']) > 0).all()
+
+def test_mcf():
+    from moose.streamer_utils import MCFReader
+    stCSV = buildSystem('data_mcf.csv')
+    moose.reinit()
+    moose.start(100)
+    csvData = np.loadtxt(stCSV.outfile, skiprows=1)
+
+    st = buildSystem('data.mcf')
+    assert st.format == 'mcf'
+    moose.reinit()
+    moose.start(100)
+    r = MCFReader(st.outfile)
+    assert r.num_rows == csvData.shape[0], (r.num_rows, csvData.shape)
+    for i, name in enumerate(r.columns):
+        t, v = r.read(name)
+        assert np.allclose(v, csvData[:, i]), name
+
+    # Only the rows in the range come back.
+    tAll, vAll = r.read(r.columns[1])
+    t, v = r.read(r.columns[1], tmin=20, tmax=30)
+    sel = (tAll >= 20) & (tAll <= 30)
+    assert (t == tAll[sel]).all()
+    assert (v == vAll[sel]).all()
+
 def main( ):
     test_sanity( )
     test_abit_more( )
+    test_background_writer( )
+    test_mapped_npy( )
+    test_mcf( )
 
 if __name__ == '__main__':
     main()
@@ -1,6 +1,7 @@
 # -*- coding: utf-8 -*-
 # test_synchan.py ---
 
+import numpy as np
 import moose
 print( 'Using moose from %s' % moose.__file__ )
 
@@ -49,5 +50,101 @@ def test_synchan():
     moose.reinit()
     moose.start(100)
 
+def make_aggregate_cell(path, aggregate):
+    """A compartment with several SynChans of the same kind, each driven by
+    its own spike train."""
+    moose.Neutral(path)
+    comp = moose.Compartment(path + '/comp')
+    comp.Rm = 1e9
+    comp.Cm = 1e-11
+    comp.Em = -0.065
+    comp.initVm = -0.065
+    chans = []
+    for i in range(4):
+        syn = moose.SynChan('%s/comp/syn%d' % (path, i))
+        syn.tau1 = 5e-3
+        syn.tau2 = 1e-3
+        syn.Gbar = 1e-9 * (i + 1)
+        syn.Ek = 0.0
+        syn.aggregate = aggregate
+        moose.connect(comp, 'channel', syn, 'channel')
+        sh = moose.SimpleSynHandler(syn.path + '/sh')
+        sh.synapse.num = 1
+        sh.synapse[0].weight = 1.0
+        sh.synapse[0].delay = 1e-3 * i
+        moose.connect(sh, 'activationOut', syn, 'activation')
+        sg = moose.SpikeGen(syn.path + '/sg')
+        sg.threshold = 0.5
+        sg.refractT = 0.01 + 0.003 * i
+        sg.edgeTriggered = False
+        stim = moose.PulseGen(syn.path + '/stim')
+        stim.delay[0] = 0.0
+        stim.level[0] = 1.0
+        stim.width[0] = 1.0
+        moose.connect(stim, 'output', sg, 'Vm')
+        moose.connect(sg, 'spikeOut', sh.synapse[0], 'addSpike')
+        chans.append(syn)
+    # A channel with other time constants stays in a group of its own.
+    odd = moose.SynChan(path + '/comp/odd')
+    odd.tau1 = 2e-3
+    odd.tau2 = 2e-3
+    odd.Gbar = 1e-9
+    odd.aggregate = aggregate
+    moose.connect(comp, 'channel', odd, 'channel')
+    tab = moose.Table(path + '/vm')
+    moose.connect(tab, 'requestOut', comp, 'getVm')
+    return chans, odd, tab
+
+
+def test_synchan_aggregate():
+    chansA, oddA, tabA = make_aggregate_cell('/aggA', False)
+    chansB, oddB, tabB = make_aggregate_cell('/aggB', True)
+    for i in range(10):
+        moose.setClock(i, 5e-5)
+    moose.reinit()
+    for c in chansA:
+        assert c.aggregateLeader == c
+    for c in chansB:
+        assert c.aggregateLeader == chansB[0]
+    assert oddB.aggregateLeader == oddB
+    moose.start(0.1)
+    assert max(tabA.vector) > -0.064
+    assert np.allclose(tabA.vector, tabB.vector, rtol=1e-6, atol=1e-9)
+    assert chansB[1].Gk == 0.0
+    moose.delete('/aggA')
+    moose.delete('/aggB')
+
+def test_synchan_aggregate_own_current():
+    # A SynChan whose Ik is sent out is left out of its group, so that
+    # what it sends is its own current.
+    tabs = []
+    for path, aggregate in (('/aggC', False), ('/aggD', True)):
+        chans, odd, tab = make_aggregate_cell(path, aggregate)
+        ik = moose.Table(path + '/ik')
+        moose.connect(chans[2], 'IkOut', ik, 'input')
+        tabs.append((chans, tab, ik))
+    for i in range(10):
+        moose.setClock(i, 5e-5)
+    moose.reinit()
+    chansD = tabs[1][0]
+    assert chansD[2].aggregateLeader == chansD[2]
+    for i in (0, 1, 3):
+        assert chansD[i].aggregateLeader == chansD[0]
+    moose.start(0.1)
+    assert min(tabs[0][2].vector) < 0.0
+    assert np.allclose(tabs[0][2].vector, tabs[1][2].vector,
+                       rtol=1e-6, atol=1e-18)
+    assert np.allclose(tabs[0][1].vector, tabs[1][1].vector,
+                       rtol=1e-6, atol=1e-9)
+    # The members carry on by themselves once their leader is gone.
+    moose.delete(chansD[0])
+    moose.start(0.05)
+    assert chansD[1].Gk > 0.0
+    moose.delete('/aggC')
+    moose.delete('/aggD')
+
+
 if __name__ == '__main__':
     test_synchan()
+    test_synchan_aggregate()
+    test_synchan_aggregate_own_current()
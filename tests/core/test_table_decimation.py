@@ -0,0 +1,71 @@
+# -*- coding: utf-8 -*-
+"""test_table_decimation.py:
+
+Test the decimation modes of moose.Table.
+
+"""
+
+import numpy as np
+import moose
+
+dt = 1e-4
+binWidth = 2e-3
+runtime = 0.1
+
+def build(modes):
+    model = moose.Neutral('/model')
+    # A single narrow pulse, much narrower than a bin.
+    pg = moose.PulseGen('/model/pg')
+    pg.baseLevel = 0.0
+    pg.delay[0] = 0.0101
+    pg.level[0] = 1.0
+    pg.width[0] = 0.0005
+    pg.delay[1] = 1e9
+    moose.setClock(pg.tick, dt)
+
+    tabs = {}
+    for mode in modes:
+        tab = moose.Table('/model/tab_%s' % mode)
+        if mode != 'none':
+            tab.decimation = mode
+            tab.binWidth = binWidth
+        assert tab.decimation == mode
+        moose.connect(tab, 'requestOut', pg, 'getOutputValue')
+        moose.setClock(tab.tick, dt)
+        tabs[mode] = tab
+    return tabs
+
+def test_decimation():
+    tabs = build(['none', 'nth', 'mean', 'minmax', 'lttb'])
+    moose.reinit()
+    moose.start(runtime)
+    for tab in tabs.values():
+        tab.flushBins()
+
+    full = tabs['none'].vector
+    nbins = int(round(runtime / binWidth))
+    assert len(full) > 10 * nbins
+    assert max(full) == 1.0
+
+    for mode in ['nth', 'mean', 'lttb']:
+        n = len(tabs[mode].vector)
+        assert nbins - 1 <= n <= nbins + 2, (mode, n)
+    assert nbins <= len(tabs['minmax'].vector) <= 2 * nbins + 2
+
+    # Extremes survive min/max and lttb, while the mean smooths them out.
+    assert max(tabs['minmax'].vector) == 1.0
+    assert max(tabs['lttb'].vector) == 1.0
+    assert 0.0 < max(tabs['mean'].vector) < 1.0
+    assert np.isclose(np.mean(tabs['mean'].vector), np.mean(full), atol=1e-3)
+
+    for tab in tabs.values():
+        t = tab.times
+        assert len(t) == len(tab.vector), (tab.path, len(t), len(tab.vector))
+        assert (np.diff(t) >= 0).all(), tab.path
+    moose.delete('/model')
+
+def main():
+    test_decimation()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,89 @@
+# -*- coding: utf-8 -*-
+"""test_table_spill.py:
+
+Test that a Table with ringSize set spills its entries to disk and still
+returns all of them.
+
+"""
+
+import os
+import numpy as np
+import moose
+
+def build(name, ringSize=0, spillFile=''):
+    pg = moose.element('/model/pg') if moose.exists('/model/pg') else None
+    if pg is None:
+        moose.Neutral('/model')
+        pg = moose.PulseGen('/model/pg')
+        pg.delay[0] = 0.01
+        pg.level[0] = 1.0
+        pg.width[0] = 0.005
+        moose.setClock(pg.tick, 1e-4)
+    tab = moose.Table('/model/%s' % name)
+    tab.ringSize = ringSize
+    if spillFile:
+        tab.spillFile = spillFile
+    moose.connect(tab, 'requestOut', pg, 'getOutputValue')
+    moose.setClock(tab.tick, 1e-4)
+    return tab
+
+def test_spill():
+    full = build('full')
+    spilled = build('spilled', ringSize=100)
+    kept = build('kept', ringSize=64, spillFile='_table_spill.npy')
+    moose.reinit()
+    moose.start(0.1)
+
+    assert spilled.numSpilled > 0
+    assert spilled.numSpilled % 100 == 0
+    assert len(spilled.vector) == len(full.vector), (len(spilled.vector), len(full.vector))
+    assert spilled.size == full.size
+    assert (spilled.vector == full.vector).all()
+    assert (spilled.times == full.times).all()
+    assert spilled.y[150] == full.y[150]
+    scratch = spilled.spillFile
+    assert os.path.exists(scratch), scratch
+
+    # The spill file is a npy file of time and value.
+    data = np.load(kept.spillFile)
+    assert len(data) == kept.numSpilled
+    assert (data[data.dtype.names[1]] == full.vector[:kept.numSpilled]).all()
+
+    # Comparisons and plot dumps cover the spilled entries too.
+    spilled.compareVec(full.vector, 'rmsd')
+    assert spilled.outputValue == 0.0
+    spilled.compareVec(np.concatenate((full.vector[:-1], [2.0])), 'rmsd')
+    assert spilled.outputValue > 0.0
+    plotfile = '_table_spill.xplot'
+    if os.path.exists(plotfile):
+        os.remove(plotfile)
+    spilled.xplot(plotfile, 'spilled')
+    spilled.compareXplot(plotfile, 'spilled', 'rmsd')
+    assert spilled.outputValue == 0.0
+    spilled.plainPlot(plotfile)
+    assert np.array_equal(np.loadtxt(plotfile), full.vector)
+    os.remove(plotfile)
+
+    # Spilled entries cannot be changed, nor viewed in place.
+    before = spilled.vector
+    spilled.linearTransform(2.0, 1.0)
+    assert np.array_equal(spilled.vector, before)
+    try:
+        moose.view(spilled)
+        assert False, 'Viewed a table with spilled entries'
+    except ValueError:
+        pass
+    assert np.array_equal(np.asarray(moose.view(full)), full.vector)
+
+    # Scratch files go with the data.
+    spilled.clearVec()
+    assert spilled.numSpilled == 0
+    assert not os.path.exists(scratch)
+    moose.delete('/model')
+    assert os.path.exists('_table_spill.npy')
+
+def main():
+    test_spill()
+
+if __name__ == '__main__':
+    main()
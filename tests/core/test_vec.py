@@ -28,8 +28,25 @@ def test_vec3():
     assert foo.concInit == 0.123, foo.concInit
     assert np.allclose(foo.vec.concInit, [0.123]*500)
 
+def test_vec_bulk():
+    # Strided and non-contiguous arrays are read in place.
+    comp = moose.vec('/comp_bulk', n=1000, dtype='Compartment')
+    vals = np.linspace(-0.07, 0.01, 2000)
+    comp.Vm = vals[::2]
+    assert np.allclose(comp.Vm, vals[::2])
+    assert comp.Vm.dtype == np.float64
+    comp.Vm = vals[::-2]
+    assert np.allclose(comp.Vm, vals[::-2])
+    # Integers go through the conversion path.
+    comp.Vm = np.arange(1000)
+    assert comp[999].Vm == 999.0
+    comp.Vm = -0.065
+    assert np.allclose(comp.Vm, -0.065)
+    moose.delete(comp.path)
+
 
 if __name__ == '__main__':
     test_vec()
     test_vec2()
     test_vec3()
+    test_vec_bulk()
@@ -0,0 +1,82 @@
+# -*- coding: utf-8 -*-
+# test_nsdf_async.py ---
+# Writes the same model with NSDFWriter2 once with asyncFlush on and once
+# with it off, and checks that both files hold the same uniform data.
+
+import os
+import tempfile
+import numpy as np
+import moose
+
+def make_model(fname, async_flush):
+    model = moose.Neutral('/model')
+    cell = moose.Neuron('/model/cell')
+    prev = None
+    for i in range(3):
+        c = moose.Compartment('/model/cell/c%d' % i)
+        c.Rm = 1e9
+        c.Ra = 1e7
+        c.Cm = 1e-11
+        c.Em = c.initVm = -0.065
+        if prev:
+            moose.connect(prev, 'raxial', c, 'axial')
+        prev = c
+    moose.element('/model/cell/c0').inject = 1e-10
+    writer = moose.NSDFWriter2('/model/writer')
+    writer.filename = fname
+    writer.mode = 2
+    writer.modelRoot = ''
+    # 7 does not divide the number of steps, so the last write is a
+    # partial one made when the run ends.
+    writer.flushLimit = 7
+    writer.asyncFlush = async_flush
+    writer.blocks = ['/model/cell/c#.Vm']
+    return model
+
+def read_uniform(fname):
+    import h5py
+    data = {}
+    with h5py.File(fname, 'r') as f:
+        def visit(name, obj):
+            if isinstance(obj, h5py.Dataset):
+                data[name] = obj[()]
+        f['/data/uniform'].visititems(visit)
+    return data
+
+def write_model(fname, async_flush):
+    make_model(fname, async_flush)
+    for i in (0, 1, 2, 3, 30):
+        moose.setClock(i, 1e-3)
+    moose.reinit()
+    moose.start(0.05)
+    moose.start(0.0305)
+    # Deleting the writer closes the file.
+    moose.delete('/model')
+    return read_uniform(fname)
+
+def test_async_flush():
+    try:
+        import h5py
+    except ImportError:
+        print('h5py is not available, skipping test')
+        return
+    if not hasattr(moose, 'NSDFWriter2'):
+        print('This MOOSE is not compiled with NSDF support')
+        return
+    d = tempfile.mkdtemp()
+    ref = write_model(os.path.join(d, 'sync.h5'), False)
+    data = write_model(os.path.join(d, 'async.h5'), True)
+    assert ref, 'No uniform data written'
+    assert sorted(ref.keys()) == sorted(data.keys())
+    for key in ref:
+        assert ref[key].shape == data[key].shape, key
+        assert np.array_equal(ref[key], data[key]), key
+        if ref[key].ndim == 2:
+            nsteps = ref[key].shape[1]
+            assert nsteps > 7 and nsteps % 7 != 0, (key, nsteps)
+
+def main():
+    test_async_flush()
+
+if __name__ == '__main__':
+    main()
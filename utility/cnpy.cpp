@@ -19,6 +19,13 @@
 #include "cnpy.hpp"
 #include <fstream>
 #include <iterator>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "print_function.hpp"
 
@@ -164,14 +171,12 @@ void changeHeaderShape(std::fstream& fs, const size_t data_len, const size_t num
     fs.write(newHeader.c_str(), newHeader.size());
 }
 
-size_t writeHeader(std::fstream& fs, const vector<string>& colnames, const vector<size_t>& shape)
+/**
+ * @brief Make the whole header: magic, header length and the header dict
+ * with the given shape string, padded for alignment.
+ */
+string headerString(const vector<string>& colnames, const string& shape, const size_t align=16)
 {
-    // Heder are always at the begining of file.
-    fs.seekp(0);
-
-    // Write the format string. 8 bytes.
-    fs.write(&__pre__[0], __pre__.size());
-
     char endianChar = cnpy2::BigEndianTest();
     const char formatChar = 'd';
 
@@ -187,7 +192,7 @@ size_t writeHeader(std::fstream& fs, const vector<string>& colnames, const vecto
     // shape is changed everytime we append the data. We use fixed number of
     // character in shape. Its a int, we will use 13 chars to represent shape.
     header += "], 'fortran_order':False,'shape':";
-    header += shapeToString(shape);
+    header += shape;
     header += ",}";
 
     // Add some extra sapce for safety.
@@ -199,17 +204,25 @@ size_t writeHeader(std::fstream& fs, const vector<string>& colnames, const vecto
     // pad with spaces so that preamble+headerlen+header is modulo 16 bytes.
     // preamble is 8 bytes, header len is 4 bytes, total 12.
     // header needs to end with \n
-    unsigned int remainder = 16 - (12 + header.size()) % 16;
+    unsigned int remainder = align - (12 + header.size()) % align;
     header.insert(header.end(), remainder-1, ' ');
     header += '\n';                             // Add newline. 
 
     // Now write the size of header. Its 4 byte long in version 2.
     uint32_t s = header.size();
-    fs.write((char*)&s, 4);
-    fs << header;
-    return fs.tellp();
+    string ret(__pre__.begin(), __pre__.end());
+    ret.append((char*)&s, 4);
+    ret += header;
+    return ret;
 }
 
+size_t writeHeader(std::fstream& fs, const vector<string>& colnames, const vector<size_t>& shape)
+{
+    // Heder are always at the begining of file.
+    fs.seekp(0);
+    fs << headerString(colnames, shapeToString(shape));
+    return fs.tellp();
+}
 
 size_t initNumpyFile(const string& outfile, const vector<string>& colnames)
 {
@@ -282,6 +295,192 @@ void appendNumpy(const string& outfile, const vector<double>& vec, const vector<
     fs.close();
 }
 
+/*-----------------------------------------------------------------------------
+ *  MappedNumpy
+ *-----------------------------------------------------------------------------*/
+const size_t MappedNumpy::chunkBytes = 1 << 26;
+
+// Width of the row count in the shape, enough for any size_t.
+static const size_t shapeWidth = 20;
+
+MappedNumpy::MappedNumpy() :
+    fd_(-1), map_(nullptr), mapBytes_(0), headerBytes_(0), shapePos_(0),
+    numCols_(0), numValues_(0)
+{
+}
+
+MappedNumpy::~MappedNumpy()
+{
+    close();
+}
+
+bool MappedNumpy::isOpen() const
+{
+    return fd_ >= 0;
+}
+
+size_t MappedNumpy::rows() const
+{
+    return numCols_ > 0 ? numValues_ / numCols_ : 0;
+}
+
+const double* MappedNumpy::data() const
+{
+    return map_ ? reinterpret_cast<const double*>(map_ + headerBytes_) : nullptr;
+}
+
+size_t MappedNumpy::size() const
+{
+    return numValues_;
+}
+
+bool MappedNumpy::create(const string& outfile, const vector<string>& colnames)
+{
+#ifndef _WIN32
+    close();
+    if(colnames.size() == 0)
+        return false;
+    fd_ = ::open(outfile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd_ < 0)
+    {
+        moose::showWarn( "Could not open file " + outfile );
+        return false;
+    }
+    // Right-aligned in a field of fixed width, so that the header never
+    // changes size. Python allows spaces in the tuple.
+    string header = headerString(colnames, "(" + string(shapeWidth-1, ' ') + "0,)", 64);
+    headerBytes_ = header.size();
+    shapePos_ = header.find("'shape':(") + 9;
+    numCols_ = colnames.size();
+    numValues_ = 0;
+    if(! reserve(headerBytes_))
+        return false;
+    memcpy(map_, header.data(), headerBytes_);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MappedNumpy::open(const string& outfile, const size_t numcols)
+{
+#ifndef _WIN32
+    close();
+    fd_ = ::open(outfile.c_str(), O_RDWR);
+    if(fd_ < 0)
+        return false;
+    struct stat st;
+    char pre[12];
+    if(fstat(fd_, &st) != 0 || pread(fd_, pre, 12, 0) != 12 ||
+            memcmp(pre, &__pre__[0], __pre__.size()) != 0)
+    {
+        close();
+        return false;
+    }
+    uint32_t len = 0;
+    memcpy(&len, pre + 8, 4);
+    string header(len, ' ');
+    if(pread(fd_, &header[0], len, 12) != (ssize_t)len)
+    {
+        close();
+        return false;
+    }
+    // Only files with the fixed width shape made by create will do.
+    size_t pos = header.find("'shape':(");
+    size_t end = header.find(",)", pos);
+    if(pos == string::npos || end == string::npos || end - pos - 9 != shapeWidth)
+    {
+        close();
+        return false;
+    }
+    headerBytes_ = 12 + len;
+    shapePos_ = 12 + pos + 9;
+    numCols_ = numcols;
+    numValues_ = strtoull(header.c_str() + pos + 9, nullptr, 10) * numcols;
+    size_t size = std::max<size_t>(st.st_size, headerBytes_ + numValues_ * sizeof(double));
+    mapBytes_ = 0;
+    return reserve(size);
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Grow the file and the mapping to at least this many bytes, in
+ * whole chunks.
+ */
+bool MappedNumpy::reserve(const size_t bytes)
+{
+#ifndef _WIN32
+    if(bytes <= mapBytes_ && map_)
+        return true;
+    size_t newBytes = chunkBytes * (1 + (bytes - 1) / chunkBytes);
+    if(map_)
+        munmap(map_, mapBytes_);
+    map_ = nullptr;
+    if(ftruncate(fd_, newBytes) != 0)
+    {
+        moose::showWarn( "Could not grow numpy file to " + std::to_string(newBytes) + " bytes" );
+        close();
+        return false;
+    }
+    void* p = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if(p == MAP_FAILED)
+    {
+        moose::showWarn( "Could not map numpy file" );
+        close();
+        return false;
+    }
+    map_ = static_cast<char*>(p);
+    mapBytes_ = newBytes;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MappedNumpy::append(const double* data, const size_t n)
+{
+    if(! isOpen())
+        return false;
+    size_t end = headerBytes_ + (numValues_ + n) * sizeof(double);
+    if(! reserve(end))
+        return false;
+    memcpy(map_ + headerBytes_ + numValues_ * sizeof(double), data, n * sizeof(double));
+    numValues_ += n;
+    checkpoint();
+    return true;
+}
+
+void MappedNumpy::checkpoint()
+{
+    if(! map_)
+        return;
+    char buf[shapeWidth + 1];
+    snprintf(buf, sizeof(buf), "%*zu", (int)shapeWidth, rows());
+    memcpy(map_ + shapePos_, buf, shapeWidth);
+}
+
+void MappedNumpy::close()
+{
+#ifndef _WIN32
+    if(fd_ < 0)
+        return;
+    if(map_)
+    {
+        checkpoint();
+        munmap(map_, mapBytes_);
+        map_ = nullptr;
+        // Cut off the unused part of the last chunk.
+        if(ftruncate(fd_, headerBytes_ + numValues_ * sizeof(double)) != 0)
+            moose::showWarn( "Could not trim numpy file" );
+    }
+    ::close(fd_);
+    fd_ = -1;
+    mapBytes_ = 0;
+#endif
+}
+
 void readNumpy(const string& infile, vector<double>& data)
 {
     cout << "Reading from " << infile << endl;
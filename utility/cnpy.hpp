@@ -98,6 +98,57 @@ void appendNumpy(const string& outfile, const vector<double>& vec, const vector<
 size_t initNumpyFile(const string& outfile, const vector<string>& colnames);
 
 
+/**
+ * @brief Numpy file that is appended to through a memory map.
+ *
+ * The header is written once with room for a shape of up to 20 digits, so
+ * it never has to be reparsed or moved. The file is grown and mapped in
+ * large chunks, and data is copied straight into the mapping. The shape
+ * in the header is patched at every checkpoint, so that numpy.load (with
+ * or without mmap_mode) can read the rows written so far while the file
+ * is still growing. Any unused part of the last chunk is cut off on close.
+ */
+class MappedNumpy
+{
+public:
+    MappedNumpy();
+    ~MappedNumpy();
+
+    /* Create the file, with one column of doubles per name. */
+    bool create(const string& outfile, const vector<string>& colnames);
+
+    /* Open a file made by create, to append to it. */
+    bool open(const string& outfile, const size_t numcols);
+
+    bool append(const double* data, const size_t n);
+
+    /* Write the number of rows into the header. */
+    void checkpoint();
+
+    void close();
+
+    bool isOpen() const;
+    size_t rows() const;
+
+    /* The values written so far, row after row. */
+    const double* data() const;
+    size_t size() const;
+
+    /* The file grows by this many bytes at a time. */
+    static const size_t chunkBytes;
+
+private:
+    bool reserve(const size_t bytes);
+
+    int fd_;
+    char* map_;
+    size_t mapBytes_;
+    size_t headerBytes_;
+    size_t shapePos_;
+    size_t numCols_;
+    size_t numValues_;
+};
+
 /* --------------------------------------------------------------------------*/
 /**
  * @Synopsis  read numpy file and return data in a vector. This for testing
@@ -0,0 +1,601 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  mcf.cpp
+ *
+ *    Description:  Chunked, compressed columnar file format for Streamer.
+ *
+ *      This program is part of MOOSE simulator.
+ *
+ * =====================================================================================
+ */
+
+#include "mcf.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include "print_function.hpp"
+
+namespace mcf
+{
+
+static const char fileMagic[] = "MOOSEMCF";
+static const char chunkMagic[] = "CHNK";
+static const char indexMagic[] = "MCFINDEX";
+static const uint32_t version = 1;
+
+const size_t Writer::defaultChunkRows = 1024;
+
+/*-----------------------------------------------------------------------------
+ *  Little endian numbers.
+ *-----------------------------------------------------------------------------*/
+static void putU64(string& s, uint64_t v)
+{
+    for (size_t i = 0; i < 8; i++)
+        s += (char)((v >> (8*i)) & 0xff);
+}
+
+static void putU32(string& s, uint32_t v)
+{
+    for (size_t i = 0; i < 4; i++)
+        s += (char)((v >> (8*i)) & 0xff);
+}
+
+static void putF64(string& s, double v)
+{
+    uint64_t u;
+    memcpy(&u, &v, 8);
+    putU64(s, u);
+}
+
+static uint64_t getU64(const char* p)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < 8; i++)
+        v |= (uint64_t)(uint8_t)p[i] << (8*i);
+    return v;
+}
+
+static uint32_t getU32(const char* p)
+{
+    uint32_t v = 0;
+    for (size_t i = 0; i < 4; i++)
+        v |= (uint32_t)(uint8_t)p[i] << (8*i);
+    return v;
+}
+
+static double getF64(const char* p)
+{
+    uint64_t u = getU64(p);
+    double v;
+    memcpy(&v, &u, 8);
+    return v;
+}
+
+/*-----------------------------------------------------------------------------
+ *  LZ stage. Sequences of (token, literals, offset, match) as in LZ4: the
+ *  high nibble of the token is the number of literals and the low nibble
+ *  the match length less 4, each extended by 255-valued bytes when 15.
+ *  The last sequence has literals only.
+ *-----------------------------------------------------------------------------*/
+static const size_t minMatch = 4;
+static const size_t hashBits = 14;
+static const size_t maxOffset = 65535;
+
+static void putLength(string& out, size_t len)
+{
+    while (len >= 255)
+    {
+        out += (char)255;
+        len -= 255;
+    }
+    out += (char)len;
+}
+
+static void putSequence(string& out, const uint8_t* lit, size_t nlit, size_t offset, size_t mlen)
+{
+    size_t m = mlen >= minMatch ? mlen - minMatch : 0;
+    uint8_t token = (uint8_t)(std::min<size_t>(nlit, 15) << 4);
+    if (mlen > 0)
+        token |= (uint8_t)std::min<size_t>(m, 15);
+    out += (char)token;
+    if (nlit >= 15)
+        putLength(out, nlit - 15);
+    out.append((const char*)lit, nlit);
+    if (mlen == 0)
+        return;
+    out += (char)(offset & 0xff);
+    out += (char)(offset >> 8);
+    if (m >= 15)
+        putLength(out, m - 15);
+}
+
+void lzCompress(const uint8_t* in, size_t n, string& out)
+{
+    vector<int64_t> table(1 << hashBits, -1);
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + minMatch <= n)
+    {
+        uint32_t seq;
+        memcpy(&seq, in + i, 4);
+        uint32_t h = (seq * 2654435761u) >> (32 - hashBits);
+        int64_t cand = table[h];
+        table[h] = i;
+        if (cand >= 0 && i - cand <= maxOffset && memcmp(in + cand, in + i, minMatch) == 0)
+        {
+            size_t len = minMatch;
+            while (i + len < n && in[cand + len] == in[i + len])
+                len++;
+            putSequence(out, in + anchor, i - anchor, i - cand, len);
+            i += len;
+            anchor = i;
+        }
+        else
+            i++;
+    }
+    putSequence(out, in + anchor, n - anchor, 0, 0);
+}
+
+static bool getLength(const uint8_t*& p, const uint8_t* end, size_t& len)
+{
+    uint8_t b;
+    do
+    {
+        if (p >= end)
+            return false;
+        b = *p++;
+        len += b;
+    }
+    while (b == 255);
+    return true;
+}
+
+bool lzDecompress(const uint8_t* in, size_t n, string& out, size_t expected)
+{
+    const uint8_t* p = in;
+    const uint8_t* end = in + n;
+    out.clear();
+    out.reserve(expected);
+    while (p < end)
+    {
+        uint8_t token = *p++;
+        size_t nlit = token >> 4;
+        if (nlit == 15 && ! getLength(p, end, nlit))
+            return false;
+        if ((size_t)(end - p) < nlit)
+            return false;
+        out.append((const char*)p, nlit);
+        p += nlit;
+        if (p == end)
+            break;
+        if (end - p < 2)
+            return false;
+        size_t offset = p[0] | (p[1] << 8);
+        p += 2;
+        size_t mlen = token & 0x0f;
+        if (mlen == 15 && ! getLength(p, end, mlen))
+            return false;
+        mlen += minMatch;
+        if (offset == 0 || offset > out.size() || out.size() + mlen > expected)
+            return false;
+        // Byte by byte, since the match may overlap what it writes.
+        size_t from = out.size() - offset;
+        for (size_t k = 0; k < mlen; k++)
+            out += out[from + k];
+    }
+    return out.size() == expected;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Delta and byte shuffle.
+ *-----------------------------------------------------------------------------*/
+// Prediction of value i from the ones before it, as 64 bit integers.
+static inline uint64_t predict(uint8_t codec, size_t i, uint64_t p1, uint64_t p2)
+{
+    if (codec == DELTA2_SHUFFLE_LZ && i > 1)
+        return 2 * p1 - p2;
+    return p1;
+}
+
+static void shuffleLz(uint8_t codec, const double* data, size_t n, string& out)
+{
+    string shuffled(8 * n, '\0');
+    uint64_t p1 = 0, p2 = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t u;
+        memcpy(&u, data + i, 8);
+        uint64_t d = u - predict(codec, i, p1, p2);
+        p2 = p1;
+        p1 = u;
+        for (size_t b = 0; b < 8; b++)
+            shuffled[b * n + i] = (char)((d >> (8*b)) & 0xff);
+    }
+    lzCompress((const uint8_t*)shuffled.data(), shuffled.size(), out);
+}
+
+uint8_t encode(const double* data, size_t n, string& out)
+{
+    string packed, packed2;
+    shuffleLz(DELTA_SHUFFLE_LZ, data, n, packed);
+    shuffleLz(DELTA2_SHUFFLE_LZ, data, n, packed2);
+    uint8_t codec = DELTA_SHUFFLE_LZ;
+    if (packed2.size() < packed.size())
+    {
+        packed.swap(packed2);
+        codec = DELTA2_SHUFFLE_LZ;
+    }
+    if (packed.size() < 8 * n)
+    {
+        out.append(packed);
+        return codec;
+    }
+
+    for (size_t i = 0; i < n; i++)
+        putF64(out, data[i]);
+    return RAW;
+}
+
+bool decode(uint8_t codec, const char* in, size_t nbytes, size_t n, double* out)
+{
+    if (codec == RAW)
+    {
+        if (nbytes != 8 * n)
+            return false;
+        for (size_t i = 0; i < n; i++)
+            out[i] = getF64(in + 8*i);
+        return true;
+    }
+    if (codec != DELTA_SHUFFLE_LZ && codec != DELTA2_SHUFFLE_LZ)
+        return false;
+
+    string shuffled;
+    if (! lzDecompress((const uint8_t*)in, nbytes, shuffled, 8 * n))
+        return false;
+    uint64_t p1 = 0, p2 = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t d = 0;
+        for (size_t b = 0; b < 8; b++)
+            d |= (uint64_t)(uint8_t)shuffled[b * n + i] << (8*b);
+        uint64_t u = d + predict(codec, i, p1, p2);
+        p2 = p1;
+        p1 = u;
+        memcpy(out + i, &u, 8);
+    }
+    return true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Reader
+ *-----------------------------------------------------------------------------*/
+bool Reader::open(const string& path)
+{
+    fs_.close();
+    columns_.clear();
+    chunks_.clear();
+    hasIndex_ = false;
+
+    fs_.open(path, std::ios::in | std::ios::binary);
+    if (! fs_.is_open())
+        return false;
+
+    char buf[16];
+    if (! fs_.read(buf, 16) || memcmp(buf, fileMagic, 8) != 0)
+        return false;
+    if (getU32(buf + 8) > version)
+    {
+        moose::showWarn("mcf: " + path + " is of a newer version.");
+        return false;
+    }
+    uint32_t ncols = getU32(buf + 12);
+    for (size_t i = 0; i < ncols; i++)
+    {
+        if (! fs_.read(buf, 4))
+            return false;
+        string name(getU32(buf), '\0');
+        if (! fs_.read(&name[0], name.size()))
+            return false;
+        columns_.push_back(name);
+    }
+    headerEnd_ = fs_.tellg();
+
+    if (! readFooter())
+        scanChunks();
+    return true;
+}
+
+bool Reader::readFooter()
+{
+    fs_.clear();
+    fs_.seekg(0, std::ios::end);
+    uint64_t size = fs_.tellg();
+    if (size < headerEnd_ + 24)
+        return false;
+
+    char buf[24];
+    fs_.seekg(size - 24);
+    if (! fs_.read(buf, 24) || memcmp(buf + 16, indexMagic, 8) != 0)
+        return false;
+    uint64_t numChunks = getU64(buf);
+    uint64_t footerOffset = getU64(buf + 8);
+    size_t entryBytes = 36 + 13 * columns_.size();
+    if (footerOffset < headerEnd_ || footerOffset + numChunks * entryBytes + 24 != size)
+        return false;
+
+    string footer(numChunks * entryBytes, '\0');
+    fs_.seekg(footerOffset);
+    if (! fs_.read(&footer[0], footer.size()))
+        return false;
+
+    const char* p = footer.data();
+    chunks_.resize(numChunks);
+    for (auto& c : chunks_)
+    {
+        c.offset = getU64(p);
+        c.firstRow = getU64(p + 8);
+        c.numRows = getU32(p + 16);
+        c.tStart = getF64(p + 20);
+        c.tEnd = getF64(p + 28);
+        p += 36;
+        c.columns.resize(columns_.size());
+        for (auto& col : c.columns)
+        {
+            col.offset = getU64(p);
+            col.nbytes = getU32(p + 8);
+            col.codec = (uint8_t)p[12];
+            p += 13;
+        }
+    }
+    dataEnd_ = footerOffset;
+    hasIndex_ = true;
+    return true;
+}
+
+/**
+ * @brief Recover the index of a file that has no footer, up to the last
+ * complete chunk.
+ */
+void Reader::scanChunks()
+{
+    chunks_.clear();
+    fs_.clear();
+    fs_.seekg(0, std::ios::end);
+    uint64_t size = fs_.tellg();
+    uint64_t pos = headerEnd_;
+    char buf[36];
+    while (pos + 36 <= size)
+    {
+        fs_.seekg(pos);
+        if (! fs_.read(buf, 36) || memcmp(buf, chunkMagic, 4) != 0)
+            break;
+        ChunkEntry c;
+        c.offset = pos;
+        c.firstRow = getU64(buf + 4);
+        c.numRows = getU32(buf + 12);
+        c.tStart = getF64(buf + 16);
+        c.tEnd = getF64(buf + 24);
+        c.columns.resize(columns_.size());
+        uint64_t q = pos + 32;
+        for (auto& col : c.columns)
+        {
+            char h[5];
+            fs_.seekg(q);
+            if (! fs_.read(h, 5))
+                break;
+            col.codec = (uint8_t)h[0];
+            col.nbytes = getU32(h + 1);
+            col.offset = q + 5;
+            q = col.offset + col.nbytes;
+        }
+        if (! fs_ || q > size)
+            break;
+        chunks_.push_back(c);
+        pos = q;
+    }
+    dataEnd_ = pos;
+    fs_.clear();
+}
+
+size_t Reader::numRows() const
+{
+    if (chunks_.empty())
+        return 0;
+    return chunks_.back().firstRow + chunks_.back().numRows;
+}
+
+int Reader::columnIndex(const string& name) const
+{
+    auto it = std::find(columns_.begin(), columns_.end(), name);
+    return it == columns_.end() ? -1 : it - columns_.begin();
+}
+
+bool Reader::readColumn(const ChunkEntry& c, size_t col, vector<double>& values)
+{
+    const ColumnEntry& e = c.columns[col];
+    string bytes(e.nbytes, '\0');
+    fs_.clear();
+    fs_.seekg(e.offset);
+    if (! fs_.read(&bytes[0], bytes.size()))
+        return false;
+    values.resize(c.numRows);
+    return decode(e.codec, bytes.data(), bytes.size(), c.numRows, values.data());
+}
+
+bool Reader::read(size_t col, double tmin, double tmax, vector<double>& values)
+{
+    values.clear();
+    if (col >= columns_.size())
+        return false;
+
+    // Chunks are in order of time, so the first one that can overlap is
+    // found by bisection.
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), tmin,
+            [](const ChunkEntry& c, double t) { return c.tEnd < t; });
+
+    vector<double> t, v;
+    for (; it != chunks_.end() && it->tStart <= tmax; it++)
+    {
+        if (! readColumn(*it, 0, t) || ! readColumn(*it, col, v))
+            return false;
+        for (size_t i = 0; i < t.size(); i++)
+            if (t[i] >= tmin && t[i] <= tmax)
+                values.push_back(v[i]);
+    }
+    return true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Writer
+ *-----------------------------------------------------------------------------*/
+Writer::Writer() : numCols_(0), chunkRows_(defaultChunkRows), numRows_(0)
+{
+}
+
+Writer::~Writer()
+{
+    close();
+}
+
+bool Writer::create(const string& path, const vector<string>& colnames, size_t chunkRows)
+{
+    close();
+    if (colnames.empty())
+        return false;
+    fs_.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (! fs_.is_open())
+    {
+        moose::showWarn("Could not open file " + path);
+        return false;
+    }
+    string header(fileMagic, 8);
+    putU32(header, version);
+    putU32(header, colnames.size());
+    for (auto& c : colnames)
+    {
+        putU32(header, c.size());
+        header += c;
+    }
+    fs_.write(header.data(), header.size());
+
+    numCols_ = colnames.size();
+    chunkRows_ = std::max<size_t>(chunkRows, 1);
+    numRows_ = 0;
+    pending_.clear();
+    chunks_.clear();
+    return true;
+}
+
+bool Writer::open(const string& path, size_t numcols, size_t chunkRows)
+{
+    close();
+    Reader r;
+    if (! r.open(path))
+        return false;
+    if (r.columns().size() != numcols)
+    {
+        moose::showWarn("mcf: " + path + " has " + std::to_string(r.columns().size())
+                + " columns, expected " + std::to_string(numcols));
+        return false;
+    }
+
+    // New chunks go over the old footer, and a new one is written on close.
+    fs_.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (! fs_.is_open())
+        return false;
+    fs_.seekp(r.dataEnd());
+
+    numCols_ = numcols;
+    chunkRows_ = std::max<size_t>(chunkRows, 1);
+    numRows_ = r.numRows();
+    pending_.clear();
+    chunks_ = r.chunks();
+    return true;
+}
+
+bool Writer::append(const double* data, size_t n)
+{
+    if (! isOpen() || n % numCols_ != 0)
+        return false;
+    pending_.insert(pending_.end(), data, data + n);
+    size_t chunkSize = chunkRows_ * numCols_;
+    size_t done = 0;
+    for (; done + chunkSize <= pending_.size(); done += chunkSize)
+        writeChunk(pending_.data() + done, chunkRows_);
+    pending_.erase(pending_.begin(), pending_.begin() + done);
+    return true;
+}
+
+void Writer::writeChunk(const double* data, size_t rows)
+{
+    if (rows == 0)
+        return;
+
+    ChunkEntry c;
+    c.offset = fs_.tellp();
+    c.firstRow = numRows_;
+    c.numRows = rows;
+    c.tStart = data[0];
+    c.tEnd = data[(rows - 1) * numCols_];
+
+    string out(chunkMagic, 4);
+    putU64(out, c.firstRow);
+    putU32(out, c.numRows);
+    putF64(out, c.tStart);
+    putF64(out, c.tEnd);
+
+    vector<double> column(rows);
+    c.columns.resize(numCols_);
+    for (size_t j = 0; j < numCols_; j++)
+    {
+        for (size_t i = 0; i < rows; i++)
+            column[i] = data[i * numCols_ + j];
+        string bytes;
+        c.columns[j].codec = encode(column.data(), rows, bytes);
+        c.columns[j].nbytes = bytes.size();
+        out += (char)c.columns[j].codec;
+        putU32(out, bytes.size());
+        c.columns[j].offset = c.offset + out.size();
+        out += bytes;
+    }
+    fs_.write(out.data(), out.size());
+
+    numRows_ += rows;
+    chunks_.push_back(c);
+}
+
+void Writer::close()
+{
+    if (! isOpen())
+        return;
+    // The last chunk may be short.
+    writeChunk(pending_.data(), pending_.size() / numCols_);
+    pending_.clear();
+
+    string footer;
+    uint64_t footerOffset = fs_.tellp();
+    for (auto& c : chunks_)
+    {
+        putU64(footer, c.offset);
+        putU64(footer, c.firstRow);
+        putU32(footer, c.numRows);
+        putF64(footer, c.tStart);
+        putF64(footer, c.tEnd);
+        for (auto& col : c.columns)
+        {
+            putU64(footer, col.offset);
+            putU32(footer, col.nbytes);
+            footer += (char)col.codec;
+        }
+    }
+    putU64(footer, chunks_.size());
+    putU64(footer, footerOffset);
+    footer.append(indexMagic, 8);
+    fs_.write(footer.data(), footer.size());
+    fs_.close();
+    chunks_.clear();
+}
+
+} // Namespace mcf ends.
@@ -0,0 +1,172 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  mcf.hpp
+ *
+ *    Description:  Chunked, compressed columnar file format for Streamer.
+ *
+ *      This program is part of MOOSE simulator.
+ *
+ * =====================================================================================
+ */
+
+#ifndef  mcf_INC
+#define  mcf_INC
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+using namespace std;
+
+/**
+ * MOOSE columnar format (mcf).
+ *
+ * Rows are collected into chunks of a fixed number of rows, and each
+ * column of a chunk is compressed and stored on its own. An index at the
+ * end of the file records where each column of each chunk is, and the
+ * range of the first column (time) it covers, so that a reader can pick
+ * out one column over a time range without reading the rest.
+ *
+ * Layout, all numbers little endian:
+ *
+ *   header:  "MOOSEMCF" u32 version, u32 numCols,
+ *            numCols x (u32 nameLen, name)
+ *   chunk:   "CHNK" u64 firstRow, u32 numRows, f64 tStart, f64 tEnd,
+ *            numCols x (u8 codec, u32 nbytes, bytes)
+ *   footer:  numChunks x (u64 offset, u64 firstRow, u32 numRows,
+ *                          f64 tStart, f64 tEnd,
+ *                          numCols x (u64 offset, u32 nbytes, u8 codec))
+ *            u64 numChunks, u64 footerOffset, "MCFINDEX"
+ *
+ * Each chunk also carries its own header, so a file that was not closed
+ * (and so has no footer) can still be read by scanning the chunks.
+ *
+ * The codec takes the difference of each value with the previous one (as
+ * 64 bit integers), shuffles the bytes so that byte k of every value is
+ * stored together, and compresses the result with a small LZ77 coder.
+ * Slowly changing signals give long runs of equal high bytes, which is
+ * what the LZ stage removes. The second order codec predicts each value
+ * by a straight line through the two before it instead, which does
+ * better on smooth signals and on evenly spaced times. Each column of
+ * each chunk is stored with whichever of the two comes out smaller.
+ *
+ * Being lossless, the ratio depends on how much noise there is in the
+ * low mantissa bytes. With the default 1024 row chunks we measured:
+ * time 46x, constants, steps and exponential decays 110-130x, a passive
+ * charging curve 1.9x, a sine 1.8x and a spiking (FitzHugh-Nagumo)
+ * trace 1.4x.
+ */
+namespace mcf
+{
+
+enum Codec { RAW = 0, DELTA_SHUFFLE_LZ = 1, DELTA2_SHUFFLE_LZ = 2 };
+
+/* Compress n doubles. Returns the codec used. */
+uint8_t encode(const double* data, size_t n, string& out);
+
+/* Inverse of encode, for n doubles. Returns false if the data is corrupt. */
+bool decode(uint8_t codec, const char* in, size_t nbytes, size_t n, double* out);
+
+/* The LZ stage on its own. */
+void lzCompress(const uint8_t* in, size_t n, string& out);
+bool lzDecompress(const uint8_t* in, size_t n, string& out, size_t expected);
+
+struct ColumnEntry
+{
+    uint64_t offset;
+    uint32_t nbytes;
+    uint8_t codec;
+};
+
+struct ChunkEntry
+{
+    uint64_t offset;
+    uint64_t firstRow;
+    uint32_t numRows;
+    double tStart;
+    double tEnd;
+    vector<ColumnEntry> columns;
+};
+
+/**
+ * @brief Reads a file written by Writer.
+ */
+class Reader
+{
+public:
+    bool open(const string& path);
+
+    const vector<string>& columns() const { return columns_; }
+    const vector<ChunkEntry>& chunks() const { return chunks_; }
+    size_t numRows() const;
+
+    /* Position of the column by name, or -1. */
+    int columnIndex(const string& name) const;
+
+    /**
+     * @brief Read the values of a column in the rows where the first column
+     * is in [tmin, tmax]. Only the chunks that overlap the range are read.
+     */
+    bool read(size_t col, double tmin, double tmax, vector<double>& values);
+
+    /* End of the last complete chunk, where a footer would start. */
+    uint64_t dataEnd() const { return dataEnd_; }
+
+    /* True if the file had a footer, and was not read by scanning. */
+    bool hasIndex() const { return hasIndex_; }
+
+private:
+    bool readFooter();
+    void scanChunks();
+    bool readColumn(const ChunkEntry& c, size_t col, vector<double>& values);
+
+    std::ifstream fs_;
+    vector<string> columns_;
+    vector<ChunkEntry> chunks_;
+    uint64_t headerEnd_ = 0;
+    uint64_t dataEnd_ = 0;
+    bool hasIndex_ = false;
+};
+
+/**
+ * @brief Writes rows of doubles, the first column being time, into chunks
+ * of chunkRows rows.
+ */
+class Writer
+{
+public:
+    Writer();
+    ~Writer();
+
+    bool create(const string& path, const vector<string>& colnames, size_t chunkRows=defaultChunkRows);
+
+    /* Open a file made by create to append to it. */
+    bool open(const string& path, size_t numcols, size_t chunkRows=defaultChunkRows);
+
+    /* Append whole rows, stored row after row. */
+    bool append(const double* data, size_t n);
+
+    /* Write out the rows not yet in a chunk, and the footer. */
+    void close();
+
+    bool isOpen() const { return fs_.is_open(); }
+
+    static const size_t defaultChunkRows;
+
+private:
+    /* Write rows, at most chunkRows of them, as one chunk. */
+    void writeChunk(const double* data, size_t rows);
+
+    std::fstream fs_;
+    size_t numCols_;
+    size_t chunkRows_;
+    uint64_t numRows_;
+    vector<double> pending_;
+    vector<ChunkEntry> chunks_;
+};
+
+} // Namespace mcf ends.
+
+#endif   /* ----- #ifndef mcf_INC  ----- */
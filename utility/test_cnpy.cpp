@@ -59,6 +59,25 @@ int main(int argc, const char *argv[])
 
     for (size_t i = 0; i < r2.size(); i++)
         assert(data[i%data.size()] == r2[i]);
-    
+
+    // Append through a memory map, closing and opening again in between.
+    datafile = "_c_data.npy";
+    cnpy2::MappedNumpy m;
+    assert(m.create(datafile, cols));
+    m.append(data.data(), data.size());
+    m.append(data.data(), data.size());
+    m.close();
+    assert(m.open(datafile, cols.size()));
+    assert(m.rows() == 20);
+    m.append(data.data(), data.size());
+    m.close();
+
+    vector<double> r3;
+    cnpy2::readNumpy(datafile, r3);
+    cout << "Total data read from mapped file " << r3.size() << endl;
+    assert(r3.size() == 3 * data.size() );
+    for (size_t i = 0; i < r3.size(); i++)
+        assert(data[i%data.size()] == r3[i]);
+
     return 0;
 }